@@ -0,0 +1,125 @@
+///////////////////////////////////////////////////////////////////////////////
+// assetpack.cpp
+// ========
+// asset pack reading through a file mapping, and writing
+///////////////////////////////////////////////////////////////////////////////
+
+#include "AssetPack.h"
+#include "MipChain.h"
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+namespace
+{
+	const uint32_t ASSET_PACK_MAGIC = 0x4B415041;	// "APAK"
+	const uint32_t ASSET_PACK_VERSION = 5;
+}
+
+const char* AssetPackName(const char* path)
+{
+	const char* name = path;
+	for (const char* c = path; *c != '\0'; ++c)
+	{
+		if (*c == '/' || *c == '\\')
+			name = c + 1;
+	}
+	return name;
+}
+
+bool AssetPack::Open(const char* path)
+{
+	if (!file.Open(path))
+		return false;
+
+	const size_t size = file.Size();
+	bool valid = size >= sizeof(AssetPackHeader);
+	valid = valid && Header().magic == ASSET_PACK_MAGIC && Header().version == ASSET_PACK_VERSION;
+	valid = valid && sizeof(AssetPackHeader) + (size_t)Header().entryCount * sizeof(AssetPackEntry) <= size;
+	for (uint32_t i = 0; valid && i < Header().entryCount; ++i)
+	{
+		const AssetPackEntry& entry = Entries()[i];
+		valid = entry.offset % ASSET_PACK_ALIGNMENT == 0 && entry.offset <= size && entry.bytes <= size - entry.offset &&
+			memchr(entry.name, '\0', sizeof(entry.name)) != nullptr;
+	}
+
+	if (!valid)
+		Close();
+	return valid;
+}
+
+const AssetPackEntry* AssetPack::Find(AssetType type, const char* name) const
+{
+	if (!IsOpen())
+		return nullptr;
+	for (uint32_t i = 0; i < Header().entryCount; ++i)
+	{
+		if (Entries()[i].type == type && strcmp(Entries()[i].name, name) == 0)
+			return &Entries()[i];
+	}
+	return nullptr;
+}
+
+bool AssetPack::Verify(const AssetPackEntry& entry) const
+{
+	return HashBytes(Data(entry), (size_t)entry.bytes) == entry.hash;
+}
+
+AssetPackEntry& AssetPackWriter::Add(AssetType type, const char* name, const void* data, size_t bytes)
+{
+	AssetPackEntry entry = {};
+	strncpy(entry.name, name, sizeof(entry.name) - 1);
+	entry.type = type;
+	entry.bytes = bytes;
+	entry.hash = HashBytes((const unsigned char*)data, bytes);
+
+	// identical data is stored once and shared by every entry holding it
+	for (const AssetPackEntry& stored : entries)
+	{
+		if (stored.hash == entry.hash && stored.bytes == bytes && memcmp(blobs.data() + stored.offset, data, bytes) == 0)
+		{
+			entry.offset = stored.offset;
+			entries.push_back(entry);
+			return entries.back();
+		}
+	}
+
+	// pad the previous entry so this one starts aligned
+	blobs.resize((blobs.size() + ASSET_PACK_ALIGNMENT - 1) / ASSET_PACK_ALIGNMENT * ASSET_PACK_ALIGNMENT);
+	entry.offset = blobs.size();
+	blobs.insert(blobs.end(), (const unsigned char*)data, (const unsigned char*)data + bytes);
+	entries.push_back(entry);
+	return entries.back();
+}
+
+bool AssetPackWriter::Write(const char* path) const
+{
+	AssetPackHeader header = {};
+	header.magic = ASSET_PACK_MAGIC;
+	header.version = ASSET_PACK_VERSION;
+	header.entryCount = (uint32_t)entries.size();
+
+	// the data starts after the entry table, on an aligned offset
+	size_t tableEnd = sizeof(AssetPackHeader) + sizeof(AssetPackEntry) * entries.size();
+	size_t dataStart = (tableEnd + ASSET_PACK_ALIGNMENT - 1) / ASSET_PACK_ALIGNMENT * ASSET_PACK_ALIGNMENT;
+	std::vector<AssetPackEntry> table(entries);
+	for (AssetPackEntry& entry : table)
+		entry.offset += dataStart;
+
+	std::ofstream out(path, std::ios::binary | std::ios::trunc);
+	out.write((const char*)&header, sizeof(header));
+	out.write((const char*)table.data(), sizeof(AssetPackEntry) * table.size());
+	const char padding[ASSET_PACK_ALIGNMENT] = {};
+	out.write(padding, dataStart - tableEnd);
+	out.write((const char*)blobs.data(), blobs.size());
+	if (!out)
+	{
+		std::cout << "Failed to write asset pack " << path << std::endl;
+		return false;
+	}
+
+	std::cout << "INFO: Asset pack " << path << ": " << entries.size() << " assets, "
+		<< (dataStart + blobs.size()) / 1024 << " KB" << std::endl;
+	return true;
+}
@@ -0,0 +1,137 @@
+///////////////////////////////////////////////////////////////////////////////
+// assetpack.h
+// ========
+// one file holding every texture and mesh of the scene, ready for the GL:
+// textures as finished mip chains (RGBA8, or DXT1/DXT5 blocks) and meshes as
+// their interleaved vertex and index data. The file is memory mapped, so
+// startup reads no image files, decodes nothing and generates no geometry,
+// and the GL is handed pointers straight into the mapping.
+//
+// Layout (little endian): AssetPackHeader, AssetPackEntry per asset, then the
+// data of each asset starting on an ASSET_PACK_ALIGNMENT boundary
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "MappedFile.h"
+
+enum class AssetType : uint32_t
+{
+	Texture = 1,
+	Mesh = 2,
+};
+
+struct AssetPackHeader
+{
+	uint32_t magic;         // "APAK"
+	uint32_t version;
+	uint32_t entryCount;
+	uint32_t reserved;
+};
+
+struct AssetPackEntry
+{
+	char name[64];          // texture file name without its directory, or mesh name
+	AssetType type;
+	uint32_t glFormat;      // textures: GL_RGBA8, GL_COMPRESSED_RGB_S3TC_DXT1_EXT or GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+	int32_t width;          // textures only
+	int32_t height;
+	uint32_t levels;
+	uint32_t solid;         // textures: the image is one color (IsSolidColor), a 1x1 texture will do
+	uint32_t color;         // that color, RGBA bytes
+	uint32_t reserved;
+	uint64_t offset;        // from the start of the file
+	uint64_t bytes;
+	uint64_t hash;          // HashBytes of the data, checked before it is used
+};
+
+// Start of a mesh's data, followed by its nVertices vertices and then nIndices
+// indices, the levels of detail's after the full mesh's
+struct PackedMeshHeader
+{
+	static const uint32_t MAX_PARTS = 8;
+	static const uint32_t MAX_LODS = 4;
+
+	uint32_t generatorVersion;  // Meshes' MESH_GENERATOR_VERSION when the mesh was built
+	uint32_t segments;          // tessellation it was built at, 0 for the fixed meshes
+	uint32_t rings;
+	uint32_t nVertices;
+	uint32_t nIndices;
+	uint32_t floatsPerVertex;   // 0 for compact vertices (Meshes::gCompactVertices)
+	uint32_t indexSize;         // bytes per index, 2 or 4
+	float positionOffset[3];    // decode compact positions, as in Meshes::GLMesh
+	float positionScale[3];
+	uint32_t nParts;
+	struct
+	{
+		uint32_t mode;
+		uint32_t first;
+		uint32_t count;
+		uint32_t indexed;
+	} parts[MAX_PARTS];
+	uint32_t nLods;
+	struct
+	{
+		float error;        // in model units
+		uint32_t first[MAX_PARTS];	// indexed triangle lists, one per part
+		uint32_t count[MAX_PARTS];
+	} lods[MAX_LODS];
+};
+
+// Every asset's data starts on a multiple of this, so vertex data and DXT
+// blocks can be read in place
+const size_t ASSET_PACK_ALIGNMENT = 64;
+
+// Name a texture is stored under: the file name without its directory
+const char* AssetPackName(const char* path);
+
+// Read-only mapping of a pack file
+class AssetPack
+{
+public:
+	// Map path and check that the header, the entry table and every entry's
+	// data fit the file. The data hashes are not checked here, so opening
+	// touches only the first pages.
+	bool Open(const char* path);
+	void Close() { file.Close(); }
+	bool IsOpen() const { return file.IsOpen(); }
+
+	// Entry of the given type and name, or nullptr
+	const AssetPackEntry* Find(AssetType type, const char* name) const;
+	const unsigned char* Data(const AssetPackEntry& entry) const { return file.Data() + entry.offset; }
+
+	// Hash the entry's data and compare it with the one stored when the pack
+	// was built; reads every page of the entry
+	bool Verify(const AssetPackEntry& entry) const;
+
+	size_t Size() const { return file.Size(); }
+
+private:
+	const AssetPackHeader& Header() const { return *(const AssetPackHeader*)file.Data(); }
+	const AssetPackEntry* Entries() const { return (const AssetPackEntry*)(file.Data() + sizeof(AssetPackHeader)); }
+
+	MappedFile file;
+};
+
+// Collects assets in memory and writes them out as a pack
+class AssetPackWriter
+{
+public:
+	// Copy bytes of data into the pack under name, or share the copy of an
+	// earlier entry with the same data. The caller fills in the texture fields
+	// of the returned entry, which stays valid until the next Add.
+	AssetPackEntry& Add(AssetType type, const char* name, const void* data, size_t bytes);
+
+	bool Write(const char* path) const;
+
+private:
+	std::vector<AssetPackEntry> entries;
+	std::vector<unsigned char> blobs;   // every entry's data, offsets relative to the first
+};
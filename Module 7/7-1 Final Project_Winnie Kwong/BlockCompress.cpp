@@ -0,0 +1,381 @@
+///////////////////////////////////////////////////////////////////////////////
+// blockcompress.cpp
+// ========
+// BC1/BC3 encoder: principal axis endpoints refined by least squares
+///////////////////////////////////////////////////////////////////////////////
+
+#include "BlockCompress.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace
+{
+	// Weight of endpoint 0 in each of the four BC1 palette entries
+	const float PALETTE_WEIGHTS[4] = { 1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f };
+
+	uint16_t To565(const float color[3])
+	{
+		int r = (int)std::lround(std::min(std::max(color[0], 0.0f), 255.0f) * 31.0f / 255.0f);
+		int g = (int)std::lround(std::min(std::max(color[1], 0.0f), 255.0f) * 63.0f / 255.0f);
+		int b = (int)std::lround(std::min(std::max(color[2], 0.0f), 255.0f) * 31.0f / 255.0f);
+		return (uint16_t)((r << 11) | (g << 5) | b);
+	}
+
+	void From565(uint16_t value, int color[3])
+	{
+		int r = (value >> 11) & 31;
+		int g = (value >> 5) & 63;
+		int b = value & 31;
+		color[0] = (r << 3) | (r >> 2);
+		color[1] = (g << 2) | (g >> 4);
+		color[2] = (b << 3) | (b >> 2);
+	}
+
+	// The 4x4 pixels of block (bx, by), clamped to the image
+	void LoadBlock(const unsigned char* rgba, int width, int height, int bx, int by, unsigned char block[64])
+	{
+		for (int y = 0; y < 4; ++y)
+		{
+			int sy = std::min(by * 4 + y, height - 1);
+			for (int x = 0; x < 4; ++x)
+			{
+				int sx = std::min(bx * 4 + x, width - 1);
+				memcpy(block + (y * 4 + x) * 4, rgba + ((size_t)sy * width + sx) * 4, 4);
+			}
+		}
+	}
+
+	void StoreBlock(const unsigned char block[64], int width, int height, int bx, int by, unsigned char* rgba)
+	{
+		for (int y = 0; y < 4 && by * 4 + y < height; ++y)
+		{
+			for (int x = 0; x < 4 && bx * 4 + x < width; ++x)
+				memcpy(rgba + ((size_t)(by * 4 + y) * width + bx * 4 + x) * 4, block + (y * 4 + x) * 4, 4);
+		}
+	}
+
+	// Nearest palette entry of each pixel, two bits per pixel
+	uint32_t PickColorIndices(const unsigned char block[64], const float palette[4][3])
+	{
+		uint32_t indices = 0;
+		for (int i = 0; i < 16; ++i)
+		{
+			int best = 0;
+			float bestDistance = 1e30f;
+			for (int p = 0; p < 4; ++p)
+			{
+				float dr = block[i * 4 + 0] - palette[p][0];
+				float dg = block[i * 4 + 1] - palette[p][1];
+				float db = block[i * 4 + 2] - palette[p][2];
+				float distance = dr * dr + dg * dg + db * db;
+				if (distance < bestDistance)
+				{
+					bestDistance = distance;
+					best = p;
+				}
+			}
+			indices |= (uint32_t)best << (i * 2);
+		}
+		return indices;
+	}
+
+	void MakePalette(const float end0[3], const float end1[3], float palette[4][3])
+	{
+		for (int p = 0; p < 4; ++p)
+		{
+			for (int c = 0; c < 3; ++c)
+				palette[p][c] = end0[c] * PALETTE_WEIGHTS[p] + end1[c] * (1.0f - PALETTE_WEIGHTS[p]);
+		}
+	}
+
+	///////////////////////////////////////////////////
+	//	EncodeColorBlock(...)
+	//
+	//	The endpoints start at the extremes of the pixels
+	//	along their principal axis, are refitted once by
+	//	least squares to the indices they produce, and are
+	//	then rounded to 565. The block is always written
+	//	in four-color mode (endpoint 0 > endpoint 1).
+	///////////////////////////////////////////////////
+	void EncodeColorBlock(const unsigned char block[64], unsigned char* out)
+	{
+		float mean[3] = { 0.0f, 0.0f, 0.0f };
+		for (int i = 0; i < 16; ++i)
+		{
+			for (int c = 0; c < 3; ++c)
+				mean[c] += block[i * 4 + c] / 16.0f;
+		}
+
+		float covariance[6] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };	// rr rg rb gg gb bb
+		for (int i = 0; i < 16; ++i)
+		{
+			float r = block[i * 4 + 0] - mean[0];
+			float g = block[i * 4 + 1] - mean[1];
+			float b = block[i * 4 + 2] - mean[2];
+			covariance[0] += r * r;
+			covariance[1] += r * g;
+			covariance[2] += r * b;
+			covariance[3] += g * g;
+			covariance[4] += g * b;
+			covariance[5] += b * b;
+		}
+
+		// power iteration for the axis of largest spread
+		float axis[3] = { 1.0f, 1.0f, 1.0f };
+		for (int iteration = 0; iteration < 8; ++iteration)
+		{
+			float next[3] =
+			{
+				covariance[0] * axis[0] + covariance[1] * axis[1] + covariance[2] * axis[2],
+				covariance[1] * axis[0] + covariance[3] * axis[1] + covariance[4] * axis[2],
+				covariance[2] * axis[0] + covariance[4] * axis[1] + covariance[5] * axis[2],
+			};
+			float length = std::max(std::max(std::fabs(next[0]), std::fabs(next[1])), std::fabs(next[2]));
+			if (length < 1e-6f)
+				break;
+			for (int c = 0; c < 3; ++c)
+				axis[c] = next[c] / length;
+		}
+
+		float minT = 1e30f;
+		float maxT = -1e30f;
+		for (int i = 0; i < 16; ++i)
+		{
+			float t = 0.0f;
+			for (int c = 0; c < 3; ++c)
+				t += (block[i * 4 + c] - mean[c]) * axis[c];
+			minT = std::min(minT, t);
+			maxT = std::max(maxT, t);
+		}
+
+		float axisLength2 = axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2];
+		float end0[3];
+		float end1[3];
+		for (int c = 0; c < 3; ++c)
+		{
+			end0[c] = mean[c] + axis[c] * maxT / std::max(axisLength2, 1e-6f);
+			end1[c] = mean[c] + axis[c] * minT / std::max(axisLength2, 1e-6f);
+		}
+
+		// least squares refit: each pixel is w * end0 + (1 - w) * end1
+		float palette[4][3];
+		MakePalette(end0, end1, palette);
+		uint32_t indices = PickColorIndices(block, palette);
+		float aa = 0.0f, ab = 0.0f, bb = 0.0f;
+		float ax[3] = { 0.0f, 0.0f, 0.0f };
+		float bx[3] = { 0.0f, 0.0f, 0.0f };
+		for (int i = 0; i < 16; ++i)
+		{
+			float w = PALETTE_WEIGHTS[(indices >> (i * 2)) & 3];
+			aa += w * w;
+			ab += w * (1.0f - w);
+			bb += (1.0f - w) * (1.0f - w);
+			for (int c = 0; c < 3; ++c)
+			{
+				ax[c] += w * block[i * 4 + c];
+				bx[c] += (1.0f - w) * block[i * 4 + c];
+			}
+		}
+		float determinant = aa * bb - ab * ab;
+		if (std::fabs(determinant) > 1e-3f)
+		{
+			for (int c = 0; c < 3; ++c)
+			{
+				end0[c] = (ax[c] * bb - bx[c] * ab) / determinant;
+				end1[c] = (bx[c] * aa - ax[c] * ab) / determinant;
+			}
+		}
+
+		uint16_t color0 = To565(end0);
+		uint16_t color1 = To565(end1);
+		if (color0 < color1)
+			std::swap(color0, color1);
+
+		// indices against the palette the decoder will actually see
+		indices = 0;
+		if (color0 != color1)
+		{
+			int quantized0[3];
+			int quantized1[3];
+			From565(color0, quantized0);
+			From565(color1, quantized1);
+			for (int c = 0; c < 3; ++c)
+			{
+				end0[c] = (float)quantized0[c];
+				end1[c] = (float)quantized1[c];
+			}
+			MakePalette(end0, end1, palette);
+			indices = PickColorIndices(block, palette);
+		}
+
+		out[0] = (unsigned char)(color0 & 0xFF);
+		out[1] = (unsigned char)(color0 >> 8);
+		out[2] = (unsigned char)(color1 & 0xFF);
+		out[3] = (unsigned char)(color1 >> 8);
+		for (int b = 0; b < 4; ++b)
+			out[4 + b] = (unsigned char)(indices >> (b * 8));
+	}
+
+	// Alpha endpoints are the block's extremes; the six values between them are
+	// interpolated by the decoder
+	void EncodeAlphaBlock(const unsigned char block[64], unsigned char* out)
+	{
+		int alpha0 = 0;
+		int alpha1 = 255;
+		for (int i = 0; i < 16; ++i)
+		{
+			alpha0 = std::max(alpha0, (int)block[i * 4 + 3]);
+			alpha1 = std::min(alpha1, (int)block[i * 4 + 3]);
+		}
+
+		uint64_t indices = 0;
+		if (alpha0 != alpha1)
+		{
+			int palette[8] = { alpha0, alpha1 };
+			for (int p = 1; p < 7; ++p)
+				palette[p + 1] = ((7 - p) * alpha0 + p * alpha1 + 3) / 7;
+
+			for (int i = 0; i < 16; ++i)
+			{
+				int best = 0;
+				for (int p = 1; p < 8; ++p)
+				{
+					if (std::abs(palette[p] - block[i * 4 + 3]) < std::abs(palette[best] - block[i * 4 + 3]))
+						best = p;
+				}
+				indices |= (uint64_t)best << (i * 3);
+			}
+		}
+
+		out[0] = (unsigned char)alpha0;
+		out[1] = (unsigned char)alpha1;
+		for (int b = 0; b < 6; ++b)
+			out[2 + b] = (unsigned char)(indices >> (b * 8));
+	}
+
+	// BC3 reads its color half in four-color mode whatever the endpoint order
+	void DecodeColorBlock(const unsigned char* in, bool alwaysFourColors, unsigned char block[64])
+	{
+		uint16_t color0 = (uint16_t)(in[0] | (in[1] << 8));
+		uint16_t color1 = (uint16_t)(in[2] | (in[3] << 8));
+		uint32_t indices = in[4] | (in[5] << 8) | (in[6] << 16) | ((uint32_t)in[7] << 24);
+
+		bool fourColors = alwaysFourColors || color0 > color1;
+		int palette[4][4];
+		From565(color0, palette[0]);
+		From565(color1, palette[1]);
+		palette[0][3] = palette[1][3] = palette[2][3] = palette[3][3] = 255;
+		for (int c = 0; c < 3; ++c)
+		{
+			if (fourColors)
+			{
+				palette[2][c] = (2 * palette[0][c] + palette[1][c] + 1) / 3;
+				palette[3][c] = (palette[0][c] + 2 * palette[1][c] + 1) / 3;
+			}
+			else
+			{
+				// three-color mode: the last entry is transparent black
+				palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+				palette[3][c] = 0;
+			}
+		}
+		if (!fourColors)
+			palette[3][3] = 0;
+
+		for (int i = 0; i < 16; ++i)
+		{
+			const int* color = palette[(indices >> (i * 2)) & 3];
+			for (int c = 0; c < 4; ++c)
+				block[i * 4 + c] = (unsigned char)color[c];
+		}
+	}
+
+	void DecodeAlphaBlock(const unsigned char* in, unsigned char block[64])
+	{
+		int palette[8] = { in[0], in[1] };
+		if (palette[0] > palette[1])
+		{
+			for (int p = 1; p < 7; ++p)
+				palette[p + 1] = ((7 - p) * palette[0] + p * palette[1] + 3) / 7;
+		}
+		else
+		{
+			for (int p = 1; p < 5; ++p)
+				palette[p + 1] = ((5 - p) * palette[0] + p * palette[1] + 2) / 5;
+			palette[6] = 0;
+			palette[7] = 255;
+		}
+
+		uint64_t indices = 0;
+		for (int b = 0; b < 6; ++b)
+			indices |= (uint64_t)in[2 + b] << (b * 8);
+		for (int i = 0; i < 16; ++i)
+			block[i * 4 + 3] = (unsigned char)palette[(indices >> (i * 3)) & 7];
+	}
+}
+
+size_t BlockCompressedBytes(int width, int height, int blockBytes)
+{
+	return (size_t)((width + 3) / 4) * ((height + 3) / 4) * blockBytes;
+}
+
+void CompressBC1(const unsigned char* rgba, int width, int height, unsigned char* blocks)
+{
+	unsigned char block[64];
+	for (int by = 0; by < (height + 3) / 4; ++by)
+	{
+		for (int bx = 0; bx < (width + 3) / 4; ++bx)
+		{
+			LoadBlock(rgba, width, height, bx, by, block);
+			EncodeColorBlock(block, blocks);
+			blocks += BC1_BLOCK_BYTES;
+		}
+	}
+}
+
+void CompressBC3(const unsigned char* rgba, int width, int height, unsigned char* blocks)
+{
+	unsigned char block[64];
+	for (int by = 0; by < (height + 3) / 4; ++by)
+	{
+		for (int bx = 0; bx < (width + 3) / 4; ++bx)
+		{
+			LoadBlock(rgba, width, height, bx, by, block);
+			EncodeAlphaBlock(block, blocks);
+			EncodeColorBlock(block, blocks + 8);
+			blocks += BC3_BLOCK_BYTES;
+		}
+	}
+}
+
+void DecompressBC1(const unsigned char* blocks, int width, int height, unsigned char* rgba)
+{
+	unsigned char block[64];
+	for (int by = 0; by < (height + 3) / 4; ++by)
+	{
+		for (int bx = 0; bx < (width + 3) / 4; ++bx)
+		{
+			DecodeColorBlock(blocks, false, block);
+			StoreBlock(block, width, height, bx, by, rgba);
+			blocks += BC1_BLOCK_BYTES;
+		}
+	}
+}
+
+void DecompressBC3(const unsigned char* blocks, int width, int height, unsigned char* rgba)
+{
+	unsigned char block[64];
+	for (int by = 0; by < (height + 3) / 4; ++by)
+	{
+		for (int bx = 0; bx < (width + 3) / 4; ++bx)
+		{
+			DecodeColorBlock(blocks + 8, true, block);
+			DecodeAlphaBlock(blocks, block);
+			StoreBlock(block, width, height, bx, by, rgba);
+			blocks += BC3_BLOCK_BYTES;
+		}
+	}
+}
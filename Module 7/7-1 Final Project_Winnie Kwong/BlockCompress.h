@@ -0,0 +1,28 @@
+///////////////////////////////////////////////////////////////////////////////
+// blockcompress.h
+// ========
+// BC1 (DXT1) and BC3 (DXT5) block compression of RGBA images on the CPU, and
+// the matching decoders for measuring the round-trip error
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+
+// Bytes per 4x4 block
+const int BC1_BLOCK_BYTES = 8;
+const int BC3_BLOCK_BYTES = 16;
+
+// Bytes of a width x height image in blocks of blockBytes; partial blocks at
+// the right and bottom edges count as whole blocks
+size_t BlockCompressedBytes(int width, int height, int blockBytes);
+
+// Compress an RGBA image into BlockCompressedBytes bytes of blocks, row by row.
+// BC1 keeps only color (every pixel opaque); BC3 adds an 8-bit alpha block.
+// Edge blocks repeat the last row and column.
+void CompressBC1(const unsigned char* rgba, int width, int height, unsigned char* blocks);
+void CompressBC3(const unsigned char* rgba, int width, int height, unsigned char* blocks);
+
+// Expand blocks back into an RGBA image of width x height
+void DecompressBC1(const unsigned char* blocks, int width, int height, unsigned char* rgba);
+void DecompressBC3(const unsigned char* blocks, int width, int height, unsigned char* rgba);
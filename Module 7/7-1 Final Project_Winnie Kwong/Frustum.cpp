@@ -0,0 +1,117 @@
+///////////////////////////////////////////////////////////////////////////////
+// frustum.cpp
+// ========
+// view frustum extraction and bounding sphere culling
+///////////////////////////////////////////////////////////////////////////////
+
+#include "Frustum.h"
+
+/*Build-time switch: test four spheres per SSE instruction (1) or one
+ *sphere at a time (0). Defaults to SSE wherever the compiler targets it*/
+#ifndef USE_SIMD_CULLING
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define USE_SIMD_CULLING 1
+#else
+#define USE_SIMD_CULLING 0
+#endif
+#endif
+
+#if USE_SIMD_CULLING
+#include <xmmintrin.h>
+#endif
+
+void BoundingSpheres::Resize(size_t count)
+{
+	x.resize(count);
+	y.resize(count);
+	z.resize(count);
+	radius.resize(count);
+}
+
+void BoundingSpheres::Set(size_t index, const glm::vec3& center, float sphereRadius)
+{
+	x[index] = center.x;
+	y[index] = center.y;
+	z[index] = center.z;
+	radius[index] = sphereRadius;
+}
+
+///////////////////////////////////////////////////
+//	ExtractFrustum(const glm::mat4&)
+//
+//	viewProjection: projection * view
+//
+//	Each clip-space bound -w <= x, y, z <= w is a plane
+//	made of the fourth row plus or minus another row of
+//	the matrix. The planes are normalized so the sphere
+//	test can compare distances against radii directly.
+///////////////////////////////////////////////////
+Frustum ExtractFrustum(const glm::mat4& viewProjection)
+{
+	// glm is column-major: row r is (m[0][r], m[1][r], m[2][r], m[3][r])
+	glm::vec4 rows[4];
+	for (int r = 0; r < 4; ++r)
+		rows[r] = glm::vec4(viewProjection[0][r], viewProjection[1][r], viewProjection[2][r], viewProjection[3][r]);
+
+	Frustum frustum;
+	frustum.planes[0] = rows[3] + rows[0];	// left
+	frustum.planes[1] = rows[3] - rows[0];	// right
+	frustum.planes[2] = rows[3] + rows[1];	// bottom
+	frustum.planes[3] = rows[3] - rows[1];	// top
+	frustum.planes[4] = rows[3] + rows[2];	// near
+	frustum.planes[5] = rows[3] - rows[2];	// far
+
+	for (glm::vec4& plane : frustum.planes)
+		plane /= glm::length(glm::vec3(plane));
+
+	return frustum;
+}
+
+GLuint CullSpheres(const Frustum& frustum, const BoundingSpheres& spheres, unsigned char* visible)
+{
+	const size_t count = spheres.Count();
+	GLuint nVisible = 0;
+	size_t i = 0;
+
+#if USE_SIMD_CULLING
+	// a sphere is outside once it lies entirely behind any one plane
+	for (; i + 4 <= count; i += 4)
+	{
+		__m128 x = _mm_loadu_ps(&spheres.x[i]);
+		__m128 y = _mm_loadu_ps(&spheres.y[i]);
+		__m128 z = _mm_loadu_ps(&spheres.z[i]);
+		__m128 negRadius = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(&spheres.radius[i]));
+		__m128 outside = _mm_setzero_ps();
+
+		for (const glm::vec4& plane : frustum.planes)
+		{
+			__m128 distance = _mm_add_ps(
+				_mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(plane.x)), _mm_mul_ps(y, _mm_set1_ps(plane.y))),
+				_mm_add_ps(_mm_mul_ps(z, _mm_set1_ps(plane.z)), _mm_set1_ps(plane.w)));
+			outside = _mm_or_ps(outside, _mm_cmplt_ps(distance, negRadius));
+		}
+
+		int mask = _mm_movemask_ps(outside);
+		for (int lane = 0; lane < 4; ++lane)
+		{
+			visible[i + lane] = ((mask >> lane) & 1) == 0;
+			nVisible += visible[i + lane];
+		}
+	}
+#endif
+
+	// whatever is left over (or everything, without SSE) one sphere at a time
+	for (; i < count; ++i)
+	{
+		bool inside = true;
+		for (const glm::vec4& plane : frustum.planes)
+		{
+			float distance = plane.x * spheres.x[i] + plane.y * spheres.y[i] + plane.z * spheres.z[i] + plane.w;
+			inside = inside && distance >= -spheres.radius[i];
+		}
+		visible[i] = inside;
+		nVisible += visible[i];
+	}
+
+	return nVisible;
+}
@@ -0,0 +1,43 @@
+///////////////////////////////////////////////////////////////////////////////
+// frustum.h
+// ========
+// view frustum planes and a bounding sphere visibility test that checks
+// four spheres at a time with SSE
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+// Six planes (left, right, bottom, top, near, far) as (normal, distance)
+// with normals pointing into the frustum, so inside points have
+// dot(normal, p) + distance >= 0
+struct Frustum
+{
+	glm::vec4 planes[6];
+};
+
+// World-space bounding spheres, one array per component so that four
+// consecutive spheres load into one SSE register each
+struct BoundingSpheres
+{
+	std::vector<float> x;
+	std::vector<float> y;
+	std::vector<float> z;
+	std::vector<float> radius;
+
+	void Resize(size_t count);
+	void Set(size_t index, const glm::vec3& center, float sphereRadius);
+	size_t Count() const { return radius.size(); }
+};
+
+// Extract the frustum of a projection * view matrix (perspective or ortho)
+Frustum ExtractFrustum(const glm::mat4& viewProjection);
+
+// Set visible[i] to 1 for every sphere that touches the frustum and to 0 for
+// the rest. Returns the number of visible spheres.
+GLuint CullSpheres(const Frustum& frustum, const BoundingSpheres& spheres, unsigned char* visible);
@@ -0,0 +1,187 @@
+///////////////////////////////////////////////////////////////////////////////
+// glstate.cpp
+// ========
+// redundant GL state filter
+///////////////////////////////////////////////////////////////////////////////
+
+#include "GLState.h"
+
+#include <cstring>
+
+GLStateCache gGLState;
+
+void GLStateCache::UseProgram(GLuint newProgram)
+{
+	if (newProgram == program)
+	{
+		++skipped;
+		return;
+	}
+
+	glUseProgram(newProgram);
+	program = newProgram;
+
+	// uniform values belong to the program, so switch to its set
+	currentUniforms = nullptr;
+	for (ProgramUniforms& entry : uniforms)
+	{
+		if (entry.program == newProgram)
+			currentUniforms = &entry;
+	}
+	if (currentUniforms == nullptr)
+	{
+		uniforms.push_back({ newProgram, {} });
+		currentUniforms = &uniforms.back();
+	}
+}
+
+void GLStateCache::BindVertexArray(GLuint newVao)
+{
+	if (newVao == vao)
+	{
+		++skipped;
+		return;
+	}
+
+	glBindVertexArray(newVao);
+	vao = newVao;
+}
+
+void GLStateCache::ActiveTexture(GLuint unit)
+{
+	if (unit == activeUnit)
+	{
+		++skipped;
+		return;
+	}
+
+	glActiveTexture(GL_TEXTURE0 + unit);
+	activeUnit = unit;
+}
+
+void GLStateCache::BindTexture(GLenum target, GLuint texture)
+{
+	// an unknown unit cannot be tracked; bind without remembering
+	if (activeUnit >= MAX_TEXTURE_UNITS)
+	{
+		glBindTexture(target, texture);
+		return;
+	}
+
+	TextureBinding& binding = textures[activeUnit];
+	if (binding.target == target && binding.texture == texture)
+	{
+		++skipped;
+		return;
+	}
+
+	glBindTexture(target, texture);
+	binding.target = target;
+	binding.texture = texture;
+}
+
+void GLStateCache::BindTexture(GLuint unit, GLenum target, GLuint texture)
+{
+	if (unit < MAX_TEXTURE_UNITS && textures[unit].target == target && textures[unit].texture == texture)
+	{
+		++skipped;
+		return;
+	}
+
+	ActiveTexture(unit);
+	BindTexture(target, texture);
+}
+
+///////////////////////////////////////////////////
+//	UniformChanged(GLint, const void*, size_t)
+//
+//	location: uniform location in the current program
+//	value, size: the bytes about to be uploaded
+//
+//	Compare against the bytes last uploaded to the
+//	location. Locations of -1 are ignored by GL, so
+//	they never need an upload.
+///////////////////////////////////////////////////
+bool GLStateCache::UniformChanged(GLint location, const void* value, size_t size)
+{
+	if (location < 0)
+	{
+		++skipped;
+		return false;
+	}
+
+	if (currentUniforms == nullptr || size > sizeof(UniformValue::data))
+		return true;
+
+	std::vector<UniformValue>& values = currentUniforms->values;
+	if ((size_t)location >= values.size())
+		values.resize(location + 1, UniformValue{ 0, {} });
+
+	UniformValue& cached = values[location];
+	if (cached.size == size && memcmp(cached.data, value, size) == 0)
+	{
+		++skipped;
+		return false;
+	}
+
+	cached.size = size;
+	memcpy(cached.data, value, size);
+	return true;
+}
+
+void GLStateCache::DeleteProgram(GLuint deleted)
+{
+	glDeleteProgram(deleted);
+
+	// a name can be reused by the next program, which starts with fresh uniforms
+	for (size_t i = 0; i < uniforms.size(); ++i)
+	{
+		if (uniforms[i].program == deleted)
+		{
+			uniforms.erase(uniforms.begin() + i);
+			break;
+		}
+	}
+	currentUniforms = nullptr;
+	for (ProgramUniforms& entry : uniforms)
+	{
+		if (entry.program == program)
+			currentUniforms = &entry;
+	}
+
+	// the current program stays in use until another one is installed
+	if (program == deleted)
+		program = UNKNOWN;
+}
+
+void GLStateCache::DeleteVertexArray(GLuint deleted)
+{
+	glDeleteVertexArrays(1, &deleted);
+
+	// deleting the bound vertex array reverts to vertex array 0
+	if (vao == deleted)
+		vao = 0;
+}
+
+void GLStateCache::DeleteTexture(GLuint deleted)
+{
+	glDeleteTextures(1, &deleted);
+
+	// deleting a bound texture reverts those units to texture 0
+	for (TextureBinding& binding : textures)
+	{
+		if (binding.texture == deleted)
+			binding.texture = 0;
+	}
+}
+
+void GLStateCache::Invalidate()
+{
+	program = UNKNOWN;
+	vao = UNKNOWN;
+	activeUnit = UNKNOWN;
+	for (TextureBinding& binding : textures)
+		binding = { GL_NONE, UNKNOWN };
+	uniforms.clear();
+	currentUniforms = nullptr;
+}
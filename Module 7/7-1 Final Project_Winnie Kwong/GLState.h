@@ -0,0 +1,79 @@
+///////////////////////////////////////////////////////////////////////////////
+// glstate.h
+// ========
+// thin cache of the GL state the renderer changes most often: the current
+// program, vertex array, texture bindings and uniform values. Calls that
+// would not change anything are dropped and counted.
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+
+#include <cstddef>
+#include <vector>
+
+class GLStateCache
+{
+public:
+	static const GLuint MAX_TEXTURE_UNITS = 32;
+
+	GLStateCache() { Invalidate(); }
+
+	void UseProgram(GLuint program);
+	void BindVertexArray(GLuint vao);
+
+	// unit is an index (0 for GL_TEXTURE0)
+	void ActiveTexture(GLuint unit);
+	void BindTexture(GLenum target, GLuint texture);	// on the active unit
+	void BindTexture(GLuint unit, GLenum target, GLuint texture);
+
+	// True if value differs from what location of the current program last
+	// received, in which case it is remembered and the caller must upload it.
+	// False counts as a skipped call.
+	bool UniformChanged(GLint location, const void* value, size_t size);
+
+	// Delete through the cache so that it forgets the deleted names
+	void DeleteProgram(GLuint program);
+	void DeleteVertexArray(GLuint vao);
+	void DeleteTexture(GLuint texture);
+
+	// Forget all tracked state, e.g. after code that changed it directly
+	void Invalidate();
+
+	GLuint SkippedCalls() const { return skipped; }
+	void ResetCounters() { skipped = 0; }
+
+private:
+	static const GLuint UNKNOWN = ~0u;
+
+	struct TextureBinding
+	{
+		GLenum target;
+		GLuint texture;
+	};
+
+	// Last value uploaded to each location of one program; size 0 is unknown
+	struct UniformValue
+	{
+		size_t size;
+		GLfloat data[16];
+	};
+
+	struct ProgramUniforms
+	{
+		GLuint program;
+		std::vector<UniformValue> values;
+	};
+
+	GLuint program;
+	GLuint vao;
+	GLuint activeUnit;
+	TextureBinding textures[MAX_TEXTURE_UNITS];
+	std::vector<ProgramUniforms> uniforms;
+	ProgramUniforms* currentUniforms = nullptr;
+	GLuint skipped = 0;
+};
+
+// The renderer's single GL context
+extern GLStateCache gGLState;
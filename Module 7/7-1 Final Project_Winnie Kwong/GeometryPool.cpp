@@ -0,0 +1,87 @@
+///////////////////////////////////////////////////////////////////////////////
+// geometrypool.cpp
+// ========
+// one vertex buffer and one index buffer behind a single VAO for many meshes
+///////////////////////////////////////////////////////////////////////////////
+
+#include "GeometryPool.h"
+#include "GLState.h"
+#include "GpuResources.h"
+
+#include <cstring>
+#include <iostream>
+
+GLint GeometryPool::AddVertices(const void* data, GLuint count, GLuint size)
+{
+	if (vertexSize == 0)
+		vertexSize = size;
+	if (size != vertexSize)
+	{
+		std::cout << "WARNING: geometry pool refused vertices of " << size << " bytes, it holds " << vertexSize << "-byte vertices" << std::endl;
+		return -1;
+	}
+
+	GLint first = (GLint)(vertices.size() / vertexSize);
+	vertices.resize(vertices.size() + (size_t)count * vertexSize);
+	memcpy(vertices.data() + (size_t)first * vertexSize, data, (size_t)count * vertexSize);
+	return first;
+}
+
+size_t GeometryPool::AddIndices(const void* data, GLuint count, GLuint indexSize)
+{
+	// 32-bit indices must start on a multiple of 4 bytes after 16-bit ones
+	size_t offset = (indices.size() + indexSize - 1) / indexSize * indexSize;
+	indices.resize(offset + (size_t)count * indexSize);
+	memcpy(indices.data() + offset, data, (size_t)count * indexSize);
+	return offset;
+}
+
+bool GeometryPool::Upload(const char* label)
+{
+	if (vertices.empty())
+	{
+		std::cout << "Geometry pool has no vertices to upload" << std::endl;
+		return false;
+	}
+
+	glGenVertexArrays(1, &vao);
+	gGpuResources.Created(GpuResourceType::VertexArray, vao, label);
+	gGLState.BindVertexArray(vao);
+
+	glGenBuffers(1, &vertexBuffer);
+	gGpuResources.Created(GpuResourceType::Buffer, vertexBuffer, label);
+	glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+	glBufferData(GL_ARRAY_BUFFER, vertices.size(), vertices.data(), GL_STATIC_DRAW);
+	gGpuResources.SetBytes(GpuResourceType::Buffer, vertexBuffer, vertices.size());
+
+	if (!indices.empty())
+	{
+		glGenBuffers(1, &indexBuffer);
+		gGpuResources.Created(GpuResourceType::Buffer, indexBuffer, label);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size(), indices.data(), GL_STATIC_DRAW);
+		gGpuResources.SetBytes(GpuResourceType::Buffer, indexBuffer, indices.size());
+	}
+
+	std::cout << "INFO: Geometry pool " << label << ": " << vertices.size() / vertexSize << " vertices ("
+		<< vertices.size() / 1024 << " KB), " << indices.size() / 1024 << " KB of indices" << std::endl;
+
+	// the GL has its own copy now
+	std::vector<unsigned char>().swap(vertices);
+	std::vector<unsigned char>().swap(indices);
+	return true;
+}
+
+void GeometryPool::Destroy()
+{
+	const GLuint buffers[] = { vertexBuffer, indexBuffer };
+	gGpuResources.Deleted(GpuResourceType::VertexArray, vao);
+	gGpuResources.Deleted(GpuResourceType::Buffer, 2, buffers);
+	gGLState.DeleteVertexArray(vao);
+	glDeleteBuffers(2, buffers);
+	vao = vertexBuffer = indexBuffer = 0;
+
+	vertices.clear();
+	indices.clear();
+	vertexSize = 0;
+}
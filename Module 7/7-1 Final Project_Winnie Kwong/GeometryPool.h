@@ -0,0 +1,48 @@
+///////////////////////////////////////////////////////////////////////////////
+// geometrypool.h
+// ========
+// one vertex buffer and one index buffer behind a single VAO for many meshes:
+// each mesh gets a range of both, and draws reach its vertices through a
+// base vertex, so switching meshes never switches VAOs
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+
+#include <cstddef>
+#include <vector>
+
+class GeometryPool
+{
+public:
+	// Append count vertices of size bytes. Returns the index of the
+	// first, the base vertex the mesh's draws use. Every mesh of a pool must
+	// use the same vertex layout.
+	GLint AddVertices(const void* data, GLuint count, GLuint size);
+
+	// Append count indices of indexSize bytes, 2 or 4. Returns the byte
+	// offset of the first in the index buffer.
+	size_t AddIndices(const void* data, GLuint count, GLuint indexSize);
+
+	// Create the VAO and upload everything added so far into one buffer of
+	// each kind. The VAO is left bound with both buffers, so the caller can
+	// describe the vertex layout.
+	bool Upload(const char* label);
+
+	void Destroy();
+
+	GLuint Vao() const { return vao; }
+	GLuint VertexBuffer() const { return vertexBuffer; }
+	GLuint IndexBuffer() const { return indexBuffer; }
+
+private:
+	// staged on the CPU until Upload, then released
+	std::vector<unsigned char> vertices;
+	std::vector<unsigned char> indices;
+	GLuint vertexSize = 0;
+
+	GLuint vao = 0;
+	GLuint vertexBuffer = 0;
+	GLuint indexBuffer = 0;
+};
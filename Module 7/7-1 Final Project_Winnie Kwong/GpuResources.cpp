@@ -0,0 +1,123 @@
+///////////////////////////////////////////////////////////////////////////////
+// gpuresources.cpp
+// ========
+// GL object registry and memory accounting
+///////////////////////////////////////////////////////////////////////////////
+
+#include "GpuResources.h"
+#include "TextureContainer.h"
+
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+GpuResourceTracker gGpuResources;
+
+namespace
+{
+	const char* const TYPE_NAMES[GPU_RESOURCE_TYPE_COUNT] = { "texture", "buffer", "vertex array", "program" };
+
+	// only textures and buffers own memory worth counting
+	bool HasBytes(GpuResourceType type)
+	{
+		return type == GpuResourceType::Texture || type == GpuResourceType::Buffer;
+	}
+
+	std::string Megabytes(size_t bytes)
+	{
+		std::ostringstream text;
+		text << std::fixed << std::setprecision(2) << bytes / (1024.0 * 1024.0) << " MB";
+		return text.str();
+	}
+}
+
+size_t GpuTextureBytes(GLenum internalFormat, int width, int height, int depth, int levels)
+{
+	GLenum format = internalFormat == GL_COMPRESSED_RGB_S3TC_DXT1_EXT || internalFormat == GL_COMPRESSED_RGBA_S3TC_DXT5_EXT ?
+		internalFormat : GL_RGBA8;
+	size_t bytes = 0;
+	for (int level = 0; level < levels; ++level)
+		bytes += TextureLevelBytes(format, width, height, level);
+	return bytes * depth;
+}
+
+void GpuResourceTracker::Created(GpuResourceType type, GLsizei count, const GLuint* names, const char* label)
+{
+	std::map<GLuint, Resource>& resources = live[(int)type];
+	for (GLsizei i = 0; i < count; ++i)
+	{
+		if (names[i] == 0)
+			continue;
+		auto resource = resources.find(names[i]);
+		if (resource != resources.end())
+		{
+			std::cout << "WARNING: " << TYPE_NAMES[(int)type] << " " << names[i] << " (" << label
+				<< ") created while already alive as " << resource->second.label << std::endl;
+			// the old storage is gone with the old object, so stop counting it
+			liveBytes[(int)type] -= resource->second.bytes;
+		}
+		resources[names[i]] = { label, 0 };
+	}
+}
+
+void GpuResourceTracker::SetBytes(GpuResourceType type, GLuint name, size_t bytes)
+{
+	auto resource = live[(int)type].find(name);
+	if (resource == live[(int)type].end() || !HasBytes(type))
+		return;
+
+	liveBytes[(int)type] += bytes - resource->second.bytes;
+	resource->second.bytes = bytes;
+
+	size_t total = liveBytes[(int)GpuResourceType::Texture] + liveBytes[(int)GpuResourceType::Buffer];
+	if (total > peakBytes)
+		peakBytes = total;
+}
+
+void GpuResourceTracker::Deleted(GpuResourceType type, GLsizei count, const GLuint* names)
+{
+	std::map<GLuint, Resource>& resources = live[(int)type];
+	for (GLsizei i = 0; i < count; ++i)
+	{
+		if (names[i] == 0)
+			continue;
+		auto resource = resources.find(names[i]);
+		if (resource == resources.end())
+		{
+			std::cout << "WARNING: deleting " << TYPE_NAMES[(int)type] << " " << names[i]
+				<< ", which was never created or is already deleted" << std::endl;
+			continue;
+		}
+		liveBytes[(int)type] -= resource->second.bytes;
+		resources.erase(resource);
+	}
+}
+
+std::string GpuResourceTracker::Summary() const
+{
+	std::ostringstream text;
+	text << LiveCount(GpuResourceType::Texture) << " textures (" << Megabytes(LiveBytes(GpuResourceType::Texture)) << "), "
+		<< LiveCount(GpuResourceType::Buffer) << " buffers (" << Megabytes(LiveBytes(GpuResourceType::Buffer)) << "), "
+		<< LiveCount(GpuResourceType::VertexArray) << " vertex arrays, "
+		<< LiveCount(GpuResourceType::Program) << " programs; peak " << Megabytes(peakBytes);
+	return text.str();
+}
+
+size_t GpuResourceTracker::ReportLeaks() const
+{
+	size_t leaks = 0;
+	for (int type = 0; type < GPU_RESOURCE_TYPE_COUNT; ++type)
+	{
+		for (const auto& resource : live[type])
+		{
+			std::cout << "LEAK: " << TYPE_NAMES[type] << " " << resource.first << " (" << resource.second.label << ")";
+			if (HasBytes((GpuResourceType)type))
+				std::cout << ", " << resource.second.bytes << " bytes";
+			std::cout << std::endl;
+			++leaks;
+		}
+	}
+	if (leaks == 0)
+		std::cout << "INFO: GPU resources: none left alive" << std::endl;
+	return leaks;
+}
@@ -0,0 +1,74 @@
+///////////////////////////////////////////////////////////////////////////////
+// gpuresources.h
+// ========
+// registry of the GL objects the program creates: every texture, buffer,
+// vertex array and program is recorded with a label and, for textures and
+// buffers, the bytes it was allocated, so the live totals can be reported
+// while running and anything not deleted is listed at exit
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+
+#include <cstddef>
+#include <map>
+#include <string>
+
+enum class GpuResourceType
+{
+	Texture,
+	Buffer,
+	VertexArray,
+	Program,
+};
+
+const int GPU_RESOURCE_TYPE_COUNT = 4;
+
+// Bytes of a texture's storage: levels mip levels of width x height, depth
+// layers deep. DXT1/DXT5 formats count their blocks, everything else
+// 4 bytes a texel (drivers pad RGB8 to that too).
+size_t GpuTextureBytes(GLenum internalFormat, int width, int height, int depth, int levels);
+
+class GpuResourceTracker
+{
+public:
+	// Record names just returned by glGen* or glCreateProgram; label says
+	// what they hold and is listed if they leak
+	void Created(GpuResourceType type, GLsizei count, const GLuint* names, const char* label);
+	void Created(GpuResourceType type, GLuint name, const char* label) { Created(type, 1, &name, label); }
+
+	// Record the bytes a texture or buffer holds after its storage was
+	// (re)allocated with glTexStorage*, glTexImage* or glBufferData
+	void SetBytes(GpuResourceType type, GLuint name, size_t bytes);
+
+	// Record names about to be deleted. Name 0 is skipped as GL skips it;
+	// names never created or already deleted are reported.
+	void Deleted(GpuResourceType type, GLsizei count, const GLuint* names);
+	void Deleted(GpuResourceType type, GLuint name) { Deleted(type, 1, &name); }
+
+	size_t LiveCount(GpuResourceType type) const { return live[(int)type].size(); }
+	size_t LiveBytes(GpuResourceType type) const { return liveBytes[(int)type]; }
+	size_t PeakBytes() const { return peakBytes; }
+
+	// One line of live counts and sizes per type
+	std::string Summary() const;
+
+	// Print every resource still alive with its label and size, e.g. at exit
+	// after everything should have been deleted. Returns how many there are.
+	size_t ReportLeaks() const;
+
+private:
+	struct Resource
+	{
+		std::string label;
+		size_t bytes;
+	};
+
+	std::map<GLuint, Resource> live[GPU_RESOURCE_TYPE_COUNT];
+	size_t liveBytes[GPU_RESOURCE_TYPE_COUNT] = {};
+	size_t peakBytes = 0;
+};
+
+// Every GL object of the renderer's context
+extern GpuResourceTracker gGpuResources;
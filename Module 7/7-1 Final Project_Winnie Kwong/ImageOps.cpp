@@ -0,0 +1,403 @@
+///////////////////////////////////////////////////////////////////////////////
+// imageops.cpp
+// ========
+// vectorized pixel kernels with scalar fallbacks
+///////////////////////////////////////////////////////////////////////////////
+
+#include "ImageOps.h"
+
+#include <algorithm>
+#include <cstring>
+
+/*Build-time switch: AVX2 kernels (2), SSSE3 kernels (1) or plain loops (0).
+ *Defaults to the widest set the compiler targets. MSVC only announces AVX2,
+ *so x64 builds without /arch:AVX2 assume SSSE3, which every x64 CPU this
+ *project runs on has*/
+#ifndef USE_SIMD_IMAGE_OPS
+#if defined(__AVX2__)
+#define USE_SIMD_IMAGE_OPS 2
+#elif defined(__SSSE3__) || defined(_M_X64)
+#define USE_SIMD_IMAGE_OPS 1
+#else
+#define USE_SIMD_IMAGE_OPS 0
+#endif
+#endif
+
+#if USE_SIMD_IMAGE_OPS >= 2
+#include <immintrin.h>
+#elif USE_SIMD_IMAGE_OPS >= 1
+#include <tmmintrin.h>
+#endif
+
+namespace
+{
+	// c * a / 255 rounded to nearest, exact for 8-bit inputs
+	inline unsigned char MulDiv255(unsigned c, unsigned a)
+	{
+		unsigned x = c * a + 128;
+		return (unsigned char)((x + (x >> 8)) >> 8);
+	}
+
+#if USE_SIMD_IMAGE_OPS
+	// Same as MulDiv255 on eight 16-bit lanes
+	inline __m128i MulDiv255(__m128i c, __m128i a)
+	{
+		__m128i x = _mm_add_epi16(_mm_mullo_epi16(c, a), _mm_set1_epi16(128));
+		return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+	}
+
+	// Broadcast each pixel's alpha over its four 16-bit lanes, with 255 in
+	// the alpha lane itself so that alpha comes out unchanged
+	inline __m128i AlphaFactors(__m128i pixels16)
+	{
+		__m128i alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(pixels16, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+		const __m128i colorLanes = _mm_setr_epi16(-1, -1, -1, 0, -1, -1, -1, 0);
+		const __m128i opaque = _mm_setr_epi16(0, 0, 0, 255, 0, 0, 0, 255);
+		return _mm_or_si128(_mm_and_si128(alpha, colorLanes), opaque);
+	}
+#endif
+
+#if USE_SIMD_IMAGE_OPS >= 2
+	inline __m256i MulDiv255(__m256i c, __m256i a)
+	{
+		__m256i x = _mm256_add_epi16(_mm256_mullo_epi16(c, a), _mm256_set1_epi16(128));
+		return _mm256_srli_epi16(_mm256_add_epi16(x, _mm256_srli_epi16(x, 8)), 8);
+	}
+
+	inline __m256i AlphaFactors(__m256i pixels16)
+	{
+		__m256i alpha = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(pixels16, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+		const __m256i colorLanes = _mm256_setr_epi16(-1, -1, -1, 0, -1, -1, -1, 0, -1, -1, -1, 0, -1, -1, -1, 0);
+		const __m256i opaque = _mm256_setr_epi16(0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0, 255);
+		return _mm256_or_si256(_mm256_and_si256(alpha, colorLanes), opaque);
+	}
+#endif
+}
+
+///////////////////////////////////////////////////
+//	FlipImageVertically(...)
+//
+//	Swap row j with row height - 1 - j, a vector
+//	register at a time; the bytes left over at the
+//	end of a row are swapped one by one
+///////////////////////////////////////////////////
+void FlipImageVertically(unsigned char* image, int width, int height, int channels)
+{
+	const size_t rowBytes = (size_t)width * channels;
+
+	for (int j = 0; j < height / 2; ++j)
+	{
+		unsigned char* top = image + j * rowBytes;
+		unsigned char* bottom = image + (height - 1 - j) * rowBytes;
+		size_t i = 0;
+
+#if USE_SIMD_IMAGE_OPS >= 2
+		for (; i + 32 <= rowBytes; i += 32)
+		{
+			__m256i a = _mm256_loadu_si256((const __m256i*)(top + i));
+			__m256i b = _mm256_loadu_si256((const __m256i*)(bottom + i));
+			_mm256_storeu_si256((__m256i*)(top + i), b);
+			_mm256_storeu_si256((__m256i*)(bottom + i), a);
+		}
+#endif
+#if USE_SIMD_IMAGE_OPS >= 1
+		for (; i + 16 <= rowBytes; i += 16)
+		{
+			__m128i a = _mm_loadu_si128((const __m128i*)(top + i));
+			__m128i b = _mm_loadu_si128((const __m128i*)(bottom + i));
+			_mm_storeu_si128((__m128i*)(top + i), b);
+			_mm_storeu_si128((__m128i*)(bottom + i), a);
+		}
+#endif
+
+		for (; i < rowBytes; ++i)
+			std::swap(top[i], bottom[i]);
+	}
+}
+
+///////////////////////////////////////////////////
+//	ExpandRgbToRgba(...)
+//
+//	One byte shuffle turns four RGB pixels (12 of
+//	the 16 bytes loaded) into four RGBA pixels with a
+//	zero alpha, which is then set to 255. The vector
+//	loops stop early enough that the 16-byte loads
+//	never read past the end of source.
+///////////////////////////////////////////////////
+void ExpandRgbToRgba(const unsigned char* source, unsigned char* target, size_t pixelCount)
+{
+	size_t i = 0;
+
+#if USE_SIMD_IMAGE_OPS >= 1
+	const __m128i expand = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+	const __m128i opaque = _mm_set1_epi32((int)0xFF000000);
+#endif
+
+#if USE_SIMD_IMAGE_OPS >= 2
+	// eight pixels: four into each 128-bit lane (the shuffle stays inside lanes)
+	const __m256i expand8 = _mm256_broadcastsi128_si256(expand);
+	const __m256i opaque8 = _mm256_set1_epi32((int)0xFF000000);
+	for (; i + 10 <= pixelCount; i += 8)
+	{
+		__m128i lo = _mm_loadu_si128((const __m128i*)(source + i * 3));
+		__m128i hi = _mm_loadu_si128((const __m128i*)(source + i * 3 + 12));
+		__m256i rgb = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+		__m256i rgba = _mm256_or_si256(_mm256_shuffle_epi8(rgb, expand8), opaque8);
+		_mm256_storeu_si256((__m256i*)(target + i * 4), rgba);
+	}
+#endif
+#if USE_SIMD_IMAGE_OPS >= 1
+	for (; i + 6 <= pixelCount; i += 4)
+	{
+		__m128i rgb = _mm_loadu_si128((const __m128i*)(source + i * 3));
+		__m128i rgba = _mm_or_si128(_mm_shuffle_epi8(rgb, expand), opaque);
+		_mm_storeu_si128((__m128i*)(target + i * 4), rgba);
+	}
+#endif
+
+	for (; i < pixelCount; ++i)
+	{
+		target[i * 4 + 0] = source[i * 3 + 0];
+		target[i * 4 + 1] = source[i * 3 + 1];
+		target[i * 4 + 2] = source[i * 3 + 2];
+		target[i * 4 + 3] = 255;
+	}
+}
+
+void SwizzleChannels(unsigned char* pixels, size_t pixelCount, const int order[4])
+{
+	size_t i = 0;
+
+#if USE_SIMD_IMAGE_OPS >= 1
+	// the same four-byte pattern for every pixel in the register
+	char pattern[16];
+	for (int p = 0; p < 16; ++p)
+		pattern[p] = (char)((p & ~3) + order[p & 3]);
+	const __m128i shuffle = _mm_loadu_si128((const __m128i*)pattern);
+#endif
+
+#if USE_SIMD_IMAGE_OPS >= 2
+	const __m256i shuffle8 = _mm256_broadcastsi128_si256(shuffle);
+	for (; i + 8 <= pixelCount; i += 8)
+	{
+		__m256i v = _mm256_loadu_si256((const __m256i*)(pixels + i * 4));
+		_mm256_storeu_si256((__m256i*)(pixels + i * 4), _mm256_shuffle_epi8(v, shuffle8));
+	}
+#endif
+#if USE_SIMD_IMAGE_OPS >= 1
+	for (; i + 4 <= pixelCount; i += 4)
+	{
+		__m128i v = _mm_loadu_si128((const __m128i*)(pixels + i * 4));
+		_mm_storeu_si128((__m128i*)(pixels + i * 4), _mm_shuffle_epi8(v, shuffle));
+	}
+#endif
+
+	for (; i < pixelCount; ++i)
+	{
+		unsigned char* pixel = pixels + i * 4;
+		unsigned char in[4] = { pixel[0], pixel[1], pixel[2], pixel[3] };
+		for (int c = 0; c < 4; ++c)
+			pixel[c] = in[order[c]];
+	}
+}
+
+///////////////////////////////////////////////////
+//	PremultiplyAlpha(...)
+//
+//	The bytes are widened to 16 bits, two pixels per
+//	half register, multiplied by their pixel's alpha
+//	and divided by 255, then packed back
+///////////////////////////////////////////////////
+void PremultiplyAlpha(unsigned char* pixels, size_t pixelCount)
+{
+	size_t i = 0;
+
+#if USE_SIMD_IMAGE_OPS >= 2
+	const __m256i zero8 = _mm256_setzero_si256();
+	for (; i + 8 <= pixelCount; i += 8)
+	{
+		__m256i v = _mm256_loadu_si256((const __m256i*)(pixels + i * 4));
+		__m256i lo = _mm256_unpacklo_epi8(v, zero8);
+		__m256i hi = _mm256_unpackhi_epi8(v, zero8);
+		lo = MulDiv255(lo, AlphaFactors(lo));
+		hi = MulDiv255(hi, AlphaFactors(hi));
+		_mm256_storeu_si256((__m256i*)(pixels + i * 4), _mm256_packus_epi16(lo, hi));
+	}
+#endif
+#if USE_SIMD_IMAGE_OPS >= 1
+	const __m128i zero = _mm_setzero_si128();
+	for (; i + 4 <= pixelCount; i += 4)
+	{
+		__m128i v = _mm_loadu_si128((const __m128i*)(pixels + i * 4));
+		__m128i lo = _mm_unpacklo_epi8(v, zero);
+		__m128i hi = _mm_unpackhi_epi8(v, zero);
+		lo = MulDiv255(lo, AlphaFactors(lo));
+		hi = MulDiv255(hi, AlphaFactors(hi));
+		_mm_storeu_si128((__m128i*)(pixels + i * 4), _mm_packus_epi16(lo, hi));
+	}
+#endif
+
+	for (; i < pixelCount; ++i)
+	{
+		unsigned char* pixel = pixels + i * 4;
+		pixel[0] = MulDiv255(pixel[0], pixel[3]);
+		pixel[1] = MulDiv255(pixel[1], pixel[3]);
+		pixel[2] = MulDiv255(pixel[2], pixel[3]);
+	}
+}
+
+///////////////////////////////////////////////////
+//	IsSolidColor(...)
+//
+//	Tracks the lowest and highest value of every
+//	channel; the vector paths keep four or eight
+//	pixels' worth of minima and maxima and fold them
+//	together at the end
+///////////////////////////////////////////////////
+bool IsSolidColor(const unsigned char* pixels, size_t pixelCount, int tolerance, uint32_t& color)
+{
+	unsigned char low[4] = { 255, 255, 255, 255 };
+	unsigned char high[4] = { 0, 0, 0, 0 };
+	size_t i = 0;
+
+#if USE_SIMD_IMAGE_OPS >= 1
+	__m128i low4 = _mm_set1_epi8((char)255);
+	__m128i high4 = _mm_setzero_si128();
+#if USE_SIMD_IMAGE_OPS >= 2
+	__m256i low8 = _mm256_set1_epi8((char)255);
+	__m256i high8 = _mm256_setzero_si256();
+	for (; i + 8 <= pixelCount; i += 8)
+	{
+		__m256i v = _mm256_loadu_si256((const __m256i*)(pixels + i * 4));
+		low8 = _mm256_min_epu8(low8, v);
+		high8 = _mm256_max_epu8(high8, v);
+	}
+	low4 = _mm_min_epu8(_mm256_castsi256_si128(low8), _mm256_extracti128_si256(low8, 1));
+	high4 = _mm_max_epu8(_mm256_castsi256_si128(high8), _mm256_extracti128_si256(high8, 1));
+#endif
+	for (; i + 4 <= pixelCount; i += 4)
+	{
+		__m128i v = _mm_loadu_si128((const __m128i*)(pixels + i * 4));
+		low4 = _mm_min_epu8(low4, v);
+		high4 = _mm_max_epu8(high4, v);
+	}
+
+	// fold the four pixels' lanes into one
+	low4 = _mm_min_epu8(low4, _mm_srli_si128(low4, 8));
+	low4 = _mm_min_epu8(low4, _mm_srli_si128(low4, 4));
+	high4 = _mm_max_epu8(high4, _mm_srli_si128(high4, 8));
+	high4 = _mm_max_epu8(high4, _mm_srli_si128(high4, 4));
+	uint32_t lowBits = (uint32_t)_mm_cvtsi128_si32(low4);
+	uint32_t highBits = (uint32_t)_mm_cvtsi128_si32(high4);
+	memcpy(low, &lowBits, 4);
+	memcpy(high, &highBits, 4);
+#endif
+
+	for (; i < pixelCount; ++i)
+	{
+		for (int c = 0; c < 4; ++c)
+		{
+			low[c] = std::min(low[c], pixels[i * 4 + c]);
+			high[c] = std::max(high[c], pixels[i * 4 + c]);
+		}
+	}
+
+	unsigned char middle[4];
+	for (int c = 0; c < 4; ++c)
+	{
+		if (pixelCount == 0 || high[c] - low[c] > tolerance)
+			return false;
+		middle[c] = (unsigned char)((low[c] + high[c] + 1) / 2);
+	}
+	memcpy(&color, middle, 4);
+	return true;
+}
+
+///////////////////////////////////////////////////
+//	HalveImage16(...)
+//
+//	Two target pixels per step: the four source
+//	pixels of each row split into even and odd
+//	pixels, which are added, then both rows are added
+//	and the sums divided by four with rounding. An odd
+//	last row or column is dropped, and a size of one
+//	reuses its only row or column.
+///////////////////////////////////////////////////
+void HalveImage16(const uint16_t* source, int width, int height, uint16_t* target)
+{
+	const int targetWidth = std::max(width / 2, 1);
+	const int targetHeight = std::max(height / 2, 1);
+
+	for (int y = 0; y < targetHeight; ++y)
+	{
+		const uint16_t* row0 = source + (size_t)std::min(y * 2, height - 1) * width * 4;
+		const uint16_t* row1 = source + (size_t)std::min(y * 2 + 1, height - 1) * width * 4;
+		uint16_t* out = target + (size_t)y * targetWidth * 4;
+		int x = 0;
+
+#if USE_SIMD_IMAGE_OPS >= 1
+		if (width >= 2)
+		{
+			const __m128i two = _mm_set1_epi16(2);
+			for (; x + 2 <= targetWidth; x += 2)
+			{
+				__m128i a0 = _mm_loadu_si128((const __m128i*)(row0 + x * 8));
+				__m128i b0 = _mm_loadu_si128((const __m128i*)(row0 + x * 8 + 8));
+				__m128i a1 = _mm_loadu_si128((const __m128i*)(row1 + x * 8));
+				__m128i b1 = _mm_loadu_si128((const __m128i*)(row1 + x * 8 + 8));
+				__m128i sum0 = _mm_add_epi16(_mm_unpacklo_epi64(a0, b0), _mm_unpackhi_epi64(a0, b0));
+				__m128i sum1 = _mm_add_epi16(_mm_unpacklo_epi64(a1, b1), _mm_unpackhi_epi64(a1, b1));
+				__m128i sum = _mm_add_epi16(_mm_add_epi16(sum0, sum1), two);
+				_mm_storeu_si128((__m128i*)(out + x * 4), _mm_srli_epi16(sum, 2));
+			}
+		}
+#endif
+
+		for (; x < targetWidth; ++x)
+		{
+			int x0 = std::min(x * 2, width - 1);
+			int x1 = std::min(x * 2 + 1, width - 1);
+			for (int c = 0; c < 4; ++c)
+				out[x * 4 + c] = (uint16_t)((row0[x0 * 4 + c] + row0[x1 * 4 + c] + row1[x0 * 4 + c] + row1[x1 * 4 + c] + 2) >> 2);
+		}
+	}
+}
+
+void ResampleImage(const unsigned char* source, int sourceWidth, int sourceHeight,
+	unsigned char* target, int targetWidth, int targetHeight, int channels)
+{
+	for (int y = 0; y < targetHeight; ++y)
+	{
+		// sample at pixel centers, clamped to the edge
+		float sy = std::min(std::max((y + 0.5f) * sourceHeight / targetHeight - 0.5f, 0.0f), (float)(sourceHeight - 1));
+		int y0 = (int)sy;
+		int y1 = std::min(y0 + 1, sourceHeight - 1);
+		float fy = sy - y0;
+
+		for (int x = 0; x < targetWidth; ++x)
+		{
+			float sx = std::min(std::max((x + 0.5f) * sourceWidth / targetWidth - 0.5f, 0.0f), (float)(sourceWidth - 1));
+			int x0 = (int)sx;
+			int x1 = std::min(x0 + 1, sourceWidth - 1);
+			float fx = sx - x0;
+
+			for (int c = 0; c < channels; ++c)
+			{
+				float top = source[(y0 * sourceWidth + x0) * channels + c] * (1.0f - fx) + source[(y0 * sourceWidth + x1) * channels + c] * fx;
+				float bottom = source[(y1 * sourceWidth + x0) * channels + c] * (1.0f - fx) + source[(y1 * sourceWidth + x1) * channels + c] * fx;
+				target[(y * targetWidth + x) * channels + c] = (unsigned char)(top * (1.0f - fy) + bottom * fy + 0.5f);
+			}
+		}
+	}
+}
+
+const char* ImageOpsInstructionSet()
+{
+#if USE_SIMD_IMAGE_OPS >= 2
+	return "AVX2";
+#elif USE_SIMD_IMAGE_OPS >= 1
+	return "SSSE3";
+#else
+	return "scalar";
+#endif
+}
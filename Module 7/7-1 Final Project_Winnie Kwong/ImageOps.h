@@ -0,0 +1,47 @@
+///////////////////////////////////////////////////////////////////////////////
+// imageops.h
+// ========
+// pixel kernels for 8-bit images with interleaved channels, run a row at a
+// time with SSE or AVX2 where the compiler targets them
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Reverse the row order in place, so that the first row ends up at the
+// bottom as OpenGL expects
+void FlipImageVertically(unsigned char* image, int width, int height, int channels);
+
+// Append an opaque alpha channel to each of pixelCount RGB pixels. target
+// holds pixelCount * 4 bytes and must not overlap source.
+void ExpandRgbToRgba(const unsigned char* source, unsigned char* target, size_t pixelCount);
+
+// Reorder the channels of each 4-channel pixel in place: channel c of the
+// result is channel order[c] of the input ({ 2, 1, 0, 3 } swaps BGRA and RGBA)
+void SwizzleChannels(unsigned char* pixels, size_t pixelCount, const int order[4]);
+
+// Multiply the color of each RGBA pixel by its alpha, rounded to nearest
+void PremultiplyAlpha(unsigned char* pixels, size_t pixelCount);
+
+// True if no channel of the pixelCount RGBA pixels varies by more than
+// tolerance. color is then the middle of each channel's range, packed as the
+// four bytes R, G, B, A in memory order.
+bool IsSolidColor(const unsigned char* pixels, size_t pixelCount, int tolerance, uint32_t& color);
+
+// Tolerance the texture code passes to IsSolidColor: a solid color saved as
+// a JPEG decodes a step or two off here and there
+const int SOLID_COLOR_TOLERANCE = 2;
+
+// Average each 2x2 block of a 16-bit RGBA image into one pixel of target,
+// which is max(1, width / 2) by max(1, height / 2). Values must stay below
+// 16384 so that four of them add up without overflow.
+void HalveImage16(const uint16_t* source, int width, int height, uint16_t* target);
+
+// Bilinear resample, sampling at pixel centers and clamping at the edges
+void ResampleImage(const unsigned char* source, int sourceWidth, int sourceHeight,
+	unsigned char* target, int targetWidth, int targetHeight, int channels);
+
+// Name of the instruction set the kernels were built for
+const char* ImageOpsInstructionSet();
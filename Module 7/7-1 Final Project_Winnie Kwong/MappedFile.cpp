@@ -0,0 +1,68 @@
+///////////////////////////////////////////////////////////////////////////////
+// mappedfile.cpp
+// ========
+// read-only file mappings
+///////////////////////////////////////////////////////////////////////////////
+
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+bool MappedFile::Open(const char* path)
+{
+	Close();
+
+#ifdef _WIN32
+	file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		file = nullptr;
+		return false;
+	}
+	LARGE_INTEGER fileSize;
+	GetFileSizeEx(file, &fileSize);
+	size = (size_t)fileSize.QuadPart;
+	mapping = size > 0 ? CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr) : nullptr;
+	data = mapping ? (const unsigned char*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+#else
+	int fd = open(path, O_RDONLY);
+	if (fd < 0)
+		return false;
+	struct stat info;
+	size = fstat(fd, &info) == 0 ? (size_t)info.st_size : 0;
+	void* mapped = size > 0 ? mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0) : MAP_FAILED;
+	close(fd);
+	data = mapped != MAP_FAILED ? (const unsigned char*)mapped : nullptr;
+#endif
+
+	if (data == nullptr)
+		Close();
+	return data != nullptr;
+}
+
+void MappedFile::Close()
+{
+#ifdef _WIN32
+	if (data)
+		UnmapViewOfFile(data);
+	if (mapping)
+		CloseHandle(mapping);
+	if (file)
+		CloseHandle(file);
+	file = mapping = nullptr;
+#else
+	if (data)
+		munmap((void*)data, size);
+#endif
+	data = nullptr;
+	size = 0;
+}
@@ -0,0 +1,36 @@
+///////////////////////////////////////////////////////////////////////////////
+// mappedfile.h
+// ========
+// read-only memory mapping of a whole file (mmap, or MapViewOfFile on
+// Windows). Pages are read from the page cache when first touched, so the
+// data can go to the GL without being copied into a buffer first.
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+
+class MappedFile
+{
+public:
+	MappedFile() = default;
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+	~MappedFile() { Close(); }
+
+	// Map the whole of path; fails for a missing or empty file
+	bool Open(const char* path);
+	void Close();
+
+	bool IsOpen() const { return data != nullptr; }
+	const unsigned char* Data() const { return data; }
+	size_t Size() const { return size; }
+
+private:
+	const unsigned char* data = nullptr;
+	size_t size = 0;
+#ifdef _WIN32
+	void* file = nullptr;
+	void* mapping = nullptr;
+#endif
+};
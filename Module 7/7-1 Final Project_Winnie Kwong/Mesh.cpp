@@ -8,34 +8,904 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 #include "mesh.h"
-
+#include "GLState.h"
+#include "AssetPack.h"
+#include "GpuResources.h"
+#include "MeshOptimize.h"
+#include "MeshSimplify.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 
 namespace
 {
 	const double M_PI = 3.14159265358979323846f;
 	const double M_PI_2 = 1.571428571428571;
+
+	// Name each mesh is stored under in an asset pack, in creation order, and
+	// the tessellation setting it is generated at, if any
+	const struct
+	{
+		const char* name;
+		Meshes::GLMesh Meshes::* mesh;
+		Meshes::Tessellation Meshes::* tessellation;
+	} PACKED_MESHES[] =
+	{
+		{ "plane", &Meshes::gPlaneMesh, nullptr },
+		{ "prism", &Meshes::gPrismMesh, nullptr },
+		{ "box", &Meshes::gBoxMesh, nullptr },
+		{ "cone", &Meshes::gConeMesh, &Meshes::gConeTessellation },
+		{ "cylinder", &Meshes::gCylinderMesh, &Meshes::gCylinderTessellation },
+		{ "tapered cylinder", &Meshes::gTaperedCylinderMesh, &Meshes::gTaperedCylinderTessellation },
+		{ "pyramid3", &Meshes::gPyramid3Mesh, nullptr },
+		{ "pyramid4", &Meshes::gPyramid4Mesh, nullptr },
+		{ "sphere", &Meshes::gSphereMesh, &Meshes::gSphereTessellation },
+		{ "torus", &Meshes::gTorusMesh, &Meshes::gTorusTessellation },
+		{ "donut", &Meshes::gDonutMesh, &Meshes::gDonutTessellation },
+	};
+
+	// Raise whenever a generator, or the welding, simplification or
+	// optimization after it, changes what it builds, so that packed meshes
+	// built before are generated again instead
+	const uint32_t MESH_GENERATOR_VERSION = 3;
+
+	// Tessellation a packed mesh records: its setting, or none for the fixed meshes
+	Meshes::Tessellation PackedTessellation(const Meshes& meshes, size_t i)
+	{
+		const Meshes::Tessellation none = { 0, 0 };
+		return PACKED_MESHES[i].tessellation != nullptr ? meshes.*PACKED_MESHES[i].tessellation : none;
+	}
+
+	// True if every draw range of a packed mesh lies inside its buffers and
+	// every index names one of its vertices, so a damaged pack that still
+	// matches its hash cannot make the GPU read past the mesh
+	bool PackedRangesValid(const PackedMeshHeader& header, const unsigned char* indices)
+	{
+		for (uint32_t part = 0; part < header.nParts; ++part)
+		{
+			const auto& range = header.parts[part];
+			uint64_t limit = range.indexed ? header.nIndices : header.nVertices;
+			if ((range.mode != GL_TRIANGLES && range.mode != GL_TRIANGLE_FAN && range.mode != GL_TRIANGLE_STRIP) ||
+				(uint64_t)range.first + range.count > limit)
+				return false;
+		}
+		for (uint32_t lod = 0; lod < header.nLods; ++lod)
+		{
+			for (uint32_t part = 0; part < header.nParts; ++part)
+			{
+				if ((uint64_t)header.lods[lod].first[part] + header.lods[lod].count[part] > header.nIndices)
+					return false;
+			}
+		}
+		for (uint32_t i = 0; i < header.nIndices; ++i)
+		{
+			uint32_t index = header.indexSize == sizeof(GLushort) ? ((const GLushort*)indices)[i] : ((const GLuint*)indices)[i];
+			if (index >= header.nVertices)
+				return false;
+		}
+		return true;
+	}
+
+	static_assert(Meshes::MAX_MESH_PARTS <= PackedMeshHeader::MAX_PARTS, "a packed mesh must hold every part");
+	static_assert(Meshes::MAX_MESH_LODS <= PackedMeshHeader::MAX_LODS, "a packed mesh must hold every level of detail");
+
+	// Errors BuildLods simplifies to, as fractions of the mesh's bounding box diagonal
+	const float LOD_ERRORS[Meshes::MAX_MESH_LODS] = { 0.0025f, 0.01f, 0.03f, 0.08f };
+
+	// A level only earns its indices if it drops at least this share of the
+	// triangles of the level before it
+	const float LOD_MIN_REDUCTION = 0.25f;
+
+	// Draw commands of a mesh at a level of detail, the full mesh for 0
+	const Meshes::DrawRange* LodParts(const Meshes::GLMesh& mesh, GLuint lod)
+	{
+		return lod == 0 || lod > mesh.nLods ? mesh.parts : mesh.lods[lod - 1].parts;
+	}
+
+	// A vertex in the compact layout: 16 bytes against 32 for 8 floats
+	struct CompactVertex
+	{
+		GLushort position[3];   // unsigned normalized across the mesh's bounding box
+		GLushort pad;
+		GLuint normal;          // GL_INT_2_10_10_10_REV, signed normalized x, y and z
+		GLushort uv[2];         // half floats
+	};
+	static_assert(sizeof(CompactVertex) == 16, "a compact vertex must be 16 bytes");
+
+	// IEEE half float rounded to nearest even. Magnitudes below the smallest
+	// normal half become zero, which no texture coordinate will miss.
+	GLushort FloatToHalf(float value)
+	{
+		uint32_t bits;
+		memcpy(&bits, &value, sizeof(bits));
+		uint32_t sign = (bits >> 16) & 0x8000;
+		int32_t exponent = (int32_t)((bits >> 23) & 0xff) - 127 + 15;
+		uint32_t mantissa = bits & 0x7fffff;
+		if (exponent <= 0)
+			return (GLushort)sign;
+		if (exponent >= 31)
+			return (GLushort)(sign | 0x7c00);
+
+		// a carry out of the mantissa correctly bumps the exponent
+		uint32_t half = sign | ((uint32_t)exponent << 10) | (mantissa >> 13);
+		uint32_t rest = mantissa & 0x1fff;
+		if (rest > 0x1000 || (rest == 0x1000 && (half & 1)))
+			++half;
+		return (GLushort)half;
+	}
+
+	float HalfToFloat(GLushort half)
+	{
+		uint32_t exponent = (half >> 10) & 0x1f;
+		uint32_t mantissa = half & 0x3ff;
+		float value;
+		if (exponent == 0)
+			value = std::ldexp((float)mantissa, -24);
+		else if (exponent == 31)
+			value = mantissa == 0 ? INFINITY : NAN;
+		else
+			value = std::ldexp((float)(mantissa | 0x400), (int)exponent - 25);
+		return (half & 0x8000) ? -value : value;
+	}
+
+	// 8-float vertices to compact ones; positions are stored as fractions of
+	// scale away from offset
+	void EncodeVertices(const GLfloat* vertices, size_t count, const glm::vec3& offset, const glm::vec3& scale,
+		std::vector<CompactVertex>& out)
+	{
+		auto snorm10 = [](float value) { return (GLuint)std::lround(std::max(-1.0f, std::min(1.0f, value)) * 511.0f) & 0x3ff; };
+
+		out.resize(count);
+		for (size_t i = 0; i < count; ++i)
+		{
+			const GLfloat* vertex = vertices + i * 8;
+			CompactVertex& compact = out[i];
+			for (int k = 0; k < 3; ++k)
+			{
+				float t = scale[k] > 0.0f ? (vertex[k] - offset[k]) / scale[k] : 0.0f;
+				compact.position[k] = (GLushort)std::lround(std::max(0.0f, std::min(1.0f, t)) * 65535.0f);
+			}
+			compact.pad = 0;
+			compact.normal = snorm10(vertex[3]) | (snorm10(vertex[4]) << 10) | (snorm10(vertex[5]) << 20);
+			compact.uv[0] = FloatToHalf(vertex[6]);
+			compact.uv[1] = FloatToHalf(vertex[7]);
+		}
+	}
+
+	// The reverse of EncodeVertices, as the GL reads the attributes
+	void DecodeVertices(const CompactVertex* vertices, size_t count, const glm::vec3& offset, const glm::vec3& scale,
+		std::vector<GLfloat>& out)
+	{
+		auto snorm10 = [](GLuint bits)
+		{
+			int value = (int)(bits & 0x3ff);
+			return std::max((value >= 512 ? value - 1024 : value) / 511.0f, -1.0f);
+		};
+
+		out.resize(count * 8);
+		for (size_t i = 0; i < count; ++i)
+		{
+			const CompactVertex& compact = vertices[i];
+			GLfloat* vertex = out.data() + i * 8;
+			for (int k = 0; k < 3; ++k)
+				vertex[k] = offset[k] + scale[k] * (compact.position[k] / 65535.0f);
+			vertex[3] = snorm10(compact.normal);
+			vertex[4] = snorm10(compact.normal >> 10);
+			vertex[5] = snorm10(compact.normal >> 20);
+			vertex[6] = HalfToFloat(compact.uv[0]);
+			vertex[7] = HalfToFloat(compact.uv[1]);
+		}
+	}
+
+	// A vertex with every attribute rounded to a multiple of the weld tolerance
+	struct WeldKey
+	{
+		long long values[8];
+
+		bool operator==(const WeldKey& other) const
+		{
+			return std::equal(values, values + 8, other.values);
+		}
+	};
+
+	struct WeldKeyHash
+	{
+		size_t operator()(const WeldKey& key) const
+		{
+			// FNV-1a over the rounded values
+			uint64_t hash = 14695981039346656037ull;
+			for (long long value : key.values)
+				hash = (hash ^ (uint64_t)value) * 1099511628211ull;
+			return (size_t)hash;
+		}
+	};
+
+	void AddVertex(Meshes::MeshData& data, const glm::vec3& position, const glm::vec3& normal, float u, float v)
+	{
+		data.vertices.insert(data.vertices.end(), { position.x, position.y, position.z, normal.x, normal.y, normal.z, u, v });
+	}
+
+	// Close the part whose indices start at first
+	void AddPart(Meshes::MeshData& data, size_t first)
+	{
+		data.parts[data.nParts++] = { GL_TRIANGLES, (GLuint)first, (GLuint)(data.indices.size() - first), true };
+	}
+
+	///////////////////////////////////////////////////
+	//	GenerateFrustum(MeshData&, GLuint, GLuint, float)
+	//
+	//	A cylinder from radius 1 at y = 0 to topRadius at
+	//	y = 1, a cone when topRadius is 0. Caps are disks
+	//	with the whole texture mapped on them; the sides
+	//	take u around the axis and v up it, with u squeezed
+	//	toward 0.5 as the radius narrows so the texture
+	//	does not shear at the top.
+	///////////////////////////////////////////////////
+	void GenerateFrustum(Meshes::MeshData& data, GLuint segments, GLuint rings, float topRadius)
+	{
+		const float bottomRadius = 1.0f;
+		segments = std::max(segments, 3u);
+		rings = std::max(rings, 1u);
+
+		data.vertices.clear();
+		data.indices.clear();
+		data.nParts = 0;
+		data.nLods = 0;
+
+		// the disk at height y, facing up or down
+		auto addCap = [&](float y, float radius, float facing)
+		{
+			size_t first = data.indices.size();
+			GLuint center = (GLuint)(data.vertices.size() / 8);
+			AddVertex(data, glm::vec3(0.0f, y, 0.0f), glm::vec3(0.0f, facing, 0.0f), 0.5f, 0.5f);
+			for (GLuint i = 0; i < segments; ++i)
+			{
+				float angle = 2.0f * (float)M_PI * i / segments;
+				AddVertex(data, glm::vec3(radius * std::cos(angle), y, -radius * std::sin(angle)), glm::vec3(0.0f, facing, 0.0f),
+					0.5f - 0.5f * std::sin(angle), 0.5f + 0.5f * std::cos(angle));
+			}
+			for (GLuint i = 0; i < segments; ++i)
+			{
+				GLuint rim = center + 1 + i;
+				GLuint next = center + 1 + (i + 1) % segments;
+				data.indices.insert(data.indices.end(), { center, facing > 0.0f ? rim : next, facing > 0.0f ? next : rim });
+			}
+			AddPart(data, first);
+		};
+
+		addCap(0.0f, bottomRadius, -1.0f);
+		if (topRadius > 0.0f)
+			addCap(1.0f, topRadius, 1.0f);
+
+		// sides: a seam column at each end, so u runs the whole way around
+		size_t first = data.indices.size();
+		GLuint base = (GLuint)(data.vertices.size() / 8);
+		for (GLuint ring = 0; ring <= rings; ++ring)
+		{
+			float y = (float)ring / rings;
+			float radius = bottomRadius + (topRadius - bottomRadius) * y;
+			for (GLuint i = 0; i <= segments; ++i)
+			{
+				float t = (float)i / segments;
+				float angle = 2.0f * (float)M_PI * t;
+				// a cone's apex is one vertex per side, the top corner of side
+				// i - 1, so it faces the middle of that side
+				float facing = (radius > 0.0f) ? angle : 2.0f * (float)M_PI * (i - 0.5f) / segments;
+				glm::vec3 normal = glm::normalize(glm::vec3(std::cos(facing), bottomRadius - topRadius, -std::sin(facing)));
+				AddVertex(data, glm::vec3(radius * std::cos(angle), y, -radius * std::sin(angle)), normal,
+					0.5f + (t - 0.5f) * radius, y);
+			}
+		}
+		for (GLuint ring = 0; ring < rings; ++ring)
+		{
+			for (GLuint i = 0; i < segments; ++i)
+			{
+				GLuint bottom = base + ring * (segments + 1) + i;
+				GLuint top = bottom + segments + 1;
+				data.indices.insert(data.indices.end(), { bottom, bottom + 1, top + 1 });
+				// the last ring of a cone meets in a point
+				if (ring + 1 < rings || topRadius > 0.0f)
+					data.indices.insert(data.indices.end(), { bottom, top + 1, top });
+			}
+		}
+		AddPart(data, first);
+	}
+
+	///////////////////////////////////////////////////
+	//	GenerateTorus(MeshData&, GLuint, GLuint, float,
+	//		float)
+	//
+	//	A ring of mainRadius around the z axis with a tube
+	//	of tubeRadius, drawn as a grid of two-triangle
+	//	quads, a closed surface BuildLods can simplify.
+	//	u runs around the ring and v around the tube, with
+	//	a seam row and column at the ends so both run the
+	//	whole way. Normals point away from the tube's
+	//	center line.
+	///////////////////////////////////////////////////
+	void GenerateTorus(Meshes::MeshData& data, GLuint segments, GLuint rings, float mainRadius, float tubeRadius)
+	{
+		segments = std::max(segments, 3u);
+		rings = std::max(rings, 3u);
+
+		data.vertices.clear();
+		data.indices.clear();
+		data.nParts = 0;
+		data.nLods = 0;
+
+		for (GLuint i = 0; i <= segments; ++i)
+		{
+			float mainAngle = 2.0f * (float)M_PI * i / segments;
+			glm::vec3 outward(std::cos(mainAngle), std::sin(mainAngle), 0.0f);
+			for (GLuint j = 0; j <= rings; ++j)
+			{
+				float tubeAngle = 2.0f * (float)M_PI * j / rings;
+				glm::vec3 normal = outward * std::cos(tubeAngle) + glm::vec3(0.0f, 0.0f, std::sin(tubeAngle));
+				AddVertex(data, outward * mainRadius + normal * tubeRadius, normal, (float)i / segments, (float)j / rings);
+			}
+		}
+		for (GLuint i = 0; i < segments; ++i)
+		{
+			for (GLuint j = 0; j < rings; ++j)
+			{
+				GLuint corner = i * (rings + 1) + j;
+				GLuint next = corner + rings + 1;
+				data.indices.insert(data.indices.end(), { corner, next, next + 1, corner, next + 1, corner + 1 });
+			}
+		}
+		AddPart(data, 0);
+	}
 }
 
 ///////////////////////////////////////////////////
-//	CreateMeshes()
+//	CreateMeshes(const AssetPack*)
+//
+//	pack: asset pack to read the meshes from, or nullptr
 //
 //	Create all the following 3D meshes:
 //		plane, pyramid, cube, cylinder, torus, sphere
+//
+//	Meshes the pack does not hold are generated on
+//	every core by GenerateMeshes, then added to the
+//	geometry pool on this thread. Returns false if
+//	the pool refused one of them or could not be
+//	uploaded.
+///////////////////////////////////////////////////
+bool Meshes::CreateMeshes(const AssetPack* pack)
+{
+	const size_t count = sizeof(PACKED_MESHES) / sizeof(PACKED_MESHES[0]);
+	std::vector<bool> needed(count, true);
+	GLuint packed = 0;
+	for (size_t i = 0; i < count; ++i)
+	{
+		if (pack != nullptr && UCreatePackedMesh(this->*PACKED_MESHES[i].mesh, *pack, PACKED_MESHES[i].name,
+			PackedTessellation(*this, i)))
+		{
+			needed[i] = false;
+			++packed;
+		}
+	}
+
+	if (packed < count)
+	{
+		std::vector<MeshData> generated;
+		auto start = std::chrono::steady_clock::now();
+		unsigned threads = GenerateMeshes(generated, needed);
+		std::cout << "INFO: " << count - packed << " meshes generated on " << threads << " threads in "
+			<< std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() << " ms" << std::endl;
+
+		// in table order, so the pool's layout does not depend on which thread finished first
+		for (size_t i = 0; i < count; ++i)
+		{
+			if (needed[i] && !UCreateMesh(this->*PACKED_MESHES[i].mesh, generated[i]))
+			{
+				std::cout << "ERROR: mesh " << PACKED_MESHES[i].name << " could not be added to the geometry pool" << std::endl;
+				return false;
+			}
+		}
+	}
+
+	// one upload for every mesh, and one VAO they all draw from
+	if (!gGeometryPool.Upload("meshes"))
+	{
+		std::cout << "ERROR: the meshes could not be uploaded" << std::endl;
+		return false;
+	}
+	SetVertexAttributes(gPlaneMesh);
+	gGLState.BindVertexArray(0);
+	for (const auto& entry : PACKED_MESHES)
+	{
+		GLMesh& mesh = this->*entry.mesh;
+		mesh.vao = gGeometryPool.Vao();
+		mesh.vbos[0] = gGeometryPool.VertexBuffer();
+		mesh.vbos[1] = gGeometryPool.IndexBuffer();
+	}
+
+	if (pack != nullptr)
+		std::cout << "INFO: " << packed << " of " << count << " meshes read from the asset pack" << std::endl;
+	return true;
+}
+
+///////////////////////////////////////////////////
+//	GenerateMeshes(std::vector<MeshData>&,
+//		const std::vector<bool>&, unsigned)
+//
+//	data: receives one entry per mesh
+//	needed: which meshes to generate, or empty for all
+//	threads: worker count, or 0 for one per core
+//
+//	Each generator only reads the tessellation
+//	settings and fills its own MeshData, so the
+//	workers take whole meshes off a shared counter,
+//	the calling thread being one of them. The round
+//	meshes go first, largest tessellation first, so
+//	that no expensive mesh starts last.
 ///////////////////////////////////////////////////
-void Meshes::CreateMeshes()
+unsigned Meshes::GenerateMeshes(std::vector<MeshData>& data, const std::vector<bool>& needed, unsigned threads) const
 {
-	UCreatePlaneMesh(gPlaneMesh);
-	UCreatePrismMesh(gPrismMesh);
-	UCreateBoxMesh(gBoxMesh);
-	UCreateConeMesh(gConeMesh);
-	UCreateCylinderMesh(gCylinderMesh);
-	UCreateTaperedCylinderMesh(gTaperedCylinderMesh);
-	UCreatePyramid3Mesh(gPyramid3Mesh);
-	UCreatePyramid4Mesh(gPyramid4Mesh);
-	UCreateSphereMesh(gSphereMesh);
-	UCreateTorusMesh(gTorusMesh);
-	UCreateDonutMesh(gDonutMesh);
+	// in the order of PACKED_MESHES
+	void (Meshes::* const generators[])(MeshData&) const =
+	{
+		&Meshes::UGeneratePlaneMesh,
+		&Meshes::UGeneratePrismMesh,
+		&Meshes::UGenerateBoxMesh,
+		&Meshes::UGenerateConeMesh,
+		&Meshes::UGenerateCylinderMesh,
+		&Meshes::UGenerateTaperedCylinderMesh,
+		&Meshes::UGeneratePyramid3Mesh,
+		&Meshes::UGeneratePyramid4Mesh,
+		&Meshes::UGenerateSphereMesh,
+		&Meshes::UGenerateTorusMesh,
+		&Meshes::UGenerateDonutMesh,
+	};
+	const size_t count = sizeof(generators) / sizeof(generators[0]);
+	static_assert(sizeof(generators) / sizeof(generators[0]) == sizeof(PACKED_MESHES) / sizeof(PACKED_MESHES[0]),
+		"every mesh needs a generator and a pack name");
+
+	data.assign(count, MeshData());
+	std::vector<size_t> jobs;
+	for (size_t i = 0; i < count; ++i)
+	{
+		if (needed.empty() || needed[i])
+			jobs.push_back(i);
+	}
+	auto cost = [&](size_t i)
+	{
+		Tessellation tessellation = PackedTessellation(*this, i);
+		return (size_t)tessellation.segments * (tessellation.rings + 2);
+	};
+	std::stable_sort(jobs.begin(), jobs.end(), [&](size_t a, size_t b) { return cost(a) > cost(b); });
+
+	if (threads == 0)
+		threads = std::max(std::thread::hardware_concurrency(), 1u);
+	threads = (unsigned)std::max<size_t>(std::min<size_t>(threads, jobs.size()), 1);
+
+	std::atomic<size_t> nextJob(0);
+	auto work = [&]()
+	{
+		for (size_t job = nextJob++; job < jobs.size(); job = nextJob++)
+			(this->*generators[jobs[job]])(data[jobs[job]]);
+	};
+	std::vector<std::thread> workers;
+	for (unsigned i = 1; i < threads; ++i)
+		workers.emplace_back(work);
+	work();
+	for (std::thread& worker : workers)
+		worker.join();
+
+	return threads;
+}
+
+///////////////////////////////////////////////////
+//	PackMeshes(AssetPackWriter&)
+//
+//	writer: pack being built
+//
+//	Only the GL keeps the meshes' data, so each mesh's
+//	ranges of the geometry pool are read back and
+//	stored in their own layout with its counts,
+//	position decoding and draw commands
+///////////////////////////////////////////////////
+void Meshes::PackMeshes(AssetPackWriter& writer) const
+{
+	for (size_t i = 0; i < sizeof(PACKED_MESHES) / sizeof(PACKED_MESHES[0]); ++i)
+	{
+		const auto& packed = PACKED_MESHES[i];
+		const GLMesh& mesh = this->*packed.mesh;
+
+		PackedMeshHeader header = {};
+		header.generatorVersion = MESH_GENERATOR_VERSION;
+		header.segments = PackedTessellation(*this, i).segments;
+		header.rings = PackedTessellation(*this, i).rings;
+		header.nVertices = mesh.nVertices;
+		header.nIndices = mesh.nIndices;
+		header.floatsPerVertex = mesh.compact ? 0 : 8;
+		header.indexSize = IndexSize(mesh);
+		for (int k = 0; k < 3; ++k)
+		{
+			header.positionOffset[k] = mesh.positionOffset[k];
+			header.positionScale[k] = mesh.positionScale[k];
+		}
+		header.nParts = mesh.nParts;
+		for (GLuint part = 0; part < mesh.nParts; ++part)
+		{
+			header.parts[part].mode = mesh.parts[part].mode;
+			header.parts[part].first = mesh.parts[part].first;
+			header.parts[part].count = mesh.parts[part].count;
+			header.parts[part].indexed = mesh.parts[part].indexed ? 1 : 0;
+		}
+		header.nLods = mesh.nLods;
+		for (GLuint lod = 0; lod < mesh.nLods; ++lod)
+		{
+			header.lods[lod].error = mesh.lods[lod].error;
+			for (GLuint part = 0; part < mesh.nParts; ++part)
+			{
+				header.lods[lod].first[part] = mesh.lods[lod].parts[part].first;
+				header.lods[lod].count[part] = mesh.lods[lod].parts[part].count;
+			}
+		}
+
+		size_t vertexBytes = (size_t)VertexSize(mesh) * mesh.nVertices;
+		size_t indexBytes = (size_t)IndexSize(mesh) * mesh.nIndices;
+		std::vector<unsigned char> data(sizeof(header) + vertexBytes + indexBytes);
+		memcpy(data.data(), &header, sizeof(header));
+
+		// the copy-read target leaves the bound VAO's index buffer alone
+		glBindBuffer(GL_COPY_READ_BUFFER, mesh.vbos[0]);
+		glGetBufferSubData(GL_COPY_READ_BUFFER, (GLintptr)mesh.baseVertex * VertexSize(mesh), vertexBytes, data.data() + sizeof(header));
+		if (mesh.nIndices > 0)
+		{
+			glBindBuffer(GL_COPY_READ_BUFFER, mesh.vbos[1]);
+			glGetBufferSubData(GL_COPY_READ_BUFFER, mesh.indexOffset, indexBytes, data.data() + sizeof(header) + vertexBytes);
+		}
+		glBindBuffer(GL_COPY_READ_BUFFER, 0);
+
+		writer.Add(AssetType::Mesh, packed.name, data.data(), data.size());
+	}
+}
+
+///////////////////////////////////////////////////
+//	WeldVertices(MeshData&, const char*, float)
+//
+//	data: generated mesh, indexed or not
+//	name: mesh name for the report
+//	tolerance: grid every attribute is rounded to
+//
+//	Vertices are hashed with each attribute rounded to
+//	a multiple of tolerance, and the first vertex seen
+//	for a key stands for all of them. Merged vertices
+//	differ by at most tolerance, but vertices that
+//	close are not always merged: one either side of a
+//	rounding boundary get different keys. Unindexed
+//	parts get indices in the order they drew their
+//	vertices.
+///////////////////////////////////////////////////
+void Meshes::WeldVertices(MeshData& data, const char* name, float tolerance)
+{
+	const GLuint floatsPerVertex = 8;
+	const size_t vertexCount = data.vertices.size() / floatsPerVertex;
+	const size_t indexCount = data.indices.size();
+
+	std::vector<GLfloat> vertices;
+	std::vector<GLuint> remap(vertexCount);
+	std::unordered_map<WeldKey, GLuint, WeldKeyHash> unique;
+	unique.reserve(vertexCount);
+	for (size_t i = 0; i < vertexCount; ++i)
+	{
+		const GLfloat* vertex = &data.vertices[i * floatsPerVertex];
+		WeldKey key;
+		for (GLuint k = 0; k < floatsPerVertex; ++k)
+			key.values[k] = std::llround(vertex[k] / tolerance);
+
+		auto found = unique.emplace(key, (GLuint)(vertices.size() / floatsPerVertex));
+		if (found.second)
+			vertices.insert(vertices.end(), vertex, vertex + floatsPerVertex);
+		remap[i] = found.first->second;
+	}
+
+	std::vector<GLuint> indices;
+	indices.reserve(indexCount);
+	for (GLuint index : data.indices)
+		indices.push_back(remap[index]);
+	for (GLuint part = 0; part < data.nParts; ++part)
+	{
+		DrawRange& range = data.parts[part];
+		if (range.indexed)
+			continue;
+		GLuint first = (GLuint)indices.size();
+		for (GLuint i = range.first; i < range.first + range.count; ++i)
+			indices.push_back(remap[i]);
+		range.first = first;
+		range.indexed = true;
+	}
+
+	data.vertices.swap(vertices);
+	data.indices.swap(indices);
+
+	std::ostringstream report;
+	report << "INFO: Welded " << name << ": " << vertexCount << " vertices, " << indexCount << " indices -> "
+		<< data.vertices.size() / floatsPerVertex << " vertices, " << data.indices.size() << " indices\n";
+	std::cout << report.str() << std::flush;
+}
+
+///////////////////////////////////////////////////
+//	BuildLods(MeshData&, const char*)
+//
+//	data: generated mesh, before OptimizeMesh
+//	name: mesh name for the report
+//
+//	Every level is simplified from full detail rather
+//	than from the level before, so errors do not add
+//	up. A level that keeps too many of the previous
+//	level's triangles is skipped. Meshes with fans,
+//	strips or unindexed parts get no levels.
+///////////////////////////////////////////////////
+void Meshes::BuildLods(MeshData& data, const char* name)
+{
+	const GLuint floatsPerVertex = 8;
+	const size_t vertexCount = data.vertices.size() / floatsPerVertex;
+
+	data.nLods = 0;
+	for (GLuint part = 0; part < data.nParts; ++part)
+	{
+		if (!data.parts[part].indexed || data.parts[part].mode != GL_TRIANGLES)
+			return;
+	}
+
+	// the parts back to back, so one simplification sees the whole surface
+	std::vector<GLuint> source;
+	size_t sourceEnds[MAX_MESH_PARTS];
+	for (GLuint part = 0; part < data.nParts; ++part)
+	{
+		const DrawRange& range = data.parts[part];
+		source.insert(source.end(), data.indices.begin() + range.first, data.indices.begin() + range.first + range.count);
+		sourceEnds[part] = source.size();
+	}
+	const float extent = MeshExtent(data.vertices.data(), vertexCount, floatsPerVertex);
+
+	// the report is written in one piece, since meshes are generated in parallel
+	std::ostringstream report;
+	report << "INFO: Levels of detail of " << name << ": " << source.size() / 3 << " triangles";
+	std::vector<GLuint> simplified(source.size());
+	size_t previous = source.size();
+	for (float targetError : LOD_ERRORS)
+	{
+		size_t partEnds[MAX_MESH_PARTS];
+		std::copy(sourceEnds, sourceEnds + data.nParts, partEnds);
+		float error = 0.0f;
+		size_t count = SimplifyMesh(simplified.data(), source.data(), source.size(), data.vertices.data(), vertexCount,
+			floatsPerVertex, partEnds, data.nParts, 0, targetError, &error);
+		if (count == 0 || count > previous * (1.0f - LOD_MIN_REDUCTION))
+			continue;
+
+		MeshLod& lod = data.lods[data.nLods++];
+		lod.error = error * extent;
+		size_t start = 0;
+		for (GLuint part = 0; part < data.nParts; ++part)
+		{
+			lod.parts[part] = { GL_TRIANGLES, (GLuint)(data.indices.size() + start), (GLuint)(partEnds[part] - start), true };
+			start = partEnds[part];
+		}
+		data.indices.insert(data.indices.end(), simplified.begin(), simplified.begin() + count);
+		previous = count;
+
+		report << ", " << count / 3 << " at " << error * 100.0f << "%";
+	}
+	report << "\n";
+	std::cout << report.str() << std::flush;
+}
+
+///////////////////////////////////////////////////
+//	OptimizeMesh(MeshData&, const char*, bool)
+//
+//	data: generated mesh
+//	name: mesh name for the report
+//	clusterForOverdraw: also sort each part's
+//	triangle clusters outward first
+//
+//	Parts are reordered one at a time, and each level
+//	of detail's separately, so that each still draws
+//	its own triangles from its own range.
+//	The miss ratio is measured over the whole index
+//	buffer with VERTEX_CACHE_SIZE entries; if the new
+//	triangle order does not lower it, the original
+//	order is kept.
+///////////////////////////////////////////////////
+void Meshes::OptimizeMesh(MeshData& data, const char* name, bool clusterForOverdraw)
+{
+	const GLuint floatsPerVertex = 8;
+	const size_t vertexCount = data.vertices.size() / floatsPerVertex;
+	if (data.indices.empty())
+		return;
+
+	float before = AverageCacheMissRatio(data.indices.data(), data.indices.size(), vertexCount);
+	std::vector<GLuint> original(data.indices);
+
+	std::vector<size_t> clusters;
+	for (GLuint lod = 0; lod <= data.nLods; ++lod)
+	{
+		const DrawRange* parts = lod == 0 ? data.parts : data.lods[lod - 1].parts;
+		for (GLuint part = 0; part < data.nParts; ++part)
+		{
+			const DrawRange& range = parts[part];
+			if (!range.indexed || range.mode != GL_TRIANGLES)
+				continue;
+
+			GLuint* indices = data.indices.data() + range.first;
+			OptimizeVertexCache(indices, range.count, vertexCount, VERTEX_CACHE_SIZE, &clusters);
+			if (clusterForOverdraw)
+				OptimizeOverdraw(indices, range.count, data.vertices.data(), floatsPerVertex, clusters);
+		}
+	}
+
+	float after = AverageCacheMissRatio(data.indices.data(), data.indices.size(), vertexCount);
+	std::ostringstream report;
+	report << "INFO: Optimized " << name << ": cache miss ratio " << before << " -> ";
+	if (after < before)
+		report << after << "\n";
+	else
+	{
+		data.indices.swap(original);
+		report << after << ", kept the original order\n";
+	}
+	std::cout << report.str() << std::flush;
+
+	// renumbering the vertices leaves the miss ratio as it is
+	OptimizeVertexFetch(data.vertices, floatsPerVertex, data.indices);
+}
+
+///////////////////////////////////////////////////
+//	UCreateMesh(GLMesh&, const MeshData&)
+//
+//	mesh: reference to mesh structure for storing data
+//	data: generated vertices, indices and parts
+//
+//	Add a mesh to the geometry pool, in the compact
+//	layout when gCompactVertices is set. Returns false
+//	if the pool holds vertices of another layout.
+///////////////////////////////////////////////////
+bool Meshes::UCreateMesh(GLMesh& mesh, const MeshData& data)
+{
+	const GLuint floatsPerVertex = 8;
+
+	// store vertex and index count
+	mesh.nVertices = (GLuint)(data.vertices.size() / floatsPerVertex);
+	mesh.nIndices = (GLuint)data.indices.size();
+	mesh.nParts = data.nParts;
+	std::copy(data.parts, data.parts + data.nParts, mesh.parts);
+	mesh.nLods = data.nLods;
+	std::copy(data.lods, data.lods + data.nLods, mesh.lods);
+	UComputeBounds(mesh, data.vertices.data());
+
+	// compact positions are fractions of the bounding box; 0xffff stays free as an index
+	mesh.compact = gCompactVertices;
+	mesh.positionOffset = mesh.compact ? mesh.boundsMin : glm::vec3(0.0f);
+	mesh.positionScale = mesh.compact ? mesh.boundsMax - mesh.boundsMin : glm::vec3(1.0f);
+	mesh.indexType = mesh.compact && mesh.nVertices < 0xffff ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+
+	std::vector<CompactVertex> compactVertices;
+	const void* vertices = data.vertices.data();
+	if (mesh.compact)
+	{
+		EncodeVertices(data.vertices.data(), mesh.nVertices, mesh.positionOffset, mesh.positionScale, compactVertices);
+		vertices = compactVertices.data();
+	}
+	std::vector<GLushort> shortIndices;
+	const void* indices = data.indices.data();
+	if (mesh.indexType == GL_UNSIGNED_SHORT)
+	{
+		shortIndices.assign(data.indices.begin(), data.indices.end());
+		indices = shortIndices.data();
+	}
+
+	// the VAO and buffers are the pool's, filled in by CreateMeshes
+	mesh.baseVertex = gGeometryPool.AddVertices(vertices, mesh.nVertices, VertexSize(mesh));
+	if (mesh.baseVertex < 0)
+		return false;
+	mesh.indexOffset = mesh.nIndices > 0 ? gGeometryPool.AddIndices(indices, mesh.nIndices, IndexSize(mesh)) : 0;
+	return true;
+}
+
+///////////////////////////////////////////////////
+//	UCreatePackedMesh(GLMesh&, const AssetPack&,
+//		const char*, const Tessellation&)
+//
+//	mesh: reference to mesh structure for storing data
+//	pack: asset pack holding the mesh
+//	name: name the mesh was packed under
+//	tessellation: setting the mesh would be generated
+//	at now, { 0, 0 } for the fixed meshes
+//
+//	Add a packed mesh to the geometry pool from the
+//	pack's mapping. Returns false if the pack does not hold
+//	the mesh, its data does not match its hash or its
+//	buffers, or it was built by other generators or at
+//	another tessellation or vertex layout than the
+//	current ones.
+///////////////////////////////////////////////////
+bool Meshes::UCreatePackedMesh(GLMesh& mesh, const AssetPack& pack, const char* name, const Tessellation& tessellation)
+{
+	const AssetPackEntry* entry = pack.Find(AssetType::Mesh, name);
+	if (entry == nullptr || entry->bytes < sizeof(PackedMeshHeader))
+		return false;
+
+	const unsigned char* data = pack.Data(*entry);
+	const PackedMeshHeader& header = *(const PackedMeshHeader*)data;
+	const bool compact = header.floatsPerVertex == 0;
+	size_t vertexBytes = (compact ? sizeof(CompactVertex) : sizeof(GLfloat) * header.floatsPerVertex) * header.nVertices;
+	size_t indexBytes = (size_t)header.indexSize * header.nIndices;
+	if ((!compact && header.floatsPerVertex != 8) || (header.indexSize != sizeof(GLushort) && header.indexSize != sizeof(GLuint)) ||
+		header.nVertices == 0 || header.nParts == 0 || header.nParts > MAX_MESH_PARTS || header.nLods > MAX_MESH_LODS ||
+		sizeof(PackedMeshHeader) + vertexBytes + indexBytes != entry->bytes ||
+		!pack.Verify(*entry) || !PackedRangesValid(header, data + sizeof(PackedMeshHeader) + vertexBytes))
+	{
+		std::cout << "WARNING: mesh " << name << " in the asset pack is damaged, generating it instead" << std::endl;
+		return false;
+	}
+	if (compact != gCompactVertices)
+	{
+		std::cout << "INFO: mesh " << name << " in the asset pack has the other vertex layout, generating it instead" << std::endl;
+		return false;
+	}
+	if (header.generatorVersion != MESH_GENERATOR_VERSION)
+	{
+		std::cout << "INFO: mesh " << name << " in the asset pack is from older generators, generating it instead" << std::endl;
+		return false;
+	}
+	if (header.segments != tessellation.segments || header.rings != tessellation.rings)
+	{
+		std::cout << "INFO: mesh " << name << " in the asset pack is " << header.segments << "x" << header.rings
+			<< ", generating it at " << tessellation.segments << "x" << tessellation.rings << " instead" << std::endl;
+		return false;
+	}
+
+	// store vertex and index count
+	mesh.nVertices = header.nVertices;
+	mesh.nIndices = header.nIndices;
+	mesh.nParts = header.nParts;
+	for (GLuint part = 0; part < mesh.nParts; ++part)
+		mesh.parts[part] = { header.parts[part].mode, header.parts[part].first, header.parts[part].count, header.parts[part].indexed != 0 };
+	mesh.nLods = header.nLods;
+	for (GLuint lod = 0; lod < mesh.nLods; ++lod)
+	{
+		mesh.lods[lod].error = header.lods[lod].error;
+		for (GLuint part = 0; part < mesh.nParts; ++part)
+			mesh.lods[lod].parts[part] = { GL_TRIANGLES, header.lods[lod].first[part], header.lods[lod].count[part], true };
+	}
+	mesh.compact = compact;
+	mesh.positionOffset = glm::vec3(header.positionOffset[0], header.positionOffset[1], header.positionOffset[2]);
+	mesh.positionScale = glm::vec3(header.positionScale[0], header.positionScale[1], header.positionScale[2]);
+	mesh.indexType = header.indexSize == sizeof(GLushort) ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+
+	// bounds come from the positions as the shaders will see them
+	const unsigned char* vertices = data + sizeof(PackedMeshHeader);
+	if (compact)
+	{
+		std::vector<GLfloat> decoded;
+		DecodeVertices((const CompactVertex*)vertices, mesh.nVertices, mesh.positionOffset, mesh.positionScale, decoded);
+		UComputeBounds(mesh, decoded.data());
+	}
+	else
+		UComputeBounds(mesh, (const GLfloat*)vertices);
+
+	// the VAO and buffers are the pool's, filled in by CreateMeshes; a mesh the
+	// pool refuses is generated instead
+	mesh.baseVertex = gGeometryPool.AddVertices(vertices, mesh.nVertices, VertexSize(mesh));
+	if (mesh.baseVertex < 0)
+		return false;
+	mesh.indexOffset = mesh.nIndices > 0 ? gGeometryPool.AddIndices(vertices + vertexBytes, mesh.nIndices, header.indexSize) : 0;
+
+	return true;
 }
 
 ///////////////////////////////////////////////////
@@ -48,6 +918,7 @@ void Meshes::DestroyMeshes()
 	UDestroyMesh(gBoxMesh);
 	UDestroyMesh(gConeMesh);
 	UDestroyMesh(gCylinderMesh);
+	UDestroyMesh(gTaperedCylinderMesh);
 	UDestroyMesh(gPlaneMesh);
 	UDestroyMesh(gPyramid3Mesh);
 	UDestroyMesh(gPyramid4Mesh);
@@ -55,20 +926,21 @@ void Meshes::DestroyMeshes()
 	UDestroyMesh(gSphereMesh);
 	UDestroyMesh(gTorusMesh);
 	UDestroyMesh(gDonutMesh);
+	gGeometryPool.Destroy();
 }
 
 ///////////////////////////////////////////////////
-//	UCreatePlaneMesh(GLMesh&)
+//	UGeneratePlaneMesh(MeshData&)
 //
-//	mesh: reference to mesh structure for storing data
+//	data: empty mesh data, filled with the mesh
 //
-//	Create a plane mesh and store it in a VAO/VBO
+//	Generate a plane mesh
 // 
 //  Correct triangle drawing command:
 //
-//	glDrawElements(GL_TRIANGLES, meshes.gPlaneMesh.nIndices, GL_UNSIGNED_INT, (void*)0);
+//	glDrawElements(GL_TRIANGLES, meshes.gPlaneMesh.nIndices, meshes.gPlaneMesh.indexType, (void*)0);
 ///////////////////////////////////////////////////
-void Meshes::UCreatePlaneMesh(GLMesh& mesh)
+void Meshes::UGeneratePlaneMesh(MeshData& data) const
 {
 	// Vertex data
 	GLfloat verts[] = {
@@ -85,53 +957,25 @@ void Meshes::UCreatePlaneMesh(GLMesh& mesh)
 		0,3,2
 	};
 
-	// total float values per each type
-	const GLuint floatsPerVertex = 3;
-	const GLuint floatsPerNormal = 3;
-	const GLuint floatsPerUV = 2;
-
-	// store vertex and index count
-	mesh.nVertices = sizeof(verts) / (sizeof(verts[0]) * (floatsPerVertex + floatsPerNormal + floatsPerUV));
-	mesh.nIndices = sizeof(indices) / sizeof(indices[0]);
-
-	// Generate the VAO for the mesh
-	glGenVertexArrays(1, &mesh.vao);
-	glBindVertexArray(mesh.vao);	// activate the VAO
-
-	// Create VBOs for the mesh
-	glGenBuffers(2, mesh.vbos);
-	glBindBuffer(GL_ARRAY_BUFFER, mesh.vbos[0]); // Activates the buffer
-	glBufferData(GL_ARRAY_BUFFER, sizeof(verts), verts, GL_STATIC_DRAW); // Sends data to the GPU
-
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.vbos[1]); // Activates the buffer
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
-
-	// Strides between vertex coordinates
-	GLint stride = sizeof(float) * (floatsPerVertex + floatsPerNormal + floatsPerUV);
-
-	// Create Vertex Attribute Pointers
-	glVertexAttribPointer(0, floatsPerVertex, GL_FLOAT, GL_FALSE, stride, 0);
-	glEnableVertexAttribArray(0);
-
-	glVertexAttribPointer(1, floatsPerNormal, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(float) * floatsPerVertex));
-	glEnableVertexAttribArray(1);
-
-	glVertexAttribPointer(2, floatsPerUV, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(float) * (floatsPerVertex + floatsPerNormal)));
-	glEnableVertexAttribArray(2);
+	data.vertices.assign(std::begin(verts), std::end(verts));
+	data.indices.assign(std::begin(indices), std::end(indices));
+	data.parts[0] = { GL_TRIANGLES, 0, (GLuint)data.indices.size(), true };
+	data.nParts = 1;
+	data.nLods = 0;
 }
 
 ///////////////////////////////////////////////////
-//	UCreatePyramid3Mesh(GLMesh&)
+//	UGeneratePyramid3Mesh(MeshData&)
 //
-//	mesh: reference to mesh structure for storing data
+//	data: empty mesh data, filled with the mesh
 //
-//	Create a pyramid mesh and store it in a VAO/VBO
+//	Generate a pyramid mesh
 //
 //  Correct triangle drawing command:
 //
-//	glDrawArrays(GL_TRIANGLE_STRIP, 0, meshes.gPyramid3Mesh.nVertices);
+//	glDrawElements(GL_TRIANGLE_STRIP, meshes.gPyramid3Mesh.nIndices, meshes.gPyramid3Mesh.indexType, (void*)0);
 ///////////////////////////////////////////////////
-void Meshes::UCreatePyramid3Mesh(GLMesh& mesh)
+void Meshes::UGeneratePyramid3Mesh(MeshData& data) const
 {
 	// Vertex data
 	GLfloat verts[] = {
@@ -158,44 +1002,27 @@ void Meshes::UCreatePyramid3Mesh(GLMesh& mesh)
 		-0.5f, -0.5f, 0.5f,		0.0f, -1.0f, 0.0f,	0.0f, 1.0f,     //front bottom left
 	};
 
-	const GLuint floatsPerVertex = 3;	// Number of coordinates per vertex
-	const GLuint floatsPerColor = 3;	// Number of values per vertex color
-	const GLuint floatsPerUV = 2;		// Number of texture coordinate values
-
-	// Calculate total defined vertices
-	mesh.nVertices = sizeof(verts) / (sizeof(verts[0]) * (floatsPerVertex + floatsPerColor + floatsPerUV));
+	data.vertices.assign(std::begin(verts), std::end(verts));
+	data.parts[0] = { GL_TRIANGLE_STRIP, 0, (GLuint)(data.vertices.size() / 8), false };
+	data.nParts = 1;
+	data.nLods = 0;
 
-	glGenVertexArrays(1, &mesh.vao);			// Creates 1 VAO
-	glGenBuffers(1, mesh.vbos);					// Creates 1 VBO
-	glBindVertexArray(mesh.vao);				// Activates the VAO
-	glBindBuffer(GL_ARRAY_BUFFER, mesh.vbos[0]);	// Activates the VBO
-	// Sends vertex or coordinate data to the GPU
-	glBufferData(GL_ARRAY_BUFFER, sizeof(verts), verts, GL_STATIC_DRAW);
-
-	// Strides between sets of attribute data
-	GLint stride = sizeof(float) * (floatsPerVertex + floatsPerColor + floatsPerUV);
-
-	// Creates the Vertex Attribute Pointers
-	glVertexAttribPointer(0, floatsPerVertex, GL_FLOAT, GL_FALSE, stride, (void*)0);
-	glEnableVertexAttribArray(0);
-	glVertexAttribPointer(1, floatsPerColor, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(float) * floatsPerVertex));
-	glEnableVertexAttribArray(1);
-	glVertexAttribPointer(2, floatsPerUV, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(float) * (floatsPerVertex + floatsPerColor)));
-	glEnableVertexAttribArray(2);
+	// the strip repeats vertices to stitch its sides together
+	WeldVertices(data, "pyramid3");
 }
 
 ///////////////////////////////////////////////////
-//	UCreatePyramid4Mesh(GLMesh&)
+//	UGeneratePyramid4Mesh(MeshData&)
 //
-//	mesh: reference to mesh structure for storing data
+//	data: empty mesh data, filled with the mesh
 //
-//	Create a pyramid mesh and store it in a VAO/VBO
+//	Generate a pyramid mesh
 //
 //  Correct triangle drawing command:
 //
-//	glDrawArrays(GL_TRIANGLE_STRIP, 0, meshes.gPyramid4Mesh.nVertices);
+//	glDrawElements(GL_TRIANGLE_STRIP, meshes.gPyramid4Mesh.nIndices, meshes.gPyramid4Mesh.indexType, (void*)0);
 ///////////////////////////////////////////////////
-void Meshes::UCreatePyramid4Mesh(GLMesh& mesh)
+void Meshes::UGeneratePyramid4Mesh(MeshData& data) const
 {
 	// Vertex data
 	GLfloat verts[] = {
@@ -231,44 +1058,27 @@ void Meshes::UCreatePyramid4Mesh(GLMesh& mesh)
 		0.0f, 0.5f, 0.0f,		0.0f, 0.0f, 1.0f,	0.5f, 1.0f,		//top point
 	};
 
-	const GLuint floatsPerVertex = 3;	// Number of coordinates per vertex
-	const GLuint floatsPerColor = 3;	// Number of values per vertex color
-	const GLuint floatsPerUV = 2;		// Number of texture coordinate values
-
-	// Calculate total defined vertices
-	mesh.nVertices = sizeof(verts) / (sizeof(verts[0]) * (floatsPerVertex + floatsPerColor + floatsPerUV));
-
-	glGenVertexArrays(1, &mesh.vao);			// Creates 1 VAO
-	glGenBuffers(1, mesh.vbos);					// Creates 1 VBO
-	glBindVertexArray(mesh.vao);				// Activates the VAO
-	glBindBuffer(GL_ARRAY_BUFFER, mesh.vbos[0]);	// Activates the VBO
-	// Sends vertex or coordinate data to the GPU
-	glBufferData(GL_ARRAY_BUFFER, sizeof(verts), verts, GL_STATIC_DRAW);
+	data.vertices.assign(std::begin(verts), std::end(verts));
+	data.parts[0] = { GL_TRIANGLE_STRIP, 0, (GLuint)(data.vertices.size() / 8), false };
+	data.nParts = 1;
+	data.nLods = 0;
 
-	// Strides between sets of attribute data
-	GLint stride = sizeof(float) * (floatsPerVertex + floatsPerColor + floatsPerUV);
-
-	// Creates the Vertex Attribute Pointers
-	glVertexAttribPointer(0, floatsPerVertex, GL_FLOAT, GL_FALSE, stride, (void*)0);
-	glEnableVertexAttribArray(0);
-	glVertexAttribPointer(1, floatsPerColor, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(float) * floatsPerVertex));
-	glEnableVertexAttribArray(1);
-	glVertexAttribPointer(2, floatsPerUV, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(float) * (floatsPerVertex + floatsPerColor)));
-	glEnableVertexAttribArray(2);
+	// the strip repeats vertices to stitch its sides together
+	WeldVertices(data, "pyramid4");
 }
 
 ///////////////////////////////////////////////////
-//	UCreatePrismMesh(GLMesh&)
+//	UGeneratePrismMesh(MeshData&)
 //
-//	mesh: reference to mesh structure for storing data
+//	data: empty mesh data, filled with the mesh
 //
-//	Create a pyramid mesh and store it in a VAO/VBO
+//	Generate a pyramid mesh
 //
 //	Correct triangle drawing command:
 //
-//	glDrawArrays(GL_TRIANGLE_STRIP, 0, meshes.gPrismMesh.nVertices);
+//	glDrawElements(GL_TRIANGLE_STRIP, meshes.gPrismMesh.nIndices, meshes.gPrismMesh.indexType, (void*)0);
 ///////////////////////////////////////////////////
-void Meshes::UCreatePrismMesh(GLMesh& mesh)
+void Meshes::UGeneratePrismMesh(MeshData& data) const
 {
 	// Vertex data
 	GLfloat verts[] = {
@@ -319,46 +1129,27 @@ void Meshes::UCreatePrismMesh(GLMesh& mesh)
 
 	};
 
-	const GLuint floatsPerVertex = 3;
-	const GLuint floatsPerNormal = 3;
-	const GLuint floatsPerUV = 2;
-
-	mesh.nVertices = sizeof(verts) / (sizeof(verts[0]) * (floatsPerVertex + floatsPerNormal + floatsPerUV));
-
-	glGenVertexArrays(1, &mesh.vao); // we can also generate multiple VAOs or buffers at the same time
-	glBindVertexArray(mesh.vao);
-
-	// Create 2 buffers: first one for the vertex data; second one for the indices
-	glGenBuffers(1, mesh.vbos);
-	glBindBuffer(GL_ARRAY_BUFFER, mesh.vbos[0]); // Activates the buffer
-	glBufferData(GL_ARRAY_BUFFER, sizeof(verts), verts, GL_STATIC_DRAW); // Sends vertex or coordinate data to the GPU
+	data.vertices.assign(std::begin(verts), std::end(verts));
+	data.parts[0] = { GL_TRIANGLE_STRIP, 0, (GLuint)(data.vertices.size() / 8), false };
+	data.nParts = 1;
+	data.nLods = 0;
 
-	// Strides between vertex coordinates is 6 (x, y, z, r, g, b, a). A tightly packed stride is 0.
-	GLint stride = sizeof(float) * (floatsPerVertex + floatsPerNormal + floatsPerUV);// The number of floats before each
-
-	// Create Vertex Attribute Pointers
-	glVertexAttribPointer(0, floatsPerVertex, GL_FLOAT, GL_FALSE, stride, 0);
-	glEnableVertexAttribArray(0);
-
-	glVertexAttribPointer(1, floatsPerNormal, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(float) * floatsPerVertex));
-	glEnableVertexAttribArray(1);
-
-	glVertexAttribPointer(2, floatsPerUV, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(float) * (floatsPerVertex + floatsPerNormal)));
-	glEnableVertexAttribArray(2);
+	// the strip repeats vertices to stitch its sides together
+	WeldVertices(data, "prism");
 }
 
 ///////////////////////////////////////////////////
-//	UCreateBoxMesh(GLMesh&)
+//	UGenerateBoxMesh(MeshData&)
 //
-//	mesh: reference to mesh structure for storing data
+//	data: empty mesh data, filled with the mesh
 //
-//	Create a cube mesh and store it in a VAO/VBO
+//	Generate a cube mesh
 //
 //	Correct triangle drawing command:
 //
-//	glDrawElements(GL_TRIANGLES, meshes.gBoxMesh.nIndices, GL_UNSIGNED_INT, (void*)0);
+//	glDrawElements(GL_TRIANGLES, meshes.gBoxMesh.nIndices, meshes.gBoxMesh.indexType, (void*)0);
 ///////////////////////////////////////////////////
-void Meshes::UCreateBoxMesh(GLMesh& mesh)
+void Meshes::UGenerateBoxMesh(MeshData& data) const
 {
 	// Position and Color data
 	GLfloat verts[] = {
@@ -414,250 +1205,50 @@ void Meshes::UCreateBoxMesh(GLMesh& mesh)
        -0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f,  0.0f, 1.0f   //35
 	};
 
-	// Index data
-	GLuint indices[] = {
-		0,1,2,
-		0,3,2,
-		4,5,6,
-		4,7,6,
-		8,9,10,
-		8,11,10,
-		12,13,14,
-		12,15,14,
-		16,17,18,
-		16,19,18,
-		20,21,22,
-		20,23,22
-	};
-
-	const GLuint floatsPerVertex = 3;
-	const GLuint floatsPerNormal = 3;
-	const GLuint floatsPerUV = 2;
+	data.vertices.assign(std::begin(verts), std::end(verts));
 
-	mesh.nVertices = sizeof(verts) / (sizeof(verts[0]) * (floatsPerVertex + floatsPerNormal + floatsPerUV));
-	mesh.nIndices = sizeof(indices) / sizeof(indices[0]);
-
-	glGenVertexArrays(1, &mesh.vao); // we can also generate multiple VAOs or buffers at the same time
-	glBindVertexArray(mesh.vao);
-
-	// Create 2 buffers: first one for the vertex data; second one for the indices
-	glGenBuffers(2, mesh.vbos);
-	glBindBuffer(GL_ARRAY_BUFFER, mesh.vbos[0]); // Activates the buffer
-	glBufferData(GL_ARRAY_BUFFER, sizeof(verts), verts, GL_STATIC_DRAW); // Sends vertex or coordinate data to the GPU
-
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.vbos[1]); // Activates the buffer
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
-
-	// Strides between vertex coordinates is 6 (x, y, z, r, g, b, a). A tightly packed stride is 0.
-	GLint stride = sizeof(float) * (floatsPerVertex + floatsPerNormal + floatsPerUV);// The number of floats before each
-
-	// Create Vertex Attribute Pointers
-	glVertexAttribPointer(0, floatsPerVertex, GL_FLOAT, GL_FALSE, stride, 0);
-	glEnableVertexAttribArray(0);
-
-	glVertexAttribPointer(1, floatsPerNormal, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(float) * floatsPerVertex));
-	glEnableVertexAttribArray(1);
+	// one part per face (back, front, left, right, bottom, top) so faces can be textured separately
+	for (GLuint face = 0; face < 6; ++face)
+		data.parts[face] = { GL_TRIANGLES, face * 6, 6, false };
+	data.nParts = 6;
+	data.nLods = 0;
 
-	glVertexAttribPointer(2, floatsPerUV, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(float) * (floatsPerVertex + floatsPerNormal)));
-	glEnableVertexAttribArray(2);
+	// each face lists the two corners its triangles share twice
+	WeldVertices(data, "box");
 }
 
 ///////////////////////////////////////////////////
-//	UCreateConeMesh(GLMesh&)
+//	UGenerateConeMesh(MeshData&)
 //
-//	mesh: reference to mesh structure for storing data
+//	data: empty mesh data, filled with the mesh
 //
-//	Create a cone mesh and store it in a VAO/VBO
+//	Generate a cone mesh at gConeTessellation
 //
 //  Correct triangle drawing commands:
 //
-//	glDrawArrays(GL_TRIANGLE_FAN, 0, 36);		//bottom
-//	glDrawArrays(GL_TRIANGLE_STRIP, 36, 108);	//sides
+//	DrawMeshPart(meshes.gConeMesh, 0);	//bottom
+//	DrawMeshPart(meshes.gConeMesh, 1);	//sides
 ///////////////////////////////////////////////////
-void Meshes::UCreateConeMesh(GLMesh& mesh)
+void Meshes::UGenerateConeMesh(MeshData& data) const
 {
-	GLfloat verts[] = {
-		// cone bottom			// normals			// texture coords
-		1.0f, 0.0f, 0.0f,		0.0f, -1.0f, 0.0f,	0.5f,1.0f,
-		.98f, 0.0f, -0.17f,		0.0f, -1.0f, 0.0f,	0.41f, 0.983f,
-		.94f, 0.0f, -0.34f,		0.0f, -1.0f, 0.0f,	0.33f, 0.96f,
-		.87f, 0.0f, -0.5f,		0.0f, -1.0f, 0.0f,	0.25f, 0.92f,
-		.77f, 0.0f, -0.64f,		0.0f, -1.0f, 0.0f,	0.17f, 0.87f,
-		.64f, 0.0f, -0.77f,		0.0f, -1.0f, 0.0f,	0.13f, 0.83f,
-		.5f, 0.0f, -0.87f,		0.0f, -1.0f, 0.0f,	0.08f, 0.77f,
-		.34f, 0.0f, -0.94f,		0.0f, -1.0f, 0.0f,	0.04f, 0.68f,
-		.17f, 0.0f, -0.98f,		0.0f, -1.0f, 0.0f,	0.017f, 0.6f,
-		0.0f, 0.0f, -1.0f,		0.0f, -1.0f, 0.0f,	0.0f,0.5f,
-		-.17f, 0.0f, -0.98f,	0.0f, -1.0f, 0.0f,	0.017f, 0.41f,
-		-.34f, 0.0f, -0.94f,	0.0f, -1.0f, 0.0f,	0.04f, 0.33f,
-		-.5f, 0.0f, -0.87f,		0.0f, -1.0f, 0.0f,	0.08f, 0.25f,
-		-.64f, 0.0f, -0.77f,	0.0f, -1.0f, 0.0f,	0.13f, 0.17f,
-		-.77f, 0.0f, -0.64f,	0.0f, -1.0f, 0.0f,	0.17f, 0.13f,
-		-.87f, 0.0f, -0.5f,		0.0f, -1.0f, 0.0f,	0.25f, 0.08f,
-		-.94f, 0.0f, -0.34f,	0.0f, -1.0f, 0.0f,	0.33f, 0.04f,
-		-.98f, 0.0f, -0.17f,	0.0f, -1.0f, 0.0f,	0.41f, 0.017f,
-		-1.0f, 0.0f, 0.0f,		0.0f, -1.0f, 0.0f,	0.5f, 0.0f,
-		-.98f, 0.0f, 0.17f,		0.0f, -1.0f, 0.0f,	0.6f, 0.017f,
-		-.94f, 0.0f, 0.34f,		0.0f, -1.0f, 0.0f,	0.68f, 0.04f,
-		-.87f, 0.0f, 0.5f,		0.0f, -1.0f, 0.0f,	0.77f, 0.08f,
-		-.77f, 0.0f, 0.64f,		0.0f, -1.0f, 0.0f,	0.83f, 0.13f,
-		-.64f, 0.0f, 0.77f,		0.0f, -1.0f, 0.0f,	0.87f, 0.17f,
-		-.5f, 0.0f, 0.87f,		0.0f, -1.0f, 0.0f,	0.92f, 0.25f,
-		-.34f, 0.0f, 0.94f,		0.0f, -1.0f, 0.0f,	0.96f, 0.33f,
-		-.17f, 0.0f, 0.98f,		0.0f, -1.0f, 0.0f,	0.983f, 0.41f,
-		0.0f, 0.0f, 1.0f,		0.0f, -1.0f, 0.0f,	1.0f, 0.5f,
-		.17f, 0.0f, 0.98f,		0.0f, -1.0f, 0.0f,	0.983f, 0.6f,
-		.34f, 0.0f, 0.94f,		0.0f, -1.0f, 0.0f,	0.96f, 0.68f,
-		.5f, 0.0f, 0.87f,		0.0f, -1.0f, 0.0f,	0.92f, 0.77f,
-		.64f, 0.0f, 0.77f,		0.0f, -1.0f, 0.0f,	0.87f, 0.83f,
-		.77f, 0.0f, 0.64f,		0.0f, -1.0f, 0.0f,	0.83f, 0.87f,
-		.87f, 0.0f, 0.5f,		0.0f, -1.0f, 0.0f,	0.77f, 0.92f,
-		.94f, 0.0f, 0.34f,		0.0f, -1.0f, 0.0f,	0.68f, 0.96f,
-		.98f, 0.0f, 0.17f,		0.0f, -1.0f, 0.0f,	0.6f, 0.983f,
-
-		// cone sides		// normals									// texture coords
-		1.0f, 0.0f, 0.0f,		0.993150651f, 0.0f, 0.116841137f, 		0.0f,0.0f,
-		0.0f, 1.0f, 0.0f,		0.993150651f, 0.0f, 0.116841137f, 		0.5f, 1.0f,
-		.98f, 0.0f, -0.17f,		0.993150651f, 0.0f, 0.116841137f, 		0.0277,0.0,
-		.98f, 0.0f, -0.17f,		0.973417103f, 0.0f, 0.229039446f, 		0.0277,0.0,
-		0.0f, 1.0f, 0.0f,		0.973417103f, 0.0f, 0.229039446f, 		0.5f, 1.0f,
-		.94f, 0.0f, -0.34f,		0.973417103f, 0.0f, 0.229039446f, 		0.0554,0.0f,
-		.94f, 0.0f, -0.34f,		0.916157305f, 0.0f, 0.400818795f, 		0.0554,0.0f,
-		0.0f, 1.0f, 0.0f,		0.916157305f, 0.0f, 0.400818795f, 		0.5f, 1.0f,
-		.87f, 0.0f, -0.5f,		0.916157305f, 0.0f, 0.400818795f, 		0.0831,0.0f,
-		.87f, 0.0f, -0.5f,		0.813733339f, 0.0f, 0.581238329f, 		0.0831,0.0f,
-		0.0f, 1.0f, 0.0f,		0.813733339f, 0.0f, 0.581238329f, 		0.5f, 1.0f,
-		.77f, 0.0f, -0.64f,		0.813733339f, 0.0f, 0.581238329f, 		0.1108f, 0.0f,
-		.77f, 0.0f, -0.64f,		0.707106769f, 0.0f, 0.707106769f, 		0.1108f, 0.0f,
-		0.0f, 1.0f, 0.0f,		0.707106769f, 0.0f, 0.707106769f, 		0.5f, 1.0f,
-		.64f, 0.0f, -0.77f,		0.707106769f, 0.0f, 0.707106769f, 		0.1385f, 0.0f,
-		.64f, 0.0f, -0.77f,		0.581238329f, 0.0f, 0.813733339f, 		0.1385f, 0.0f,
-		0.0f, 1.0f, 0.0f,		0.581238329f, 0.0f, 0.813733339f, 		0.5f, 1.0f,
-		.5f, 0.0f, -0.87f,		0.581238329f, 0.0f, 0.813733339f, 		0.1662f, 0.0f,
-		.5f, 0.0f, -0.87f,		0.400818795f, 0.0f, 0.916157305f, 		0.1662f, 0.0f,
-		0.0f, 1.0f, 0.0f,		0.400818795f, 0.0f, 0.916157305f, 		0.5f, 1.0f,
-		.34f, 0.0f, -0.94f,		0.400818795f, 0.0f, 0.916157305f, 		0.1939f, 0.0f,
-		.34f, 0.0f, -0.94f,		0.229039446f, 0.0f, 0.973417103f, 		0.1939f, 0.0f,
-		0.0f, 1.0f, 0.0f,		0.229039446f, 0.0f, 0.973417103f, 		0.5f, 1.0f,
-		.17f, 0.0f, -0.98f,		0.229039446f, 0.0f, 0.973417103f, 		0.2216f, 0.0f,
-		.17f, 0.0f, -0.98f,		0.116841137f, 0.0f, 0.993150651f, 		0.2216f, 0.0f,
-		0.0f, 1.0f, 0.0f,		0.116841137f, 0.0f, 0.993150651f, 		0.5f, 1.0f,
-		0.0f, 0.0f, -1.0f,		0.116841137f, 0.0f, 0.993150651f, 		0.2493f, 0.0f,
-
-		0.0f, 0.0f, -1.0f,		-0.116841137f, 0.0f, 0.993150651f, 		0.2493f, 0.0f,
-		0.0f, 1.0f, 0.0f,		-0.116841137f, 0.0f, 0.993150651f, 		0.5f, 1.0f,
-		-.17f, 0.0f, -0.98f,	-0.116841137f, 0.0f, 0.993150651f, 		0.277f, 0.0f,
-		-.17f, 0.0f, -0.98f,	-0.229039446f, 0.0f, 0.973417103f, 		0.277f, 0.0f,
-		0.0f, 1.0f, 0.0f,		-0.229039446f, 0.0f, 0.973417103f, 		0.5f, 1.0f,
-		-.34f, 0.0f, -0.94f,	-0.229039446f, 0.0f, 0.973417103f, 		0.3047f, 0.0f,
-		-.34f, 0.0f, -0.94f,	-0.400818795f, 0.0f, 0.916157305f, 		0.3047f, 0.0f,
-		0.0f, 1.0f, 0.0f,		-0.400818795f, 0.0f, 0.916157305f, 		0.5f, 1.0f,
-		-.5f, 0.0f, -0.87f,		-0.400818795f, 0.0f, 0.916157305f, 		0.3324f, 0.0f,
-		-.5f, 0.0f, -0.87f,		-0.581238329f, 0.0f, 0.813733339f, 		0.3324f, 0.0f,
-		0.0f, 1.0f, 0.0f,		-0.581238329f, 0.0f, 0.813733339f, 		0.5f, 1.0f,
-		-.64f, 0.0f, -0.77f,	-0.581238329f, 0.0f, 0.813733339f, 		0.3601f, 0.0f,
-		-.64f, 0.0f, -0.77f,	-0.707106769f, 0.0f, 0.707106769f, 		0.3601f, 0.0f,
-		0.0f, 1.0f, 0.0f,		-0.707106769f, 0.0f, 0.707106769f, 		0.5f, 1.0f,
-		-.77f, 0.0f, -0.64f,	-0.707106769f, 0.0f, 0.707106769f, 		0.3878f, 0.0f,
-		-.77f, 0.0f, -0.64f,	-0.813733339f, 0.0f, 0.581238329f, 		0.3878f, 0.0f,
-		0.0f, 1.0f, 0.0f,		-0.813733339f, 0.0f, 0.581238329f, 		0.5f, 1.0f,
-		-.87f, 0.0f, -0.5f,		-0.813733339f, 0.0f, 0.581238329f, 		0.4155f, 0.0f,
-		-.87f, 0.0f, -0.5f,		-0.916157305f, 0.0f, 0.400818795f, 		0.4155f, 0.0f,
-		0.0f, 1.0f, 0.0f,		-0.916157305f, 0.0f, 0.400818795f, 		0.5f, 1.0f,
-		-.94f, 0.0f, -0.34f,	-0.916157305f, 0.0f, 0.400818795f, 		0.4432f, 0.0f,
-		-.94f, 0.0f, -0.34f,	-0.973417103f, 0.0f, 0.229039446f, 		0.4432f, 0.0f,
-		0.0f, 1.0f, 0.0f,		-0.973417103f, 0.0f, 0.229039446f, 		0.5f, 1.0f,
-		-.98f, 0.0f, -0.17f,	-0.973417103f, 0.0f, 0.229039446f, 		0.4709f, 0.0f,
-		-.98f, 0.0f, -0.17f,	-0.993150651f, 0.0f, 0.116841137f, 		0.4709f, 0.0f,
-		0.0f, 1.0f, 0.0f,		-0.993150651f, 0.0f, 0.116841137f, 		0.5f, 1.0f,
-		-1.0f, 0.0f, 0.0f,		-0.993150651f, 0.0f, 0.116841137f, 		0.4986f, 0.0f,
-		-1.0f, 0.0f, 0.0f,		-0.993150651f, 0.0f, -0.116841137f, 		0.4986f, 0.0f,
-		0.0f, 1.0f, 0.0f,		-0.993150651f, 0.0f, -0.116841137f, 		0.5f, 1.0f,
-		-.98f, 0.0f, 0.17f,		-0.993150651f, 0.0f, -0.116841137f, 		0.5263f, 0.0f,
-		-.98f, 0.0f, 0.17f,		-0.973417103f, 0.0f, -0.229039446f, 		0.5263f, 0.0f,
-		0.0f, 1.0f, 0.0f,		-0.973417103f, 0.0f, -0.229039446f, 		0.5f, 1.0f,
-		-.94f, 0.0f, 0.34f,		-0.973417103f, 0.0f, -0.229039446f, 		0.554f, 0.0f,
-		-.94f, 0.0f, 0.34f,		-0.916157305f, 0.0f, -0.400818795f, 		0.554f, 0.0f,
-		0.0f, 1.0f, 0.0f,		-0.916157305f, 0.0f, -0.400818795f, 		0.5f, 1.0f,
-		-.87f, 0.0f, 0.5f,		-0.916157305f, 0.0f, -0.400818795f, 		0.5817f, 0.0f,
-		-.87f, 0.0f, 0.5f,		-0.813733339f, 0.0f, -0.581238329f, 		0.5817f, 0.0f,
-		0.0f, 1.0f, 0.0f,		-0.813733339f, 0.0f, -0.581238329f, 		0.5f, 1.0f,
-		-.77f, 0.0f, 0.64f,		-0.813733339f, 0.0f, -0.581238329f, 		0.6094f, 0.0f,
-		-.77f, 0.0f, 0.64f,		-0.707106769f, 0.0f, -0.707106769f, 		0.6094f, 0.0f,
-		0.0f, 1.0f, 0.0f,		-0.707106769f, 0.0f, -0.707106769f, 		0.5f, 1.0f,
-		-.64f, 0.0f, 0.77f,		-0.707106769f, 0.0f, -0.707106769f, 		0.6371f, 0.0f,
-		-.64f, 0.0f, 0.77f,		-0.581238329f, 0.0f, -0.813733339f, 		0.6371f, 0.0f,
-		0.0f, 1.0f, 0.0f,		-0.581238329f, 0.0f, -0.813733339f, 		0.5f, 1.0f,
-		-.5f, 0.0f, 0.87f,		-0.581238329f, 0.0f, -0.813733339f, 		0.6648f, 0.0f,
-		-.5f, 0.0f, 0.87f,		-0.400818795f, 0.0f, -0.916157305f, 		0.6648f, 0.0f,
-		0.0f, 1.0f, 0.0f,		-0.400818795f, 0.0f, -0.916157305f, 		0.5f, 1.0f,
-		-.34f, 0.0f, 0.94f,		-0.400818795f, 0.0f, -0.916157305f, 		0.6925f, 0.0f,
-		-.34f, 0.0f, 0.94f,		-0.229039446f, 0.0f, -0.973417103f, 		0.6925f, 0.0f,
-		0.0f, 1.0f, 0.0f,		-0.229039446f, 0.0f, -0.973417103f, 		0.5f, 1.0f,
-		-.17f, 0.0f, 0.98f,		-0.229039446f, 0.0f, -0.973417103f, 		0.7202f, 0.0f,
-		-.17f, 0.0f, 0.98f,		-0.116841137f, 0.0f, -0.993150651f, 		0.7202f, 0.0f,
-		0.0f, 1.0f, 0.0f,		-0.116841137f, 0.0f, -0.993150651f, 		0.5f, 1.0f,
-		0.0f, 0.0f, 1.0f,		-0.116841137f, 0.0f, -0.993150651f, 		0.7479f, 0.0f,
-
-		0.0f, 0.0f, 1.0f,		0.116841137f, 0.0f, -0.993150651f, 	0.7479f, 0.0f,
-		0.0f, 1.0f, 0.0f,		0.116841137f, 0.0f, -0.993150651f, 	0.5f, 1.0f,
-		.17f, 0.0f, 0.98f,		0.116841137f, 0.0f, -0.993150651f, 	0.7756f, 0.0f,
-		.17f, 0.0f, 0.98f,		0.229039446f, 0.0f, -0.973417103f, 	0.7756f, 0.0f,
-		0.0f, 1.0f, 0.0f,		0.229039446f, 0.0f, -0.973417103f, 	0.5f, 1.0f,
-		.34f, 0.0f, 0.94f,		0.229039446f, 0.0f, -0.973417103f, 	0.8033f, 0.0f,
-		.34f, 0.0f, 0.94f,		0.400818795f, 0.0f, -0.916157305f, 	0.8033f, 0.0f,
-		0.0f, 1.0f, 0.0f,		0.400818795f, 0.0f, -0.916157305f, 	0.5f, 1.0f,
-		.5f, 0.0f, 0.87f,		0.400818795f, 0.0f, -0.916157305f, 	0.831f, 0.0f,
-		.5f, 0.0f, 0.87f,		0.581238329f, 0.0f, -0.813733339f, 	0.831f, 0.0f,
-		0.0f, 1.0f, 0.0f,		0.581238329f, 0.0f, -0.813733339f, 	0.5f, 1.0f,
-		.64f, 0.0f, 0.77f,		0.581238329f, 0.0f, -0.813733339f, 	0.8587f, 0.0f,
-		.64f, 0.0f, 0.77f,		0.707106769f, 0.0f, -0.707106769f, 	0.8587f, 0.0f,
-		0.0f, 1.0f, 0.0f,		0.707106769f, 0.0f, -0.707106769f, 	0.5f, 1.0f,
-		.77f, 0.0f, 0.64f,		0.707106769f, 0.0f, -0.707106769f, 	0.8864f, 0.0f,
-		.77f, 0.0f, 0.64f,		0.813733339f, 0.0f, -0.581238329f, 	0.8864f, 0.0f,
-		0.0f, 1.0f, 0.0f,		0.813733339f, 0.0f, -0.581238329f, 	0.5f, 1.0f,
-		.87f, 0.0f, 0.5f,		0.813733339f, 0.0f, -0.581238329f, 	0.9141f, 0.0f,
-		.87f, 0.0f, 0.5f,		0.916157305f, 0.0f, -0.400818795f, 	0.9141f, 0.0f,
-		0.0f, 1.0f, 0.0f,		0.916157305f, 0.0f, -0.400818795f, 	0.5f, 1.0f,
-		.94f, 0.0f, 0.34f,		0.916157305f, 0.0f, -0.400818795f, 	0.9418f, 0.0f,
-		.94f, 0.0f, 0.34f,		0.973417103f, 0.0f, -0.229039446f, 	0.9418f, 0.0f,
-		0.0f, 1.0f, 0.0f,		0.973417103f, 0.0f, -0.229039446f, 	0.5f, 1.0f,
-		.98f, 0.0f, 0.17f,		0.973417103f, 0.0f, -0.229039446f, 	0.9695f, 0.0f,
-		.98f, 0.0f, 0.17f,		0.993150651f, 0.0f, -0.116841137f, 	0.9695f, 0.0f,
-		0.0f, 1.0f, 0.0f,		0.993150651f, 0.0f, -0.116841137f, 	0.5f, 1.0f,
-		1.0f, 0.0f, 0.0f,		0.993150651f, 0.0f, -0.116841137f, 	0.0f, 0.0f
-	};
-
-	// total float values per each type
-	const GLuint floatsPerVertex = 3;
-	const GLuint floatsPerNormal = 3;
-	const GLuint floatsPerUV = 2;
-
-	// store vertex and index count
-	mesh.nVertices = sizeof(verts) / (sizeof(verts[0]) * (floatsPerVertex + floatsPerNormal + floatsPerUV));
-	mesh.nIndices = 0;
-
-	// Create VAO
-	glGenVertexArrays(1, &mesh.vao); // we can also generate multiple VAOs or buffers at the same time
-	glBindVertexArray(mesh.vao);
-
-	// Create VBO
-	glGenBuffers(1, mesh.vbos);
-	glBindBuffer(GL_ARRAY_BUFFER, mesh.vbos[0]); // Activates the buffer
-	glBufferData(GL_ARRAY_BUFFER, sizeof(verts), verts, GL_STATIC_DRAW); // Sends vertex or coordinate data to the GPU
-
-	// Strides between vertex coordinates
-	GLint stride = sizeof(float) * (floatsPerVertex + floatsPerNormal + floatsPerUV);
-
-	// Create Vertex Attribute Pointers
-	glVertexAttribPointer(0, floatsPerVertex, GL_FLOAT, GL_FALSE, stride, (void*)0);
-	glEnableVertexAttribArray(0);
-
-	glVertexAttribPointer(1, floatsPerNormal, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(float) * (floatsPerVertex)));
-	glEnableVertexAttribArray(1);
+	GenerateCone(data, gConeTessellation.segments, gConeTessellation.rings);
+	BuildLods(data, "cone");
+	OptimizeMesh(data, "cone");
+}
 
-	glVertexAttribPointer(2, floatsPerUV, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(float) * (floatsPerVertex + floatsPerNormal)));
-	glEnableVertexAttribArray(2);
+///////////////////////////////////////////////////
+//	GenerateCone(MeshData&, GLuint, GLuint)
+//
+//	data: filled with the generated mesh
+//	segments: divisions around the axis
+//	rings: divisions from the base to the apex
+//
+//	The apex is one vertex per segment so that each
+//	side keeps its own normal there
+///////////////////////////////////////////////////
+void Meshes::GenerateCone(MeshData& data, GLuint segments, GLuint rings)
+{
+	GenerateFrustum(data, segments, rings, 0.0f);
 }
 
 void Meshes::CalculateTriangleNormal(glm::vec3 p0, glm::vec3 p1, glm::vec3 p2)
@@ -687,1850 +1278,442 @@ void Meshes::CalculateTriangleNormal(glm::vec3 p0, glm::vec3 p1, glm::vec3 p2)
 }
 
 ///////////////////////////////////////////////////
-//	UCreateCylinderMesh(GLMesh&)
+//	UGenerateCylinderMesh(MeshData&)
 //
-//	mesh: reference to mesh structure for storing data
+//	data: empty mesh data, filled with the mesh
 //
-//	Create a cylinder mesh and store it in a VAO/VBO
+//	Generate a cylinder mesh at
+//	gCylinderTessellation
 //
 //  Correct triangle drawing commands:
 //
-//	glDrawArrays(GL_TRIANGLE_FAN, 0, 36);		//bottom
-//	glDrawArrays(GL_TRIANGLE_FAN, 36, 36);		//top
-//	glDrawArrays(GL_TRIANGLE_STRIP, 72, 146);	//sides
+//	DrawMeshPart(meshes.gCylinderMesh, 0);	//bottom
+//	DrawMeshPart(meshes.gCylinderMesh, 1);	//top
+//	DrawMeshPart(meshes.gCylinderMesh, 2);	//sides
 ///////////////////////////////////////////////////
-void Meshes::UCreateCylinderMesh(GLMesh& mesh)
+void Meshes::UGenerateCylinderMesh(MeshData& data) const
 {
-	GLfloat verts[] = {
-		// cylinder bottom		// normals			// texture coords
-		1.0f, 0.0f, 0.0f,		0.0f, -1.0f, 0.0f,	0.5f,1.0f,
-		.98f, 0.0f, -0.17f,		0.0f, -1.0f, 0.0f,	0.41f, 0.983f,
-		.94f, 0.0f, -0.34f,		0.0f, -1.0f, 0.0f,	0.33f, 0.96f,
-		.87f, 0.0f, -0.5f,		0.0f, -1.0f, 0.0f,	0.25f, 0.92f,
-		.77f, 0.0f, -0.64f,		0.0f, -1.0f, 0.0f,	0.17f, 0.87f,
-		.64f, 0.0f, -0.77f,		0.0f, -1.0f, 0.0f,	0.13f, 0.83f,
-		.5f, 0.0f, -0.87f,		0.0f, -1.0f, 0.0f,	0.08f, 0.77f,
-		.34f, 0.0f, -0.94f,		0.0f, -1.0f, 0.0f,	0.04f, 0.68f,
-		.17f, 0.0f, -0.98f,		0.0f, -1.0f, 0.0f,	0.017f, 0.6f,
-		0.0f, 0.0f, -1.0f,		0.0f, -1.0f, 0.0f,	0.0f,0.5f,
-		-.17f, 0.0f, -0.98f,	0.0f, -1.0f, 0.0f,	0.017f, 0.41f,
-		-.34f, 0.0f, -0.94f,	0.0f, -1.0f, 0.0f,	0.04f, 0.33f,
-		-.5f, 0.0f, -0.87f,		0.0f, -1.0f, 0.0f,	0.08f, 0.25f,
-		-.64f, 0.0f, -0.77f,	0.0f, -1.0f, 0.0f,	0.13f, 0.17f,
-		-.77f, 0.0f, -0.64f,	0.0f, -1.0f, 0.0f,	0.17f, 0.13f,
-		-.87f, 0.0f, -0.5f,		0.0f, -1.0f, 0.0f,	0.25f, 0.08f,
-		-.94f, 0.0f, -0.34f,	0.0f, -1.0f, 0.0f,	0.33f, 0.04f,
-		-.98f, 0.0f, -0.17f,	0.0f, -1.0f, 0.0f,	0.41f, 0.017f,
-		-1.0f, 0.0f, 0.0f,		0.0f, -1.0f, 0.0f,	0.5f, 0.0f,
-		-.98f, 0.0f, 0.17f,		0.0f, -1.0f, 0.0f,	0.6f, 0.017f,
-		-.94f, 0.0f, 0.34f,		0.0f, -1.0f, 0.0f,	0.68f, 0.04f,
-		-.87f, 0.0f, 0.5f,		0.0f, -1.0f, 0.0f,	0.77f, 0.08f,
-		-.77f, 0.0f, 0.64f,		0.0f, -1.0f, 0.0f,	0.83f, 0.13f,
-		-.64f, 0.0f, 0.77f,		0.0f, -1.0f, 0.0f,	0.87f, 0.17f,
-		-.5f, 0.0f, 0.87f,		0.0f, -1.0f, 0.0f,	0.92f, 0.25f,
-		-.34f, 0.0f, 0.94f,		0.0f, -1.0f, 0.0f,	0.96f, 0.33f,
-		-.17f, 0.0f, 0.98f,		0.0f, -1.0f, 0.0f,	0.983f, 0.41f,
-		0.0f, 0.0f, 1.0f,		0.0f, -1.0f, 0.0f,	1.0f, 0.5f,
-		.17f, 0.0f, 0.98f,		0.0f, -1.0f, 0.0f,	0.983f, 0.6f,
-		.34f, 0.0f, 0.94f,		0.0f, -1.0f, 0.0f,	0.96f, 0.68f,
-		.5f, 0.0f, 0.87f,		0.0f, -1.0f, 0.0f,	0.92f, 0.77f,
-		.64f, 0.0f, 0.77f,		0.0f, -1.0f, 0.0f,	0.87f, 0.83f,
-		.77f, 0.0f, 0.64f,		0.0f, -1.0f, 0.0f,	0.83f, 0.87f,
-		.87f, 0.0f, 0.5f,		0.0f, -1.0f, 0.0f,	0.77f, 0.92f,
-		.94f, 0.0f, 0.34f,		0.0f, -1.0f, 0.0f,	0.68f, 0.96f,
-		.98f, 0.0f, 0.17f,		0.0f, -1.0f, 0.0f,	0.6f, 0.983f,
-
-		// cylinder top			// normals			// texture coords
-		1.0f, 1.0f, 0.0f,		0.0f, 1.0f, 0.0f,	0.5f,1.0f,
-		.98f, 1.0f, -0.17f,		0.0f, 1.0f, 0.0f,	0.41f, 0.983f,
-		.94f, 1.0f, -0.34f,		0.0f, 1.0f, 0.0f,	0.33f, 0.96f,
-		.87f, 1.0f, -0.5f,		0.0f, 1.0f, 0.0f,	0.25f, 0.92f,
-		.77f, 1.0f, -0.64f,		0.0f, 1.0f, 0.0f,	0.17f, 0.87f,
-		.64f, 1.0f, -0.77f,		0.0f, 1.0f, 0.0f,	0.13f, 0.83f,
-		.5f, 1.0f, -0.87f,		0.0f, 1.0f, 0.0f,	0.08f, 0.77f,
-		.34f, 1.0f, -0.94f,		0.0f, 1.0f, 0.0f,	0.04f, 0.68f,
-		.17f, 1.0f, -0.98f,		0.0f, 1.0f, 0.0f,	0.017f, 0.6f,
-		0.0f, 1.0f, -1.0f,		0.0f, 1.0f, 0.0f,	0.0f,0.5f,
-		-.17f, 1.0f, -0.98f,	0.0f, 1.0f, 0.0f,	0.017f, 0.41f,
-		-.34f, 1.0f, -0.94f,	0.0f, 1.0f, 0.0f,	0.04f, 0.33f,
-		-.5f, 1.0f, -0.87f,		0.0f, 1.0f, 0.0f,	0.08f, 0.25f,
-		-.64f, 1.0f, -0.77f,	0.0f, 1.0f, 0.0f,	0.13f, 0.17f,
-		-.77f, 1.0f, -0.64f,	0.0f, 1.0f, 0.0f,	0.17f, 0.13f,
-		-.87f, 1.0f, -0.5f,		0.0f, 1.0f, 0.0f,	0.25f, 0.08f,
-		-.94f, 1.0f, -0.34f,	0.0f, 1.0f, 0.0f,	0.33f, 0.04f,
-		-.98f, 1.0f, -0.17f,	0.0f, 1.0f, 0.0f,	0.41f, 0.017f,
-		-1.0f, 1.0f, 0.0f,		0.0f, 1.0f, 0.0f,	0.5f, 0.0f,
-		-.98f, 1.0f, 0.17f,		0.0f, 1.0f, 0.0f,	0.6f, 0.017f,
-		-.94f, 1.0f, 0.34f,		0.0f, 1.0f, 0.0f,	0.68f, 0.04f,
-		-.87f, 1.0f, 0.5f,		0.0f, 1.0f, 0.0f,	0.77f, 0.08f,
-		-.77f, 1.0f, 0.64f,		0.0f, 1.0f, 0.0f,	0.83f, 0.13f,
-		-.64f, 1.0f, 0.77f,		0.0f, 1.0f, 0.0f,	0.87f, 0.17f,
-		-.5f, 1.0f, 0.87f,		0.0f, 1.0f, 0.0f,	0.92f, 0.25f,
-		-.34f, 1.0f, 0.94f,		0.0f, 1.0f, 0.0f,	0.96f, 0.33f,
-		-.17f, 1.0f, 0.98f,		0.0f, 1.0f, 0.0f,	0.983f, 0.41f,
-		0.0f, 1.0f, 1.0f,		0.0f, 1.0f, 0.0f,	1.0f, 0.5f,
-		.17f, 1.0f, 0.98f,		0.0f, 1.0f, 0.0f,	0.983f, 0.6f,
-		.34f, 1.0f, 0.94f,		0.0f, 1.0f, 0.0f,	0.96f, 0.68f,
-		.5f, 1.0f, 0.87f,		0.0f, 1.0f, 0.0f,	0.92f, 0.77f,
-		.64f, 1.0f, 0.77f,		0.0f, 1.0f, 0.0f,	0.87f, 0.83f,
-		.77f, 1.0f, 0.64f,		0.0f, 1.0f, 0.0f,	0.83f, 0.87f,
-		.87f, 1.0f, 0.5f,		0.0f, 1.0f, 0.0f,	0.77f, 0.92f,
-		.94f, 1.0f, 0.34f,		0.0f, 1.0f, 0.0f,	0.68f, 0.96f,
-		.98f, 1.0f, 0.17f,		0.0f, 1.0f, 0.0f,	0.6f, 0.983f,
-
-		// cylinder body		// normals				// texture coords
-		1.0f, 1.0f, 0.0f,		1.0f, 0.0f, 0.0f,		0.0,1.0,
-		1.0f, 0.0f, 0.0f,		1.0f, 0.0f, 0.0f,		0.0,0.0,
-		.98f, 0.0f, -0.17f,		1.0f, 0.0f, 0.0f,		0.0277,0.0,
-		1.0f, 1.0f, 0.0f,		0.92f, 0.0f, -0.08f,	0.0,1.0,
-		.98f, 1.0f, -0.17f,		0.92f, 0.0f, -0.08f,	0.0277,1.0,
-		.98f, 0.0f, -0.17f,		0.92f, 0.0f, -0.08f,	0.0277,0.0,
-		.94f, 0.0f, -0.34f,		0.83f, 0.0f, -0.17f,	0.0554,0.0,
-		.98f, 1.0f, -0.17f,		0.83f, 0.0f, -0.17f,	0.0277,1.0,
-		.94f, 1.0f, -0.34f,		0.83f, 0.0f, -0.17f,	0.0554,1.0,
-		.94f, 0.0f, -0.34f,		0.75f, 0.0f, -0.25f,	0.0554,0.0,
-		.87f, 0.0f, -0.5f,		0.75f, 0.0f, -0.25f,	0.0831,0.0,
-		.94f, 1.0f, -0.34f,		0.75f, 0.0f, -0.25f,	0.0554,1.0,
-		.87f, 1.0f, -0.5f,		0.67f, 0.0f, -0.33f,	0.0831,1.0,
-		.87f, 0.0f, -0.5f,		0.67f, 0.0f, -0.33f,	0.0831,0.0,
-		.77f, 0.0f, -0.64f,		0.67f, 0.0f, -0.33f,	0.1108,0.0,
-		.87f, 1.0f, -0.5f,		0.58f, 0.0f, -0.42f,	0.0831,1.0,
-		.77f, 1.0f, -0.64f,		0.58f, 0.0f, -0.42f,	0.1108,1.0,
-		.77f, 0.0f, -0.64f,		0.58f, 0.0f, -0.42f,	0.1108,0.0,
-		.64f, 0.0f, -0.77f,		0.5f, 0.0f, -0.5f,		0.1385,0.0,
-		.77f, 1.0f, -0.64f,		0.5f, 0.0f, -0.5f,		0.1108,1.0,
-		.64f, 1.0f, -0.77f,		0.5f, 0.0f, -0.5f,		0.1385,1.0,
-		.64f, 0.0f, -0.77f,		0.42f, 0.0f, -0.58f,	0.1385,0.0,
-		.5f, 0.0f, -0.87f,		0.42f, 0.0f, -0.58f,	0.1662,0.0,
-		.64f, 1.0f, -0.77f,		0.42f, 0.0f, -0.58f,	0.1385, 1.0,
-		.5f, 1.0f, -0.87f,		0.33f, 0.0f, -0.67f,	0.1662, 1.0,
-		.5f, 0.0f, -0.87f,		0.33f, 0.0f, -0.67f,	0.1662, 0.0,
-		.34f, 0.0f, -0.94f,		0.33f, 0.0f, -0.67f,	0.1939, 0.0,
-		.5f, 1.0f, -0.87f,		0.25f, 0.0f, -0.75f,	0.1662, 1.0,
-		.34f, 1.0f, -0.94f,		0.25f, 0.0f, -0.75f,	0.1939, 1.0,
-		.34f, 0.0f, -0.94f,		0.25f, 0.0f, -0.75f,	0.1939, 0.0,
-		.17f, 0.0f, -0.98f,		0.17f, 0.0f, -0.83f,	0.2216, 0.0,
-		.34f, 1.0f, -0.94f,		0.17f, 0.0f, -0.83f,	0.1939, 1.0,
-		.17f, 1.0f, -0.98f,		0.17f, 0.0f, -0.83f,	0.2216, 1.0,
-		.17f, 0.0f, -0.98f,		0.08f, 0.0f, -0.92f,	0.2216, 0.0,
-		0.0f, 0.0f, -1.0f,		0.08f, 0.0f, -0.92f,	0.2493, 0.0,
-		.17f, 1.0f, -0.98f,		0.08f, 0.0f, -0.92f,	0.2216, 1.0,
-		0.0f, 1.0f, -1.0f,		0.0f, 0.0f, -1.0f,		0.2493, 1.0,
-		0.0f, 0.0f, -1.0f,		0.0f, 0.0f, -1.0f,		0.2493, 0.0,
-		-.17f, 0.0f, -0.98f,	0.0f, 0.0f, -1.0f,		0.277, 0.0,
-		0.0f, 1.0f, -1.0f,		0.08f, 0.0f, -1.08f,	0.2493, 1.0,
-		-.17f, 1.0f, -0.98f,	-0.08f, 0.0f, -0.92f,	0.277, 1.0,
-		-.17f, 0.0f, -0.98f,	-0.08f, 0.0f, -0.92f,	0.277, 0.0,
-		-.34f, 0.0f, -0.94f,	-0.08f, 0.0f, -0.92f,	0.3047, 0.0,
-		-.17f, 1.0f, -0.98f,	-0.08f, 0.0f, -0.92f,	0.277, 1.0,
-		-.34f, 1.0f, -0.94f,	-0.17f, 0.0f, -0.83f,	0.3047, 1.0,
-		-.34f, 0.0f, -0.94f,	-0.17f, 0.0f, -0.83f,	0.3047, 0.0,
-		-.5f, 0.0f, -0.87f,		-0.17f, 0.0f, -0.83f,	0.3324, 0.0,
-		-.34f, 1.0f, -0.94f,	-0.25f, 0.0f, -0.75f,	0.3047, 1.0,
-		-.5f, 1.0f, -0.87f,		-0.25f, 0.0f, -0.75f,	0.3324, 1.0,
-		-.5f, 0.0f, -0.87f,		-0.25f, 0.0f, -0.75f,	0.3324, 0.0,
-		-.64f, 0.0f, -0.77f,	-0.33f, 0.0f, -0.67f,	0.3601, 0.0,
-		-.5f, 1.0f, -0.87f,		-0.33f, 0.0f, -0.67f,	0.3324, 1.0,
-		-.64f, 1.0f, -0.77f,	-0.33f, 0.0f, -0.67f,	0.3601, 1.0,
-		-.64f, 0.0f, -0.77f,	-0.42f, 0.0f, -0.58f,	0.3601, 0.0,
-		-.77f, 0.0f, -0.64f,	-0.42f, 0.0f, -0.58f,	0.3878, 0.0,
-		-.64f, 1.0f, -0.77f,	-0.42f, 0.0f, -0.58f,	0.3601, 1.0,
-		-.77f, 1.0f, -0.64f,	-0.5f, 0.0f, -0.5f,		0.3878, 1.0,
-		-.77f, 0.0f, -0.64f,	-0.5f, 0.0f, -0.5f,		0.3878, 0.0,
-		-.87f, 0.0f, -0.5f,		-0.5f, 0.0f, -0.5f,		0.4155, 0.0,
-		-.77f, 1.0f, -0.64f,	-0.58f, 0.0f, -0.42f,	0.3878, 1.0,
-		-.87f, 1.0f, -0.5f,		-0.58f, 0.0f, -0.42f,	0.4155, 1.0,
-		-.87f, 0.0f, -0.5f,		-0.58f, 0.0f, -0.42f,	0.4155, 0.0,
-		-.94f, 0.0f, -0.34f,	-0.67f, 0.0f, -0.33f,	0.4432, 0.0,
-		-.87f, 1.0f, -0.5f,		-0.67f, 0.0f, -0.33f,	0.4155, 1.0,
-		-.94f, 1.0f, -0.34f,	-0.67f, 0.0f, -0.33f,	0.4432, 1.0,
-		-.94f, 0.0f, -0.34f,	-0.75f, 0.0f, -0.25f,	0.4432, 0.0,
-		-.98f, 0.0f, -0.17f,	-0.75f, 0.0f, -0.25f,	0.4709, 0.0,
-		-.94f, 1.0f, -0.34f,	-0.75f, 0.0f, -0.25f,	0.4432, 1.0,
-		-.98f, 1.0f, -0.17f,	-0.83f, 0.0f, -0.17f,	0.4709, 1.0,
-		-.98f, 0.0f, -0.17f,	-0.83f, 0.0f, -0.17f,	0.4709, 0.0,
-		-1.0f, 0.0f, 0.0f,		-0.83f, 0.0f, -0.17f,	0.4986, 0.0,
-		-.98f, 1.0f, -0.17f,	-0.92f, 0.0f, -0.08f,	0.4709, 1.0,
-		-1.0f, 1.0f, 0.0f,		-0.92f, 0.0f, -0.08f,	0.4986, 1.0,
-		-1.0f, 0.0f, 0.0f,		-0.92f, 0.0f, -0.08f,	0.4986, 0.0,
-		-.98f, 0.0f, 0.17f,		-1.0f, 0.0f, 0.0f,		0.5263, 0.0,
-		-1.0f, 1.0f, 0.0f,		-1.0f, 0.0f, 0.0f,		0.4986, 1.0,
-		-.98f, 1.0f, 0.17f,		-1.0f, 0.0f, 0.0f,		0.5263, 1.0,
-		-.98f, 0.0f, 0.17f,		-0.92f, 0.0f, 0.08f,	0.5263, 0.0,
-		-.94f, 0.0f, 0.34f,		-0.92f, 0.0f, 0.08f,	0.554, 0.0,
-		-.98f, 1.0f, 0.17f,		-0.92f, 0.0f, 0.08f,	0.5263, 1.0,
-		-.94f, 1.0f, 0.34f,		-0.83f, 0.0f, 0.17f,	0.554, 1.0,
-		-.94f, 0.0f, 0.34f,		-0.83f, 0.0f, 0.17f,	0.554, 0.0,
-		-.87f, 0.0f, 0.5f,		-0.83f, 0.0f, 0.17f,	0.5817, 0.0,
-		-.94f, 1.0f, 0.34f,		-0.75f, 0.0f, 0.25f,	0.554, 1.0,
-		-.87f, 1.0f, 0.5f,		-0.75f, 0.0f, 0.25f,	0.5817, 1.0,
-		-.87f, 0.0f, 0.5f,		-0.75f, 0.0f, 0.25f,	0.5817, 0.0,
-		-.77f, 0.0f, 0.64f,		-0.67f, 0.0f, 0.33f,	0.6094, 0.0,
-		-.87f, 1.0f, 0.5f,		-0.67f, 0.0f, 0.33f,	0.5817, 1.0,
-		-.77f, 1.0f, 0.64f,		-0.67f, 0.0f, 0.33f,	0.6094, 1.0,
-		-.77f, 0.0f, 0.64f,		-0.58f, 0.0f, 0.42f,	0.6094, 0.0,
-		-.64f, 0.0f, 0.77f,		-0.58f, 0.0f, 0.42f,	0.6371, 0.0,
-		-.77f, 1.0f, 0.64f,		-0.58f, 0.0f, 0.42f,	0.6094, 1.0,
-		-.64f, 1.0f, 0.77f,		-0.5f, 0.0f, 0.5f,		0.6371, 1.0,
-		-.64f, 0.0f, 0.77f,		-0.5f, 0.0f, 0.5f,		0.6371, 0.0,
-		-.5f, 0.0f, 0.87f,		-0.5f, 0.0f, 0.5f,		0.6648, 0.0,
-		-.64f, 1.0f, 0.77f,		-0.42f, 0.0f, 0.58f,	0.6371, 1.0,
-		-.5f, 1.0f, 0.87f,		-0.42f, 0.0f, 0.58f,	0.6648, 1.0,
-		-.5f, 0.0f, 0.87f,		-0.42f, 0.0f, 0.58f,	0.6648, 0.0,
-		-.34f, 0.0f, 0.94f,		-0.33f, 0.0f, 0.67f,	0.6925, 0.0,
-		-.5f, 1.0f, 0.87f,		-0.33f, 0.0f, 0.67f,	0.6648, 1.0,
-		-.34f, 1.0f, 0.94f,		-0.33f, 0.0f, 0.67f,	0.6925, 1.0,
-		-.34f, 0.0f, 0.94f,		-0.25f, 0.0f, 0.75f,	0.6925, 0.0,
-		-.17f, 0.0f, 0.98f,		-0.25f, 0.0f, 0.75f,	0.7202, 0.0,
-		-.34f, 1.0f, 0.94f,		-0.25f, 0.0f, 0.75f,	0.6925, 1.0,
-		-.17f, 1.0f, 0.98f,		-0.17f, 0.0f, 0.83f,	0.7202, 1.0,
-		-.17f, 0.0f, 0.98f,		-0.17f, 0.0f, 0.83f,	0.7202, 0.0,
-		0.0f, 0.0f, 1.0f,		-0.17f, 0.0f, 0.83f,	0.7479, 0.0,
-		-.17f, 1.0f, 0.98f,		-0.08f, 0.0f, 0.92f,	0.7202, 1.0,
-		0.0f, 1.0f, 1.0f,		-0.08f, 0.0f, 0.92f,	0.7479, 1.0,
-		0.0f, 0.0f, 1.0f,		-0.08f, 0.0f, 0.92f,	0.7479, 0.0,
-		.17f, 0.0f, 0.98f,		-0.0f, 0.0f, 1.0f,		0.7756, 0.0,
-		0.0f, 1.0f, 1.0f,		-0.0f, 0.0f, 1.0f,		0.7479, 1.0,
-		.17f, 1.0f, 0.98f,		-0.0f, 0.0f, 1.0f,		0.7756, 1.0,
-		.17f, 0.0f, 0.98f,		0.08f, 0.0f, 0.92f,		0.7756, 0.0,
-		.34f, 0.0f, 0.94f,		0.08f, 0.0f, 0.92f,		0.8033, 0.0,
-		.17f, 1.0f, 0.98f,		0.08f, 0.0f, 0.92f,		0.7756, 1.0,
-		.34f, 1.0f, 0.94f,		0.17f, 0.0f, 0.83f,		0.8033, 1.0,
-		.34f, 0.0f, 0.94f,		0.17f, 0.0f, 0.83f,		0.8033, 0.0,
-		.5f, 0.0f, 0.87f,		0.17f, 0.0f, 0.83f,		0.831, 0.0,
-		.34f, 1.0f, 0.94f,		0.25f, 0.0f, 0.75f,		0.8033, 1.0,
-		.5f, 1.0f, 0.87f,		0.25f, 0.0f, 0.75f,		0.831, 1.0,
-		.5f, 0.0f, 0.87f,		0.25f, 0.0f, 0.75f,		0.831, 0.0,
-		.64f, 0.0f, 0.77f,		0.33f, 0.0f, 0.67f,		0.8587, 0.0,
-		.5f, 1.0f, 0.87f,		0.33f, 0.0f, 0.67f,		0.831, 1.0,
-		.64f, 1.0f, 0.77f,		0.33f, 0.0f, 0.67f,		0.8587, 1.0,
-		.64f, 0.0f, 0.77f,		0.42f, 0.0f, 0.58f,		0.8587, 0.0,
-		.77f, 0.0f, 0.64f,		0.42f, 0.0f, 0.58f,		0.8864, 0.0,
-		.64f, 1.0f, 0.77f,		0.42f, 0.0f, 0.58f,		0.8587, 1.0,
-		.77f, 1.0f, 0.64f,		0.5f, 0.0f, 0.5f,		0.8864, 1.0,
-		.77f, 0.0f, 0.64f,		0.5f, 0.0f, 0.5f,		0.8864, 0.0,
-		.87f, 0.0f, 0.5f,		0.5f, 0.0f, 0.5f,		0.9141, 0.0,
-		.77f, 1.0f, 0.64f,		0.58f, 0.0f, 0.42f,		0.8864, 1.0,
-		.87f, 1.0f, 0.5f,		0.58f, 0.0f, 0.42f,		0.9141, 1.0,
-		.87f, 0.0f, 0.5f,		0.58f, 0.0f, 0.42f,		0.9141, 0.0,
-		.94f, 0.0f, 0.34f,		0.67f, 0.0f, 0.33f,		0.9418, 0.0,
-		.87f, 1.0f, 0.5f,		0.67f, 0.0f, 0.33f,		0.9141, 1.0,
-		.94f, 1.0f, 0.34f,		0.67f, 0.0f, 0.33f,		0.9418, 1.0,
-		.94f, 0.0f, 0.34f,		0.75f, 0.0f, 0.25f,		0.9418, 0.0,
-		.98f, 0.0f, 0.17f,		0.75f, 0.0f, 0.25f,		0.9695, 0.0,
-		.94f, 1.0f, 0.34f,		0.75f, 0.0f, 0.25f,		0.9418, 0.0,
-		.98f, 1.0f, 0.17f,		0.83f, 0.0f, 0.17f,		0.9695, 1.0,
-		.98f, 0.0f, 0.17f,		0.83f, 0.0f, 0.17f,		0.9695, 0.0,
-		1.0f, 0.0f, 0.0f,		0.83f, 0.0f, 0.17f,		1.0, 0.0,
-		.98f, 1.0f, 0.17f,		0.92f, 0.0f, 0.08f,		0.9695, 1.0,
-		1.0f, 1.0f, 0.0f,		0.92f, 0.0f, 0.08f,		1.0, 1.0,
-		1.0f, 0.0f, 0.0f,		0.92f, 0.0f, 0.08f,		1.0, 0.0
-	};
-
-	// total float values per each type
-	const GLuint floatsPerVertex = 3;
-	const GLuint floatsPerNormal = 3;
-	const GLuint floatsPerUV = 2;
-
-	// store vertex and index count
-	mesh.nVertices = sizeof(verts) / (sizeof(verts[0]) * (floatsPerVertex + floatsPerNormal + floatsPerUV));
-	mesh.nIndices = 0;
-
-	// Create VAO
-	glGenVertexArrays(1, &mesh.vao); // we can also generate multiple VAOs or buffers at the same time
-	glBindVertexArray(mesh.vao);
-
-	// Create VBO
-	glGenBuffers(1, mesh.vbos);
-	glBindBuffer(GL_ARRAY_BUFFER, mesh.vbos[0]); // Activates the buffer
-	glBufferData(GL_ARRAY_BUFFER, sizeof(verts), verts, GL_STATIC_DRAW); // Sends vertex or coordinate data to the GPU
-
-	// Strides between vertex coordinates
-	GLint stride = sizeof(float) * (floatsPerVertex + floatsPerNormal + floatsPerUV);
-
-	// Create Vertex Attribute Pointers
-	glVertexAttribPointer(0, floatsPerVertex, GL_FLOAT, GL_FALSE, stride, (void*)0);
-	glEnableVertexAttribArray(0);
-
-	glVertexAttribPointer(1, floatsPerNormal, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(float) * (floatsPerVertex)));
-	glEnableVertexAttribArray(1);
+	GenerateCylinder(data, gCylinderTessellation.segments, gCylinderTessellation.rings);
+	BuildLods(data, "cylinder");
+	OptimizeMesh(data, "cylinder");
+}
 
-	glVertexAttribPointer(2, floatsPerUV, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(float) * (floatsPerVertex + floatsPerNormal)));
-	glEnableVertexAttribArray(2);
+///////////////////////////////////////////////////
+//	GenerateCylinder(MeshData&, GLuint, GLuint)
+//
+//	data: filled with the generated mesh
+//	segments: divisions around the axis
+//	rings: divisions from the bottom to the top
+///////////////////////////////////////////////////
+void Meshes::GenerateCylinder(MeshData& data, GLuint segments, GLuint rings)
+{
+	GenerateFrustum(data, segments, rings, 1.0f);
 }
 
 ///////////////////////////////////////////////////
-//	UCreateTaperedCylinderMesh(GLMesh&)
+//	UGenerateTaperedCylinderMesh(MeshData&)
 //
-//	mesh: reference to mesh structure for storing data
+//	data: empty mesh data, filled with the mesh
 //
-//	Create a tapered cylinder mesh and store it in a VAO/VBO
+//	Generate a tapered cylinder mesh at
+//	gTaperedCylinderTessellation
 //
 //  Correct triangle drawing commands:
 //
-//	glDrawArrays(GL_TRIANGLE_FAN, 0, 36);		//bottom
-//	glDrawArrays(GL_TRIANGLE_FAN, 36, 72);		//top
-//	glDrawArrays(GL_TRIANGLE_STRIP, 72, 146);	//sides
+//	DrawMeshPart(meshes.gTaperedCylinderMesh, 0);	//bottom
+//	DrawMeshPart(meshes.gTaperedCylinderMesh, 1);	//top
+//	DrawMeshPart(meshes.gTaperedCylinderMesh, 2);	//sides
 ///////////////////////////////////////////////////
-void Meshes::UCreateTaperedCylinderMesh(GLMesh& mesh)
+void Meshes::UGenerateTaperedCylinderMesh(MeshData& data) const
 {
-	GLfloat verts[] = {
-		// cylinder bottom		// normals			// texture coords
-		1.0f, 0.0f, 0.0f,		0.0f, -1.0f, 0.0f,	0.5f,1.0f,
-		.98f, 0.0f, -0.17f,		0.0f, -1.0f, 0.0f,	0.41f, 0.983f,
-		.94f, 0.0f, -0.34f,		0.0f, -1.0f, 0.0f,	0.33f, 0.96f,
-		.87f, 0.0f, -0.5f,		0.0f, -1.0f, 0.0f,	0.25f, 0.92f,
-		.77f, 0.0f, -0.64f,		0.0f, -1.0f, 0.0f,	0.17f, 0.87f,
-		.64f, 0.0f, -0.77f,		0.0f, -1.0f, 0.0f,	0.13f, 0.83f,
-		.5f, 0.0f, -0.87f,		0.0f, -1.0f, 0.0f,	0.08f, 0.77f,
-		.34f, 0.0f, -0.94f,		0.0f, -1.0f, 0.0f,	0.04f, 0.68f,
-		.17f, 0.0f, -0.98f,		0.0f, -1.0f, 0.0f,	0.017f, 0.6f,
-		0.0f, 0.0f, -1.0f,		0.0f, -1.0f, 0.0f,	0.0f,0.5f,
-		-.17f, 0.0f, -0.98f,	0.0f, -1.0f, 0.0f,	0.017f, 0.41f,
-		-.34f, 0.0f, -0.94f,	0.0f, -1.0f, 0.0f,	0.04f, 0.33f,
-		-.5f, 0.0f, -0.87f,		0.0f, -1.0f, 0.0f,	0.08f, 0.25f,
-		-.64f, 0.0f, -0.77f,	0.0f, -1.0f, 0.0f,	0.13f, 0.17f,
-		-.77f, 0.0f, -0.64f,	0.0f, -1.0f, 0.0f,	0.17f, 0.13f,
-		-.87f, 0.0f, -0.5f,		0.0f, -1.0f, 0.0f,	0.25f, 0.08f,
-		-.94f, 0.0f, -0.34f,	0.0f, -1.0f, 0.0f,	0.33f, 0.04f,
-		-.98f, 0.0f, -0.17f,	0.0f, -1.0f, 0.0f,	0.41f, 0.017f,
-		-1.0f, 0.0f, 0.0f,		0.0f, -1.0f, 0.0f,	0.5f, 0.0f,
-		-.98f, 0.0f, 0.17f,		0.0f, -1.0f, 0.0f,	0.6f, 0.017f,
-		-.94f, 0.0f, 0.34f,		0.0f, -1.0f, 0.0f,	0.68f, 0.04f,
-		-.87f, 0.0f, 0.5f,		0.0f, -1.0f, 0.0f,	0.77f, 0.08f,
-		-.77f, 0.0f, 0.64f,		0.0f, -1.0f, 0.0f,	0.83f, 0.13f,
-		-.64f, 0.0f, 0.77f,		0.0f, -1.0f, 0.0f,	0.87f, 0.17f,
-		-.5f, 0.0f, 0.87f,		0.0f, -1.0f, 0.0f,	0.92f, 0.25f,
-		-.34f, 0.0f, 0.94f,		0.0f, -1.0f, 0.0f,	0.96f, 0.33f,
-		-.17f, 0.0f, 0.98f,		0.0f, -1.0f, 0.0f,	0.983f, 0.41f,
-		0.0f, 0.0f, 1.0f,		0.0f, -1.0f, 0.0f,	1.0f, 0.5f,
-		.17f, 0.0f, 0.98f,		0.0f, -1.0f, 0.0f,	0.983f, 0.6f,
-		.34f, 0.0f, 0.94f,		0.0f, -1.0f, 0.0f,	0.96f, 0.68f,
-		.5f, 0.0f, 0.87f,		0.0f, -1.0f, 0.0f,	0.92f, 0.77f,
-		.64f, 0.0f, 0.77f,		0.0f, -1.0f, 0.0f,	0.87f, 0.83f,
-		.77f, 0.0f, 0.64f,		0.0f, -1.0f, 0.0f,	0.83f, 0.87f,
-		.87f, 0.0f, 0.5f,		0.0f, -1.0f, 0.0f,	0.77f, 0.92f,
-		.94f, 0.0f, 0.34f,		0.0f, -1.0f, 0.0f,	0.68f, 0.96f,
-		.98f, 0.0f, 0.17f,		0.0f, -1.0f, 0.0f,	0.6f, 0.983f,
-
-		// cylinder top			// normals			// texture coords
-		0.5f, 1.0f, 0.0f,		0.0f, 1.0f, 0.0f,	0.5f,1.0f,
-		.49f, 1.0f, -0.085f,	0.0f, 1.0f, 0.0f,	0.41f, 0.983f,
-		.47f, 1.0f, -0.17f,		0.0f, 1.0f, 0.0f,	0.33f, 0.96f,
-		.435f, 1.0f, -0.25f,	0.0f, 1.0f, 0.0f,	0.25f, 0.92f,
-		.385f, 1.0f, -0.32f,	0.0f, 1.0f, 0.0f,	0.17f, 0.87f,
-		.32f, 1.0f, -0.385f,	0.0f, 1.0f, 0.0f,	0.13f, 0.83f,
-		.25f, 1.0f, -0.435f,	0.0f, 1.0f, 0.0f,	0.08f, 0.77f,
-		.17f, 1.0f, -0.47f,		0.0f, 1.0f, 0.0f,	0.04f, 0.68f,
-		.085f, 1.0f, -0.49f,	0.0f, 1.0f, 0.0f,	0.017f, 0.6f,
-		0.0f, 1.0f, -0.5f,		0.0f, 1.0f, 0.0f,	0.0f,0.5f,
-		-.085f, 1.0f, -0.49f,	0.0f, 1.0f, 0.0f,	0.017f, 0.41f,
-		-.17f, 1.0f, -0.47f,	0.0f, 1.0f, 0.0f,	0.04f, 0.33f,
-		-.25f, 1.0f, -0.435f,	0.0f, 1.0f, 0.0f,	0.08f, 0.25f,
-		-.32f, 1.0f, -0.385f,	0.0f, 1.0f, 0.0f,	0.13f, 0.17f,
-		-.385f, 1.0f, -0.32f,	0.0f, 1.0f, 0.0f,	0.17f, 0.13f,
-		-.435f, 1.0f, -0.25f,	0.0f, 1.0f, 0.0f,	0.25f, 0.08f,
-		-.47f, 1.0f, -0.17f,	0.0f, 1.0f, 0.0f,	0.33f, 0.04f,
-		-.49f, 1.0f, -0.085f,	0.0f, 1.0f, 0.0f,	0.41f, 0.017f,
-		-0.5f, 1.0f, 0.0f,		0.0f, 1.0f, 0.0f,	0.5f, 0.0f,
-		-.49f, 1.0f, 0.085f,	0.0f, 1.0f, 0.0f,	0.6f, 0.017f,
-		-.47f, 1.0f, 0.17f,		0.0f, 1.0f, 0.0f,	0.68f, 0.04f,
-		-.435f, 1.0f, 0.25f,	0.0f, 1.0f, 0.0f,	0.77f, 0.08f,
-		-.385f, 1.0f, 0.32f,	0.0f, 1.0f, 0.0f,	0.83f, 0.13f,
-		-.32f, 1.0f, 0.385f,	0.0f, 1.0f, 0.0f,	0.87f, 0.17f,
-		-.25f, 1.0f, 0.435f,	0.0f, 1.0f, 0.0f,	0.92f, 0.25f,
-		-.17f, 1.0f, 0.47f,		0.0f, 1.0f, 0.0f,	0.96f, 0.33f,
-		-.085f, 1.0f, 0.49f,	0.0f, 1.0f, 0.0f,	0.983f, 0.41f,
-		0.0f, 1.0f, 0.5f,		0.0f, 1.0f, 0.0f,	1.0f, 0.5f,
-		.085f, 1.0f, 0.49f,		0.0f, 1.0f, 0.0f,	0.983f, 0.6f,
-		.17f, 1.0f, 0.47f,		0.0f, 1.0f, 0.0f,	0.96f, 0.68f,
-		.25f, 1.0f, 0.435f,		0.0f, 1.0f, 0.0f,	0.92f, 0.77f,
-		.32f, 1.0f, 0.385f,		0.0f, 1.0f, 0.0f,	0.87f, 0.83f,
-		.385f, 1.0f, 0.32f,		0.0f, 1.0f, 0.0f,	0.83f, 0.87f,
-		.435f, 1.0f, 0.25f,		0.0f, 1.0f, 0.0f,	0.77f, 0.92f,
-		.47f, 1.0f, 0.17f,		0.0f, 1.0f, 0.0f,	0.68f, 0.96f,
-		.49f, 1.0f, 0.085f,		0.0f, 1.0f, 0.0f,	0.6f, 0.983f,
-
-		// cylinder body		// normals				// texture coords
-		0.5f, 1.0f, 0.0f,		1.0f, 0.0f, 0.0f,		0.25,1.0,
-		1.0f, 0.0f, 0.0f,		1.0f, 0.0f, 0.0f,		0.0,0.0,
-		.98f, 0.0f, -0.17f,		1.0f, 0.0f, 0.0f,		0.0277,0.0,
-		0.5f, 1.0f, 0.0f,		0.92f, 0.0f, -0.08f,	0.25,1.0,
-		.49f, 1.0f, -0.085f,	0.92f, 0.0f, -0.08f,	0.2635,1.0,
-		.98f, 0.0f, -0.17f,		0.92f, 0.0f, -0.08f,	0.0277,0.0,
-		.94f, 0.0f, -0.34f,		0.83f, 0.0f, -0.17f,	0.0554,0.0,
-		.49f, 1.0f, -0.085f,	0.83f, 0.0f, -0.17f,	0.2635,1.0,
-		.47f, 1.0f, -0.17f,		0.83f, 0.0f, -0.17f,	0.277,1.0,
-		.94f, 0.0f, -0.34f,		0.75f, 0.0f, -0.25f,	0.0554,0.0,
-		.87f, 0.0f, -0.5f,		0.75f, 0.0f, -0.25f,	0.0831,0.0,
-		.47f, 1.0f, -0.17f,		0.75f, 0.0f, -0.25f,	0.277,1.0,
-		.435f, 1.0f, -0.25f,	0.67f, 0.0f, -0.33f,	0.2905,1.0,
-		.87f, 0.0f, -0.5f,		0.67f, 0.0f, -0.33f,	0.0831,0.0,
-		.77f, 0.0f, -0.64f,		0.67f, 0.0f, -0.33f,	0.1108,0.0,
-		.435f, 1.0f, -0.25f,	0.58f, 0.0f, -0.42f,	0.2905,1.0,
-		.385f, 1.0f, -0.32f,	0.58f, 0.0f, -0.42f,	0.304,1.0,
-		.77f, 0.0f, -0.64f,		0.58f, 0.0f, -0.42f,	0.1108,0.0,
-		.64f, 0.0f, -0.77f,		0.5f, 0.0f, -0.5f,		0.1385,0.0,
-		.385f, 1.0f, -0.32f,	0.5f, 0.0f, -0.5f,		0.304,1.0,
-		.32f, 1.0f, -0.385f,	0.5f, 0.0f, -0.5f,		0.3175,1.0,
-		.64f, 0.0f, -0.77f,		0.42f, 0.0f, -0.58f,	0.1385,0.0,
-		.5f, 0.0f, -0.87f,		0.42f, 0.0f, -0.58f,	0.1662,0.0,
-		.32f, 1.0f, -0.385f,	0.42f, 0.0f, -0.58f,	0.3175, 1.0,
-		.25f, 1.0f, -0.435f,	0.33f, 0.0f, -0.67f,	0.331, 1.0,
-		.5f, 0.0f, -0.87f,		0.33f, 0.0f, -0.67f,	0.1662, 0.0,
-		.34f, 0.0f, -0.94f,		0.33f, 0.0f, -0.67f,	0.1939, 0.0,
-		.25f, 1.0f, -0.435f,	0.25f, 0.0f, -0.75f,	0.331, 1.0,
-		.17f, 1.0f, -0.47f,		0.25f, 0.0f, -0.75f,	0.3445, 1.0,
-		.34f, 0.0f, -0.94f,		0.25f, 0.0f, -0.75f,	0.1939, 0.0,
-		.17f, 0.0f, -0.98f,		0.17f, 0.0f, -0.83f,	0.2216, 0.0,
-		.17f, 1.0f, -0.47f,		0.17f, 0.0f, -0.83f,	0.3445, 1.0,
-		.085f, 1.0f, -0.49f,	0.17f, 0.0f, -0.83f,	0.358, 1.0,
-		.17f, 0.0f, -0.98f,		0.08f, 0.0f, -0.92f,	0.2216, 0.0,
-		0.0f, 0.0f, -1.0f,		0.08f, 0.0f, -0.92f,	0.2493, 0.0,
-		.085f, 1.0f, -0.49f,	0.08f, 0.0f, -0.92f,	0.358, 1.0,
-		0.0f, 1.0f, -0.5f,		0.0f, 0.0f, -1.0f,		0.3715, 1.0,
-		0.0f, 0.0f, -1.0f,		0.0f, 0.0f, -1.0f,		0.2493, 0.0,
-		-.17f, 0.0f, -0.98f,	0.0f, 0.0f, -1.0f,		0.277, 0.0,
-		0.0f, 1.0f, -0.5f,		0.08f, 0.0f, -1.08f,	0.3715, 1.0,
-		-.085f, 1.0f, -0.49f,	-0.08f, 0.0f, -0.92f,	0.385, 1.0,
-		-.17f, 0.0f, -0.98f,	-0.08f, 0.0f, -0.92f,	0.277, 0.0,
-		-.34f, 0.0f, -0.94f,	-0.08f, 0.0f, -0.92f,	0.3047, 0.0,
-		-.085f, 1.0f, -0.49f,	-0.08f, 0.0f, -0.92f,	0.385, 1.0,
-		-.17f, 1.0f, -0.47f,	-0.17f, 0.0f, -0.83f,	0.3985, 1.0,
-		-.34f, 0.0f, -0.94f,	-0.17f, 0.0f, -0.83f,	0.3047, 0.0,
-		-.5f, 0.0f, -0.87f,		-0.17f, 0.0f, -0.83f,	0.3324, 0.0,
-		-.17f, 1.0f, -0.47f,	-0.25f, 0.0f, -0.75f,	0.3985, 1.0,
-		-.25f, 1.0f, -0.435f,	-0.25f, 0.0f, -0.75f,	0.412, 1.0,
-		-.5f, 0.0f, -0.87f,		-0.25f, 0.0f, -0.75f,	0.3324, 0.0,
-		-.64f, 0.0f, -0.77f,	-0.33f, 0.0f, -0.67f,	0.3601, 0.0,
-		-.25f, 1.0f, -0.435f,	-0.33f, 0.0f, -0.67f,	0.412, 1.0,
-		-.32f, 1.0f, -0.385f,	-0.33f, 0.0f, -0.67f,	0.4255, 1.0,
-		-.64f, 0.0f, -0.77f,	-0.42f, 0.0f, -0.58f,	0.3601, 0.0,
-		-.77f, 0.0f, -0.64f,	-0.42f, 0.0f, -0.58f,	0.3878, 0.0,
-		-.32f, 1.0f, -0.385f,	-0.42f, 0.0f, -0.58f,	0.4255, 1.0,
-		-.385f, 1.0f, -0.32f,	-0.5f, 0.0f, -0.5f,		0.439, 1.0,
-		-.77f, 0.0f, -0.64f,	-0.5f, 0.0f, -0.5f,		0.3878, 0.0,
-		-.87f, 0.0f, -0.5f,		-0.5f, 0.0f, -0.5f,		0.4155, 0.0,
-		-.385f, 1.0f, -0.32f,	-0.58f, 0.0f, -0.42f,	0.439, 1.0,
-		-.435f, 1.0f, -0.25f,	-0.58f, 0.0f, -0.42f,	0.4525, 1.0,
-		-.87f, 0.0f, -0.5f,		-0.58f, 0.0f, -0.42f,	0.4155, 0.0,
-		-.94f, 0.0f, -0.34f,	-0.67f, 0.0f, -0.33f,	0.4432, 0.0,
-		-.435f, 1.0f, -0.25f,	-0.67f, 0.0f, -0.33f,	0.4525, 1.0,
-		-.47f, 1.0f, -0.17f,	-0.67f, 0.0f, -0.33f,	0.466, 1.0,
-		-.94f, 0.0f, -0.34f,	-0.75f, 0.0f, -0.25f,	0.4432, 0.0,
-		-.98f, 0.0f, -0.17f,	-0.75f, 0.0f, -0.25f,	0.4709, 0.0,
-		-.47f, 1.0f, -0.17f,	-0.75f, 0.0f, -0.25f,	0.466, 1.0,
-		-.49f, 1.0f, -0.085f,	-0.83f, 0.0f, -0.17f,	0.4795, 1.0,
-		-.98f, 0.0f, -0.17f,	-0.83f, 0.0f, -0.17f,	0.4709, 0.0,
-		-1.0f, 0.0f, 0.0f,		-0.83f, 0.0f, -0.17f,	0.4986, 0.0,
-		-.49f, 1.0f, -0.085f,	-0.92f, 0.0f, -0.08f,	0.4795, 1.0,
-		-0.5f, 1.0f, 0.0f,		-0.92f, 0.0f, -0.08f,	0.493, 1.0,
-		-1.0f, 0.0f, 0.0f,		-0.92f, 0.0f, -0.08f,	0.4986, 0.0,
-		-.98f, 0.0f, 0.17f,		-1.0f, 0.0f, 0.0f,		0.5263, 0.0,
-		-0.5f, 1.0f, 0.0f,		-1.0f, 0.0f, 0.0f,		0.493, 1.0,
-		-.49f, 1.0f, 0.085f,	-1.0f, 0.0f, 0.0f,		0.5065, 1.0,
-		-.98f, 0.0f, 0.17f,		-0.92f, 0.0f, 0.08f,	0.5263, 0.0,
-		-.94f, 0.0f, 0.34f,		-0.92f, 0.0f, 0.08f,	0.554, 0.0,
-		-.49f, 1.0f, 0.085f,	-0.92f, 0.0f, 0.08f,	0.5065, 1.0,
-		-.47f, 1.0f, 0.17f,		-0.83f, 0.0f, 0.17f,	0.52, 1.0,
-		-.94f, 0.0f, 0.34f,		-0.83f, 0.0f, 0.17f,	0.554, 0.0,
-		-.87f, 0.0f, 0.5f,		-0.83f, 0.0f, 0.17f,	0.5817, 0.0,
-		-.47f, 1.0f, 0.17f,		-0.75f, 0.0f, 0.25f,	0.52, 1.0,
-		-.435f, 1.0f, 0.25f,	-0.75f, 0.0f, 0.25f,	0.5335, 1.0,
-		-.87f, 0.0f, 0.5f,		-0.75f, 0.0f, 0.25f,	0.5817, 0.0,
-		-.77f, 0.0f, 0.64f,		-0.67f, 0.0f, 0.33f,	0.6094, 0.0,
-		-.435f, 1.0f, 0.25f,	-0.67f, 0.0f, 0.33f,	0.5335, 1.0,
-		-.385f, 1.0f, 0.32f,	-0.67f, 0.0f, 0.33f,	0.547, 1.0,
-		-.77f, 0.0f, 0.64f,		-0.58f, 0.0f, 0.42f,	0.6094, 0.0,
-		-.64f, 0.0f, 0.77f,		-0.58f, 0.0f, 0.42f,	0.6371, 0.0,
-		-.385f, 1.0f, 0.32f,	-0.58f, 0.0f, 0.42f,	0.547, 1.0,
-		-.32f, 1.0f, 0.385f,	-0.5f, 0.0f, 0.5f,		0.5605, 1.0,
-		-.64f, 0.0f, 0.77f,		-0.5f, 0.0f, 0.5f,		0.6371, 0.0,
-		-.5f, 0.0f, 0.87f,		-0.5f, 0.0f, 0.5f,		0.6648, 0.0,
-		-.32f, 1.0f, 0.385f,	-0.42f, 0.0f, 0.58f,	0.5605, 1.0,
-		-.25f, 1.0f, 0.435f,	-0.42f, 0.0f, 0.58f,	0.574, 1.0,
-		-.5f, 0.0f, 0.87f,		-0.42f, 0.0f, 0.58f,	0.6648, 0.0,
-		-.34f, 0.0f, 0.94f,		-0.33f, 0.0f, 0.67f,	0.6925, 0.0,
-		-.25f, 1.0f, 0.435f,	-0.33f, 0.0f, 0.67f,	0.574, 1.0,
-		-.17f, 1.0f, 0.47f,		-0.33f, 0.0f, 0.67f,	0.5875, 1.0,
-		-.34f, 0.0f, 0.94f,		-0.25f, 0.0f, 0.75f,	0.6925, 0.0,
-		-.17f, 0.0f, 0.98f,		-0.25f, 0.0f, 0.75f,	0.7202, 0.0,
-		-.17f, 1.0f, 0.47f,		-0.25f, 0.0f, 0.75f,	0.5875, 1.0,
-		-.085f, 1.0f, 0.49f,	-0.17f, 0.0f, 0.83f,	0.601, 1.0,
-		-.17f, 0.0f, 0.98f,		-0.17f, 0.0f, 0.83f,	0.7202, 0.0,
-		0.0f, 0.0f, 1.0f,		-0.17f, 0.0f, 0.83f,	0.7479, 0.0,
-		-.085f, 1.0f, 0.49f,	-0.08f, 0.0f, 0.92f,	0.601, 1.0,
-		0.0f, 1.0f, 0.5f,		-0.08f, 0.0f, 0.92f,	0.6145, 1.0,
-		0.0f, 0.0f, 1.0f,		-0.08f, 0.0f, 0.92f,	0.7479, 0.0,
-		.17f, 0.0f, 0.98f,		-0.0f, 0.0f, 1.0f,		0.7756, 0.0,
-		0.0f, 1.0f, 0.5f,		-0.0f, 0.0f, 1.0f,		0.6145, 1.0,
-		.085f, 1.0f, 0.49f,		-0.0f, 0.0f, 1.0f,		0.628, 1.0,
-		.17f, 0.0f, 0.98f,		0.08f, 0.0f, 0.92f,		0.7756, 0.0,
-		.34f, 0.0f, 0.94f,		0.08f, 0.0f, 0.92f,		0.8033, 0.0,
-		.085f, 1.0f, 0.49f,		0.08f, 0.0f, 0.92f,		0.628, 1.0,
-		.17f, 1.0f, 0.47f,		0.17f, 0.0f, 0.83f,		0.6415, 1.0,
-		.34f, 0.0f, 0.94f,		0.17f, 0.0f, 0.83f,		0.8033, 0.0,
-		.5f, 0.0f, 0.87f,		0.17f, 0.0f, 0.83f,		0.831, 0.0,
-		.17f, 1.0f, 0.47f,		0.25f, 0.0f, 0.75f,		0.6415, 1.0,
-		.25f, 1.0f, 0.435f,		0.25f, 0.0f, 0.75f,		0.655, 1.0,
-		.5f, 0.0f, 0.87f,		0.25f, 0.0f, 0.75f,		0.831, 0.0,
-		.64f, 0.0f, 0.77f,		0.33f, 0.0f, 0.67f,		0.8587, 0.0,
-		.25f, 1.0f, 0.435f,		0.33f, 0.0f, 0.67f,		0.655, 1.0,
-		.32f, 1.0f, 0.385f,		0.33f, 0.0f, 0.67f,		0.6685, 1.0,
-		.64f, 0.0f, 0.77f,		0.42f, 0.0f, 0.58f,		0.8587, 0.0,
-		.77f, 0.0f, 0.64f,		0.42f, 0.0f, 0.58f,		0.8864, 0.0,
-		.32f, 1.0f, 0.385f,		0.42f, 0.0f, 0.58f,		0.6685, 1.0,
-		.385f, 1.0f, 0.32f,		0.5f, 0.0f, 0.5f,		0.682, 1.0,
-		.77f, 0.0f, 0.64f,		0.5f, 0.0f, 0.5f,		0.8864, 0.0,
-		.87f, 0.0f, 0.5f,		0.5f, 0.0f, 0.5f,		0.9141, 0.0,
-		.385f, 1.0f, 0.32f,		0.58f, 0.0f, 0.42f,		0.682, 1.0,
-		.435f, 1.0f, 0.25f,		0.58f, 0.0f, 0.42f,		0.6955, 1.0,
-		.87f, 0.0f, 0.5f,		0.58f, 0.0f, 0.42f,		0.9141, 0.0,
-		.94f, 0.0f, 0.34f,		0.67f, 0.0f, 0.33f,		0.9418, 0.0,
-		.435f, 1.0f, 0.25f,		0.67f, 0.0f, 0.33f,		0.6955, 1.0,
-		.47f, 1.0f, 0.17f,		0.67f, 0.0f, 0.33f,		0.709, 1.0,
-		.94f, 0.0f, 0.34f,		0.75f, 0.0f, 0.25f,		0.9418, 0.0,
-		.98f, 0.0f, 0.17f,		0.75f, 0.0f, 0.25f,		0.9695, 0.0,
-		.47f, 1.0f, 0.17f,		0.75f, 0.0f, 0.25f,		0.709, 0.0,
-		.49f, 1.0f, 0.085f,		0.83f, 0.0f, 0.17f,		0.7225, 1.0,
-		.98f, 0.0f, 0.17f,		0.83f, 0.0f, 0.17f,		0.9695, 0.0,
-		1.0f, 0.0f, 0.0f,		0.83f, 0.0f, 0.17f,		1.0, 0.0,
-		.49f, 1.0f, 0.085f,		0.92f, 0.0f, 0.08f,		0.7225, 1.0,
-		0.5f, 1.0f, 0.0f,		0.92f, 0.0f, 0.08f,		0.75, 1.0,
-		1.0f, 0.0f, 0.0f,		0.92f, 0.0f, 0.08f,		1.0, 0.0
-	};
-
-	// total float values per each type
-	const GLuint floatsPerVertex = 3;
-	const GLuint floatsPerNormal = 3;
-	const GLuint floatsPerUV = 2;
-
-	// store vertex and index count
-	mesh.nVertices = sizeof(verts) / (sizeof(verts[0]) * (floatsPerVertex + floatsPerNormal + floatsPerUV));
-	mesh.nIndices = 0;
-
-	// Create VAO
-	glGenVertexArrays(1, &mesh.vao); // we can also generate multiple VAOs or buffers at the same time
-	glBindVertexArray(mesh.vao);
-
-	// Create VBO
-	glGenBuffers(1, mesh.vbos);
-	glBindBuffer(GL_ARRAY_BUFFER, mesh.vbos[0]); // Activates the buffer
-	glBufferData(GL_ARRAY_BUFFER, sizeof(verts), verts, GL_STATIC_DRAW); // Sends vertex or coordinate data to the GPU
-
-	// Strides between vertex coordinates
-	GLint stride = sizeof(float) * (floatsPerVertex + floatsPerNormal + floatsPerUV);
-
-	// Create Vertex Attribute Pointers
-	glVertexAttribPointer(0, floatsPerVertex, GL_FLOAT, GL_FALSE, stride, (void*)0);
-	glEnableVertexAttribArray(0);
-
-	glVertexAttribPointer(1, floatsPerNormal, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(float) * (floatsPerVertex)));
-	glEnableVertexAttribArray(1);
+	GenerateTaperedCylinder(data, gTaperedCylinderTessellation.segments, gTaperedCylinderTessellation.rings);
+	BuildLods(data, "tapered cylinder");
+	OptimizeMesh(data, "tapered cylinder");
+}
 
-	glVertexAttribPointer(2, floatsPerUV, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(float) * (floatsPerVertex + floatsPerNormal)));
-	glEnableVertexAttribArray(2);
+///////////////////////////////////////////////////
+//	GenerateTaperedCylinder(MeshData&, GLuint, GLuint)
+//
+//	data: filled with the generated mesh
+//	segments: divisions around the axis
+//	rings: divisions from the bottom to the top
+///////////////////////////////////////////////////
+void Meshes::GenerateTaperedCylinder(MeshData& data, GLuint segments, GLuint rings)
+{
+	GenerateFrustum(data, segments, rings, 0.5f);
 }
 
 ///////////////////////////////////////////////////
-//	UCreateTorusMesh(GLMesh&)
+//	UGenerateTorusMesh(MeshData&)
 //
-//	mesh: reference to mesh structure for storing data
+//	data: empty mesh data, filled with the mesh
 //
-//	Create a torus mesh and store it in a VAO/VBO
+//	Generate a torus mesh at gTorusTessellation
 //
 //	Correct triangle drawing command:
 //
-//	glDrawArrays(GL_TRIANGLES, 0, meshes.gTorusMesh.nVertices);
+//	DrawMesh(meshes.gTorusMesh);
 ///////////////////////////////////////////////////
-void Meshes::UCreateTorusMesh(GLMesh& mesh)
+void Meshes::UGenerateTorusMesh(MeshData& data) const
 {
-	int _mainSegments = 30;
-	int _tubeSegments = 30;
-	float _mainRadius = 1.0f;
-	float _tubeRadius = .1f;
-
-	auto mainSegmentAngleStep = glm::radians(360.0f / float(_mainSegments));
-	auto tubeSegmentAngleStep = glm::radians(360.0f / float(_tubeSegments));
-
-	std::vector<glm::vec3> vertex_list;
-	std::vector<std::vector<glm::vec3>> segments_list;
-	std::vector<glm::vec2> texture_coords;
-	glm::vec3 center(0.0f, 0.0f, 0.0f);
-	glm::vec3 normal;
-	glm::vec3 vertex;
-	glm::vec2 text_coord;
-
-	// generate the torus vertices
-	auto currentMainSegmentAngle = 0.0f;
-	for (auto i = 0; i < _mainSegments; i++)
-	{
-		// Calculate sine and cosine of main segment angle
-		auto sinMainSegment = sin(currentMainSegmentAngle);
-		auto cosMainSegment = cos(currentMainSegmentAngle);
-		auto currentTubeSegmentAngle = 0.0f;
-		std::vector<glm::vec3> segment_points;
-		for (auto j = 0; j < _tubeSegments; j++)
-		{
-			// Calculate sine and cosine of tube segment angle
-			auto sinTubeSegment = sin(currentTubeSegmentAngle);
-			auto cosTubeSegment = cos(currentTubeSegmentAngle);
-
-			// Calculate vertex position on the surface of torus
-			auto surfacePosition = glm::vec3(
-				(_mainRadius + _tubeRadius * cosTubeSegment) * cosMainSegment,
-				(_mainRadius + _tubeRadius * cosTubeSegment) * sinMainSegment,
-				_tubeRadius * sinTubeSegment);
-
-			//vertex_list.push_back(surfacePosition);
-			segment_points.push_back(surfacePosition);
+	GenerateTorus(data, gTorusTessellation.segments, gTorusTessellation.rings, 1.0f, 0.1f);
+	BuildLods(data, "torus");
+	OptimizeMesh(data, "torus");
+}
 
-			// Update current tube angle
-			currentTubeSegmentAngle += tubeSegmentAngleStep;
-		}
-		segments_list.push_back(segment_points);
-		segment_points.clear();
+///////////////////////////////////////////////////
+//	UGenerateSphereMesh(MeshData&)
+//
+//	data: empty mesh data, filled with the mesh
+//
+//	Generate a sphere mesh at gSphereTessellation
+//
+//  Correct triangle drawing command:
+//
+//	DrawMesh(meshes.gSphereMesh);
+///////////////////////////////////////////////////
+void Meshes::UGenerateSphereMesh(MeshData& data) const
+{
+	GenerateSphere(data, gSphereTessellation.segments, gSphereTessellation.rings);
+	BuildLods(data, "sphere");
+	OptimizeMesh(data, "sphere");
+}
 
-		// Update main segment angle
-		currentMainSegmentAngle += mainSegmentAngleStep;
-	}
+///////////////////////////////////////////////////
+//	GenerateSphere(MeshData&, GLuint, GLuint)
+//
+//	data: filled with the generated mesh
+//	segments: divisions around the axis
+//	rings: latitude bands from pole to pole
+//
+//	A vertex at each pole and segments + 1 per ring,
+//	the first and last meeting at a seam on the -z
+//	side. u is the angle around the axis scaled by the
+//	ring's radius, so the texture narrows toward the
+//	poles instead of pinching; v runs from the bottom
+//	pole to the top one.
+///////////////////////////////////////////////////
+void Meshes::GenerateSphere(MeshData& data, GLuint segments, GLuint rings)
+{
+	segments = std::max(segments, 3u);
+	rings = std::max(rings, 2u);
 
-	float horizontalStep = 1.0 / _mainSegments;
-	float verticalStep = 1.0 / _tubeSegments;
-	float u = 0.0;
-	float v = 0.0;
+	data.vertices.clear();
+	data.indices.clear();
+	data.nParts = 0;
+	data.nLods = 0;
 
-	// connect the various segments together, forming triangles
-	for (int i = 0; i < _mainSegments; i++)
+	AddVertex(data, glm::vec3(0.0f, 1.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f), 0.5f, 1.0f);
+	for (GLuint ring = 1; ring < rings; ++ring)
 	{
-		for (int j = 0; j < _tubeSegments; j++)
+		float latitude = (float)M_PI * ring / rings;
+		float y = std::cos(latitude);
+		float radius = std::sin(latitude);
+		for (GLuint i = 0; i <= segments; ++i)
 		{
-			if (((i + 1) < _mainSegments) && ((j + 1) < _tubeSegments))
-			{
-				vertex_list.push_back(segments_list[i][j]);
-				texture_coords.push_back(glm::vec2(u, v));
-				vertex_list.push_back(segments_list[i][j + 1]);
-				texture_coords.push_back(glm::vec2(u, v + verticalStep));
-				vertex_list.push_back(segments_list[i + 1][j + 1]);
-				texture_coords.push_back(glm::vec2(u + horizontalStep, v + verticalStep));
-				vertex_list.push_back(segments_list[i][j]);
-				texture_coords.push_back(glm::vec2(u, v));
-				vertex_list.push_back(segments_list[i + 1][j]);
-				texture_coords.push_back(glm::vec2(u + horizontalStep, v));
-				vertex_list.push_back(segments_list[i + 1][j + 1]);
-				texture_coords.push_back(glm::vec2(u + horizontalStep, v - verticalStep));
-				vertex_list.push_back(segments_list[i][j]);
-				texture_coords.push_back(glm::vec2(u, v));
-			}
-			else
-			{
-				if (((i + 1) == _mainSegments) && ((j + 1) == _tubeSegments))
-				{
-					vertex_list.push_back(segments_list[i][j]);
-					texture_coords.push_back(glm::vec2(u, v));
-					vertex_list.push_back(segments_list[i][0]);
-					texture_coords.push_back(glm::vec2(u, 0));
-					vertex_list.push_back(segments_list[0][0]);
-					texture_coords.push_back(glm::vec2(0, 0));
-					vertex_list.push_back(segments_list[i][j]);
-					texture_coords.push_back(glm::vec2(u, v));
-					vertex_list.push_back(segments_list[0][j]);
-					texture_coords.push_back(glm::vec2(0, v));
-					vertex_list.push_back(segments_list[0][0]);
-					texture_coords.push_back(glm::vec2(0, 0));
-					vertex_list.push_back(segments_list[i][j]);
-					texture_coords.push_back(glm::vec2(u, v));
-				}
-				else if ((i + 1) == _mainSegments)
-				{
-					vertex_list.push_back(segments_list[i][j]);
-					texture_coords.push_back(glm::vec2(u, v));
-					vertex_list.push_back(segments_list[i][j + 1]);
-					texture_coords.push_back(glm::vec2(u, v + verticalStep));
-					vertex_list.push_back(segments_list[0][j + 1]);
-					texture_coords.push_back(glm::vec2(0, v + verticalStep));
-					vertex_list.push_back(segments_list[i][j]);
-					texture_coords.push_back(glm::vec2(u, v));
-					vertex_list.push_back(segments_list[0][j]);
-					texture_coords.push_back(glm::vec2(0, v));
-					vertex_list.push_back(segments_list[0][j + 1]);
-					texture_coords.push_back(glm::vec2(0, v + verticalStep));
-					vertex_list.push_back(segments_list[i][j]);
-					texture_coords.push_back(glm::vec2(u, v));
-				}
-				else if ((j + 1) == _tubeSegments)
-				{
-					vertex_list.push_back(segments_list[i][j]);
-					texture_coords.push_back(glm::vec2(u, v));
-					vertex_list.push_back(segments_list[i][0]);
-					texture_coords.push_back(glm::vec2(u, 0));
-					vertex_list.push_back(segments_list[i + 1][0]);
-					texture_coords.push_back(glm::vec2(u + horizontalStep, 0));
-					vertex_list.push_back(segments_list[i][j]);
-					texture_coords.push_back(glm::vec2(u, v));
-					vertex_list.push_back(segments_list[i + 1][j]);
-					texture_coords.push_back(glm::vec2(u + horizontalStep, v));
-					vertex_list.push_back(segments_list[i + 1][0]);
-					texture_coords.push_back(glm::vec2(u + horizontalStep, 0));
-					vertex_list.push_back(segments_list[i][j]);
-					texture_coords.push_back(glm::vec2(u, v));
-				}
-
-			}
-			v += verticalStep;
+			// -0.5 to 0.5 around the axis, 0 facing +z
+			float t = (float)i / segments - 0.5f;
+			float angle = 2.0f * (float)M_PI * t;
+			glm::vec3 position(radius * std::sin(angle), y, radius * std::cos(angle));
+			AddVertex(data, position, glm::normalize(position), 0.5f + radius * t, 1.0f - (float)ring / rings);
 		}
-		v = 0.0;
-		u += horizontalStep;
 	}
-
-	std::vector<GLfloat> combined_values;
-
-	// combine interleaved vertices, normals, and texture coords
-	for (int i = 0; i < vertex_list.size(); i++)
+	AddVertex(data, glm::vec3(0.0f, -1.0f, 0.0f), glm::vec3(0.0f, -1.0f, 0.0f), 0.5f, 0.0f);
+
+	const GLuint top = 0;
+	const GLuint bottom = (GLuint)(data.vertices.size() / 8) - 1;
+	const GLuint lastRing = 1 + (rings - 2) * (segments + 1);
+	for (GLuint i = 0; i < segments; ++i)
+		data.indices.insert(data.indices.end(), { top, 1 + i, 2 + i });
+	for (GLuint ring = 1; ring + 1 < rings; ++ring)
 	{
-		vertex = vertex_list[i];
-		normal = normalize(vertex);
-		text_coord = texture_coords[i];
-		combined_values.push_back(vertex.x);
-		combined_values.push_back(vertex.y);
-		combined_values.push_back(vertex.z);
-		combined_values.push_back(normal.x);
-		combined_values.push_back(normal.y);
-		combined_values.push_back(normal.z);
-		combined_values.push_back(text_coord.x);
-		combined_values.push_back(text_coord.y);
+		for (GLuint i = 0; i < segments; ++i)
+		{
+			GLuint upper = 1 + (ring - 1) * (segments + 1) + i;
+			GLuint lower = upper + segments + 1;
+			data.indices.insert(data.indices.end(), { upper, lower, lower + 1, upper, lower + 1, upper + 1 });
+		}
 	}
+	for (GLuint i = 0; i < segments; ++i)
+		data.indices.insert(data.indices.end(), { lastRing + i, bottom, lastRing + i + 1 });
+	AddPart(data, 0);
+}
 
-	// total float values per each type
-	const GLuint floatsPerVertex = 3;
-	const GLuint floatsPerNormal = 3;
-	const GLuint floatsPerUV = 2;
-
-	// store vertex and index count
-	mesh.nVertices = vertex_list.size();
-	mesh.nIndices = 0;
-
-	// Create VAO
-	glGenVertexArrays(1, &mesh.vao); // we can also generate multiple VAOs or buffers at the same time
-	glBindVertexArray(mesh.vao);
-
-	// Create VBOs
-	glGenBuffers(1, mesh.vbos);
-	glBindBuffer(GL_ARRAY_BUFFER, mesh.vbos[0]); // Activates the buffer
-	glBufferData(GL_ARRAY_BUFFER, sizeof(GLfloat) * combined_values.size(), combined_values.data(), GL_STATIC_DRAW); // Sends vertex or coordinate data to the GPU
-
-	// Strides between vertex coordinates
-	GLint stride = sizeof(float) * (floatsPerVertex + floatsPerNormal + floatsPerUV);
-
-	// Create Vertex Attribute Pointers
-	glVertexAttribPointer(0, floatsPerVertex, GL_FLOAT, GL_FALSE, stride, 0);
-	glEnableVertexAttribArray(0);
-
-	glVertexAttribPointer(1, floatsPerNormal, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(float) * floatsPerVertex));
-	glEnableVertexAttribArray(1);
 
-	glVertexAttribPointer(2, floatsPerUV, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(float) * (floatsPerVertex + floatsPerNormal)));
-	glEnableVertexAttribArray(2);
+///////////////////////////////////////////////////
+//	UGenerateDonutMesh(MeshData&)
+//
+//	data: empty mesh data, filled with the mesh
+//
+//	Generate a torus mesh at gDonutTessellation
+//
+//	Correct triangle drawing command:
+//
+//	DrawMesh(meshes.gDonutMesh);
+///////////////////////////////////////////////////
+void Meshes::UGenerateDonutMesh(MeshData& data) const
+{
+	GenerateTorus(data, gDonutTessellation.segments, gDonutTessellation.rings, 1.0f, 0.5f);
+	BuildLods(data, "donut");
+	OptimizeMesh(data, "donut");
 }
 
 ///////////////////////////////////////////////////
-//	UCreateSphereMesh(GLMesh&)
+//	DrawMesh(const GLMesh&, GLuint)
 //
-//	mesh: reference to mesh structure for storing data
+//	mesh: mesh whose VAO is currently bound
+//	lod: level of detail from SelectLod
 //
-//	Create a sphere mesh and store it in a VAO/VBO
+//	Draw every part of the mesh. Neighbouring
+//	triangle-list parts are merged into one call.
+///////////////////////////////////////////////////
+void Meshes::DrawMesh(const GLMesh& mesh, GLuint lod) const
+{
+	const DrawRange* parts = LodParts(mesh, lod);
+	GLuint part = 0;
+	while (part < mesh.nParts)
+	{
+		DrawRange range = parts[part++];
+		while (range.mode == GL_TRIANGLES && part < mesh.nParts &&
+			parts[part].mode == GL_TRIANGLES && parts[part].indexed == range.indexed &&
+			parts[part].first == range.first + range.count)
+		{
+			range.count += parts[part++].count;
+		}
+		UDrawRange(mesh, range);
+	}
+}
+
+///////////////////////////////////////////////////
+//	DrawMeshPart(const GLMesh&, GLuint, GLuint)
 //
-//  Correct triangle drawing command:
+//	mesh: mesh whose VAO is currently bound
+//	part: index into mesh.parts
+//	lod: level of detail from SelectLod
 //
-//	glDrawElements(GL_TRIANGLES, meshes.gSphereMesh.nIndices, GL_UNSIGNED_INT, (void*)0);
+//	Draw a single part of the mesh
 ///////////////////////////////////////////////////
-void Meshes::UCreateSphereMesh(GLMesh& mesh)
+void Meshes::DrawMeshPart(const GLMesh& mesh, GLuint part, GLuint lod) const
 {
-	GLfloat verts[] = {
-		// vertex data					// texture coords			// index
-		// top center point
-		0.0f, 1.0f, 0.0f,				0.5f, 1.0f,					//0
-		// ring 1
-		0.0f, 0.9808f, 0.1951f,			0.5f, 0.9375f,				//1
-		0.0747f, 0.9808f, 0.1802f,		0.51219375f, 0.9375f,		//2
-		0.1379f, 0.9808f, 0.1379f,		0.5243875f, 0.9375f,		//3
-		0.1802f, 0.9808f, 0.0747f,		0.53658125f, 0.9375f,		//4
-		0.1951f, 0.9808, 0.0f,			0.548775f, 0.9375f,			//5
-		0.1802f, 0.9808f, -0.0747f,		0.56096875f, 0.9375f,		//6
-		0.1379f, 0.9808f, -0.1379f,		0.5731625f, 0.9375f,		//7
-		0.0747f, 0.9808f, -0.1802f,		0.58535625f, 0.9375f,		//8
-		0.0f, 0.9808f, -0.1951f,		0.59755f, 0.9375f,			//9 - seam
-		0.0f, 0.9808f, -0.1951f,		0.40245f, 0.9375f,			//10 - seam
-		-0.0747f, 0.9808f, -0.1802f,	0.41464375f, 0.9375f,		//11
-		-0.1379f, 0.9808f, -0.1379f,	0.4268375f, 0.9375f,		//12
-		-0.1802f, 0.9808f, -0.0747f,	0.43903125f, 0.9375f,		//13
-		-0.1951f, 0.9808, 0.0f,			0.451225f, 0.9375f,			//14
-		-0.1802f, 0.9808f, 0.0747f,		0.46341875f, 0.9375f,		//15
-		-0.1379f, 0.9808f, 0.1379f,		0.4756125f, 0.9375f,		//16
-		-0.0747f, 0.9808f, 0.1802f,		0.48780625f, 0.9375f,		//17
-		// ring 2
-		0.0f, 0.9239f, 0.3827f,			0.5f, 0.875f,				//18
-		0.1464f, 0.9239f, 0.3536f,		0.52391875f, 0.875f,		//19
-		0.2706f, 0.9239f, 0.2706f,		0.5478375f, 0.875f,			//20
-		0.3536f, 0.9239f, 0.1464f,		0.57175625f, 0.875f,		//21
-		0.3827f, 0.9239f, 0.0f,			0.5956755f, 0.875f,			//22
-		0.3536f, 0.9239f, -0.1464f,		0.61959425f, 0.875f,		//23
-		0.2706f, 0.9239f, -0.2706f,		0.643513f, 0.875f,			//24
-		0.1464f, 0.9239f, -0.3536f,		0.66743175f, 0.875f,		//25
-		0.0f, 0.9239f, -0.3827f,		0.6913505f, 0.875f,			//26 - seam
-		0.0f, 0.9239f, -0.3827f,		0.3086495f, 0.875f,			//27 - seam
-		-0.1464f, 0.9239f, -0.3536f,	0.33256825f, 0.875f,		//28
-		-0.2706f, 0.9239f, -0.2706f,	0.356487f, 0.875f,			//29
-		-0.3536f, 0.9239f, -0.1464f,	0.38040575f, 0.875f,		//30
-		-0.3827f, 0.9239f, 0.0f,		0.4043245f, 0.875f,			//31
-		-0.3536f, 0.9239f, 0.1464f,		0.42824325f, 0.875f,		//32
-		-0.2706f, 0.9239f, 0.2706f,		0.452162f, 0.875f,			//33
-		-0.1464f, 0.9239f, 0.3536f,		0.47608075f, 0.875f,		//34
-		// ring 3
-		0.0f, 0.8315f, 0.5556f,			0.5f, 0.8125f,				//35
-		0.2126f, 0.8315f, 0.5133f,		0.534725f, 0.8125f,			//36
-		0.3928f, 0.8315f, 0.3928f,		0.56945f, 0.8125f,			//37
-		0.5133f, 0.8315f, 0.2126f,		0.604175f, 0.8125f,			//38
-		0.5556f, 0.8315f, 0.0f,			0.6389f, 0.8125f,			//39
-		0.5133f, 0.8315f, -0.2126f,		0.673625f, 0.8125f,			//40
-		0.3928f, 0.8315f, -0.3928f,		0.70835f, 0.8125f,			//41
-		0.2126f, 0.8315f, -0.5133f,		0.743075f, 0.8125f,			//42
-		0.0f, 0.8315f, -0.5556f,		0.7778f, 0.8125f,			//43 - seam
-		0.0f, 0.8315f, -0.5556f,		0.2222f, 0.8125f,			//44 - seam
-		-0.2126f, 0.8315f, -0.5133f,	0.256925f, 0.8125f,			//45
-		-0.3928f, 0.8315f, -0.3928f,	0.29165f, 0.8125f,			//46
-		-0.5133f, 0.8315f, -0.2126f,	0.326375f, 0.8125f,			//47
-		-0.5556f, 0.8315f, 0.0f,		0.3611f, 0.8125f,			//48
-		-0.5133f, 0.8315f, 0.2126f,		0.395825f, 0.8125f,			//49
-		-0.3928f, 0.8315f, 0.3928f,		0.43055f, 0.8125f,			//50
-		-0.2126f, 0.8315f, 0.5133f,		0.465275f, 0.8125f,			//51
-		// ring 4
-		0.0f, 0.7071f, 0.7071f,			0.5f, 0.75f,				//52
-		0.2706f, 0.7071f, 0.6533f,		0.54419375f, 0.75f,			//53
-		0.5f, 0.7071f, 0.5f,			0.5883875f, 0.75f,			//54
-		0.6533f, 0.7071f, 0.2706f,		0.63258125f, 0.75f,			//55
-		0.7071f, 0.7071f, 0.0f,			0.676775f, 0.75f,			//56
-		0.6533f, 0.7071f, -0.2706f,		0.72096875f, 0.75f,			//57
-		0.5f, 0.7071f, -0.5f,			0.7651625f, 0.75f,			//58
-		0.2706f, 0.7071f, -0.6533f,		0.80935625f, 0.75f,			//59
-		0.0f, 0.7071f, -0.7071f,		0.85355f, 0.75f,			//60 - seam
-		0.0f, 0.7071f, -0.7071f,		0.14645f, 0.75f,			//61 - seam
-		-0.2706f, 0.7071f, -0.6533f,	0.19064375f, 0.75f,			//62
-		-0.5f, 0.7071f, -0.5f,			0.2348375f, 0.75f,			//63
-		-0.6533f, 0.7071f, -0.2706f,	0.27903135f, 0.75f,			//64
-		-0.7071f, 0.7071f, 0.0f,		0.323225f, 0.75f,			//65
-		-0.6533f, 0.7071f, 0.2706f,		0.36741875f, 0.75f,			//66
-		-0.5f, 0.7071f, 0.5f,			0.4116125f, 0.75f,			//67
-		-0.2706f, 0.7071f, 0.6533f,		0.45580625f, 0.75f,			//68
-		// ring 5
-		0.0f, 0.5556f, 0.8315f,			0.5f, 0.6875f,				//69
-		0.3182f, 0.5556f, 0.7682f,		0.55196875f, 0.6875f,		//70
-		0.5879f, 0.5556f, 0.5879f,		0.6039375f, 0.6875f,		//71
-		0.7682f, 0.5556f, 0.3182f,		0.65590625f, 0.6875f,		//72
-		0.8315f, 0.5556f, 0.0f,			0.707875f, 0.6875f,			//73
-		0.7682f, 0.5556f, -0.3182f,		0.75984375f, 0.6875f,		//74
-		0.5879f, 0.5556f, -0.5879f,		0.8118125f, 0.6875f,		//75
-		0.3182f, 0.5556f, -0.7682f,		0.86378125f, 0.6875f,		//76
-		0.0f, 0.5556f, -0.8315f,		0.91575f, 0.6875f,			//77 - seam
-		0.0f, 0.5556f, -0.8315f,		0.08425f, 0.6875f,			//78 - seam
-		-0.3182f, 0.5556f, -0.7682f,	0.13621875f, 0.6875f,		//79
-		-0.5879f, 0.5556f, -0.5879f,	0.1881875f, 0.6875f,		//80
-		-0.7682f, 0.5556f, -0.3182f,	0.24015625f, 0.6875f,		//81
-		-0.8315f, 0.5556f, 0.0f,		0.292125f, 0.6875f,			//82
-		-0.7682f, 0.5556f, 0.3182f,		0.34409375f, 0.6875f,		//83
-		-0.5879f, 0.5556f, 0.5879f,		0.3960625f, 0.6875f,		//84
-		-0.3182f, 0.5556f, 0.7682f,		0.44803125f, 0.6875f,		//85
-		//ring 6
-		0.0f, 0.3827f, 0.9239f,			0.5f, 0.625f,				//86
-		0.3536f, 0.3827f, 0.8536f,		0.55774375f, 0.625f,		//87
-		0.6533f, 0.3827f, 0.6533f,		0.6154875f, 0.625f,			//88
-		0.8536f, 0.3827f, 0.3536f,		0.67323125f, 0.625f,		//89
-		0.9239f, 0.3827f, 0.0f,			0.730975f, 0.625f,			//90
-		0.8536f, 0.3827f, -0.3536f,		0.78871875f, 0.625f,		//91
-		0.6533f, 0.3827f, -0.6533f,		0.8464625f, 0.625f,			//92
-		0.3536f, 0.3827f, -0.8536f,		0.90420625f, 0.625f,		//93
-		0.0f, 0.3827f, -0.9239f,		0.96195f, 0.625f,			//94 - seam
-		0.0f, 0.3827f, -0.9239f,		0.03805f, 0.625f,			//95 - seam
-		-0.3536f, 0.3827f, -0.8536f,	0.09579375f, 0.625f,		//96
-		-0.6533f, 0.3827f, -0.6533f,	0.1535375f, 0.625f,			//97
-		-0.8536f, 0.3827f, -0.3536f,	0.21128125f, 0.625f,		//98
-		-0.9239f, 0.3827f, 0.0f,		0.269025f, 0.625f,			//99
-		-0.8536f, 0.3827f, 0.3536f,		0.32676875f, 0.625f,		//100
-		-0.6533f, 0.3827f, 0.6533f,		0.3845125f, 0.625f,			//101
-		-0.3536f, 0.3827f, 0.8536f,		0.44225625f, 0.625f,		//102
-		// ring 7
-		0.0f, 0.1951f, 0.9808f,			0.5f, 0.5625f,				//103
-		0.3753f, 0.1915f, 0.9061f,		0.5613f, 0.5625f,			//104
-		0.6935f, 0.1915f, 0.6935f,		0.6226f, 0.5625f,			//105
-		0.9061f, 0.1915f, 0.3753f,		0.6839f, 0.5625f,			//106
-		0.9808f, 0.1915f, 0.0f,			0.7452f, 0.5625f,			//107
-		0.9061f, 0.1915f, -0.3753f,		0.8065f, 0.5625f,			//108
-		0.6935f, 0.1915f, -0.6935f,		0.8678f, 0.5625f,			//109
-		0.3753f, 0.1915f, -0.9061f,		0.9291f, 0.5625f,			//110
-		0.0f, 0.1915f, -0.9808f,		0.9904f, 0.5625f,			//111 - seam
-		0.0f, 0.1915f, -0.9808f,		0.0096f, 0.5625f,			//112 - seam
-		-0.3753f, 0.1915f, -0.9061f,	0.0709f, 0.5625f,			//113
-		-0.6935f, 0.1915f, -0.6935f,	0.1322f, 0.5625f,			//114
-		-0.9061f, 0.1915f, -0.3753f,	0.1935f, 0.5625f,			//115
-		-0.9808f, 0.1915f, 0.0f,		0.2548f, 0.5625f,			//116
-		-0.9061f, 0.1915f, 0.3753f,		0.3161f, 0.5625f,			//117
-		-0.6935f, 0.1915f, 0.6935f,		0.3774f, 0.5625f,			//118
-		-0.3753f, 0.1915f, 0.9061f,		0.4387f, 0.5625f,			//119
-		// ring 8
-		0.0f, 0.0f, 1.0f,				0.5f, 0.5f,					//120
-		0.3827f, 0.0f, 0.9239f,			0.5625f, 0.5f,				//121
-		0.7071f, 0.0f, 0.7071f,			0.625f, 0.5f,				//122
-		0.9239f, 0.0f, 0.3827f,			0.6875f, 0.5f,				//123
-		1.0f, 0.0f, 0.0f,				0.75f, 0.5f,				//124
-		0.9239f, 0.0f, -0.3827f,		0.8125f, 0.5f,				//125
-		0.7071f, 0.0f, -0.7071f,		0.875f, 0.5f,				//126
-		0.3827f, 0.0f, -0.9239f,		0.9375f, 0.5f,				//127
-		0.0f, 0.0f, -1.0f,				1.0f, 0.5f,					//128 - seam
-		0.0f, 0.0f, -1.0f, 				0.0f, 0.5f,					//129 - seam
-		-0.3827f, 0.0f, -0.9239f,		0.0625f, 0.5f,				//130
-		-0.7071f, 0.0f, -0.7071f,		0.125f, 0.5f,				//131
-		-0.9239f, 0.0f, -0.3827f,		0.1875f, 0.5f,				//132
-		-1.0f, 0.0f, 0.0f,				0.25f, 0.5f,				//133
-		-0.9239f, 0.0f, 0.3827f,		0.3125f, 0.5f,				//134
-		-0.7071, 0.0, 0.7071f,			0.375f, 0.5f,				//135
-		-0.3827f, 0.0f, 0.9239f,		0.4375f, 0.5f,				//136
-		// ring 9
-		0.0f, -0.1915f, 0.9808f,		0.5f, 0.4375f,				//137
-		0.3753f, -0.1915f, 0.9061f,		0.5613f, 0.4375f,			//138
-		0.6935f, -0.1915f, 0.6935f,		0.6226f, 0.4375f,			//139
-		0.9061f, -0.1915f, 0.3753f,		0.6839f, 0.4375f,			//140
-		0.9808f, -0.1915f, 0.0f,		0.7452f, 0.4375f,			//141
-		0.9061f, -0.1915f, -0.3753f,	0.8065f, 0.4375f,			//142
-		0.6935f, -0.1915f, -0.6935f,	0.8678f, 0.4375f,			//143
-		0.3753f, -0.1915f, -0.9061f,	0.9261f, 0.4375f,			//144
-		0.0f, -0.1915f, -0.9808f,		0.9904f, 0.4375f,			//145 - seam
-		0.0f, -0.1915f, -0.9808f,		0.0096f, 0.4375f,			//146 - seam
-		-0.3753f, -0.1915f, -0.9061f,	0.0709f, 0.4375f,			//147
-		-0.6935f, -0.1915f, -0.6935f,	0.1322f, 0.4375f,			//148
-		-0.9061f, -0.1915f, -0.3753f,	0.1935f, 0.4375f,			//149
-		-0.9808f, -0.1915f, 0.0f,		0.2548f, 0.4375f,			//150
-		-0.9061f, -0.1915f, 0.3753f,	0.3161f, 0.4375f,			//151
-		-0.6935f, -0.1915f, 0.6935f,	0.3774f, 0.4375f,			//152
-		-0.3753f, -0.1915f, 0.9061f,	0.4387f, 0.4375f,			//153
-		// ring 10
-		0.0f, -0.3827f, 0.9239f,		0.5f, 0.375f,				//154
-		0.3536f, -0.3827f, 0.8536f,		0.55774375f, 0.375f,		//155
-		0.6533f, -0.3827f, 0.6533f,		0.6154875f, 0.375f,			//156
-		0.8536f, -0.3827f, 0.3536f,		0.67323125f, 0.375f,		//157
-		0.9239f, -0.3827f, 0.0f,		0.730975f, 0.375f,			//158
-		0.8536f, -0.3827f, -0.3536f,	0.78871875f, 0.375f,		//159
-		0.6533f, -0.3827f, -0.6533f,	0.8464625f, 0.375f,			//160
-		0.3536f, -0.3827f, -0.8536f,	0.90420625f, 0.375f,		//161
-		0.0f, -0.3827f, -0.9239f,		0.96195f, 0.375f,			//162 - seam
-		0.0f, -0.3827f, -0.9239f,		0.03805f, 0.375f,			//163 - seam
-		-0.3536f, -0.3827f, -0.8536f,	0.09579375f, 0.375f,		//164
-		-0.6533f, -0.3827f, -0.6533f,	0.1535375f, 0.375f,			//165
-		-0.8536f, -0.3827f, -0.3536f,	0.21128125f, 0.375f,		//166
-		-0.9239f, -0.3827f, 0.0f,		0.269025f, 0.375f,			//167
-		-0.8536f, -0.3827f, 0.3536f,	0.32676875f, 0.375f,		//168
-		-0.6533f, -0.3827f, 0.6533f,	0.3845125f, 0.375f,			//169
-		-0.3536f, -0.3827f, 0.8536f,	0.44225625f, 0.375f,		//170
-		// ring 11
-		0.0f, -0.5556f, 0.8315f,		0.5f, 0.3125f,				//171
-		0.3182f, -0.5556f, 0.7682f,		0.55196875f, 0.3125f,		//172
-		0.5879f, -0.5556f, 0.5879f,		0.6039375f, 0.3125f,		//173
-		0.7682f, -0.5556f, 0.3182f,		0.65590625f, 0.3125f,		//174
-		0.8315f, -0.5556f, 0.0f,		0.707875f, 0.3125f,			//175
-		0.7682f, -0.5556f, -0.3182f,	0.75984375f, 0.3125f,		//176
-		0.5879f, -0.5556f, -0.5879f,	0.8118125f, 0.3125f,		//177
-		0.3182f, -0.5556f, -0.7682f,	0.86378125f, 0.3125f,		//178
-		0.0f, -0.5556f, -0.8315f,		0.91575f, 0.3125f,			//179 - seam
-		0.0f, -0.5556f, -0.8315f,		0.08425f, 0.3125f,			//180 - seam
-		-0.3182f, -0.5556f, -0.7682f,	0.13621875f, 0.3125f,		//181
-		-0.5879f, 0.5556f, -0.5879f,	0.1881875f, 0.3125f,		//182
-		-0.7682f, -0.5556f, -0.3182f,	0.24015625f, 0.3125f,		//183
-		-0.8315f, -0.5556f, 0.0f,		0.292125f, 0.3125f,			//184
-		-0.7682f, -0.5556f, 0.3182f,	0.34409375f, 0.3125f,		//185
-		-0.5879f, -0.5556f, 0.5879f,	0.3960625f, 0.3125f,		//186
-		-0.3182f, -0.5556f, 0.7682f,	0.44803125f, 0.3125f,		//187
-		// ring 12
-		0.0f, -0.7071f, 0.7071f,		0.5f, 0.25f,				//188
-		0.2706f, -0.7071f, 0.6533f,		0.54419375f, 0.25f,			//189
-		0.5f, -0.7071f, 0.5f,			0.5883875f, 0.25f,			//190
-		0.6533f, -0.7071f, 0.2706f,		0.63258125f, 0.25f,			//191
-		0.7071f, -0.7071f, 0.0f,		0.676775f, 0.25f,			//192
-		0.6533f, -0.7071f, -0.2706f,	0.72096875f, 0.25f,			//193
-		0.5f, -0.7071f, -0.5f,			0.7651625f, 0.25f,			//194
-		0.2706f, -0.7071f, -0.6533f,	0.80935625f, 0.25f,			//195
-		0.0f, -0.7071f, -0.7071f,		0.85355f, 0.25f,			//196 - seam
-		0.0f, -0.7071f, -0.7071f,		0.14645f, 0.25f,			//197 - seam
-		-0.2706f, -0.7071f, -0.6533f,	0.19064375f, 0.25f,			//198
-		-0.5f, -0.7071f, -0.5f,			0.2348375f, 0.25f,			//199
-		-0.6533f, -0.7071f, -0.2706f,	0.27903135f, 0.25f,			//200
-		-0.7071f, -0.7071f, 0.0f,		0.323225f, 0.25f,			//201
-		-0.6533f, -0.7071f, 0.2706f,	0.36741875f, 0.25f,			//202
-		-0.5f, -0.7071f, 0.5f,			0.4116125f, 0.25f,			//203
-		-0.2706f, -0.7071f, 0.6533f,	0.45580625f, 0.25f,			//204
-		// ring 13
-		0.0f, -0.8315f, 0.5556f,		0.5f, 0.1875f,				//205
-		0.2126f, -0.8315f, 0.5133f,		0.534725f, 0.1875f,			//206
-		0.3928f, -0.8315f, 0.3928f,		0.56945f, 0.1875f,			//207
-		0.5133f, -0.8315f, 0.2126f,		0.604175f, 0.1875f,			//208
-		0.5556f, -0.8315f, 0.0f,		0.6389f, 0.1875f,			//209
-		0.5133f, -0.8315f, -0.2126f,	0.673625f, 0.1875f,			//210
-		0.3928f, -0.8315f, -0.3928f,	0.70835f, 0.1875f,			//211
-		0.2126f, -0.8315f, -0.5133f,	0.743075f, 0.1875f,			//212
-		0.0f, -0.8315f, -0.5556f,		0.7778f, 0.1875f,			//213 - seam
-		0.0f, -0.8315f, -0.5556f,		0.2222f, 0.1875f,			//214 - seam
-		-0.2126f, -0.8315f, -0.5133f,	0.256925f, 0.1875f,			//215
-		-0.3928f, -0.8315f, -0.3928f,	0.29165f, 0.1875f,			//216
-		-0.5133f, -0.8315f, -0.2126f,	0.326375f, 0.1875f,			//217
-		-0.5556f, -0.8315f, 0.0f,		0.3611f, 0.1875f,			//218
-		-0.5133f, -0.8315f, 0.2126f,	0.395825f, 0.1875f,			//219
-		-0.3928f, -0.8315f, 0.3928f,	0.43055f, 0.1875f,			//220
-		-0.2126f, -0.8315f, 0.5133f,	0.465275f, 0.1875f,			//221
-		// ring 14
-		0.0f, -0.9239f, 0.3827f,		0.5f, 0.125f,				//222
-		0.1464f, -0.9239f, 0.3536f,		0.52391875f, 0.125f,		//223
-		0.2706f, -0.9239f, 0.2706f,		0.5478375f, 0.125f,			//224
-		0.3536f, -0.9239f, 0.1464f,		0.57175625f, 0.125f,		//225
-		0.3827f, -0.9239f, 0.0f,		0.5956755f, 0.125f,			//226
-		0.3536f, -0.9239f, -0.1464f,	0.61959425f, 0.125f,		//227
-		0.2706f, -0.9239f, -0.2706f,	0.643513f, 0.125f,			//228
-		0.1464f, -0.9239f, -0.3536f,	0.66743175f, 0.125f,		//229
-		0.0f, -0.9239f, -0.3827f,		0.6913505f, 0.125f,			//230 - seam
-		0.0f, -0.9239f, -0.3827f,		0.3086495f, 0.125f,			//231 - seam
-		-0.1464f, -0.9239f, -0.3536f,	0.33256825f, 0.125f,		//232
-		-0.2706f, -0.9239f, -0.2706f,	0.356487f, 0.125f,			//233
-		-0.3536f, -0.9239f, -0.1464f,	0.38040575f, 0.125f,		//234
-		-0.3827f, -0.9239f, 0.0f,		0.4043245f, 0.125f,			//235
-		-0.3536f, -0.9239f, 0.1464f,	0.42824325f, 0.125f,		//236
-		-0.2706f, -0.9239f, 0.2706f,	0.452162f, 0.125f,			//237
-		-0.1464f, -0.9239f, 0.3536f,	0.47608075f, 0.125f,		//238
-		// ring 15
-		0.0f, -0.9808f, 0.1951f,		0.5f, 0.0625f,				//239
-		0.0747f, -0.9808f, 0.1802f,		0.51219375f, 0.0625f,		//240
-		0.1379f, -0.9808f, 0.1379f,		0.5243875f, 0.0625f,		//241
-		0.1802f, -0.9808f, 0.0747f,		0.53658125f, 0.0625f,		//242
-		0.1951f, -0.9808, 0.0f,			0.548775f, 0.0625f,			//243
-		0.1802f, -0.9808f, -0.0747f,	0.56096875f, 0.0625f,		//244
-		0.1379f, -0.9808f, -0.1379f,	0.5731625f, 0.0625f,		//245
-		0.0747f, -0.9808f, -0.1802f,	0.58535625f, 0.0625f,		//246
-		0.0f, -0.9808f, -0.1951f,		0.59755f, 0.0625f,			//247 - seam
-		0.0f, -0.9808f, -0.1951f,		0.40245f, 0.0625f,			//248 - seam
-		-0.0747f, -0.9808f, -0.1802f,	0.41464375f, 0.0625f,		//249
-		-0.1379f, -0.9808f, -0.1379f,	0.4268375f, 0.0625f,		//250
-		-0.1802f, -0.9808f, -0.0747f,	0.43903125f, 0.0625f,		//251
-		-0.1951f, -0.9808, 0.0f,		0.451225f, 0.0625f,			//252
-		-0.1802f, -0.9808f, 0.0747f,	0.46341875f, 0.0625f,		//253
-		-0.1379f, -0.9808f, 0.1379f,	0.4756125f, 0.0625f,		//254
-		-0.0747f, -0.9808f, 0.1802f,	0.48780625f, 0.0625f,		//255
-		// bottom center point
-		0.0f, -1.0f, 0.0f,				0.5f, 0.0f					//256
-	};
+	if (part < mesh.nParts)
+		UDrawRange(mesh, LodParts(mesh, lod)[part]);
+}
 
-	// index data
-	GLuint indices[] = {
-		//ring 1 - top
-		0,10,11,
-		0,11,12,
-		0,12,13,
-		0,13,14,
-		0,14,15,
-		0,15,16,
-		0,16,17,
-		0,17,1,
-		0,1,2,
-		0,2,3,
-		0,3,4,
-		0,4,5,
-		0,5,6,
-		0,6,7,
-		0,7,8,
-		0,8,9,
-		0,9,10,
-
-		// ring 1 to ring 2
-		10,27,28,
-		10,11,28,
-		11,28,29,
-		11,12,29,
-		12,29,30,
-		12,13,30,
-		13,30,31,
-		13,14,31,
-		14,31,32,
-		14,15,32,
-		15,32,33,
-		15,16,33,
-		16,33,34,
-		16,17,34,
-		17,34,18,
-		17,1,18,
-		1,18,19,
-		1,2,19,
-		2,19,20,
-		2,3,20,
-		3,20,21,
-		3,4,21,
-		4,21,22,
-		4,5,22,
-		5,22,23,
-		5,6,23,
-		6,23,24,
-		6,7,24,
-		7,24,25,
-		7,8,25,
-		8,25,26,
-		8,9,26,
-		9,26,27,
-		9,10,27,
-
-		// ring 2 to ring 3
-		27,44,45,
-		27,28,45,
-		28,45,46,
-		28,29,46,
-		29,46,47,
-		29,30,47,
-		30,47,48,
-		30,31,48,
-		31,48,49,
-		31,32,49,
-		32,49,50,
-		32,33,50,
-		33,50,51,
-		33,34,51,
-		34,51,35,
-		34,18,35,
-		18,35,36,
-		18,19,36,
-		19,36,37,
-		19,20,37,
-		20,37,38,
-		20,21,38,
-		21,38,39,
-		21,22,39,
-		22,39,40,
-		22,23,40,
-		23,40,41,
-		23,24,41,
-		24,41,42,
-		24,25,42,
-		25,42,43,
-		25,26,43,
-		26,43,44,
-		26,27,44,
-
-		// ring 3 to ring 4
-		44,61,62,
-		44,45,62,
-		45,62,63,
-		45,46,63,
-		46,63,64,
-		46,47,64,
-		47,64,65,
-		47,48,65,
-		48,65,66,
-		48,49,66,
-		49,66,67,
-		49,50,67,
-		50,67,68,
-		50,51,68,
-		51,68,52,
-		51,35,52,
-		35,52,53,
-		35,36,53,
-		36,53,54,
-		36,37,54,
-		37,54,55,
-		37,38,55,
-		38,55,56,
-		38,39,56,
-		39,56,57,
-		39,40,57,
-		40,57,58,
-		40,41,58,
-		41,58,59,
-		41,42,59,
-		42,59,60,
-		42,43,60,
-		43,60,61,
-		43,44,61,
-
-		// ring 4 to ring 5
-		61,78,79,
-		61,62,79,
-		62,79,80,
-		62,63,80,
-		63,80,81,
-		63,64,81,
-		64,81,82,
-		64,65,82,
-		65,82,83,
-		65,66,83,
-		66,83,84,
-		66,67,84,
-		67,84,85,
-		67,68,85,
-		68,85,69,
-		68,52,69,
-		52,69,70,
-		52,53,70,
-		53,70,71,
-		53,54,71,
-		54,71,72,
-		54,55,72,
-		55,72,73,
-		55,56,73,
-		56,73,74,
-		56,57,74,
-		57,74,75,
-		57,58,75,
-		58,75,76,
-		58,59,76,
-		59,76,77,
-		59,60,77,
-		60,77,78,
-		60,61,78,
-
-		// ring 5 to ring 6
-		78,95,96,
-		78,79,96,
-		79,96,97,
-		79,80,97,
-		80,97,98,
-		80,81,98,
-		81,98,99,
-		81,82,99,
-		82,99,100,
-		82,83,100,
-		83,100,101,
-		83,84,101,
-		84,101,102,
-		84,85,102,
-		85,102,86,
-		85,69,86,
-		69,86,87,
-		69,70,87,
-		70,87,88,
-		70,71,88,
-		71,88,89,
-		71,72,89,
-		72,89,90,
-		72,73,90,
-		73,90,91,
-		73,74,91,
-		74,91,92,
-		74,75,92,
-		75,92,93,
-		75,76,93,
-		76,93,94,
-		76,77,94,
-		77,94,95,
-		77,78,95,
-
-		// ring 6 to ring 7
-		95,112,113,
-		95,96,113,
-		96,113,114,
-		96,97,114,
-		97,114,115,
-		97,98,115,
-		98,115,116,
-		98,99,116,
-		99,116,117,
-		99,100,117,
-		100,117,118,
-		100,101,118,
-		101,118,119,
-		101,102,119,
-		102,119,103,
-		102,86,103,
-		86,103,104,
-		86,87,104,
-		87,104,105,
-		87,88,105,
-		88,105,106,
-		88,89,106,
-		89,106,107,
-		89,90,107,
-		90,107,108,
-		90,91,108,
-		91,108,109,
-		91,92,109,
-		92,109,110,
-		92,93,110,
-		93,110,111,
-		93,94,111,
-		94,111,112,
-		94,95,112,
-
-		// ring 7 to ring 8
-		112,129,130,
-		112,113,130,
-		113,130,131,
-		113,114,131,
-		114,131,132,
-		114,115,132,
-		115,132,133,
-		115,116,133,
-		116,133,134,
-		116,117,134,
-		117,134,135,
-		117,118,135,
-		118,135,136,
-		118,119,136,
-		119,136,120,
-		119,103,120,
-		103,120,121,
-		103,104,121,
-		104,121,122,
-		104,105,122,
-		105,122,123,
-		105,106,123,
-		106,123,124,
-		106,107,124,
-		107,124,125,
-		107,108,125,
-		108,125,126,
-		108,109,126,
-		109,126,127,
-		109,110,127,
-		110,127,128,
-		110,111,128,
-		111,128,129,
-		111,112,129,
-
-		// ring 8 to ring 9
-		129,146,147,
-		129,130,147,
-		130,147,148,
-		130,131,148,
-		131,148,149,
-		131,132,149,
-		132,149,150,
-		132,133,150,
-		133,150,151,
-		133,134,151,
-		134,151,152,
-		134,135,152,
-		135,152,153,
-		135,136,153,
-		136,153,137,
-		136,120,137,
-		120,137,138,
-		120,121,138,
-		121,138,139,
-		121,122,139,
-		122,139,140,
-		122,123,140,
-		123,140,141,
-		123,124,141,
-		124,141,142,
-		124,125,142,
-		125,142,143,
-		125,126,143,
-		126,143,144,
-		126,127,144,
-		127,144,145,
-		127,128,145,
-		128,145,146,
-		128,129,146,
-
-		// ring 9 to ring 10
-		146,163,164,
-		146,147,164,
-		147,164,165,
-		147,148,165,
-		148,165,166,
-		148,149,166,
-		149,166,167,
-		149,150,167,
-		150,167,168,
-		150,151,168,
-		151,168,169,
-		151,152,169,
-		152,169,170,
-		152,153,170,
-		153,170,154,
-		153,137,154,
-		137,154,155,
-		137,138,155,
-		138,155,156,
-		138,139,156,
-		139,156,157,
-		139,140,157,
-		140,157,158,
-		140,141,158,
-		141,158,159,
-		141,142,159,
-		142,159,160,
-		142,143,160,
-		143,160,161,
-		143,144,161,
-		144,161,162,
-		144,145,162,
-		145,162,163,
-		145,146,163,
-
-		// ring 10 to ring 11
-		163,180,181,
-		163,164,181,
-		164,181,182,
-		164,165,182,
-		165,182,183,
-		165,166,183,
-		166,183,184,
-		166,167,184,
-		167,184,185,
-		167,168,185,
-		168,185,186,
-		168,169,186,
-		169,186,187,
-		169,170,187,
-		170,187,171,
-		170,154,171,
-		154,171,172,
-		154,155,172,
-		155,172,173,
-		155,156,173,
-		156,173,174,
-		156,157,174,
-		157,174,175,
-		157,158,175,
-		158,175,176,
-		158,159,176,
-		159,176,177,
-		159,160,177,
-		160,177,178,
-		160,161,178,
-		161,178,179,
-		161,162,179,
-		162,179,180,
-		162,163,180,
-
-		// ring 11 to ring 12
-		180,197,198,
-		180,181,198,
-		181,198,199,
-		181,182,199,
-		182,199,200,
-		182,183,200,
-		183,200,201,
-		183,184,201,
-		184,201,202,
-		184,185,202,
-		185,202,203,
-		185,186,203,
-		186,203,204,
-		186,187,204,
-		187,204,188,
-		187,171,188,
-		171,188,189,
-		171,172,189,
-		172,189,190,
-		172,173,190,
-		173,190,191,
-		173,174,191,
-		174,191,192,
-		174,175,192,
-		175,192,193,
-		175,176,193,
-		176,193,194,
-		176,177,194,
-		177,194,195,
-		177,178,195,
-		178,195,196,
-		178,179,196,
-		179,196,197,
-		179,180,197,
-
-		// ring 12 to ring 13
-		197,214,215,
-		197,198,215,
-		198,215,216,
-		198,199,216,
-		199,216,217,
-		199,200,217,
-		200,217,218,
-		200,201,218,
-		201,218,219,
-		201,202,219,
-		202,219,220,
-		202,203,220,
-		203,220,221,
-		203,204,221,
-		204,221,205,
-		204,188,205,
-		188,205,206,
-		188,189,206,
-		189,206,207,
-		189,190,207,
-		190,207,208,
-		190,191,208,
-		191,208,209,
-		191,192,209,
-		192,209,210,
-		192,193,210,
-		193,210,211,
-		193,194,211,
-		194,211,212,
-		194,195,212,
-		195,212,213,
-		195,196,213,
-		196,213,214,
-		196,197,214,
-
-		// ring 13 to ring 14
-		214,231,232,
-		214,215,232,
-		215,232,233,
-		215,216,233,
-		216,233,234,
-		216,217,234,
-		217,234,235,
-		217,218,235,
-		218,235,236,
-		218,219,236,
-		219,236,237,
-		219,220,237,
-		220,237,238,
-		220,221,238,
-		221,238,222,
-		221,205,222,
-		205,222,223,
-		205,206,223,
-		206,223,224,
-		206,207,224,
-		207,224,225,
-		207,208,225,
-		208,225,226,
-		208,209,226,
-		209,226,227,
-		209,210,227,
-		210,227,228,
-		210,211,228,
-		211,228,229,
-		211,212,229,
-		212,229,230,
-		212,213,230,
-		213,230,231,
-		213,214,231,
-
-		// ring 14 to ring 15
-		231,248,249,
-		231,232,249,
-		232,249,250,
-		232,233,250,
-		233,250,251,
-		233,234,251,
-		234,251,252,
-		234,235,252,
-		235,252,253,
-		235,236,253,
-		236,253,254,
-		236,237,254,
-		237,254,255,
-		237,238,255,
-		238,255,239,
-		238,222,239,
-		222,239,240,
-		222,223,240,
-		223,240,241,
-		223,224,241,
-		224,241,242,
-		224,225,242,
-		225,242,243,
-		225,226,243,
-		226,243,244,
-		226,227,244,
-		227,244,245,
-		227,228,245,
-		228,245,246,
-		228,229,246,
-		229,246,247,
-		229,230,247,
-		230,247,248,
-		230,231,248,
-
-		// ring 15 - bottom
-		248,256,249,
-		249,256,250,
-		250,256,251,
-		251,256,252,
-		252,256,253,
-		253,256,254,
-		254,256,255,
-		255,256,239,
-		239,256,240,
-		240,256,241,
-		241,256,242,
-		242,256,243,
-		243,256,244,
-		244,256,245,
-		245,256,246,
-		246,256,247,
-		247,256,248
-	};
+GLuint Meshes::SelectLod(const GLMesh& mesh, float maxError)
+{
+	// errors grow with each level, so stop at the first one that is too coarse
+	GLuint lod = 0;
+	while (lod < mesh.nLods && mesh.lods[lod].error <= maxError)
+		++lod;
+	return lod;
+}
 
-	// total float values per each type
-	const GLuint floatsPerVertex = 3;
-	const GLuint floatsPerNormal = 3;
-	const GLuint floatsPerUV = 2;
+///////////////////////////////////////////////////
+//	CreateInstances(GLInstances&, const GLMesh&, ...)
+//
+//	instances: reference to instance structure for storing data
+//	mesh: mesh drawn by every instance
+//	models: model matrix of each instance
+//	textureLayers: texture array layer of each instance
+//	count: number of instances
+//
+//	Upload the instance transforms and texture layers
+//	and create a VAO that pairs them with the mesh
+//	vertices
+///////////////////////////////////////////////////
+void Meshes::CreateInstances(GLInstances& instances, const GLMesh& mesh,
+	const glm::mat4* models, const GLint* textureLayers, GLuint count)
+{
+	instances.mesh = &mesh;
+	instances.nInstances = count;
 
-	// store vertex and index count
-	mesh.nVertices = sizeof(verts) / (sizeof(verts[0]) * (floatsPerVertex));
-	mesh.nIndices = sizeof(indices) / (sizeof(indices[0]));
+	glGenVertexArrays(1, &instances.vao);
+	gGpuResources.Created(GpuResourceType::VertexArray, instances.vao, "instances");
+	gGLState.BindVertexArray(instances.vao);
 
-	glm::vec3 normal;
-	glm::vec3 vert;
-	glm::vec3 center(0.0f, 0.0f, 0.0f);
-	float u, v;
-	std::vector<GLfloat> combined_values;
+	// Per-vertex attributes come straight from the geometry pool's buffers
+	glBindBuffer(GL_ARRAY_BUFFER, mesh.vbos[0]);
+	SetVertexAttributes(mesh);
 
-	// combine interleaved vertices, normals, and texture coords
-	for (int i = 0; i < sizeof(verts) / (sizeof(verts[0])); i += 5)
+	for (GLuint part = 0; part < mesh.nParts; ++part)
 	{
-		vert = glm::vec3(verts[i], verts[i + 1], verts[i + 2]);
-		normal = normalize(vert - center);
-		//u = atan2(normal.x, normal.z) / (2 * M_PI) + 0.5;
-		//v = normal.y * 0.5 + 0.5;
-		combined_values.push_back(vert.x);
-		combined_values.push_back(vert.y);
-		combined_values.push_back(vert.z);
-		combined_values.push_back(normal.x);
-		combined_values.push_back(normal.y);
-		combined_values.push_back(normal.z);
-		combined_values.push_back(verts[i + 3]);
-		combined_values.push_back(verts[i + 4]);
+		if (mesh.parts[part].indexed)
+		{
+			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.vbos[1]);
+			break;
+		}
 	}
 
-	// Create VAO
-	glGenVertexArrays(1, &mesh.vao); // we can also generate multiple VAOs or buffers at the same time
-	glBindVertexArray(mesh.vao);
+	// A mat4 attribute takes four vec4 locations, each advancing once per instance
+	glGenBuffers(2, instances.vbos);
+	gGpuResources.Created(GpuResourceType::Buffer, 2, instances.vbos, "instances");
+	glBindBuffer(GL_ARRAY_BUFFER, instances.vbos[0]);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(glm::mat4) * count, models, GL_STATIC_DRAW);
+	gGpuResources.SetBytes(GpuResourceType::Buffer, instances.vbos[0], sizeof(glm::mat4) * count);
+	for (GLuint column = 0; column < 4; ++column)
+	{
+		GLuint location = INSTANCE_MODEL_LOCATION + column;
+		glVertexAttribPointer(location, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4), (void*)(sizeof(glm::vec4) * column));
+		glEnableVertexAttribArray(location);
+		glVertexAttribDivisor(location, 1);
+	}
 
-	// Create VBOs
-	glGenBuffers(2, mesh.vbos);
-	glBindBuffer(GL_ARRAY_BUFFER, mesh.vbos[0]); // Activates the vertex buffer
-	glBufferData(GL_ARRAY_BUFFER, sizeof(GLfloat) * combined_values.size(), combined_values.data(), GL_STATIC_DRAW); // Sends vertex or coordinate data to the GPU
+	glBindBuffer(GL_ARRAY_BUFFER, instances.vbos[1]);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(GLint) * count, textureLayers, GL_STATIC_DRAW);
+	gGpuResources.SetBytes(GpuResourceType::Buffer, instances.vbos[1], sizeof(GLint) * count);
+	glVertexAttribIPointer(INSTANCE_LAYER_LOCATION, 1, GL_INT, sizeof(GLint), 0);
+	glEnableVertexAttribArray(INSTANCE_LAYER_LOCATION);
+	glVertexAttribDivisor(INSTANCE_LAYER_LOCATION, 1);
 
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.vbos[1]); // Activates the index buffer
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
+	gGLState.BindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
 
-	// Strides between vertex coordinates
-	GLint stride = sizeof(float) * (floatsPerVertex + floatsPerNormal + floatsPerUV);
+///////////////////////////////////////////////////
+//	DrawInstances(const GLInstances&, GLuint)
+//
+//	instances: instances whose VAO is currently bound
+//	lod: level of detail every instance is drawn at
+//
+//	Draw every instance with one instanced call per
+//	mesh part
+///////////////////////////////////////////////////
+void Meshes::DrawInstances(const GLInstances& instances, GLuint lod) const
+{
+	const GLMesh& mesh = *instances.mesh;
+	const DrawRange* parts = LodParts(mesh, lod);
+	for (GLuint part = 0; part < mesh.nParts; ++part)
+	{
+		const DrawRange& range = parts[part];
+		if (range.indexed)
+			glDrawElementsInstancedBaseVertex(range.mode, range.count, mesh.indexType,
+				(void*)(mesh.indexOffset + (size_t)IndexSize(mesh) * range.first), instances.nInstances, mesh.baseVertex);
+		else
+			glDrawArraysInstanced(range.mode, mesh.baseVertex + range.first, range.count, instances.nInstances);
+	}
+}
 
-	// Create Vertex Attribute Pointers
-	glVertexAttribPointer(0, floatsPerVertex, GL_FLOAT, GL_FALSE, stride, 0);
-	glEnableVertexAttribArray(0);
+void Meshes::DestroyInstances(GLInstances& instances)
+{
+	gGpuResources.Deleted(GpuResourceType::VertexArray, instances.vao);
+	gGpuResources.Deleted(GpuResourceType::Buffer, 2, instances.vbos);
+	gGLState.DeleteVertexArray(instances.vao);
+	glDeleteBuffers(2, instances.vbos);
+	instances.vao = instances.vbos[0] = instances.vbos[1] = 0;
+	instances.nInstances = 0;
+}
 
-	glVertexAttribPointer(1, floatsPerNormal, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(float) * floatsPerVertex));
-	glEnableVertexAttribArray(1);
+void Meshes::UDrawRange(const GLMesh& mesh, const DrawRange& range) const
+{
+	if (range.indexed)
+		glDrawElementsBaseVertex(range.mode, range.count, mesh.indexType,
+			(void*)(mesh.indexOffset + (size_t)IndexSize(mesh) * range.first), mesh.baseVertex);
+	else
+		glDrawArrays(range.mode, mesh.baseVertex + range.first, range.count);
+}
 
-	glVertexAttribPointer(2, floatsPerUV, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(float) * (floatsPerVertex + floatsPerNormal)));
-	glEnableVertexAttribArray(2);
+GLuint Meshes::VertexSize(const GLMesh& mesh)
+{
+	return mesh.compact ? sizeof(CompactVertex) : sizeof(GLfloat) * 8;
 }
 
+GLuint Meshes::IndexSize(const GLMesh& mesh)
+{
+	return mesh.indexType == GL_UNSIGNED_SHORT ? sizeof(GLushort) : sizeof(GLuint);
+}
 
 ///////////////////////////////////////////////////
-//	UCreateDonutMesh(GLMesh&)
-//
-//	mesh: reference to mesh structure for storing data
-//
-//	Create a torus mesh and store it in a VAO/VBO
+//	SetVertexAttributes(const GLMesh&)
 //
-//	Correct triangle drawing command:
+//	mesh: mesh whose vertex layout to describe
 //
-//	glDrawArrays(GL_TRIANGLES, 0, meshes.gTorusMesh.nVertices);
+//	Compact attributes are normalized by the GL, so
+//	the shaders read vec3 normals in [-1, 1] and vec3
+//	positions in [0, 1] that positionOffset and
+//	positionScale turn back into model space
 ///////////////////////////////////////////////////
-void Meshes::UCreateDonutMesh(GLMesh& mesh)
+void Meshes::SetVertexAttributes(const GLMesh& mesh)
 {
-	int _mainSegments = 30;
-	int _tubeSegments = 30;
-	float _mainRadius = 1.0f;
-	float _tubeRadius = 0.5f;
-
-	auto mainSegmentAngleStep = glm::radians(360.0f / float(_mainSegments));
-	auto tubeSegmentAngleStep = glm::radians(360.0f / float(_tubeSegments));
-
-	std::vector<glm::vec3> vertex_list;
-	std::vector<std::vector<glm::vec3>> segments_list;
-	std::vector<glm::vec2> texture_coords;
-	glm::vec3 center(0.0f, 0.0f, 0.0f);
-	glm::vec3 normal;
-	glm::vec3 vertex;
-	glm::vec2 text_coord;
-
-	// generate the torus vertices
-	auto currentMainSegmentAngle = 0.0f;
-	for (auto i = 0; i < _mainSegments; i++)
+	if (mesh.compact)
 	{
-		// Calculate sine and cosine of main segment angle
-		auto sinMainSegment = sin(currentMainSegmentAngle);
-		auto cosMainSegment = cos(currentMainSegmentAngle);
-		auto currentTubeSegmentAngle = 0.0f;
-		std::vector<glm::vec3> segment_points;
-		for (auto j = 0; j < _tubeSegments; j++)
-		{
-			// Calculate sine and cosine of tube segment angle
-			auto sinTubeSegment = sin(currentTubeSegmentAngle);
-			auto cosTubeSegment = cos(currentTubeSegmentAngle);
-
-			// Calculate vertex position on the surface of torus
-			auto surfacePosition = glm::vec3(
-				(_mainRadius + _tubeRadius * cosTubeSegment) * cosMainSegment,
-				(_mainRadius + _tubeRadius * cosTubeSegment) * sinMainSegment,
-				_tubeRadius * sinTubeSegment);
-
-			//vertex_list.push_back(surfacePosition);
-			segment_points.push_back(surfacePosition);
-
-			// Update current tube angle
-			currentTubeSegmentAngle += tubeSegmentAngleStep;
-		}
-		segments_list.push_back(segment_points);
-		segment_points.clear();
-
-		// Update main segment angle
-		currentMainSegmentAngle += mainSegmentAngleStep;
+		GLint stride = sizeof(CompactVertex);
+		glVertexAttribPointer(0, 3, GL_UNSIGNED_SHORT, GL_TRUE, stride, (void*)offsetof(CompactVertex, position));
+		glVertexAttribPointer(1, 4, GL_INT_2_10_10_10_REV, GL_TRUE, stride, (void*)offsetof(CompactVertex, normal));
+		glVertexAttribPointer(2, 2, GL_HALF_FLOAT, GL_FALSE, stride, (void*)offsetof(CompactVertex, uv));
 	}
-
-	float horizontalStep = 1.0 / _mainSegments;
-	float verticalStep = 1.0 / _tubeSegments;
-	float u = 0.0;
-	float v = 0.0;
-
-	// connect the various segments together, forming triangles
-	for (int i = 0; i < _mainSegments; i++)
+	else
 	{
-		for (int j = 0; j < _tubeSegments; j++)
-		{
-			if (((i + 1) < _mainSegments) && ((j + 1) < _tubeSegments))
-			{
-				vertex_list.push_back(segments_list[i][j]);
-				texture_coords.push_back(glm::vec2(u, v));
-				vertex_list.push_back(segments_list[i][j + 1]);
-				texture_coords.push_back(glm::vec2(u, v + verticalStep));
-				vertex_list.push_back(segments_list[i + 1][j + 1]);
-				texture_coords.push_back(glm::vec2(u + horizontalStep, v + verticalStep));
-				vertex_list.push_back(segments_list[i][j]);
-				texture_coords.push_back(glm::vec2(u, v));
-				vertex_list.push_back(segments_list[i + 1][j]);
-				texture_coords.push_back(glm::vec2(u + horizontalStep, v));
-				vertex_list.push_back(segments_list[i + 1][j + 1]);
-				texture_coords.push_back(glm::vec2(u + horizontalStep, v - verticalStep));
-				vertex_list.push_back(segments_list[i][j]);
-				texture_coords.push_back(glm::vec2(u, v));
-			}
-			else
-			{
-				if (((i + 1) == _mainSegments) && ((j + 1) == _tubeSegments))
-				{
-					vertex_list.push_back(segments_list[i][j]);
-					texture_coords.push_back(glm::vec2(u, v));
-					vertex_list.push_back(segments_list[i][0]);
-					texture_coords.push_back(glm::vec2(u, 0));
-					vertex_list.push_back(segments_list[0][0]);
-					texture_coords.push_back(glm::vec2(0, 0));
-					vertex_list.push_back(segments_list[i][j]);
-					texture_coords.push_back(glm::vec2(u, v));
-					vertex_list.push_back(segments_list[0][j]);
-					texture_coords.push_back(glm::vec2(0, v));
-					vertex_list.push_back(segments_list[0][0]);
-					texture_coords.push_back(glm::vec2(0, 0));
-					vertex_list.push_back(segments_list[i][j]);
-					texture_coords.push_back(glm::vec2(u, v));
-				}
-				else if ((i + 1) == _mainSegments)
-				{
-					vertex_list.push_back(segments_list[i][j]);
-					texture_coords.push_back(glm::vec2(u, v));
-					vertex_list.push_back(segments_list[i][j + 1]);
-					texture_coords.push_back(glm::vec2(u, v + verticalStep));
-					vertex_list.push_back(segments_list[0][j + 1]);
-					texture_coords.push_back(glm::vec2(0, v + verticalStep));
-					vertex_list.push_back(segments_list[i][j]);
-					texture_coords.push_back(glm::vec2(u, v));
-					vertex_list.push_back(segments_list[0][j]);
-					texture_coords.push_back(glm::vec2(0, v));
-					vertex_list.push_back(segments_list[0][j + 1]);
-					texture_coords.push_back(glm::vec2(0, v + verticalStep));
-					vertex_list.push_back(segments_list[i][j]);
-					texture_coords.push_back(glm::vec2(u, v));
-				}
-				else if ((j + 1) == _tubeSegments)
-				{
-					vertex_list.push_back(segments_list[i][j]);
-					texture_coords.push_back(glm::vec2(u, v));
-					vertex_list.push_back(segments_list[i][0]);
-					texture_coords.push_back(glm::vec2(u, 0));
-					vertex_list.push_back(segments_list[i + 1][0]);
-					texture_coords.push_back(glm::vec2(u + horizontalStep, 0));
-					vertex_list.push_back(segments_list[i][j]);
-					texture_coords.push_back(glm::vec2(u, v));
-					vertex_list.push_back(segments_list[i + 1][j]);
-					texture_coords.push_back(glm::vec2(u + horizontalStep, v));
-					vertex_list.push_back(segments_list[i + 1][0]);
-					texture_coords.push_back(glm::vec2(u + horizontalStep, 0));
-					vertex_list.push_back(segments_list[i][j]);
-					texture_coords.push_back(glm::vec2(u, v));
-				}
-
-			}
-			v += verticalStep;
-		}
-		v = 0.0;
-		u += horizontalStep;
+		// total float values per each type
+		const GLuint floatsPerVertex = 3;
+		const GLuint floatsPerNormal = 3;
+		const GLuint floatsPerUV = 2;
+
+		// Strides between vertex coordinates
+		GLint stride = sizeof(float) * (floatsPerVertex + floatsPerNormal + floatsPerUV);
+		glVertexAttribPointer(0, floatsPerVertex, GL_FLOAT, GL_FALSE, stride, 0);
+		glVertexAttribPointer(1, floatsPerNormal, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(float) * floatsPerVertex));
+		glVertexAttribPointer(2, floatsPerUV, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(float) * (floatsPerVertex + floatsPerNormal)));
 	}
+	glEnableVertexAttribArray(0);
+	glEnableVertexAttribArray(1);
+	glEnableVertexAttribArray(2);
+}
 
-	std::vector<GLfloat> combined_values;
+void Meshes::ReadIndices(const GLMesh& mesh, std::vector<GLuint>& indices)
+{
+	indices.resize(mesh.nIndices);
+	if (mesh.nIndices == 0)
+		return;
 
-	// combine interleaved vertices, normals, and texture coords
-	for (int i = 0; i < vertex_list.size(); i++)
+	// the copy-read target leaves the bound VAO's index buffer alone
+	glBindBuffer(GL_COPY_READ_BUFFER, mesh.vbos[1]);
+	if (mesh.indexType == GL_UNSIGNED_SHORT)
 	{
-		vertex = vertex_list[i];
-		normal = normalize(vertex);
-		text_coord = texture_coords[i];
-		combined_values.push_back(vertex.x);
-		combined_values.push_back(vertex.y);
-		combined_values.push_back(vertex.z);
-		combined_values.push_back(normal.x);
-		combined_values.push_back(normal.y);
-		combined_values.push_back(normal.z);
-		combined_values.push_back(text_coord.x);
-		combined_values.push_back(text_coord.y);
+		std::vector<GLushort> shortIndices(mesh.nIndices);
+		glGetBufferSubData(GL_COPY_READ_BUFFER, mesh.indexOffset, sizeof(GLushort) * mesh.nIndices, shortIndices.data());
+		std::copy(shortIndices.begin(), shortIndices.end(), indices.begin());
 	}
+	else
+		glGetBufferSubData(GL_COPY_READ_BUFFER, mesh.indexOffset, sizeof(GLuint) * mesh.nIndices, indices.data());
+	glBindBuffer(GL_COPY_READ_BUFFER, 0);
+}
 
-	// total float values per each type
-	const GLuint floatsPerVertex = 3;
-	const GLuint floatsPerNormal = 3;
-	const GLuint floatsPerUV = 2;
-
-	// store vertex and index count
-	mesh.nVertices = vertex_list.size();
-	mesh.nIndices = 0;
-
-	// Create VAO
-	glGenVertexArrays(1, &mesh.vao); // we can also generate multiple VAOs or buffers at the same time
-	glBindVertexArray(mesh.vao);
-
-	// Create VBOs
-	glGenBuffers(1, mesh.vbos);
-	glBindBuffer(GL_ARRAY_BUFFER, mesh.vbos[0]); // Activates the buffer
-	glBufferData(GL_ARRAY_BUFFER, sizeof(GLfloat)* combined_values.size(), combined_values.data(), GL_STATIC_DRAW); // Sends vertex or coordinate data to the GPU
-
-	// Strides between vertex coordinates
-	GLint stride = sizeof(float) * (floatsPerVertex + floatsPerNormal + floatsPerUV);
-
-	// Create Vertex Attribute Pointers
-	glVertexAttribPointer(0, floatsPerVertex, GL_FLOAT, GL_FALSE, stride, 0);
-	glEnableVertexAttribArray(0);
+///////////////////////////////////////////////////
+//	UComputeBounds(GLMesh&, const GLfloat*)
+//
+//	mesh: mesh whose nVertices is already set
+//	vertices: the interleaved position, normal and
+//	texture coordinate data uploaded to the VBO
+//
+//	Store the model-space bounding box and a bounding
+//	sphere around the box center for frustum culling
+///////////////////////////////////////////////////
+void Meshes::UComputeBounds(GLMesh& mesh, const GLfloat* vertices)
+{
+	const GLuint floatsPerVertex = 8;
 
-	glVertexAttribPointer(1, floatsPerNormal, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(float)* floatsPerVertex));
-	glEnableVertexAttribArray(1);
+	mesh.boundsMin = mesh.boundsMax = glm::vec3(vertices[0], vertices[1], vertices[2]);
+	for (GLuint i = 1; i < mesh.nVertices; ++i)
+	{
+		glm::vec3 position(vertices[i * floatsPerVertex], vertices[i * floatsPerVertex + 1], vertices[i * floatsPerVertex + 2]);
+		mesh.boundsMin = glm::min(mesh.boundsMin, position);
+		mesh.boundsMax = glm::max(mesh.boundsMax, position);
+	}
 
-	glVertexAttribPointer(2, floatsPerUV, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(float)* (floatsPerVertex + floatsPerNormal)));
-	glEnableVertexAttribArray(2);
+	// the farthest vertex from the box center gives a tighter sphere than the box corners
+	mesh.boundsCenter = (mesh.boundsMin + mesh.boundsMax) * 0.5f;
+	mesh.boundsRadius = 0.0f;
+	for (GLuint i = 0; i < mesh.nVertices; ++i)
+	{
+		glm::vec3 position(vertices[i * floatsPerVertex], vertices[i * floatsPerVertex + 1], vertices[i * floatsPerVertex + 2]);
+		mesh.boundsRadius = glm::max(mesh.boundsRadius, glm::length(position - mesh.boundsCenter));
+	}
 }
 
+// The GL objects belong to the geometry pool, which DestroyMeshes deletes
 void Meshes::UDestroyMesh(GLMesh& mesh)
 {
-	glDeleteVertexArrays(1, &mesh.vao);
-	glDeleteBuffers(2, mesh.vbos);
-}
\ No newline at end of file
+	mesh.vao = mesh.vbos[0] = mesh.vbos[1] = 0;
+	mesh.baseVertex = 0;
+	mesh.indexOffset = 0;
+}
\ No newline at end of file
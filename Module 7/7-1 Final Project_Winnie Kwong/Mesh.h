@@ -13,20 +13,105 @@
 
 #include <glm/glm.hpp>
 
+#include <vector>
+
+#include "GeometryPool.h"
+
+class AssetPack;
+class AssetPackWriter;
+
 class Meshes
 {
 
 public:
 
-	// Stores the GL data relative to a given mesh
+	// A single draw command within a mesh, e.g. the bottom fan of a cylinder
+	struct DrawRange
+	{
+		GLenum mode;        // GL_TRIANGLES, GL_TRIANGLE_FAN or GL_TRIANGLE_STRIP
+		GLuint first;       // First vertex, or first index for indexed meshes
+		GLuint count;       // Number of vertices or indices to draw
+		bool indexed;       // Draw from the mesh's index buffer
+	};
+
+	static const GLuint MAX_MESH_PARTS = 6;
+	static const GLuint MAX_MESH_LODS = 4;
+
+	// A coarser level of detail: the same parts drawn with fewer triangles
+	// of the mesh's own vertices, from indices after the full-detail ones
+	struct MeshLod
+	{
+		DrawRange parts[MAX_MESH_PARTS];	// Draw commands, one per part of the mesh
+		float error;        // Bound on how far the surface strays from full detail, in model units
+	};
+
+	// Vertex and index data of a generated mesh before it goes to the GPU:
+	// interleaved position, normal and texture coordinates, and the parts
+	// that draw it
+	struct MeshData
+	{
+		std::vector<GLfloat> vertices;
+		std::vector<GLuint> indices;
+		DrawRange parts[MAX_MESH_PARTS];
+		GLuint nParts;
+		MeshLod lods[MAX_MESH_LODS];
+		GLuint nLods;
+	};
+
+	// Tessellation of a generated round mesh. On the torus and donut,
+	// segments go around the ring and rings around the tube.
+	struct Tessellation
+	{
+		GLuint segments;    // Divisions around the y axis
+		GLuint rings;       // Divisions along it, or latitude bands of a sphere
+	};
+
+	// Grid WeldVertices rounds every position, normal and texture coordinate
+	// to by default. Vertices that round to the same values are merged, so
+	// merged vertices differ by at most this much, but two closer than this
+	// can still fall either side of a grid line and stay apart.
+	static constexpr float WELD_TOLERANCE = 1.0e-5f;
+
+	// Stores the GL data relative to a given mesh. Every mesh lives in the
+	// same geometry pool, so they all share one VAO and pair of buffers.
 	struct GLMesh
 	{
-		GLuint vao;         // Handle for the vertex array object
-		GLuint vbos[2];     // Handles for the vertex buffer objects
+		GLuint vao;         // Handle for the geometry pool's vertex array object
+		GLuint vbos[2];     // Handles for the pool's vertex and index buffers
+		GLint baseVertex;   // First vertex of the mesh in vbos[0]; indices count from it
+		size_t indexOffset;	// Byte offset of the mesh's first index in vbos[1]
 		GLuint nVertices;	// Number of vertices for the mesh
 		GLuint nIndices;    // Number of indices for the mesh
+		DrawRange parts[MAX_MESH_PARTS];	// Draw commands that make up the mesh
+		GLuint nParts;      // Number of draw commands in parts
+		MeshLod lods[MAX_MESH_LODS];	// Coarser levels of detail, finest first
+		GLuint nLods;       // Number of levels in lods
+		glm::vec3 boundsMin;	// Model-space bounding box
+		glm::vec3 boundsMax;
+		glm::vec3 boundsCenter;	// Model-space bounding sphere
+		float boundsRadius;
+		bool compact;       // Vertices are in the compact layout rather than 8 floats
+		glm::vec3 positionOffset;	// Stored positions decode to offset + scale * position
+		glm::vec3 positionScale;
+		GLenum indexType;   // GL_UNSIGNED_SHORT or GL_UNSIGNED_INT
+	};
+
+	// Many copies of one mesh drawn with instanced calls. The VAO reads the
+	// mesh's own vertex buffer plus per-instance model matrices and texture
+	// array layers, so instances of every texture draw together.
+	struct GLInstances
+	{
+		GLuint vao;         // Handle for the vertex array object
+		GLuint vbos[2];     // Handles for the per-instance model matrices and texture layers
+		GLuint nInstances;  // Number of instances
+		const GLMesh* mesh;	// Mesh every instance draws
 	};
 
+	// First of the four attribute locations taken by the per-instance model matrix
+	static const GLuint INSTANCE_MODEL_LOCATION = 4;
+	// Attribute location of the per-instance texture array layer
+	static const GLuint INSTANCE_LAYER_LOCATION = 8;
+
 	GLMesh gBoxMesh;
 	GLMesh gConeMesh;
 	GLMesh gCylinderMesh;
@@ -39,24 +124,120 @@ public:
 	GLMesh gTorusMesh;
 	GLMesh gDonutMesh;
 
+	// Tessellation CreateMeshes generates the round meshes at; set before
+	// calling it to trade detail against vertex cost. The defaults match the
+	// tables the meshes used to be typed in as, which --check-meshes compares
+	// them with.
+	Tessellation gConeTessellation = { 36, 1 };
+	Tessellation gCylinderTessellation = { 36, 1 };
+	Tessellation gTaperedCylinderTessellation = { 36, 1 };
+	Tessellation gSphereTessellation = { 16, 16 };
+	Tessellation gTorusTessellation = { 30, 30 };
+	Tessellation gDonutTessellation = { 30, 30 };
+
+	// Vertex layout CreateMeshes uploads in; set before calling it. Compact
+	// vertices take 16 bytes instead of 32: positions as 16-bit fractions of
+	// the mesh's bounding box, normals as GL_INT_2_10_10_10_REV and texture
+	// coordinates as half floats. Compact meshes of fewer than 65536
+	// vertices get 16-bit indices too.
+	bool gCompactVertices = true;
+
 public:
-	void CreateMeshes();
+	// Meshes found in pack are uploaded from its mapping if they were built by
+	// the same generators at the current tessellation and vertex layout; the
+	// rest are generated. Returns false if a mesh could not be added to the
+	// geometry pool or the pool could not be uploaded.
+	bool CreateMeshes(const AssetPack* pack = nullptr);
+
+	// The CPU stage of CreateMeshes: build the vertices and indices of every
+	// mesh flagged in needed (every mesh if it is empty) into data, one entry
+	// per mesh, on threads threads or one per core. Needs no GL context.
+	// Returns the number of threads used.
+	unsigned GenerateMeshes(std::vector<MeshData>& data, const std::vector<bool>& needed = std::vector<bool>(),
+		unsigned threads = 0) const;
 	void DestroyMeshes();
 
+	// Add the vertex and index data of every mesh to a pack being built. The
+	// data is read back from the meshes' buffers, so call after CreateMeshes.
+	void PackMeshes(AssetPackWriter& writer) const;
+
+	// Bytes of one vertex and of one index of a mesh
+	static GLuint VertexSize(const GLMesh& mesh);
+	static GLuint IndexSize(const GLMesh& mesh);
+
+	// Point attributes 0 (position), 1 (normal) and 2 (texture coordinates)
+	// of the bound VAO at the buffer bound to GL_ARRAY_BUFFER, which holds
+	// vertices laid out like mesh's
+	static void SetVertexAttributes(const GLMesh& mesh);
+
+	// Read a mesh's index buffer back, widened to 32 bits
+	static void ReadIndices(const GLMesh& mesh, std::vector<GLuint>& indices);
+
+	// Issue the draw commands for a whole mesh, or a single part of it, at a
+	// level of detail from SelectLod. The mesh's VAO must already be bound.
+	void DrawMesh(const GLMesh& mesh, GLuint lod = 0) const;
+	void DrawMeshPart(const GLMesh& mesh, GLuint part, GLuint lod = 0) const;
+
+	// Level of detail to draw a mesh at when its surface may stray by up to
+	// maxError model units: 0 for full detail, or 1 + the index of the
+	// coarsest entry of mesh.lods that is still accurate enough
+	static GLuint SelectLod(const GLMesh& mesh, float maxError);
+
+	// Instanced drawing: models and textureLayers hold one entry per instance.
+	// The instances' VAO must be bound before drawing them.
+	void CreateInstances(GLInstances& instances, const GLMesh& mesh,
+		const glm::mat4* models, const GLint* textureLayers, GLuint count);
+	void DrawInstances(const GLInstances& instances, GLuint lod = 0) const;
+	void DestroyInstances(GLInstances& instances);
+
+	// Round meshes of radius 1 around the y axis. The cone and cylinders stand
+	// from y = 0 to 1 with parts bottom, top (not on the cone) and sides; the
+	// tapered cylinder narrows to radius 0.5 at the top. The sphere is centered
+	// on the origin and drawn as one part.
+	static void GenerateCone(MeshData& data, GLuint segments, GLuint rings);
+	static void GenerateCylinder(MeshData& data, GLuint segments, GLuint rings);
+	static void GenerateTaperedCylinder(MeshData& data, GLuint segments, GLuint rings);
+	static void GenerateSphere(MeshData& data, GLuint segments, GLuint rings);
+
+	// Merge the vertices of data that round to the same multiples of
+	// tolerance and index the rest, turning every part into an indexed one
+	// that draws the same triangles. Exact duplicates are always merged.
+	// Prints the counts before and after under name.
+	static void WeldVertices(MeshData& data, const char* name, float tolerance = WELD_TOLERANCE);
+
+	// Simplify the indexed GL_TRIANGLES parts of data into up to
+	// MAX_MESH_LODS coarser levels, at errors from 0.25% to 8% of the mesh's
+	// size, and append their indices. Prints each level's triangle count.
+	static void BuildLods(MeshData& data, const char* name);
+
+	// Reorder the triangles of each indexed GL_TRIANGLES part, at every level
+	// of detail, for the vertex cache, and with clusterForOverdraw for less
+	// overdraw, unless that raises the cache miss ratio; then reorder the
+	// vertices for fetch locality. Prints the miss ratio before and after.
+	static void OptimizeMesh(MeshData& data, const char* name, bool clusterForOverdraw = true);
+
 private:
-	void UCreatePlaneMesh(GLMesh& mesh);
-	void UCreatePrismMesh(GLMesh& mesh);
-	void UCreateBoxMesh(GLMesh& mesh);
-	void UCreateConeMesh(GLMesh& mesh);
-	void UCreateCylinderMesh(GLMesh& mesh);
-	void UCreateTaperedCylinderMesh(GLMesh& mesh);
-	void UCreateTorusMesh(GLMesh& mesh);
-	void UCreatePyramid3Mesh(GLMesh& mesh);
-	void UCreatePyramid4Mesh(GLMesh& mesh);
-	void UCreateSphereMesh(GLMesh& mesh);
-	void UCreateDonutMesh(GLMesh& mesh);
+	void UGeneratePlaneMesh(MeshData& data) const;
+	void UGeneratePrismMesh(MeshData& data) const;
+	void UGenerateBoxMesh(MeshData& data) const;
+	void UGenerateConeMesh(MeshData& data) const;
+	void UGenerateCylinderMesh(MeshData& data) const;
+	void UGenerateTaperedCylinderMesh(MeshData& data) const;
+	void UGenerateTorusMesh(MeshData& data) const;
+	void UGeneratePyramid3Mesh(MeshData& data) const;
+	void UGeneratePyramid4Mesh(MeshData& data) const;
+	void UGenerateSphereMesh(MeshData& data) const;
+	void UGenerateDonutMesh(MeshData& data) const;
+
+	// Holds the vertices and indices of every mesh; CreateMeshes uploads it
+	// once all of them are added
+	GeometryPool gGeometryPool;
 
+	bool UCreateMesh(GLMesh& mesh, const MeshData& data);
+	bool UCreatePackedMesh(GLMesh& mesh, const AssetPack& pack, const char* name, const Tessellation& tessellation);
 	void UDestroyMesh(GLMesh& mesh);
+	void UComputeBounds(GLMesh& mesh, const GLfloat* vertices);
+	void UDrawRange(const GLMesh& mesh, const DrawRange& range) const;
 
 	void CalculateTriangleNormal(glm::vec3 px, glm::vec3 py, glm::vec3 pz);
-};
\ No newline at end of file
+};
\ No newline at end of file
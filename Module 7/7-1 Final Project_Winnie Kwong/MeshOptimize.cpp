@@ -0,0 +1,277 @@
+///////////////////////////////////////////////////////////////////////////////
+// meshoptimize.cpp
+// ========
+// triangle and vertex reordering for indexed triangle lists
+///////////////////////////////////////////////////////////////////////////////
+
+#include "MeshOptimize.h"
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+
+float AverageCacheMissRatio(const uint32_t* indices, size_t indexCount, size_t vertexCount, unsigned cacheSize)
+{
+	if (indexCount < 3)
+		return 0.0f;
+
+	// a vertex stays in a FIFO cache until cacheSize misses after its own
+	const size_t NOT_CACHED = SIZE_MAX;
+	std::vector<size_t> missWhenCached(vertexCount, NOT_CACHED);
+	size_t misses = 0;
+	for (size_t i = 0; i < indexCount; ++i)
+	{
+		size_t& cached = missWhenCached[indices[i]];
+		if (cached == NOT_CACHED || misses - cached >= cacheSize)
+			cached = misses++;
+	}
+	return (float)misses / (indexCount / 3);
+}
+
+///////////////////////////////////////////////////
+//	OptimizeVertexCache(uint32_t*, size_t, size_t,
+//		unsigned, std::vector<size_t>*)
+//
+//	Tipsify (Sander, Nehab and Barczak, "Fast Triangle
+//	Reordering for Vertex Locality and Reduced
+//	Overdraw", 2007): emit every remaining triangle
+//	around a fanning vertex, then move on to the vertex
+//	just used that will stay in the cache longest while
+//	its own triangles go through it. When none is left,
+//	back up through the vertices emitted so far, and
+//	failing that take the next vertex with triangles
+//	left in index order. Linear in the triangle count.
+///////////////////////////////////////////////////
+void OptimizeVertexCache(uint32_t* indices, size_t indexCount, size_t vertexCount, unsigned cacheSize,
+	std::vector<size_t>* clusters)
+{
+	const size_t triangleCount = indexCount / 3;
+	if (clusters != nullptr)
+		clusters->clear();
+	if (triangleCount == 0)
+		return;
+
+	// the triangles using each vertex, and how many of them are still to be emitted
+	std::vector<uint32_t> offsets(vertexCount + 1, 0);
+	for (size_t i = 0; i < triangleCount * 3; ++i)
+		++offsets[indices[i] + 1];
+	for (size_t v = 0; v < vertexCount; ++v)
+		offsets[v + 1] += offsets[v];
+	std::vector<uint32_t> triangles(triangleCount * 3);
+	std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+	for (size_t i = 0; i < triangleCount * 3; ++i)
+		triangles[fill[indices[i]]++] = (uint32_t)(i / 3);
+	std::vector<uint32_t> live(vertexCount);
+	for (size_t v = 0; v < vertexCount; ++v)
+		live[v] = offsets[v + 1] - offsets[v];
+
+	// a vertex is cached while fewer than cacheSize misses came after its own
+	std::vector<uint32_t> cacheTime(vertexCount, 0);
+	uint32_t time = cacheSize + 1;
+	auto inCache = [&](uint32_t v) { return time - cacheTime[v] <= cacheSize; };
+
+	std::vector<bool> emitted(triangleCount, false);
+	std::vector<uint32_t> output;
+	output.reserve(triangleCount * 3);
+	std::vector<uint32_t> deadEnd;
+	std::vector<uint32_t> candidates;
+	size_t cursor = 0;
+
+	auto skipDeadEnd = [&]() -> int64_t
+	{
+		while (!deadEnd.empty())
+		{
+			uint32_t v = deadEnd.back();
+			deadEnd.pop_back();
+			if (live[v] > 0)
+				return v;
+		}
+		for (; cursor < vertexCount; ++cursor)
+		{
+			if (live[cursor] > 0)
+				return (int64_t)cursor;
+		}
+		return -1;
+	};
+
+	int64_t fanning = indices[0];
+	while (fanning >= 0)
+	{
+		if (clusters != nullptr && !inCache((uint32_t)fanning))
+			clusters->push_back(output.size());
+
+		candidates.clear();
+		for (uint32_t a = offsets[fanning]; a < offsets[fanning + 1]; ++a)
+		{
+			uint32_t triangle = triangles[a];
+			if (emitted[triangle])
+				continue;
+			emitted[triangle] = true;
+			for (int k = 0; k < 3; ++k)
+			{
+				uint32_t v = indices[triangle * 3 + k];
+				output.push_back(v);
+				deadEnd.push_back(v);
+				candidates.push_back(v);
+				--live[v];
+				if (!inCache(v))
+					cacheTime[v] = time++;
+			}
+		}
+
+		// the oldest candidate that is still cached once its remaining
+		// triangles (up to two new vertices each) have been emitted
+		int64_t next = -1;
+		int64_t bestPriority = -1;
+		for (uint32_t v : candidates)
+		{
+			if (live[v] == 0)
+				continue;
+			int64_t priority = 0;
+			if (time - cacheTime[v] + 2 * live[v] <= cacheSize)
+				priority = time - cacheTime[v];
+			if (priority > bestPriority)
+			{
+				bestPriority = priority;
+				next = v;
+			}
+		}
+		fanning = next >= 0 ? next : skipDeadEnd();
+	}
+
+	std::copy(output.begin(), output.end(), indices);
+}
+
+///////////////////////////////////////////////////
+//	OptimizeOverdraw(uint32_t*, size_t, const float*,
+//		size_t, const std::vector<size_t>&, float,
+//		unsigned)
+//
+//	The splits follow Tipsify's paper: each cluster is
+//	walked with a cache that starts cold, and a new
+//	cluster starts after any triangle that brings the
+//	run's miss ratio down to the limit. Each cluster is
+//	then measured by how far its area-weighted center
+//	lies out from the mesh's center along its average
+//	normal, and they are drawn from the most outward
+//	to the least.
+///////////////////////////////////////////////////
+void OptimizeOverdraw(uint32_t* indices, size_t indexCount, const float* positions, size_t floatsPerVertex,
+	const std::vector<size_t>& clusters, float threshold, unsigned cacheSize)
+{
+	if (clusters.empty() || indexCount < 3)
+		return;
+
+	size_t vertexCount = 0;
+	for (size_t i = 0; i < indexCount; ++i)
+		vertexCount = std::max(vertexCount, (size_t)indices[i] + 1);
+	const float limit = threshold * AverageCacheMissRatio(indices, indexCount, vertexCount, cacheSize);
+
+	std::vector<size_t> splits;
+	const size_t NOT_CACHED = SIZE_MAX;
+	std::vector<size_t> missWhenCached(vertexCount, NOT_CACHED);
+	size_t misses = 0;
+	for (size_t c = 0; c < clusters.size(); ++c)
+	{
+		size_t end = c + 1 < clusters.size() ? clusters[c + 1] : indexCount;
+		size_t start = clusters[c];
+		size_t startMisses = misses = misses + cacheSize;	// ages every cached vertex out
+		splits.push_back(start);
+		for (size_t i = start; i + 2 < end; i += 3)
+		{
+			for (int k = 0; k < 3; ++k)
+			{
+				size_t& cached = missWhenCached[indices[i + k]];
+				if (cached == NOT_CACHED || misses - cached >= cacheSize)
+					cached = misses++;
+			}
+			size_t next = i + 3;
+			if (next < end && (float)(misses - startMisses) / ((next - start) / 3) <= limit)
+			{
+				splits.push_back(next);
+				start = next;
+				startMisses = misses = misses + cacheSize;
+			}
+		}
+	}
+	if (splits.size() < 2)
+		return;
+
+	auto position = [&](uint32_t v) { return glm::vec3(positions[v * floatsPerVertex], positions[v * floatsPerVertex + 1], positions[v * floatsPerVertex + 2]); };
+
+	struct Cluster
+	{
+		size_t first;
+		size_t count;
+		glm::vec3 center;       // sum of triangle centers times twice their area
+		glm::vec3 normal;       // sum of triangle normals times twice their area
+		float area;
+		float outward;
+	};
+
+	std::vector<Cluster> order(splits.size());
+	glm::vec3 meshCenter(0.0f);
+	float meshArea = 0.0f;
+	for (size_t c = 0; c < splits.size(); ++c)
+	{
+		Cluster& cluster = order[c];
+		cluster.first = splits[c];
+		cluster.count = (c + 1 < splits.size() ? splits[c + 1] : indexCount) - cluster.first;
+		cluster.center = cluster.normal = glm::vec3(0.0f);
+		cluster.area = 0.0f;
+		for (size_t i = cluster.first; i + 2 < cluster.first + cluster.count; i += 3)
+		{
+			glm::vec3 p0 = position(indices[i]), p1 = position(indices[i + 1]), p2 = position(indices[i + 2]);
+			glm::vec3 normal = glm::cross(p1 - p0, p2 - p0);
+			float area = glm::length(normal);
+			cluster.center += (p0 + p1 + p2) * (area / 3.0f);
+			cluster.normal += normal;
+			cluster.area += area;
+		}
+		meshCenter += cluster.center;
+		meshArea += cluster.area;
+	}
+	if (meshArea <= 0.0f)
+		return;
+	meshCenter /= meshArea;
+
+	for (Cluster& cluster : order)
+	{
+		float length = glm::length(cluster.normal);
+		cluster.outward = cluster.area > 0.0f && length > 0.0f ?
+			glm::dot(cluster.center / cluster.area - meshCenter, cluster.normal / length) : 0.0f;
+	}
+	std::stable_sort(order.begin(), order.end(), [](const Cluster& a, const Cluster& b) { return a.outward > b.outward; });
+
+	std::vector<uint32_t> sorted;
+	sorted.reserve(indexCount);
+	for (const Cluster& cluster : order)
+		sorted.insert(sorted.end(), indices + cluster.first, indices + cluster.first + cluster.count);
+	std::copy(sorted.begin(), sorted.end(), indices);
+}
+
+void OptimizeVertexFetch(std::vector<float>& vertices, size_t floatsPerVertex, std::vector<uint32_t>& indices)
+{
+	const size_t vertexCount = vertices.size() / floatsPerVertex;
+	const uint32_t UNUSED = UINT32_MAX;
+
+	std::vector<uint32_t> remap(vertexCount, UNUSED);
+	uint32_t next = 0;
+	for (uint32_t& index : indices)
+	{
+		if (remap[index] == UNUSED)
+			remap[index] = next++;
+		index = remap[index];
+	}
+	for (size_t v = 0; v < vertexCount; ++v)
+	{
+		if (remap[v] == UNUSED)
+			remap[v] = next++;
+	}
+
+	std::vector<float> reordered(vertices.size());
+	for (size_t v = 0; v < vertexCount; ++v)
+		std::copy(vertices.begin() + v * floatsPerVertex, vertices.begin() + (v + 1) * floatsPerVertex,
+			reordered.begin() + remap[v] * floatsPerVertex);
+	vertices.swap(reordered);
+}
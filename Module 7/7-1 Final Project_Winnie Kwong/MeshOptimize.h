@@ -0,0 +1,44 @@
+///////////////////////////////////////////////////////////////////////////////
+// meshoptimize.h
+// ========
+// reorder the triangles and vertices of indexed triangle lists for the GPU:
+// triangles for the post-transform vertex cache (Tipsify) and, optionally,
+// for less overdraw, and vertices in the order the triangles first use them
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Entries of the FIFO post-transform cache the orderings are tuned for and
+// the cache miss ratio is measured with
+const unsigned VERTEX_CACHE_SIZE = 16;
+
+// Average cache miss ratio: vertices transformed per triangle drawing
+// indexCount indices through a FIFO cache of cacheSize entries. 3 is no
+// reuse at all; a regular grid approaches 0.5.
+float AverageCacheMissRatio(const uint32_t* indices, size_t indexCount, size_t vertexCount,
+	unsigned cacheSize = VERTEX_CACHE_SIZE);
+
+// Reorder the triangles of indices in place for a cache of cacheSize entries.
+// When clusters is given it receives the first index of each run of
+// triangles that starts after the cache went cold, the units
+// OptimizeOverdraw may move around without losing the cache order.
+void OptimizeVertexCache(uint32_t* indices, size_t indexCount, size_t vertexCount,
+	unsigned cacheSize = VERTEX_CACHE_SIZE, std::vector<size_t>* clusters = nullptr);
+
+// Sort the clusters found by OptimizeVertexCache so that those facing away
+// from the mesh's center come first; on convex-ish meshes they hide the
+// ones behind them. The clusters are first split further wherever the run
+// so far misses the cache at no more than threshold times the miss ratio
+// of the whole list, which bounds what the sort costs the cache. positions
+// holds x, y, z at the start of every floatsPerVertex floats.
+void OptimizeOverdraw(uint32_t* indices, size_t indexCount, const float* positions, size_t floatsPerVertex,
+	const std::vector<size_t>& clusters, float threshold = 1.05f, unsigned cacheSize = VERTEX_CACHE_SIZE);
+
+// Renumber the vertices in the order indices first reference them, so the
+// vertex fetch walks the buffer forward. Vertices nothing references are
+// kept, after the rest.
+void OptimizeVertexFetch(std::vector<float>& vertices, size_t floatsPerVertex, std::vector<uint32_t>& indices);
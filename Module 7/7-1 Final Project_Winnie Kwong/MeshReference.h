@@ -0,0 +1,27 @@
+///////////////////////////////////////////////////////////////////////////////
+// meshreference.h
+// ========
+// the cone, cylinder, tapered cylinder and sphere as they were typed into
+// meshes.cpp before they were generated, kept to check the generators against
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Mesh.h"
+
+// Largest differences the generated round meshes may show against the old
+// tables and still look the same. Positions are in model units; the tables
+// were typed to two decimals. Texture coordinates of the caps were typed to
+// two decimals as well, and some of them rounded by eye.
+const float REFERENCE_POSITION_TOLERANCE = 0.01f;
+const float REFERENCE_TEXCOORD_TOLERANCE = 0.03f;
+
+// Generate the cone, cylinder, tapered cylinder and sphere at the
+// tessellations of meshes and compare each part with the old tables. Every
+// point of either surface must lie near the other, the texture coordinates
+// at a point must agree, and the generated normals may lean away from the
+// old facets by no more than half the angle between neighbouring facets,
+// which is what smooth shading changes on a faceted surface. A few typos in
+// the tables are fixed before comparing and listed. Prints one line per part
+// and returns false if any difference is out of tolerance.
+bool CheckReferenceMeshes(const Meshes& meshes);
@@ -0,0 +1,354 @@
+///////////////////////////////////////////////////////////////////////////////
+// meshsimplify.cpp
+// ========
+// quadric error metric simplification by half-edge collapses
+///////////////////////////////////////////////////////////////////////////////
+
+#include "MeshSimplify.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+	// Symmetric 4x4 matrix summing the squared distances to a set of planes
+	struct Quadric
+	{
+		double a00, a01, a02, a03, a11, a12, a13, a22, a23, a33;
+	};
+
+	void AddPlane(Quadric& q, const double n[3], double d)
+	{
+		q.a00 += n[0] * n[0];
+		q.a01 += n[0] * n[1];
+		q.a02 += n[0] * n[2];
+		q.a03 += n[0] * d;
+		q.a11 += n[1] * n[1];
+		q.a12 += n[1] * n[2];
+		q.a13 += n[1] * d;
+		q.a22 += n[2] * n[2];
+		q.a23 += n[2] * d;
+		q.a33 += d * d;
+	}
+
+	void AddQuadric(Quadric& q, const Quadric& other)
+	{
+		q.a00 += other.a00; q.a01 += other.a01; q.a02 += other.a02; q.a03 += other.a03;
+		q.a11 += other.a11; q.a12 += other.a12; q.a13 += other.a13;
+		q.a22 += other.a22; q.a23 += other.a23;
+		q.a33 += other.a33;
+	}
+
+	// Sum of squared distances from p to the quadric's planes
+	double QuadricError(const Quadric& q, const float* p)
+	{
+		double x = p[0], y = p[1], z = p[2];
+		return q.a00 * x * x + q.a11 * y * y + q.a22 * z * z
+			+ 2.0 * (q.a01 * x * y + q.a02 * x * z + q.a12 * y * z)
+			+ 2.0 * (q.a03 * x + q.a13 * y + q.a23 * z) + q.a33;
+	}
+
+	void Cross(const float* p0, const float* p1, const float* p2, double n[3])
+	{
+		double u[3] = { (double)p1[0] - p0[0], (double)p1[1] - p0[1], (double)p1[2] - p0[2] };
+		double v[3] = { (double)p2[0] - p0[0], (double)p2[1] - p0[1], (double)p2[2] - p0[2] };
+		n[0] = u[1] * v[2] - u[2] * v[1];
+		n[1] = u[2] * v[0] - u[0] * v[2];
+		n[2] = u[0] * v[1] - u[1] * v[0];
+	}
+
+	struct PositionKey
+	{
+		long long x, y, z;
+
+		bool operator==(const PositionKey& other) const { return x == other.x && y == other.y && z == other.z; }
+	};
+
+	struct PositionKeyHash
+	{
+		size_t operator()(const PositionKey& key) const
+		{
+			return (size_t)((key.x * 73856093) ^ (key.y * 19349663) ^ (key.z * 83492791));
+		}
+	};
+
+	// Move every vertex at one position onto vertices at another
+	struct Collapse
+	{
+		uint32_t from;      // position group that goes away
+		uint32_t to;        // position group it joins
+		double error;
+	};
+}
+
+float MeshExtent(const float* vertices, size_t vertexCount, size_t floatsPerVertex)
+{
+	if (vertexCount == 0)
+		return 0.0f;
+
+	float low[3] = { FLT_MAX, FLT_MAX, FLT_MAX };
+	float high[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+	for (size_t v = 0; v < vertexCount; ++v)
+	{
+		for (int k = 0; k < 3; ++k)
+		{
+			low[k] = std::min(low[k], vertices[v * floatsPerVertex + k]);
+			high[k] = std::max(high[k], vertices[v * floatsPerVertex + k]);
+		}
+	}
+	return std::sqrt((high[0] - low[0]) * (high[0] - low[0]) + (high[1] - low[1]) * (high[1] - low[1]) +
+		(high[2] - low[2]) * (high[2] - low[2]));
+}
+
+///////////////////////////////////////////////////
+//	SimplifyMesh(...)
+//
+//	Works on position groups, the sets of vertices
+//	sharing a position, so that a collapse can never
+//	tear a seam. Each pass lists the collapses of every
+//	remaining edge, moving whichever end costs less,
+//	and applies them cheapest first; a group and the
+//	groups around it take part in one collapse per pass,
+//	so the flip test of each sees its neighbours as
+//	they are. Passes repeat until the target count is
+//	met or no collapse under the error limit is left.
+///////////////////////////////////////////////////
+size_t SimplifyMesh(uint32_t* destination, const uint32_t* indices, size_t indexCount,
+	const float* vertices, size_t vertexCount, size_t floatsPerVertex,
+	size_t* partEnds, size_t partCount, size_t targetIndexCount, float targetError, float* resultError)
+{
+	auto position = [&](uint32_t v) { return vertices + v * floatsPerVertex; };
+
+	const float extent = MeshExtent(vertices, vertexCount, floatsPerVertex);
+	const double errorLimit = (double)targetError * extent * (double)targetError * extent;
+
+	// position groups
+	std::vector<uint32_t> group(vertexCount);
+	std::vector<std::vector<uint32_t>> members;
+	{
+		const float cell = std::max(extent * 1.0e-6f, FLT_MIN);
+		std::unordered_map<PositionKey, uint32_t, PositionKeyHash> groups;
+		groups.reserve(vertexCount);
+		for (size_t v = 0; v < vertexCount; ++v)
+		{
+			const float* p = position((uint32_t)v);
+			PositionKey key = { std::llround(p[0] / cell), std::llround(p[1] / cell), std::llround(p[2] / cell) };
+			auto found = groups.emplace(key, (uint32_t)members.size());
+			if (found.second)
+				members.emplace_back();
+			group[v] = found.first->second;
+			members[group[v]].push_back((uint32_t)v);
+		}
+	}
+	const size_t groupCount = members.size();
+
+	// current triangles as vertex ids, and the part each came from
+	std::vector<uint32_t> triangles(indices, indices + indexCount / 3 * 3);
+	std::vector<uint32_t> triangleParts(triangles.size() / 3);
+	for (size_t t = 0, part = 0; t < triangleParts.size(); ++t)
+	{
+		while (part + 1 < partCount && t * 3 >= partEnds[part])
+			++part;
+		triangleParts[t] = (uint32_t)part;
+	}
+	std::vector<uint32_t> remap(vertexCount);
+	for (size_t v = 0; v < vertexCount; ++v)
+		remap[v] = (uint32_t)v;
+
+	// planes of the original triangles, each counted once: the root of the
+	// sum is then a length in model units, whatever the mesh's scale, and no
+	// less than the distance to any one of the planes
+	std::vector<Quadric> quadrics(groupCount, Quadric());
+	std::unordered_map<uint64_t, uint32_t> edgeUses;
+	for (size_t t = 0; t < triangles.size(); t += 3)
+	{
+		double n[3];
+		Cross(position(triangles[t]), position(triangles[t + 1]), position(triangles[t + 2]), n);
+		double length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+		if (length > 0.0)
+		{
+			n[0] /= length; n[1] /= length; n[2] /= length;
+			const float* p0 = position(triangles[t]);
+			double d = -(n[0] * p0[0] + n[1] * p0[1] + n[2] * p0[2]);
+			for (int k = 0; k < 3; ++k)
+				AddPlane(quadrics[group[triangles[t + k]]], n, d);
+		}
+		for (int k = 0; k < 3; ++k)
+		{
+			uint64_t a = group[triangles[t + k]], b = group[triangles[t + (k + 1) % 3]];
+			if (a != b)
+				++edgeUses[std::min(a, b) << 32 | std::max(a, b)];
+		}
+	}
+
+	// an edge not shared by exactly two triangles is a border or non-manifold; keep it in place
+	std::vector<char> locked(groupCount, 0);
+	for (const auto& edge : edgeUses)
+	{
+		if (edge.second != 2)
+			locked[edge.first >> 32] = locked[edge.first & 0xFFFFFFFF] = 1;
+	}
+
+	// drop triangles that are degenerate to begin with
+	auto rebuild = [&]()
+	{
+		size_t kept = 0;
+		for (size_t t = 0; t < triangles.size(); t += 3)
+		{
+			uint32_t a = remap[triangles[t]], b = remap[triangles[t + 1]], c = remap[triangles[t + 2]];
+			if (group[a] == group[b] || group[b] == group[c] || group[a] == group[c])
+				continue;
+			triangleParts[kept / 3] = triangleParts[t / 3];
+			triangles[kept++] = a;
+			triangles[kept++] = b;
+			triangles[kept++] = c;
+		}
+		triangles.resize(kept);
+		triangleParts.resize(kept / 3);
+	};
+	rebuild();
+
+	std::vector<uint32_t> adjacencyOffsets(groupCount + 1);
+	std::vector<uint32_t> adjacency;
+	std::vector<Collapse> collapses;
+	std::vector<char> touched(groupCount);
+	double maxError = 0.0;
+
+	// true if moving from onto to turns a triangle around, or nearly
+	auto flips = [&](uint32_t from, uint32_t to)
+	{
+		for (uint32_t a = adjacencyOffsets[from]; a < adjacencyOffsets[from + 1]; ++a)
+		{
+			const uint32_t* corners = &triangles[adjacency[a] * 3];
+			if (group[corners[0]] == to || group[corners[1]] == to || group[corners[2]] == to)
+				continue;
+
+			const float* before[3];
+			const float* after[3];
+			for (int k = 0; k < 3; ++k)
+			{
+				before[k] = position(corners[k]);
+				after[k] = group[corners[k]] == from ? position(members[to][0]) : before[k];
+			}
+			double n0[3], n1[3];
+			Cross(before[0], before[1], before[2], n0);
+			Cross(after[0], after[1], after[2], n1);
+			double dot = n0[0] * n1[0] + n0[1] * n1[1] + n0[2] * n1[2];
+			double lengths = std::sqrt((n0[0] * n0[0] + n0[1] * n0[1] + n0[2] * n0[2]) * (n1[0] * n1[0] + n1[1] * n1[1] + n1[2] * n1[2]));
+			if (dot <= 0.25 * lengths)
+				return true;
+		}
+		return false;
+	};
+
+	while (triangles.size() > targetIndexCount)
+	{
+		// triangles around each position group
+		std::fill(adjacencyOffsets.begin(), adjacencyOffsets.end(), 0);
+		for (uint32_t v : triangles)
+			++adjacencyOffsets[group[v] + 1];
+		for (size_t g = 0; g < groupCount; ++g)
+			adjacencyOffsets[g + 1] += adjacencyOffsets[g];
+		adjacency.resize(triangles.size());
+		std::vector<uint32_t> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+		for (size_t i = 0; i < triangles.size(); ++i)
+			adjacency[fill[group[triangles[i]]]++] = (uint32_t)(i / 3);
+
+		// each edge once, from the triangle that has it in increasing group order
+		collapses.clear();
+		for (size_t t = 0; t < triangles.size(); t += 3)
+		{
+			for (int k = 0; k < 3; ++k)
+			{
+				uint32_t a = group[triangles[t + k]], b = group[triangles[t + (k + 1) % 3]];
+				if (a > b || (locked[a] && locked[b]))
+					continue;
+
+				Quadric q = quadrics[a];
+				AddQuadric(q, quadrics[b]);
+				double aToB = locked[a] ? DBL_MAX : QuadricError(q, position(members[b][0]));
+				double bToA = locked[b] ? DBL_MAX : QuadricError(q, position(members[a][0]));
+				Collapse collapse = aToB <= bToA ? Collapse{ a, b, aToB } : Collapse{ b, a, bToA };
+				if (collapse.error <= errorLimit)
+					collapses.push_back(collapse);
+			}
+		}
+		std::sort(collapses.begin(), collapses.end(), [](const Collapse& x, const Collapse& y) { return x.error < y.error; });
+
+		std::fill(touched.begin(), touched.end(), 0);
+		size_t removable = (triangles.size() - targetIndexCount) / 3;
+		size_t removed = 0;
+		size_t applied = 0;
+		for (const Collapse& collapse : collapses)
+		{
+			if (removed >= removable)
+				break;
+			if (touched[collapse.from] || touched[collapse.to] || flips(collapse.from, collapse.to))
+				continue;
+
+			// each vertex joins the vertex at the new position with the nearest attributes
+			for (uint32_t v : members[collapse.from])
+			{
+				uint32_t best = 0;
+				double bestDistance = DBL_MAX;
+				for (uint32_t w : members[collapse.to])
+				{
+					if (remap[w] != w)
+						continue;
+					double distance = 0.0;
+					for (size_t k = 3; k < floatsPerVertex; ++k)
+					{
+						double difference = (double)vertices[v * floatsPerVertex + k] - vertices[w * floatsPerVertex + k];
+						distance += difference * difference;
+					}
+					if (distance < bestDistance)
+					{
+						bestDistance = distance;
+						best = w;
+					}
+				}
+				remap[v] = best;
+			}
+
+			for (uint32_t a = adjacencyOffsets[collapse.from]; a < adjacencyOffsets[collapse.from + 1]; ++a)
+			{
+				const uint32_t* corners = &triangles[adjacency[a] * 3];
+				bool shared = false;
+				for (int k = 0; k < 3; ++k)
+				{
+					touched[group[corners[k]]] = 1;
+					shared = shared || group[corners[k]] == collapse.to;
+				}
+				removed += shared ? 1 : 0;
+			}
+
+			for (uint32_t v : members[collapse.from])
+				group[v] = collapse.to;
+			members[collapse.to].insert(members[collapse.to].end(), members[collapse.from].begin(), members[collapse.from].end());
+			members[collapse.from].clear();
+			AddQuadric(quadrics[collapse.to], quadrics[collapse.from]);
+			touched[collapse.to] = 1;
+
+			maxError = std::max(maxError, collapse.error);
+			++applied;
+		}
+		if (applied == 0)
+			break;
+		rebuild();
+	}
+
+	std::copy(triangles.begin(), triangles.end(), destination);
+	for (size_t part = 0; part < partCount; ++part)
+		partEnds[part] = 0;
+	for (size_t t = 0; t < triangleParts.size(); ++t)
+		partEnds[triangleParts[t]] = t * 3 + 3;
+	for (size_t part = 1; part < partCount; ++part)
+		partEnds[part] = std::max(partEnds[part], partEnds[part - 1]);
+
+	if (resultError != nullptr)
+		*resultError = extent > 0.0f ? (float)(std::sqrt(std::max(maxError, 0.0)) / extent) : 0.0f;
+	return triangles.size();
+}
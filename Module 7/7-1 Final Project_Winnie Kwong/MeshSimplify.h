@@ -0,0 +1,38 @@
+///////////////////////////////////////////////////////////////////////////////
+// meshsimplify.h
+// ========
+// quadric error metric simplification of indexed triangle lists (Garland and
+// Heckbert, "Surface Simplification Using Quadric Error Metrics", 1997), for
+// building the coarser levels of detail of a mesh from its own vertices
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Diagonal of the bounding box of a mesh's positions; simplification errors
+// are fractions of it. vertices holds x, y, z at the start of every
+// floatsPerVertex floats.
+float MeshExtent(const float* vertices, size_t vertexCount, size_t floatsPerVertex);
+
+// Collapse edges of the triangle list indices, least quadric error first,
+// until at most targetIndexCount indices are left or the next collapse would
+// move the surface by more than targetError times the mesh extent. The error
+// of a collapse is the root of the summed squared distances from the kept
+// vertex to the planes of every original triangle merged into it, an upper
+// bound on its distance from each of them.
+//
+// No vertex is moved or added, so the result written to destination indexes
+// the same vertex buffer. Vertices sharing a position collapse together, each
+// onto the vertex at the new position whose remaining floats (normal and
+// texture coordinates) are nearest its own, so hard edges and texture seams
+// stay closed. Vertices on open borders never move.
+//
+// partEnds holds the index where each of partCount parts of indices ends;
+// surviving triangles keep their order, and on return partEnds gives where
+// each part ends in destination. Returns the index count left; the largest
+// error reached, as a fraction of the extent, goes to resultError.
+size_t SimplifyMesh(uint32_t* destination, const uint32_t* indices, size_t indexCount,
+	const float* vertices, size_t vertexCount, size_t floatsPerVertex,
+	size_t* partEnds, size_t partCount, size_t targetIndexCount, float targetError, float* resultError = nullptr);
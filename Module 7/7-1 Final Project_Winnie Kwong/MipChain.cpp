@@ -0,0 +1,194 @@
+///////////////////////////////////////////////////////////////////////////////
+// mipchain.cpp
+// ========
+// gamma-correct mip chain generation and the chain cache file format
+///////////////////////////////////////////////////////////////////////////////
+
+#include "MipChain.h"
+#include "ImageOps.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+
+namespace
+{
+	// Linear values use 14 bits so that HalveImage16 can add four of them
+	const int LINEAR_MAX = 16383;
+
+	const uint32_t CACHE_MAGIC = 0x4350494D;	// "MIPC"
+	// Bumped whenever the filter or the file layout changes, so that chains
+	// built the old way are rebuilt
+	const uint32_t CACHE_VERSION = 2;
+
+	struct CacheHeader
+	{
+		uint32_t magic;
+		uint32_t version;
+		uint64_t sourceHash;
+		int32_t width;
+		int32_t height;
+		uint64_t bytes;
+		uint32_t solid;         // level 0 is a single color
+		uint32_t color;         // that color, RGBA bytes
+	};
+
+	// sRGB <-> linear conversion tables, built once
+	struct GammaTables
+	{
+		uint16_t toLinear[256];
+		unsigned char toSrgb[LINEAR_MAX + 1];
+
+		GammaTables()
+		{
+			for (int i = 0; i < 256; ++i)
+			{
+				double c = i / 255.0;
+				double linear = c <= 0.04045 ? c / 12.92 : std::pow((c + 0.055) / 1.055, 2.4);
+				toLinear[i] = (uint16_t)std::lround(linear * LINEAR_MAX);
+			}
+			for (int i = 0; i <= LINEAR_MAX; ++i)
+			{
+				double linear = (double)i / LINEAR_MAX;
+				double c = linear <= 0.0031308 ? linear * 12.92 : 1.055 * std::pow(linear, 1.0 / 2.4) - 0.055;
+				toSrgb[i] = (unsigned char)std::lround(c * 255.0);
+			}
+		}
+	};
+
+	const GammaTables& Gamma()
+	{
+		static const GammaTables tables;
+		return tables;
+	}
+}
+
+int MipLevelCount(int width, int height)
+{
+	int levels = 1;
+	while ((std::max(width, height) >> levels) > 0)
+		++levels;
+	return levels;
+}
+
+int MipLevelSize(int size, int level)
+{
+	return std::max(size >> level, 1);
+}
+
+size_t MipLevelOffset(int width, int height, int level)
+{
+	size_t offset = 0;
+	for (int i = 0; i < level; ++i)
+		offset += (size_t)MipLevelSize(width, i) * MipLevelSize(height, i) * 4;
+	return offset;
+}
+
+size_t MipChainBytes(int width, int height)
+{
+	return MipLevelOffset(width, height, MipLevelCount(width, height));
+}
+
+///////////////////////////////////////////////////
+//	BuildMipChain(...)
+//
+//	Level 0 is copied as is. The rest are reduced in
+//	a 14-bit linear copy of the image, so that rounding
+//	does not pile up from level to level, and each
+//	reduced level is encoded back to sRGB bytes.
+///////////////////////////////////////////////////
+void BuildMipChain(const unsigned char* image, int width, int height, unsigned char* chain)
+{
+	const GammaTables& gamma = Gamma();
+	const size_t pixelCount = (size_t)width * height;
+	memcpy(chain, image, pixelCount * 4);
+
+	std::vector<uint16_t> linear(pixelCount * 4);
+	for (size_t i = 0; i < pixelCount; ++i)
+	{
+		linear[i * 4 + 0] = gamma.toLinear[image[i * 4 + 0]];
+		linear[i * 4 + 1] = gamma.toLinear[image[i * 4 + 1]];
+		linear[i * 4 + 2] = gamma.toLinear[image[i * 4 + 2]];
+		linear[i * 4 + 3] = (uint16_t)((image[i * 4 + 3] * LINEAR_MAX + 127) / 255);
+	}
+
+	std::vector<uint16_t> reduced(linear.size());
+	const int levels = MipLevelCount(width, height);
+	for (int level = 1; level < levels; ++level)
+	{
+		int sourceWidth = MipLevelSize(width, level - 1);
+		int sourceHeight = MipLevelSize(height, level - 1);
+		HalveImage16(linear.data(), sourceWidth, sourceHeight, reduced.data());
+		linear.swap(reduced);
+
+		unsigned char* out = chain + MipLevelOffset(width, height, level);
+		size_t levelPixels = (size_t)MipLevelSize(width, level) * MipLevelSize(height, level);
+		for (size_t i = 0; i < levelPixels; ++i)
+		{
+			out[i * 4 + 0] = gamma.toSrgb[linear[i * 4 + 0]];
+			out[i * 4 + 1] = gamma.toSrgb[linear[i * 4 + 1]];
+			out[i * 4 + 2] = gamma.toSrgb[linear[i * 4 + 2]];
+			out[i * 4 + 3] = (unsigned char)((linear[i * 4 + 3] * 255 + LINEAR_MAX / 2) / LINEAR_MAX);
+		}
+	}
+}
+
+uint64_t HashBytes(const unsigned char* data, size_t size)
+{
+	uint64_t hash = 14695981039346656037ull;
+	for (size_t i = 0; i < size; ++i)
+	{
+		hash ^= data[i];
+		hash *= 1099511628211ull;
+	}
+	return hash;
+}
+
+bool ReadMipCache(const char* path, uint64_t sourceHash, int width, int height, std::vector<unsigned char>& chain)
+{
+	std::ifstream file(path, std::ios::binary);
+	if (!file)
+		return false;
+
+	CacheHeader header;
+	if (!file.read((char*)&header, sizeof(header)))
+		return false;
+	if (header.magic != CACHE_MAGIC || header.version != CACHE_VERSION || header.sourceHash != sourceHash ||
+		header.width != width || header.height != height || header.bytes != MipChainBytes(width, height))
+		return false;
+
+	chain.resize((size_t)header.bytes);
+	if (!file.read((char*)chain.data(), chain.size()))
+	{
+		chain.clear();
+		return false;
+	}
+	return true;
+}
+
+bool WriteMipCache(const char* path, uint64_t sourceHash, int width, int height, const std::vector<unsigned char>& chain)
+{
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+	if (!file)
+		return false;
+
+	CacheHeader header = { CACHE_MAGIC, CACHE_VERSION, sourceHash, width, height, chain.size(), 0, 0 };
+	header.solid = IsSolidColor(chain.data(), (size_t)width * height, SOLID_COLOR_TOLERANCE, header.color) ? 1 : 0;
+	file.write((const char*)&header, sizeof(header));
+	file.write((const char*)chain.data(), chain.size());
+	return (bool)file;
+}
+
+bool ReadMipCacheColor(const char* path, uint64_t sourceHash, uint32_t& color)
+{
+	std::ifstream file(path, std::ios::binary);
+	CacheHeader header;
+	if (!file || !file.read((char*)&header, sizeof(header)))
+		return false;
+	if (header.magic != CACHE_MAGIC || header.version != CACHE_VERSION || header.sourceHash != sourceHash || !header.solid)
+		return false;
+
+	color = header.color;
+	return true;
+}
@@ -0,0 +1,42 @@
+///////////////////////////////////////////////////////////////////////////////
+// mipchain.h
+// ========
+// build RGBA mip chains on the CPU, averaging in linear light rather than on
+// the sRGB-encoded bytes, and keep finished chains in cache files so later
+// runs skip decoding and filtering
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Levels of a full chain down to 1x1, as glTexStorage expects
+int MipLevelCount(int width, int height);
+
+// Size of one level, max(1, size >> level)
+int MipLevelSize(int size, int level);
+
+// Bytes of an RGBA chain with every level packed back to back, largest first,
+// and the offset of one level inside it
+size_t MipChainBytes(int width, int height);
+size_t MipLevelOffset(int width, int height, int level);
+
+// Fill chain (MipChainBytes bytes) with image as level 0 and each further
+// level a 2x2 box reduction of the one above. Color is treated as sRGB and
+// filtered in linear space; alpha is filtered as is.
+void BuildMipChain(const unsigned char* image, int width, int height, unsigned char* chain);
+
+// 64-bit FNV-1a of a file's bytes; identifies the source of a cached chain
+uint64_t HashBytes(const unsigned char* data, size_t size);
+
+// Read a chain written by WriteMipCache. Fails unless the file holds a chain
+// of exactly width x height built from a source with sourceHash.
+bool ReadMipCache(const char* path, uint64_t sourceHash, int width, int height, std::vector<unsigned char>& chain);
+bool WriteMipCache(const char* path, uint64_t sourceHash, int width, int height, const std::vector<unsigned char>& chain);
+
+// Read only the header of a cache written for sourceHash, whatever its size.
+// True if the image is a single color (IsSolidColor with
+// SOLID_COLOR_TOLERANCE, checked when the cache was written), returned in color.
+bool ReadMipCacheColor(const char* path, uint64_t sourceHash, uint32_t& color);
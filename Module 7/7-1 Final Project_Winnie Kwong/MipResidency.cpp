@@ -0,0 +1,79 @@
+///////////////////////////////////////////////////////////////////////////////
+// mipresidency.cpp
+// ========
+// per-layer mip level planning under a memory budget
+///////////////////////////////////////////////////////////////////////////////
+
+#include "MipResidency.h"
+
+#include <algorithm>
+
+void MipResidency::Reset(GLsizei layerCount, const std::vector<size_t>& bytes, int base, size_t budgetBytes)
+{
+	levelBytes = bytes;
+	baseLevel = std::max(0, std::min(base, (int)levelBytes.size() - 1));
+	budget = budgetBytes;
+	wanted.assign(layerCount, baseLevel);
+	pixels.assign(layerCount, 0.0f);
+	order.resize(layerCount);
+}
+
+void MipResidency::Request(GLint layer, int level, float size)
+{
+	if (layer < 0 || layer >= (GLint)wanted.size())
+		return;
+	wanted[layer] = std::min(wanted[layer], std::max(level, 0));
+	pixels[layer] = std::max(pixels[layer], size);
+}
+
+size_t MipResidency::LayerBytes(int finestLevel) const
+{
+	size_t bytes = 0;
+	for (int level = std::max(finestLevel, 0); level < (int)levelBytes.size(); ++level)
+		bytes += levelBytes[level];
+	return bytes;
+}
+
+///////////////////////////////////////////////////
+//	Plan(const std::vector<int>&, std::vector<int>&)
+//
+//	Start every layer at the base level, then hand
+//	out one finer level at a time: every layer that
+//	wants level n - 1 gets it, largest on screen first,
+//	before any layer gets level n - 2. What is left
+//	of the budget keeps levels already resident,
+//	again largest first.
+///////////////////////////////////////////////////
+void MipResidency::Plan(const std::vector<int>& resident, std::vector<int>& target)
+{
+	const GLsizei layerCount = (GLsizei)wanted.size();
+	for (GLsizei layer = 0; layer < layerCount; ++layer)
+		order[layer] = layer;
+	std::stable_sort(order.begin(), order.end(), [this](GLsizei a, GLsizei b) { return pixels[a] > pixels[b]; });
+
+	target.assign(layerCount, baseLevel);
+	size_t total = LayerBytes(baseLevel) * layerCount;
+	for (int level = baseLevel - 1; level >= 0; --level)
+	{
+		for (GLsizei layer : order)
+		{
+			if (wanted[layer] <= level && target[layer] == level + 1 && total + levelBytes[level] <= budget)
+			{
+				target[layer] = level;
+				total += levelBytes[level];
+			}
+		}
+	}
+
+	for (GLsizei layer : order)
+	{
+		while (layer < (GLsizei)resident.size() && resident[layer] < target[layer] && total + levelBytes[target[layer] - 1] <= budget)
+		{
+			--target[layer];
+			total += levelBytes[target[layer]];
+		}
+	}
+
+	std::fill(wanted.begin(), wanted.end(), baseLevel);
+	std::fill(pixels.begin(), pixels.end(), 0.0f);
+}
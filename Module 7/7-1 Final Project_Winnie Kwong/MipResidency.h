@@ -0,0 +1,51 @@
+///////////////////////////////////////////////////////////////////////////////
+// mipresidency.h
+// ========
+// decide which mip levels of each texture array layer stay on the GPU: every
+// frame the renderer asks for the level each layer needs at its size on
+// screen, and the plan gives out finer levels under a byte budget, one level
+// at a time across all layers so that no texture gets sharp while another
+// is left far too blurry
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+
+#include <cstddef>
+#include <vector>
+
+class MipResidency
+{
+public:
+	// layerCount layers whose level n takes levelBytes[n] bytes per layer.
+	// Levels from baseLevel down to 1x1 are always resident and count
+	// against budgetBytes like the rest.
+	void Reset(GLsizei layerCount, const std::vector<size_t>& levelBytes, int baseLevel, size_t budgetBytes);
+
+	// Layer should have level this frame; it covers pixels on screen, which
+	// orders the layers when the budget runs short. Repeated requests for a
+	// layer keep the finest level and the largest size.
+	void Request(GLint layer, int level, float pixels);
+
+	// Finest level of every layer for this frame's requests, given the finest
+	// level each holds now. Levels no longer asked for are kept while the
+	// budget allows, so a layer seen at the edge of two levels is not
+	// evicted and uploaded again every frame. Clears the requests.
+	void Plan(const std::vector<int>& resident, std::vector<int>& target);
+
+	// Bytes of one layer holding finestLevel and every coarser level
+	size_t LayerBytes(int finestLevel) const;
+
+	int BaseLevel() const { return baseLevel; }
+	size_t Budget() const { return budget; }
+
+private:
+	std::vector<size_t> levelBytes;
+	int baseLevel = 0;
+	size_t budget = 0;
+
+	std::vector<int> wanted;        // finest level requested this frame, per layer
+	std::vector<float> pixels;      // largest size on screen this frame, per layer
+	std::vector<GLsizei> order;     // layers by size on screen, largest first
+};
@@ -0,0 +1,84 @@
+///////////////////////////////////////////////////////////////////////////////
+// renderqueue.cpp
+// ========
+// sort key packing and radix sort of the render queue
+///////////////////////////////////////////////////////////////////////////////
+
+#include "RenderQueue.h"
+
+#include <cstring>
+
+namespace
+{
+	const int PROGRAM_SHIFT = 56;
+	const int VAO_SHIFT = 40;
+	const int TEXTURE_SHIFT = 32;
+
+	const uint64_t PROGRAM_MASK = 0xFFull << PROGRAM_SHIFT;
+	const uint64_t VAO_MASK = 0xFFFFull << VAO_SHIFT;
+	const uint64_t TEXTURE_MASK = 0xFFull << TEXTURE_SHIFT;
+}
+
+uint64_t RenderQueue::MakeKey(GLuint program, GLuint vao, GLint texture, float depth)
+{
+	// non-negative floats order the same way as their bit patterns
+	uint32_t depthBits = 0;
+	if (depth > 0.0f)
+		memcpy(&depthBits, &depth, sizeof(depthBits));
+
+	return ((uint64_t)(program & 0xFF) << PROGRAM_SHIFT) |
+		((uint64_t)(vao & 0xFFFF) << VAO_SHIFT) |
+		((uint64_t)(texture & 0xFF) << TEXTURE_SHIFT) |
+		depthBits;
+}
+
+///////////////////////////////////////////////////
+//	Sort()
+//
+//	Least significant digit first, so each pass is a
+//	stable counting sort on one byte of the key. A pass
+//	where every key has the same byte is skipped; with
+//	one program most of the high bytes are constant.
+///////////////////////////////////////////////////
+void RenderQueue::Sort()
+{
+	if (items.size() < 2)
+		return;
+
+	scratch.resize(items.size());
+	for (int shift = 0; shift < 64; shift += 8)
+	{
+		GLuint counts[256] = {};
+		for (const Item& item : items)
+			counts[(item.key >> shift) & 0xFF]++;
+
+		if (counts[(items[0].key >> shift) & 0xFF] == items.size())
+			continue;
+
+		GLuint offsets[256];
+		GLuint offset = 0;
+		for (int digit = 0; digit < 256; ++digit)
+		{
+			offsets[digit] = offset;
+			offset += counts[digit];
+		}
+
+		for (const Item& item : items)
+			scratch[offsets[(item.key >> shift) & 0xFF]++] = item;
+		items.swap(scratch);
+	}
+}
+
+GLuint RenderQueue::CountStateChanges() const
+{
+	GLuint changes = 0;
+	for (size_t i = 0; i < items.size(); ++i)
+	{
+		uint64_t key = items[i].key;
+		uint64_t previous = i > 0 ? items[i - 1].key : ~key;
+		changes += (key & PROGRAM_MASK) != (previous & PROGRAM_MASK);
+		changes += (key & VAO_MASK) != (previous & VAO_MASK);
+		changes += (key & TEXTURE_MASK) != (previous & TEXTURE_MASK);
+	}
+	return changes;
+}
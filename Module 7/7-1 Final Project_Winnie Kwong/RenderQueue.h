@@ -0,0 +1,47 @@
+///////////////////////////////////////////////////////////////////////////////
+// renderqueue.h
+// ========
+// sort draw submissions by a 64-bit key of program, VAO, texture and depth
+// so consecutive draws share as much GL state as possible
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+
+#include <cstdint>
+#include <vector>
+
+class RenderQueue
+{
+public:
+	// One submission: its sort key and the caller's index of what to draw
+	struct Item
+	{
+		uint64_t key;
+		GLuint index;
+	};
+
+	// Key layout, most significant first:
+	//	program (8 bits) | VAO (16 bits) | texture (8 bits) | depth (32 bits)
+	// texture is whatever selects the draw's texture, a unit or an array layer.
+	// GL names are truncated to their field; that only affects how well
+	// draws group, never which state a draw uses. Depth sorts front to back.
+	static uint64_t MakeKey(GLuint program, GLuint vao, GLint texture, float depth);
+
+	void Clear() { items.clear(); }
+	void Push(uint64_t key, GLuint index) { items.push_back({ key, index }); }
+
+	// LSD radix sort of the items by key, eight bits per pass
+	void Sort();
+
+	// Program, VAO and texture changes needed to draw the items in their
+	// current order, counting the first draw's state as changes
+	GLuint CountStateChanges() const;
+
+	const std::vector<Item>& Items() const { return items; }
+
+private:
+	std::vector<Item> items;
+	std::vector<Item> scratch;
+};
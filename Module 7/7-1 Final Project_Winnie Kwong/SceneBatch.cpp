@@ -0,0 +1,330 @@
+///////////////////////////////////////////////////////////////////////////////
+// scenebatch.cpp
+// ========
+// draw a static scene with one glMultiDrawElementsIndirect call
+///////////////////////////////////////////////////////////////////////////////
+
+#include "SceneBatch.h"
+#include "GLState.h"
+#include "GpuResources.h"
+
+#include <cstddef>
+#include <iostream>
+
+namespace
+{
+	// Where a mesh ended up inside the merged buffers, at each level of detail
+	struct MergedMesh
+	{
+		const Meshes::GLMesh* mesh;
+		GLint baseVertex;
+		GLuint firstIndex[1 + Meshes::MAX_MESH_LODS][Meshes::MAX_MESH_PARTS];
+		GLuint indexCount[1 + Meshes::MAX_MESH_LODS][Meshes::MAX_MESH_PARTS];
+	};
+
+	void AppendTriangle(std::vector<GLuint>& out, GLuint a, GLuint b, GLuint c)
+	{
+		// degenerate triangles only exist to stitch strips and fans together
+		if (a == b || b == c || a == c)
+			return;
+		out.push_back(a);
+		out.push_back(b);
+		out.push_back(c);
+	}
+
+	///////////////////////////////////////////////////
+	//	AppendTriangles(...)
+	//
+	//	range: part of a mesh to convert
+	//	meshIndices: the mesh's index buffer, used when range.indexed
+	//	out: merged index list to append to
+	//
+	//	Unroll a triangle list, fan or strip into a plain
+	//	triangle list so that every part can be drawn
+	//	with one GL_TRIANGLES command
+	///////////////////////////////////////////////////
+	void AppendTriangles(const Meshes::DrawRange& range, const std::vector<GLuint>& meshIndices, std::vector<GLuint>& out)
+	{
+		std::vector<GLuint> v(range.count);
+		for (GLuint i = 0; i < range.count; ++i)
+			v[i] = range.indexed ? meshIndices[range.first + i] : range.first + i;
+
+		switch (range.mode)
+		{
+		case GL_TRIANGLES:
+			for (GLuint i = 0; i + 2 < range.count; i += 3)
+				AppendTriangle(out, v[i], v[i + 1], v[i + 2]);
+			break;
+
+		case GL_TRIANGLE_FAN:
+			for (GLuint i = 1; i + 1 < range.count; ++i)
+				AppendTriangle(out, v[0], v[i], v[i + 1]);
+			break;
+
+		case GL_TRIANGLE_STRIP:
+			// every other triangle of a strip is wound the other way round
+			for (GLuint i = 0; i + 2 < range.count; ++i)
+			{
+				if (i % 2 == 0)
+					AppendTriangle(out, v[i], v[i + 1], v[i + 2]);
+				else
+					AppendTriangle(out, v[i + 1], v[i], v[i + 2]);
+			}
+			break;
+
+		default:
+			std::cout << "WARNING: scene batch skipped an unsupported primitive mode " << range.mode << std::endl;
+			break;
+		}
+	}
+}
+
+void SceneBatch::Add(const Meshes::GLMesh& mesh, int part, const glm::mat4& model, GLint textureLayer,
+	const glm::vec3& diffuseColor, const glm::vec3& specularColor, float shininess)
+{
+	if (part >= (int)mesh.nParts)
+	{
+		std::cout << "WARNING: scene batch ignored a draw of missing mesh part " << part << std::endl;
+		return;
+	}
+
+	QueuedDraw draw;
+	draw.mesh = &mesh;
+	draw.part = part;
+	draw.record.model = model;
+	draw.record.diffuseColor = diffuseColor;
+	draw.record.shininess = shininess;
+	draw.record.specularColor = specularColor;
+	draw.record.textureLayer = textureLayer;
+	draw.record.positionOffset = mesh.positionOffset;
+	draw.record.positionScale = mesh.positionScale;
+	draws.push_back(draw);
+}
+
+///////////////////////////////////////////////////
+//	Build()
+//
+//	Merge the indices of every mesh used by the queued
+//	draws into one index buffer, drawn with the
+//	vertices of the shared geometry pool, and create
+//	the draw record storage buffer and the indirect
+//	command buffer.
+//	Textures come from one array selected per draw by
+//	the record's layer, so every draw shares one call.
+///////////////////////////////////////////////////
+bool SceneBatch::Build()
+{
+	if (draws.empty())
+	{
+		std::cout << "Scene batch has nothing to draw" << std::endl;
+		return false;
+	}
+
+	// the vertices stay where they are in the geometry pool, in the meshes'
+	// own layout, and each draw's record decodes its positions; only the
+	// indices of each mesh are read back once and merged
+	const Meshes::GLMesh& layout = *draws[0].mesh;
+	std::vector<MergedMesh> merged;
+	std::vector<GLuint> indices;
+	bool shortIndices = true;
+
+	for (const QueuedDraw& draw : draws)
+	{
+		const Meshes::GLMesh& mesh = *draw.mesh;
+		bool known = false;
+		for (const MergedMesh& m : merged)
+			known = known || m.mesh == &mesh;
+		if (known)
+			continue;
+
+		if (mesh.vbos[0] != layout.vbos[0] || mesh.compact != layout.compact)
+		{
+			std::cout << "Scene batch needs every mesh in the same geometry pool" << std::endl;
+			return false;
+		}
+
+		MergedMesh m = {};
+		m.mesh = &mesh;
+		m.baseVertex = mesh.baseVertex;
+
+		// indices are relative to each mesh's baseVertex, so 16 bits do if every mesh's fit
+		std::vector<GLuint> meshIndices;
+		Meshes::ReadIndices(mesh, meshIndices);
+		shortIndices = shortIndices && mesh.indexType == GL_UNSIGNED_SHORT;
+
+		// each level's parts back to back, like the full mesh's
+		for (GLuint lod = 0; lod <= mesh.nLods; ++lod)
+		{
+			const Meshes::DrawRange* parts = lod == 0 ? mesh.parts : mesh.lods[lod - 1].parts;
+			for (GLuint part = 0; part < mesh.nParts; ++part)
+			{
+				m.firstIndex[lod][part] = (GLuint)indices.size();
+				AppendTriangles(parts[part], meshIndices, indices);
+				m.indexCount[lod][part] = (GLuint)indices.size() - m.firstIndex[lod][part];
+			}
+		}
+		merged.push_back(m);
+	}
+	indexType = shortIndices ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+
+	// one indirect command per draw; baseInstance carries the draw's record index
+	std::vector<DrawRecord> records;
+	std::vector<GLuint> drawIds;
+	commands.clear();
+	levels.clear();
+
+	for (const QueuedDraw& draw : draws)
+	{
+		const MergedMesh* m = nullptr;
+		for (const MergedMesh& candidate : merged)
+			if (candidate.mesh == draw.mesh)
+				m = &candidate;
+
+		// the parts of a mesh were appended back to back, so a whole mesh is one
+		// range; levels the mesh does not have repeat its coarsest one
+		for (GLuint level = 0; level < LEVELS; ++level)
+		{
+			GLuint lod = level < draw.mesh->nLods ? level : draw.mesh->nLods;
+			IndexRange range;
+			if (draw.part < 0)
+			{
+				GLuint last = draw.mesh->nParts - 1;
+				range.firstIndex = m->firstIndex[lod][0];
+				range.count = m->firstIndex[lod][last] + m->indexCount[lod][last] - m->firstIndex[lod][0];
+			}
+			else
+			{
+				range.firstIndex = m->firstIndex[lod][draw.part];
+				range.count = m->indexCount[lod][draw.part];
+			}
+			levels.push_back(range);
+		}
+
+		DrawElementsIndirectCommand command;
+		command.firstIndex = levels[commands.size() * LEVELS].firstIndex;
+		command.count = levels[commands.size() * LEVELS].count;
+		command.instanceCount = 1;
+		command.baseVertex = m->baseVertex;
+		command.baseInstance = (GLuint)commands.size();
+
+		drawIds.push_back((GLuint)commands.size());
+		records.push_back(draw.record);
+		commands.push_back(command);
+	}
+
+	glGenVertexArrays(1, &vao);
+	gGpuResources.Created(GpuResourceType::VertexArray, vao, "scene batch");
+	gGLState.BindVertexArray(vao);
+
+	glBindBuffer(GL_ARRAY_BUFFER, layout.vbos[0]);
+	Meshes::SetVertexAttributes(layout);
+
+	// the draw id advances once per instance, and each command starts at its own baseInstance
+	glGenBuffers(1, &drawIdBuffer);
+	gGpuResources.Created(GpuResourceType::Buffer, drawIdBuffer, "scene batch draw ids");
+	glBindBuffer(GL_ARRAY_BUFFER, drawIdBuffer);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(GLuint) * drawIds.size(), drawIds.data(), GL_STATIC_DRAW);
+	gGpuResources.SetBytes(GpuResourceType::Buffer, drawIdBuffer, sizeof(GLuint) * drawIds.size());
+	glVertexAttribIPointer(3, 1, GL_UNSIGNED_INT, sizeof(GLuint), 0);
+	glVertexAttribDivisor(3, 1);
+	glEnableVertexAttribArray(3);
+
+	glGenBuffers(1, &indexBuffer);
+	gGpuResources.Created(GpuResourceType::Buffer, indexBuffer, "scene batch indices");
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
+	if (indexType == GL_UNSIGNED_SHORT)
+	{
+		std::vector<GLushort> narrowed(indices.begin(), indices.end());
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(GLushort) * narrowed.size(), narrowed.data(), GL_STATIC_DRAW);
+		gGpuResources.SetBytes(GpuResourceType::Buffer, indexBuffer, sizeof(GLushort) * narrowed.size());
+	}
+	else
+	{
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(GLuint) * indices.size(), indices.data(), GL_STATIC_DRAW);
+		gGpuResources.SetBytes(GpuResourceType::Buffer, indexBuffer, sizeof(GLuint) * indices.size());
+	}
+
+	gGLState.BindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	glGenBuffers(1, &recordBuffer);
+	gGpuResources.Created(GpuResourceType::Buffer, recordBuffer, "scene batch records");
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, recordBuffer);
+	glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(DrawRecord) * records.size(), records.data(), GL_STATIC_DRAW);
+	gGpuResources.SetBytes(GpuResourceType::Buffer, recordBuffer, sizeof(DrawRecord) * records.size());
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+	glGenBuffers(1, &commandBuffer);
+	gGpuResources.Created(GpuResourceType::Buffer, commandBuffer, "scene batch commands");
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, commandBuffer);
+	glBufferData(GL_DRAW_INDIRECT_BUFFER, sizeof(DrawElementsIndirectCommand) * commands.size(), commands.data(), GL_DYNAMIC_DRAW);
+	gGpuResources.SetBytes(GpuResourceType::Buffer, commandBuffer, sizeof(DrawElementsIndirectCommand) * commands.size());
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+
+	GLuint triangles = 0;
+	for (const DrawElementsIndirectCommand& command : commands)
+		triangles += command.count / 3;
+	std::cout << "INFO: Scene batch: " << draws.size() << " draws, " << merged.size() << " meshes, "
+		<< triangles << " triangles at full detail in one multi-draw call" << std::endl;
+
+	return true;
+}
+
+void SceneBatch::UpdateModel(GLsizei draw, const glm::mat4& model)
+{
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, recordBuffer);
+	glBufferSubData(GL_SHADER_STORAGE_BUFFER, sizeof(DrawRecord) * draw + offsetof(DrawRecord, model),
+		sizeof(glm::mat4), &model);
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+}
+
+void SceneBatch::SetVisible(const unsigned char* visible, const unsigned char* lods)
+{
+	// only upload the commands when a flag or level changed
+	bool changed = false;
+	for (size_t i = 0; i < commands.size(); ++i)
+	{
+		GLuint instanceCount = visible[i] ? 1 : 0;
+		const IndexRange& range = levels[i * LEVELS + (lods != nullptr && lods[i] < LEVELS ? lods[i] : 0)];
+		changed = changed || commands[i].instanceCount != instanceCount ||
+			commands[i].firstIndex != range.firstIndex || commands[i].count != range.count;
+		commands[i].instanceCount = instanceCount;
+		commands[i].firstIndex = range.firstIndex;
+		commands[i].count = range.count;
+	}
+
+	if (changed)
+	{
+		glBindBuffer(GL_DRAW_INDIRECT_BUFFER, commandBuffer);
+		glBufferSubData(GL_DRAW_INDIRECT_BUFFER, 0, sizeof(DrawElementsIndirectCommand) * commands.size(), commands.data());
+		glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+	}
+}
+
+void SceneBatch::Draw() const
+{
+	gGLState.BindVertexArray(vao);
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, commandBuffer);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, DRAW_BLOCK_BINDING, recordBuffer);
+
+	glMultiDrawElementsIndirect(GL_TRIANGLES, indexType, 0, (GLsizei)commands.size(), 0);
+
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+}
+
+void SceneBatch::Destroy()
+{
+	const GLuint buffers[] = { indexBuffer, drawIdBuffer, recordBuffer, commandBuffer };
+	gGpuResources.Deleted(GpuResourceType::VertexArray, vao);
+	gGpuResources.Deleted(GpuResourceType::Buffer, 4, buffers);
+	gGLState.DeleteVertexArray(vao);
+	glDeleteBuffers(1, &indexBuffer);
+	glDeleteBuffers(1, &drawIdBuffer);
+	glDeleteBuffers(1, &recordBuffer);
+	glDeleteBuffers(1, &commandBuffer);
+	vao = indexBuffer = drawIdBuffer = recordBuffer = commandBuffer = 0;
+
+	draws.clear();
+	commands.clear();
+	levels.clear();
+}
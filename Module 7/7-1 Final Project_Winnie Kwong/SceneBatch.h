@@ -0,0 +1,88 @@
+///////////////////////////////////////////////////////////////////////////////
+// scenebatch.h
+// ========
+// draw a static scene with one glMultiDrawElementsIndirect call: vertices are
+// read straight from the meshes' shared geometry pool, the indices of every
+// mesh are merged into one index buffer, and each draw's model matrix,
+// material, texture array layer and position decoding live in a shader
+// storage buffer
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+#include "Mesh.h"
+#include "ShaderBlocks.h"
+
+class SceneBatch
+{
+public:
+	// Queue one draw; part is an index into mesh.parts, or -1 for the whole mesh
+	void Add(const Meshes::GLMesh& mesh, int part, const glm::mat4& model, GLint textureLayer,
+		const glm::vec3& diffuseColor, const glm::vec3& specularColor, float shininess);
+
+	// Merge the queued meshes' indices and upload them with the draw records
+	// and commands. Vertices are drawn straight from the meshes' geometry
+	// pool, so every mesh must be in the same one, and their index buffers
+	// are read back once, so they must still exist.
+	bool Build();
+
+	// Replace the model matrix of a built draw; draw is its position in Add order
+	void UpdateModel(GLsizei draw, const glm::mat4& model);
+
+	// Skip culled draws: visible holds one flag per draw in Add order. Draws
+	// stay in the indirect buffer with an instance count of zero. lods, if
+	// given, holds each draw's level of detail from Meshes::SelectLod.
+	void SetVisible(const unsigned char* visible, const unsigned char* lods = nullptr);
+
+	// Submit every queued draw. The batch shader program must be in use and
+	// the scene's texture array bound.
+	void Draw() const;
+
+	void Destroy();
+
+	GLsizei DrawCount() const { return (GLsizei)draws.size(); }
+
+private:
+	// Memory layout of one glMultiDrawElementsIndirect command
+	struct DrawElementsIndirectCommand
+	{
+		GLuint count;
+		GLuint instanceCount;
+		GLuint firstIndex;
+		GLint baseVertex;
+		GLuint baseInstance;
+	};
+
+	struct QueuedDraw
+	{
+		const Meshes::GLMesh* mesh;
+		int part;
+		DrawRecord record;
+	};
+
+	// Indices of a draw at one level of detail inside the merged index buffer
+	struct IndexRange
+	{
+		GLuint firstIndex;
+		GLuint count;
+	};
+	static const GLuint LEVELS = 1 + Meshes::MAX_MESH_LODS;
+
+	// draws, records and commands all share the Add order
+	std::vector<QueuedDraw> draws;
+	std::vector<DrawElementsIndirectCommand> commands;  // CPU copy of commandBuffer
+	std::vector<IndexRange> levels;     // LEVELS per draw, full detail first
+
+	GLuint vao = 0;             // reads vertices from the meshes' geometry pool
+	GLuint indexBuffer = 0;     // merged triangle-list indices
+	GLuint drawIdBuffer = 0;    // 0..n-1, read per draw through baseInstance
+	GLuint recordBuffer = 0;    // DrawRecord per draw (shader storage)
+	GLuint commandBuffer = 0;   // DrawElementsIndirectCommand per draw
+	GLenum indexType = GL_UNSIGNED_INT;	// of indexBuffer
+};
@@ -0,0 +1,218 @@
+///////////////////////////////////////////////////////////////////////////////
+// scenefile.cpp
+// ========
+// load a scene description file into render records
+//
+// Format: one entry per line, '#' starts a comment.
+//
+//	object   <mesh> <part> <sx sy sz> <angle> <ax ay az> <px py pz> <layer>
+//	         <dr dg db> <sr sg sb> <shininess>
+//	         [name <id>] [parent <id>]
+//	instance (same fields as object; part must be "all", no name or parent)
+//
+// mesh is one of plane, box, cone, cylinder, taperedcylinder, prism, sphere,
+// pyramid3, pyramid4, torus, donut. part is "all" or an index into the
+// mesh's parts. The angle is in radians. An object with a parent is placed
+// relative to the parent's position and rotation (not its scale); the parent
+// must be named on an earlier line.
+///////////////////////////////////////////////////////////////////////////////
+
+#include "SceneFile.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+namespace
+{
+	const Meshes::GLMesh* FindMesh(const Meshes& meshes, const char* name)
+	{
+		struct NamedMesh { const char* name; const Meshes::GLMesh* mesh; };
+		const NamedMesh table[] =
+		{
+			{ "plane", &meshes.gPlaneMesh },
+			{ "box", &meshes.gBoxMesh },
+			{ "cone", &meshes.gConeMesh },
+			{ "cylinder", &meshes.gCylinderMesh },
+			{ "taperedcylinder", &meshes.gTaperedCylinderMesh },
+			{ "prism", &meshes.gPrismMesh },
+			{ "sphere", &meshes.gSphereMesh },
+			{ "pyramid3", &meshes.gPyramid3Mesh },
+			{ "pyramid4", &meshes.gPyramid4Mesh },
+			{ "torus", &meshes.gTorusMesh },
+			{ "donut", &meshes.gDonutMesh },
+		};
+
+		for (const NamedMesh& entry : table)
+		{
+			if (strcmp(entry.name, name) == 0)
+				return entry.mesh;
+		}
+		return nullptr;
+	}
+
+	// Splits a line into whitespace separated tokens in place
+	class Tokens
+	{
+	public:
+		explicit Tokens(char* line) : cursor(line) {}
+
+		const char* Next()
+		{
+			while (*cursor == ' ' || *cursor == '\t' || *cursor == '\r')
+				++cursor;
+			if (*cursor == '\0')
+				return nullptr;
+
+			const char* token = cursor;
+			while (*cursor != '\0' && *cursor != ' ' && *cursor != '\t' && *cursor != '\r')
+				++cursor;
+			if (*cursor != '\0')
+				*cursor++ = '\0';
+			return token;
+		}
+
+		bool Float(float& value)
+		{
+			const char* token = Next();
+			char* end = nullptr;
+			if (token != nullptr)
+				value = strtof(token, &end);
+			return token != nullptr && *end == '\0';
+		}
+
+		bool Vec3(glm::vec3& value)
+		{
+			return Float(value.x) && Float(value.y) && Float(value.z);
+		}
+
+		bool Int(int& value)
+		{
+			const char* token = Next();
+			char* end = nullptr;
+			if (token != nullptr)
+				value = (int)strtol(token, &end, 10);
+			return token != nullptr && *end == '\0';
+		}
+
+	private:
+		char* cursor;
+	};
+
+	// Transform fields of a line, before they become a transform node
+	struct Placement
+	{
+		glm::vec3 scale;
+		float angle;
+		glm::vec3 axis;
+		glm::vec3 position;
+	};
+
+	bool ParseRecord(Tokens& tokens, const Meshes& meshes, RenderRecord& record, Placement& placement)
+	{
+		const char* meshName = tokens.Next();
+		record.mesh = meshName != nullptr ? FindMesh(meshes, meshName) : nullptr;
+		if (record.mesh == nullptr)
+			return false;
+
+		const char* part = tokens.Next();
+		if (part == nullptr)
+			return false;
+		if (strcmp(part, "all") == 0)
+			record.part = -1;
+		else
+		{
+			char* end = nullptr;
+			record.part = (int)strtol(part, &end, 10);
+			if (*end != '\0' || record.part < 0 || record.part >= (int)record.mesh->nParts)
+				return false;
+		}
+
+		return tokens.Vec3(placement.scale) && tokens.Float(placement.angle) && tokens.Vec3(placement.axis) &&
+			tokens.Vec3(placement.position) && tokens.Int(record.textureLayer) &&
+			tokens.Vec3(record.diffuseColor) && tokens.Vec3(record.specularColor) && tokens.Float(record.shininess);
+	}
+}
+
+///////////////////////////////////////////////////
+//	LoadSceneFile(const char*, const Meshes&, SceneDescription&)
+//
+//	filename: scene file to read
+//	meshes: created meshes that records point into
+//	scene: receives the records; cleared first
+//
+//	Read every object and instance line of the file
+///////////////////////////////////////////////////
+bool LoadSceneFile(const char* filename, const Meshes& meshes, SceneDescription& scene)
+{
+	std::ifstream file(filename);
+	if (!file)
+	{
+		std::cout << "Failed to open scene file " << filename << std::endl;
+		return false;
+	}
+
+	scene.objects.clear();
+	scene.instances.clear();
+	scene.transforms.Clear();
+	scene.nodes.clear();
+
+	std::string line;
+	int lineNumber = 0;
+	while (std::getline(file, line))
+	{
+		++lineNumber;
+
+		size_t comment = line.find('#');
+		if (comment != std::string::npos)
+			line.erase(comment);
+
+		Tokens tokens(&line[0]);
+		const char* keyword = tokens.Next();
+		if (keyword == nullptr)
+			continue;
+
+		RenderRecord record;
+		Placement placement;
+		bool isObject = strcmp(keyword, "object") == 0;
+		bool isInstance = strcmp(keyword, "instance") == 0;
+		bool valid = (isObject || isInstance) && ParseRecord(tokens, meshes, record, placement);
+
+		// optional name and parent; instanced draws always cover every part of
+		// their mesh and are placed once, so they take neither
+		const char* name = nullptr;
+		int parent = -1;
+		for (const char* option = tokens.Next(); valid && option != nullptr; option = tokens.Next())
+		{
+			const char* value = tokens.Next();
+			if (value != nullptr && strcmp(option, "name") == 0 && scene.nodes.count(value) == 0)
+				name = value;
+			else if (value != nullptr && strcmp(option, "parent") == 0 && scene.nodes.count(value) != 0)
+				parent = scene.nodes[value];
+			else
+				valid = false;
+		}
+		valid = valid && !(isInstance && (record.part >= 0 || name != nullptr || parent >= 0));
+
+		if (!valid)
+		{
+			std::cout << "ERROR: " << filename << "(" << lineNumber << "): cannot read scene entry" << std::endl;
+			return false;
+		}
+
+		record.transform = scene.transforms.Add(placement.scale, placement.angle, placement.axis, placement.position, parent);
+		if (name != nullptr)
+			scene.nodes[name] = record.transform;
+
+		if (isObject)
+			scene.objects.push_back(record);
+		else
+			scene.instances.push_back(record);
+	}
+
+	std::cout << "INFO: Loaded " << scene.objects.size() << " objects and " << scene.instances.size()
+		<< " instances from " << filename << std::endl;
+	return true;
+}
@@ -0,0 +1,45 @@
+///////////////////////////////////////////////////////////////////////////////
+// scenefile.h
+// ========
+// load a scene description file: one line per object naming its mesh,
+// transform, texture layer and material, flattened into render records
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+
+#include <glm/glm.hpp>
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "Mesh.h"
+#include "Transform.h"
+
+// Everything needed to draw one object. Records are stored contiguously so
+// the draw loop walks memory front to back.
+struct RenderRecord
+{
+	const Meshes::GLMesh* mesh;
+	int part;                   // index into mesh->parts, or -1 for the whole mesh
+	GLint textureLayer;         // layer of the scene texture array
+	int transform;              // node in SceneDescription::transforms
+	glm::vec3 diffuseColor;
+	float shininess;
+	glm::vec3 specularColor;
+};
+
+struct SceneDescription
+{
+	std::vector<RenderRecord> objects;      // "object" lines, drawn one by one or batched
+	std::vector<RenderRecord> instances;    // "instance" lines, drawn with instanced calls
+	TransformHierarchy transforms;          // one node per record, in file order
+	std::map<std::string, int> nodes;       // transform node of each named object
+};
+
+// Parse a scene file into scene, resolving mesh names against meshes and
+// parent names against earlier objects. The transforms are left dirty.
+// Prints the offending line number and returns false on a malformed file.
+bool LoadSceneFile(const char* filename, const Meshes& meshes, SceneDescription& scene);
@@ -0,0 +1,89 @@
+///////////////////////////////////////////////////////////////////////////////
+// shaderblocks.h
+// ========
+// CPU-side mirrors of the interface blocks declared in the shaders.
+// Member order and padding must follow the block's layout rules exactly.
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+
+// Binding points shared by the shaders and the code that fills the buffers
+const unsigned int FRAME_BLOCK_BINDING = 0;
+const unsigned int DRAW_BLOCK_BINDING = 1;
+const unsigned int LAYER_LOD_BINDING = 2;   // one float per texture array layer, filled by TextureArrayLoader
+
+// std140 mirror of the FlashLight struct inside FrameBlock.
+// A vec3 takes 16 bytes of alignment, but a lone float may fill its 4th slot.
+struct FlashLightStd140
+{
+	glm::vec3 position;
+	float pad0;
+	glm::vec3 direction;
+	float cutOff;
+	float outerCutOff;
+	float constant;
+	float linear;
+	float quadratic;
+	glm::vec3 ambientColor;
+	float pad1;
+	glm::vec3 diffuseColor;
+	float pad2;
+	glm::vec3 specularColor;
+	float pad3;
+};
+
+// std140 mirror of "uniform FrameBlock": everything that changes at most once per frame
+struct FrameBlock
+{
+	glm::mat4 view;
+	glm::mat4 projection;
+	glm::vec3 viewPosition;
+	float ambientStrength;
+	glm::vec3 ambientColor;
+	float specularIntensity1;
+	glm::vec3 light1Color;
+	float highlightSize1;
+	glm::vec3 light1Position;
+	float specularIntensity2;
+	glm::vec3 light2Color;
+	float highlightSize2;
+	glm::vec3 light2Position;
+	float pad0;
+	FlashLightStd140 flashLight;
+};
+
+static_assert(sizeof(FlashLightStd140) == 96, "FlashLightStd140 does not match std140 layout");
+static_assert(offsetof(FlashLightStd140, cutOff) == 28, "FlashLightStd140 does not match std140 layout");
+static_assert(offsetof(FlashLightStd140, ambientColor) == 48, "FlashLightStd140 does not match std140 layout");
+static_assert(offsetof(FrameBlock, viewPosition) == 128, "FrameBlock does not match std140 layout");
+static_assert(offsetof(FrameBlock, light2Position) == 208, "FrameBlock does not match std140 layout");
+static_assert(offsetof(FrameBlock, flashLight) == 224, "FrameBlock does not match std140 layout");
+static_assert(sizeof(FrameBlock) == 320, "FrameBlock does not match std140 layout");
+
+// std430 mirror of one element of "buffer DrawBlock": the per-draw state of a
+// batched scene, indexed in the vertex shader by the draw's instance id
+struct DrawRecord
+{
+	glm::mat4 model;
+	glm::vec3 diffuseColor;
+	float shininess;
+	glm::vec3 specularColor;
+	GLint textureLayer;
+	glm::vec3 positionOffset;   // decodes the mesh's stored positions (Meshes::GLMesh)
+	float pad0;
+	glm::vec3 positionScale;
+	float pad1;
+};
+
+static_assert(offsetof(DrawRecord, shininess) == 76, "DrawRecord does not match std430 layout");
+static_assert(offsetof(DrawRecord, specularColor) == 80, "DrawRecord does not match std430 layout");
+static_assert(offsetof(DrawRecord, textureLayer) == 92, "DrawRecord does not match std430 layout");
+static_assert(offsetof(DrawRecord, positionOffset) == 96, "DrawRecord does not match std430 layout");
+static_assert(offsetof(DrawRecord, positionScale) == 112, "DrawRecord does not match std430 layout");
+static_assert(sizeof(DrawRecord) == 128, "DrawRecord does not match std430 layout");
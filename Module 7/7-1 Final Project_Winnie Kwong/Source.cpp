@@ -1,5 +1,14 @@
 #include <iostream>         // cout, cerr
 #include <cstdlib>          // EXIT_FAILURE
+#include <string>           // shader source assembly
+#include <random>           // stress-test sprinkle placement
+#include <vector>
+#include <algorithm>        // fill, min
+#include <chrono>           // image kernel and mesh generation benchmarks
+#include <cstring>          // memcmp
+#include <cerrno>           // strtoul range errors
+#include <memory>           // unique_ptr
+#include <thread>           // hardware_concurrency
 #include <GL/glew.h>        // GLEW library
 #include <GLFW/glfw3.h>     // GLFW library
 
@@ -10,6 +19,21 @@
 
 #include "Mesh.h"
 #include "Camera.h" // Camera class
+#include "Uniforms.h" // Uniform location handles
+#include "ShaderBlocks.h" // CPU mirrors of shader interface blocks
+#include "SceneBatch.h" // Multi-draw submission of the static scene
+#include "SceneFile.h" // Scene description loader
+#include "Frustum.h" // View frustum culling
+#include "RenderQueue.h" // Sorted draw submission
+#include "GLState.h" // Redundant GL state filter
+#include "TextureLoader.h" // Background texture loading
+#include "ImageOps.h" // Vectorized pixel kernels
+#include "TextureContainer.h" // Cooked block-compressed textures
+#include "MipChain.h" // Mip level sizes
+#include "AssetPack.h" // Memory-mapped textures and meshes
+#include "BlockCompress.h" // BC1/BC3 decoding
+#include "GpuResources.h" // GL object and memory accounting
+#include "MeshReference.h" // Round meshes checked against the old tables
 
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"    // Image loading Utility functions
@@ -23,6 +47,24 @@ using namespace std; // Standard namespace
 #define GLSL(Version, Source) "#version " #Version " core \n" #Source
 #endif
 
+/*Shader source fragment Macro (no #version line, for pieces that get concatenated)*/
+#ifndef GLSL_SOURCE
+#define GLSL_SOURCE(...) #__VA_ARGS__
+#endif
+
+/*Build-time switch: upload per-frame camera and lighting state through one
+ *std140 uniform buffer (1) or with individual glUniform calls (0)*/
+#ifndef USE_FRAME_UBO
+#define USE_FRAME_UBO 1
+#endif
+
+/*Build-time switch: draw the whole scene from merged buffers with
+ *glMultiDrawElementsIndirect and per-draw records in a storage buffer (1),
+ *or issue one set of uniforms and draw calls per object (0)*/
+#ifndef USE_SCENE_BATCH
+#define USE_SCENE_BATCH 1
+#endif
+
 // Unnamed namespace
 namespace
 {
@@ -45,18 +87,96 @@ namespace
 	GLFWwindow* gWindow = nullptr;
 	// Triangle mesh data
 	GLMesh gMesh;
-	// Texture IDs
-	GLuint texture0, texture1, texture2, texture3, texture4, texture5,
-		texture6, texture7, texture8, texture9, texture10, texture11,
-		texture12, texture13, texture14, texture15, texture16;
+	// Scene textures, one layer each of gTextureArrayId. The texture numbers
+	// in the scene file are indices into this list.
+	const char* const TEXTURE_FILES[] =
+	{
+		"../7-1 Final Project_Winnie Kwong/Texture/foam_board.jpg",        // 0 plane
+		"../7-1 Final Project_Winnie Kwong/Texture/metal.jpg",             // 1 ornament clasp & hook, triforce hook
+		"../7-1 Final Project_Winnie Kwong/Texture/ornament_body.jpg",     // 2 ornament body
+		"../7-1 Final Project_Winnie Kwong/Texture/metal_triforce.jpg",    // 3 triforce
+		"../7-1 Final Project_Winnie Kwong/Texture/bottom donut.jpg",      // 4 donut bottom body
+		"../7-1 Final Project_Winnie Kwong/Texture/top donut.jpg",         // 5 donut top body
+		"../7-1 Final Project_Winnie Kwong/Texture/orange.jpg",            // 6 Rubiks Cube faces
+		"../7-1 Final Project_Winnie Kwong/Texture/red.jpg",               // 7
+		"../7-1 Final Project_Winnie Kwong/Texture/green.jpg",             // 8
+		"../7-1 Final Project_Winnie Kwong/Texture/blue.jpg",              // 9
+		"../7-1 Final Project_Winnie Kwong/Texture/yellow.jpg",            // 10
+		"../7-1 Final Project_Winnie Kwong/Texture/white.jpg",             // 11
+		"../7-1 Final Project_Winnie Kwong/Texture/yellow sprinkle.jpg",   // 12 donut sprinkles
+		"../7-1 Final Project_Winnie Kwong/Texture/red sprinkle.jpg",      // 13
+		"../7-1 Final Project_Winnie Kwong/Texture/pink sprinkle.jpg",     // 14
+		"../7-1 Final Project_Winnie Kwong/Texture/green sprinkle.jpg",    // 15
+		"../7-1 Final Project_Winnie Kwong/Texture/blue sprinkle.jpg",     // 16
+	};
+	// Texture array ID, bound to texture unit 0 for every program
+	GLuint gTextureArrayId;
+	// 1x1 layers standing in for the single-color textures, bound to texture unit 1
+	GLuint gColorArrayId;
+	// Fills the texture array's layers while the scene is already rendering
+	TextureArrayLoader gTextureLoader;
+	// Texture array memory the streamed mip levels may take; --texture-budget 0 loads every level
+	const size_t DEFAULT_TEXTURE_BUDGET_MB = 256;
+	// Every texture and mesh in one file, written by --build-pack
+	const char* const ASSET_PACK_FILE = "../7-1 Final Project_Winnie Kwong/Scene.pack";
+	// Mapped at startup when the file exists; textures and meshes it holds are read from it
+	AssetPack gAssetPack;
 	// Defining both shader programs
 	GLuint gProgramId;
-	GLuint gRedFaceTextureId;
-	GLuint gYellowFaceTextureId;
-	GLuint gWhiteFaceTextureId;
-	GLuint gGreenFaceTextureId;
-	GLuint gBlueFaceTextureId;
-	GLuint gOrangeFaceTextureId;
+
+	// Uniform locations of a shader program, resolved once after the program links
+	struct SceneUniforms
+	{
+		UniformMat4 model;
+		UniformVec3 positionOffset;
+		UniformVec3 positionScale;
+		UniformMat4 view;
+		UniformMat4 projection;
+		UniformVec3 viewPosition;
+		UniformFloat ambientStrength;
+		UniformVec3 ambientColor;
+		UniformVec3 light1Color;
+		UniformVec3 light1Position;
+		UniformVec3 light2Color;
+		UniformVec3 light2Position;
+		UniformVec4 objectColor;
+		UniformFloat specularIntensity1;
+		UniformFloat highlightSize1;
+		UniformFloat specularIntensity2;
+		UniformFloat highlightSize2;
+		UniformInt hasTexture;
+		UniformInt textureArray;
+		UniformInt colorArray;
+		UniformInt textureLayer;
+
+		struct
+		{
+			UniformVec3 position;
+			UniformVec3 direction;
+			UniformFloat cutOff;
+			UniformFloat outerCutOff;
+			UniformFloat constant;
+			UniformFloat linear;
+			UniformFloat quadratic;
+			UniformVec3 ambientColor;
+			UniformVec3 diffuseColor;
+			UniformVec3 specularColor;
+		} flashLight;
+
+		struct
+		{
+			UniformVec3 diffuseColor;
+			UniformVec3 specularColor;
+			UniformFloat shininess;
+		} material;
+	};
+	SceneUniforms gUniforms;
+
+#if USE_FRAME_UBO
+	// Uniform buffer backing FrameBlock, refilled once per frame
+	GLuint gFrameUbo;
+	FrameBlock gFrameBlock;
+#endif
 
 	bool perspective = false;
 
@@ -72,6 +192,75 @@ namespace
 
 	//Shape Meshes from Professor Brian
 	Meshes meshes;
+
+	// Scene loaded at startup; objects and instances are flat arrays of render records
+	const char* const DEFAULT_SCENE_FILE = "../7-1 Final Project_Winnie Kwong/Scene/final_project.scene";
+	SceneDescription gScene;
+
+#if USE_SCENE_BATCH
+	// Merged geometry, draw records and indirect commands for gScene.objects
+	SceneBatch gSceneBatch;
+#else
+	// Visible objects of the frame, sorted to minimize state changes
+	RenderQueue gRenderQueue;
+#endif
+
+	// The instances of one mesh. Every instance uses the material of the first one.
+	struct InstanceSet
+	{
+		Meshes::GLInstances instances;
+		glm::vec3 diffuseColor;
+		glm::vec3 specularColor;
+		float shininess;
+		GLuint lod;         // Level of detail its nearest instance needs
+	};
+	std::vector<InstanceSet> gInstanceSets;
+
+	// --bench-frames: frames to draw before reporting, and CPU time spent submitting draws
+	int gBenchFrames = 0;
+	int gFramesDrawn = 0;
+	double gDrawLoopSeconds = 0.0;
+
+	// Counters of the last frame, printed once a second with --stats
+	struct FrameStats
+	{
+		GLuint matricesRecomputed;
+		GLuint objectsDrawn;
+		GLuint objectsCulled;
+		GLuint objectsReduced;          // drawn at a coarser level of detail
+		GLuint stateChangesUnsorted;    // program/VAO/texture changes in scene order
+		GLuint stateChangesSorted;      // the same after sorting the render queue
+		GLuint glCallsSkipped;          // dropped by gGLState as redundant
+	};
+	FrameStats gFrameStats = {};
+	bool gPrintStats = false;
+	double gLastStatsTime = 0.0;
+
+	// World-space bounding sphere and visibility of each scene object;
+	// --no-cull draws everything for comparison
+	BoundingSpheres gObjectSpheres;
+	std::vector<unsigned char> gObjectVisible;
+	bool gCulling = true;
+
+	// Level of detail of each scene object: the coarsest whose surface strays
+	// by at most LOD_PIXEL_ERROR pixels on screen. --no-lod draws everything
+	// at full detail.
+	const float LOD_PIXEL_ERROR = 1.0f;
+	std::vector<unsigned char> gObjectLods;
+	bool gLods = true;
+
+	// World-space bounding sphere and texture layer of each instance, for texture streaming
+	BoundingSpheres gInstanceSpheres;
+	std::vector<GLint> gInstanceLayers;
+	std::vector<size_t> gInstanceSetIndices;	// into gInstanceSets, for level of detail selection
+
+	// R spins the ornament body; its clasp and hook are children and follow it
+	int gOrnamentNode = -1;
+	float gOrnamentAngle = 0.0f;
+
+	// Program for instanced meshes and its uniform locations
+	GLuint gInstanceProgramId;
+	SceneUniforms gInstanceUniforms;
 }
 
 /* User-defined Function prototypes to:
@@ -86,17 +275,104 @@ void UMousePositionCallback(GLFWwindow* window, double xpos, double ypos);
 void UMouseScrollCallback(GLFWwindow* window, double xoffset, double yoffset);
 void UMouseButtonCallback(GLFWwindow* window, int button, int action, int mods);
 bool UCreateShaderProgram(const char* vtxShaderSource, const char* fragShaderSource, GLuint& programId);
+void UResolveUniforms(GLuint programId, SceneUniforms& uniforms, bool modelUniform, bool materialUniforms, bool meshUniforms);
+void USetFrameUniforms(const SceneUniforms& uniforms, const glm::mat4& view, const glm::mat4& projection);
 void UDestroyShaderProgram(GLuint programId);
 void flipImageVertically(unsigned char* image, int width, int height, int channels);
+bool UBenchmarkImageOps(const char* filename);
+bool UBenchmarkMeshGeneration(GLuint segments);
+bool UOptionCount(int argc, char* argv[], int& i, unsigned long max, unsigned long& value);
 void URender();
-bool UCreateTexture(const char* filename, GLuint& textureId);
+bool UBuildSceneBatch();
+void UUpdateObjectBounds(bool all);
+void UCreateInstanceSets(GLuint extraSprinkles);
+void URequestTextureDetail();
+float UPixelsPerUnit(const BoundingSpheres& spheres, size_t i);
+void USelectLods();
+bool UCookTextures();
+bool UBuildAssetPack();
 void UDestroyTexture(GLuint textureId);
 
 
 ////////////////////////////////////////////////////////////////////////////////////////
 // SHADER CODE
+/* Version line that starts every assembled shader*/
+const GLchar* shaderVersionSource = GLSL(440, );
+
+/* Struct types shared by both shader stages*/
+const GLchar* typesShaderSource = GLSL_SOURCE(
+struct FlashLight {
+	vec3 position;
+	vec3 direction;
+	float cutOff;
+	float outerCutOff;
+
+	float constant;
+	float linear;
+	float quadratic;
+
+	vec3 ambientColor;
+	vec3 diffuseColor;
+	vec3 specularColor;
+};
+
+struct Material {
+	vec3 diffuseColor;
+	vec3 specularColor;
+	float shininess;
+};
+);
+
+/* Frame-level declarations shared by both shader stages.
+ * With USE_FRAME_UBO the camera and lighting state lives in one std140
+ * uniform block (mirrored by FrameBlock in ShaderBlocks.h) that is
+ * updated with a single buffer upload per frame.
+ */
+#if USE_FRAME_UBO
+const GLchar* frameShaderSource = GLSL_SOURCE(
+layout(std140, binding = 0) uniform FrameBlock
+{
+	mat4 view;
+	mat4 projection;
+	vec3 viewPosition;
+	float ambientStrength;
+	vec3 ambientColor;
+	float specularIntensity1;
+	vec3 light1Color;
+	float highlightSize1;
+	vec3 light1Position;
+	float specularIntensity2;
+	vec3 light2Color;
+	float highlightSize2;
+	vec3 light2Position;
+	FlashLight flashLight;
+};
+);
+#else
+const GLchar* frameShaderSource = GLSL_SOURCE(
+//Uniform / Global variables for the transform matrices
+uniform mat4 view;
+uniform mat4 projection;
+
+// Uniform / Global variables for light color, light position, and camera/view position
+uniform vec3 ambientColor;
+uniform vec3 light1Color;
+uniform vec3 light1Position;
+uniform vec3 light2Color;
+uniform vec3 light2Position;
+uniform vec3 viewPosition;
+uniform float ambientStrength = 0.1f; // Set ambient or global lighting strength
+uniform float specularIntensity1 = 0.8f;
+uniform float highlightSize1 = 16.0f;
+uniform float specularIntensity2 = 0.8f;
+uniform float highlightSize2 = 16.0f;
+
+uniform FlashLight flashLight;
+);
+#endif
+
 /* Vertex Shader Source Code*/
-const GLchar* vertexShaderSource = GLSL(440,
+const GLchar* vertexShaderSource = GLSL_SOURCE(
 	layout(location = 0) in vec3 vertexPosition; // VAP position 0 for vertex position data
 layout(location = 1) in vec3 vertexNormal; // VAP position 1 for normals
 layout(location = 2) in vec2 textureCoordinate;
@@ -104,76 +380,156 @@ layout(location = 2) in vec2 textureCoordinate;
 out vec3 vertexFragmentNormal; // For outgoing normals to fragment shader
 out vec3 vertexFragmentPos; // For outgoing color / pixels to fragment shader
 out vec2 vertexTextureCoordinate;
+flat out int vertexTextureLayer;
 
-//Uniform / Global variables for the  transform matrices
+//Uniform / Global variables for the model transform matrix and texture array layer
 uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
+uniform int textureLayer;
+// Decoding of the mesh's stored positions; compact meshes store fractions of their bounding box
+uniform vec3 positionOffset = vec3(0.0f);
+uniform vec3 positionScale = vec3(1.0f);
 
 void main()
 {
-	gl_Position = projection * view * model * vec4(vertexPosition, 1.0f); // Transforms vertices into clip coordinates
+	vec3 position = positionOffset + positionScale * vertexPosition;
+
+	gl_Position = projection * view * model * vec4(position, 1.0f); // Transforms vertices into clip coordinates
 
-	vertexFragmentPos = vec3(model * vec4(vertexPosition, 1.0f)); // Gets fragment / pixel position in world space only (exclude view and projection)
+	vertexFragmentPos = vec3(model * vec4(position, 1.0f)); // Gets fragment / pixel position in world space only (exclude view and projection)
 
 	vertexFragmentNormal = mat3(transpose(inverse(model))) * vertexNormal; // get normal vectors in world space only and exclude normal translation properties
 	vertexTextureCoordinate = textureCoordinate;
+	vertexTextureLayer = textureLayer;
 }
 );
 
 
-/* Surface Fragment Shader Source Code*/
-const GLchar* fragmentShaderSource = GLSL(440,
+/* Instanced Vertex Shader Source Code: the model matrix and texture layer are per-instance attributes*/
+const GLchar* instanceVertexShaderSource = GLSL_SOURCE(
+	layout(location = 0) in vec3 vertexPosition; // VAP position 0 for vertex position data
+layout(location = 1) in vec3 vertexNormal; // VAP position 1 for normals
+layout(location = 2) in vec2 textureCoordinate;
+layout(location = 4) in mat4 instanceModel; // per-instance model matrix, takes locations 4 to 7
+layout(location = 8) in int instanceLayer; // per-instance texture array layer
 
-	in vec3 vertexFragmentNormal; // For incoming normals
-in vec3 vertexFragmentPos; // For incoming fragment position
-in vec2 vertexTextureCoordinate;
+out vec3 vertexFragmentNormal; // For outgoing normals to fragment shader
+out vec3 vertexFragmentPos; // For outgoing color / pixels to fragment shader
+out vec2 vertexTextureCoordinate;
+flat out int vertexTextureLayer;
 
-out vec4 fragmentColor; // For outgoing cube color to the GPU
+// Decoding of the mesh's stored positions; compact meshes store fractions of their bounding box
+uniform vec3 positionOffset = vec3(0.0f);
+uniform vec3 positionScale = vec3(1.0f);
 
-// Uniform / Global variables for object color, light color, light position, and camera/view position
-uniform vec4 objectColor;
-uniform vec3 ambientColor;
-uniform vec3 light1Color;
-uniform vec3 light1Position;
-uniform vec3 light2Color;
-uniform vec3 light2Position;
-uniform vec3 viewPosition;
-uniform sampler2D uTexture; // Useful when working with multiple textures
-uniform bool ubHasTexture;
-uniform float ambientStrength = 0.1f; // Set ambient or global lighting strength
-uniform float specularIntensity1 = 0.8f;
-uniform float highlightSize1 = 16.0f;
-uniform float specularIntensity2 = 0.8f;
-uniform float highlightSize2 = 16.0f;
+void main()
+{
+	vec3 position = positionOffset + positionScale * vertexPosition;
 
-struct FlashLight {
-	vec3 position;
-	vec3 direction;
-	float cutOff;
-	float outerCutOff;
+	gl_Position = projection * view * instanceModel * vec4(position, 1.0f); // Transforms vertices into clip coordinates
 
-	float constant;
-	float linear;
-	float quadratic;
+	vertexFragmentPos = vec3(instanceModel * vec4(position, 1.0f)); // Gets fragment / pixel position in world space only (exclude view and projection)
 
-	vec3 ambientColor;
+	vertexFragmentNormal = mat3(transpose(inverse(instanceModel))) * vertexNormal; // get normal vectors in world space only and exclude normal translation properties
+	vertexTextureCoordinate = textureCoordinate;
+	vertexTextureLayer = instanceLayer;
+}
+);
+
+/* Batched Vertex Shader Source Code: the model matrix, material and texture layer of each
+ * draw come from the DrawBlock storage buffer (mirrored by DrawRecord in
+ * ShaderBlocks.h) instead of per-object uniforms
+ */
+const GLchar* batchVertexShaderSource = GLSL_SOURCE(
+	layout(location = 0) in vec3 vertexPosition; // VAP position 0 for vertex position data
+layout(location = 1) in vec3 vertexNormal; // VAP position 1 for normals
+layout(location = 2) in vec2 textureCoordinate;
+layout(location = 3) in uint drawId; // one value per draw, selected by the command's baseInstance
+
+out vec3 vertexFragmentNormal; // For outgoing normals to fragment shader
+out vec3 vertexFragmentPos; // For outgoing color / pixels to fragment shader
+out vec2 vertexTextureCoordinate;
+flat out int vertexTextureLayer;
+flat out Material currentMaterial; // Material of the draw, constant across each primitive
+
+struct DrawRecord {
+	mat4 model;
 	vec3 diffuseColor;
+	float shininess;
 	vec3 specularColor;
+	int textureLayer;
+	vec3 positionOffset; // decodes the mesh's stored positions
+	vec3 positionScale;
 };
 
-struct Material {
-	vec3 diffuseColor;
-	vec3 specularColor;
-	float shininess;
+layout(std430, binding = 1) readonly buffer DrawBlock
+{
+	DrawRecord draws[];
 };
 
-uniform FlashLight flashLight;
+void main()
+{
+	mat4 model = draws[drawId].model;
+	vec3 position = draws[drawId].positionOffset + draws[drawId].positionScale * vertexPosition;
+
+	gl_Position = projection * view * model * vec4(position, 1.0f); // Transforms vertices into clip coordinates
+
+	vertexFragmentPos = vec3(model * vec4(position, 1.0f)); // Gets fragment / pixel position in world space only (exclude view and projection)
+
+	vertexFragmentNormal = mat3(transpose(inverse(model))) * vertexNormal; // get normal vectors in world space only and exclude normal translation properties
+	vertexTextureCoordinate = textureCoordinate;
+	vertexTextureLayer = draws[drawId].textureLayer;
+
+	currentMaterial.diffuseColor = draws[drawId].diffuseColor;
+	currentMaterial.specularColor = draws[drawId].specularColor;
+	currentMaterial.shininess = draws[drawId].shininess;
+}
+);
+
+/* Where the fragment shader gets its material: a uniform set per object,
+ * or the flat output of the batched vertex shader
+ */
+const GLchar* materialUniformShaderSource = GLSL_SOURCE(
 uniform Material currentMaterial;
+);
+const GLchar* materialInputShaderSource = GLSL_SOURCE(
+flat in Material currentMaterial;
+);
+
+/* Surface Fragment Shader Source Code*/
+const GLchar* fragmentShaderSource = GLSL_SOURCE(
+
+	in vec3 vertexFragmentNormal; // For incoming normals
+in vec3 vertexFragmentPos; // For incoming fragment position
+in vec2 vertexTextureCoordinate;
+flat in int vertexTextureLayer;
+
+out vec4 fragmentColor; // For outgoing cube color to the GPU
+
+// Uniform / Global variables for object color and texture
+uniform vec4 objectColor;
+uniform sampler2DArray uTextureArray; // Every scene texture, one per layer
+uniform sampler2DArray uColorArray; // Single-color textures, one 1x1 layer per color
+uniform bool ubHasTexture;
+
+// Finest mip level of each texture array layer that is resident
+layout(std430, binding = 2) readonly buffer LayerLodBlock
+{
+	float layerMinLod[];
+};
 
 // function prototypes
 vec3 CalcFlashLight(FlashLight light, vec3 normal, vec3 fragPos, vec3 viewDir);
 
+// Texture color of the fragment; negative layers are single colors. Streamed
+// layers are never sampled finer than their finest resident level.
+vec4 SceneTexture()
+{
+	if (vertexTextureLayer < 0)
+		return texelFetch(uColorArray, ivec3(0, 0, -1 - vertexTextureLayer), 0);
+	float lod = max(textureQueryLod(uTextureArray, vertexTextureCoordinate).y, layerMinLod[vertexTextureLayer]);
+	return textureLod(uTextureArray, vec3(vertexTextureCoordinate, vertexTextureLayer), lod);
+}
+
 void main()
 {
 	/*Phong lighting model calculations to generate ambient, diffuse, and specular components*/
@@ -207,7 +563,7 @@ void main()
 
 	//**Calculate phong result**
 	//Texture holds the color to be used for all three components
-	vec4 textureColor = texture(uTexture, vertexTextureCoordinate);
+	vec4 textureColor = SceneTexture();
 	vec3 phong1;
 	vec3 phong2;
 	vec3 flashlightResult;
@@ -246,9 +602,9 @@ vec3 CalcFlashLight(FlashLight light, vec3 normal, vec3 fragPos, vec3 viewDir)
 	float epsilon = light.cutOff - light.outerCutOff;
 	float intensity = clamp((theta - light.outerCutOff) / epsilon, 0.0, 1.0);
 	// combine results
-	vec3 ambient = light.ambientColor * vec3(texture(uTexture, vertexTextureCoordinate));
-	vec3 diffuse = (light.diffuseColor + currentMaterial.diffuseColor) * diff * vec3(texture(uTexture, vertexTextureCoordinate));
-	vec3 specular = (light.specularColor + currentMaterial.specularColor) * spec * vec3(texture(uTexture, vertexTextureCoordinate));
+	vec3 ambient = light.ambientColor * vec3(SceneTexture());
+	vec3 diffuse = (light.diffuseColor + currentMaterial.diffuseColor) * diff * vec3(SceneTexture());
+	vec3 specular = (light.specularColor + currentMaterial.specularColor) * spec * vec3(SceneTexture());
 	ambient *= attenuation * intensity;
 	diffuse *= attenuation * intensity;
 	specular *= attenuation * intensity;
@@ -259,161 +615,183 @@ vec3 CalcFlashLight(FlashLight light, vec3 normal, vec3 fragPos, vec3 viewDir)
 
 int main(int argc, char* argv[])
 {
+	// Command line options:
+	//	--scene <file>         scene file to load instead of DEFAULT_SCENE_FILE
+	//	--sprinkles <count>    scatter extra sprinkles over the donut (stress test)
+	//	--bench-frames <count> draw count frames, print the average draw loop time and exit
+	//	--stats                print the per-frame counters once a second
+	//	--no-cull              draw every object, visible or not
+	//	--no-lod               draw every object at full detail, however small on screen
+	//	--float-vertices       upload meshes as 8 floats per vertex and 32-bit indices instead of compacted
+	//	--bench-image-ops <image> time the pixel kernels on an image and exit
+	//	--bench-meshes <segments> time generating every round mesh at segments x segments and exit
+	//	--check-meshes         compare the generated round meshes with the tables they replaced and exit
+	//	--no-mip-cache         rebuild every texture's mip chain instead of reading the cache
+	//	--cook-textures        write a block-compressed container next to every texture and exit
+	//	--build-pack           write every texture and mesh to ASSET_PACK_FILE and exit
+	//	--no-pack              load the images and generate the meshes even if the pack exists
+	//	--texture-budget <MB>  memory for streamed texture levels (DEFAULT_TEXTURE_BUDGET_MB), 0 loads every level
+	const char* sceneFile = DEFAULT_SCENE_FILE;
+	GLuint extraSprinkles = 0;
+	bool buildPack = false;
+	bool usePack = true;
+	size_t textureBudgetMB = DEFAULT_TEXTURE_BUDGET_MB;
+	unsigned long count = 0;
+	for (int i = 1; i < argc; ++i)
+	{
+		string option(argv[i]);
+		if (option == "--stats")
+			gPrintStats = true;
+		else if (option == "--no-cull")
+			gCulling = false;
+		else if (option == "--no-lod")
+			gLods = false;
+		else if (option == "--float-vertices")
+			meshes.gCompactVertices = false;
+		else if (option == "--no-mip-cache")
+			gTextureLoader.SetMipCache(false);
+		else if (option == "--cook-textures")
+			return UCookTextures() ? EXIT_SUCCESS : EXIT_FAILURE;
+		else if (option == "--check-meshes")
+			return CheckReferenceMeshes(meshes) ? EXIT_SUCCESS : EXIT_FAILURE;
+		else if (option == "--build-pack")
+			buildPack = true;
+		else if (option == "--no-pack")
+			usePack = false;
+		// the file options below are ignored when their value is missing; a
+		// count that is missing, not a number or out of range is an error
+		else if (option == "--scene" && i + 1 < argc)
+			sceneFile = argv[++i];
+		else if (option == "--bench-image-ops" && i + 1 < argc)
+			return UBenchmarkImageOps(argv[++i]) ? EXIT_SUCCESS : EXIT_FAILURE;
+		else if (option == "--sprinkles")
+		{
+			if (!UOptionCount(argc, argv, i, 1000000, count))
+				return EXIT_FAILURE;
+			extraSprinkles = (GLuint)count;
+		}
+		else if (option == "--bench-frames")
+		{
+			if (!UOptionCount(argc, argv, i, 1000000, count))
+				return EXIT_FAILURE;
+			gBenchFrames = (int)count;
+		}
+		else if (option == "--bench-meshes")
+		{
+			if (!UOptionCount(argc, argv, i, 1024, count))
+				return EXIT_FAILURE;
+			return UBenchmarkMeshGeneration((GLuint)count) ? EXIT_SUCCESS : EXIT_FAILURE;
+		}
+		else if (option == "--texture-budget")
+		{
+			if (!UOptionCount(argc, argv, i, 1024 * 1024, count))
+				return EXIT_FAILURE;
+			textureBudgetMB = (size_t)count;
+		}
+	}
+	gTextureLoader.SetStreamingBudget(textureBudgetMB * 1024 * 1024);
+
 	if (!UInitialize(argc, argv, &gWindow))
 		return EXIT_FAILURE;
 
+	// Map the asset pack, unless it is about to be rebuilt from the sources
+	if (usePack && !buildPack && gAssetPack.Open(ASSET_PACK_FILE))
+		cout << "INFO: Asset pack " << ASSET_PACK_FILE << " mapped (" << gAssetPack.Size() / 1024 << " KB)" << endl;
+
 	// Create the mesh
 	//UCreateMesh(gMesh); // Calls the function to create the Vertex Buffer Object
-	meshes.CreateMeshes();
+	if (!meshes.CreateMeshes(gAssetPack.IsOpen() ? &gAssetPack : nullptr))
+		return EXIT_FAILURE;
+
+	// --build-pack: the meshes have just been generated, so pack them with the textures
+	if (buildPack)
+		return UBuildAssetPack() ? EXIT_SUCCESS : EXIT_FAILURE;
+
+	// Load the scene description
+	if (!LoadSceneFile(sceneFile, meshes, gScene))
+		return EXIT_FAILURE;
+
+	// Nothing has moved yet: every model matrix is computed once here
+	cout << "INFO: " << gScene.transforms.Update() << " model matrices computed" << endl;
+	UUpdateObjectBounds(true);
+	if (gScene.nodes.count("ornament") != 0)
+		gOrnamentNode = gScene.nodes["ornament"];
+
+	// Assemble the shader sources: version, shared types, frame-level declarations, then the stage itself
+#if USE_SCENE_BATCH
+	const string vertexSource = string(shaderVersionSource) + typesShaderSource + frameShaderSource + batchVertexShaderSource;
+	const string fragmentSource = string(shaderVersionSource) + typesShaderSource + frameShaderSource + materialInputShaderSource + fragmentShaderSource;
+#else
+	const string vertexSource = string(shaderVersionSource) + typesShaderSource + frameShaderSource + vertexShaderSource;
+	const string fragmentSource = string(shaderVersionSource) + typesShaderSource + frameShaderSource + materialUniformShaderSource + fragmentShaderSource;
+#endif
 
 	// Create the shader program
-	if (!UCreateShaderProgram(vertexShaderSource, fragmentShaderSource, gProgramId))
+	if (!UCreateShaderProgram(vertexSource.c_str(), fragmentSource.c_str(), gProgramId))
+		return EXIT_FAILURE;
+
+	// Create the program for instanced meshes
+	const string instanceVertexSource = string(shaderVersionSource) + typesShaderSource + frameShaderSource + instanceVertexShaderSource;
+	const string instanceFragmentSource = string(shaderVersionSource) + typesShaderSource + frameShaderSource + materialUniformShaderSource + fragmentShaderSource;
+	if (!UCreateShaderProgram(instanceVertexSource.c_str(), instanceFragmentSource.c_str(), gInstanceProgramId))
 		return EXIT_FAILURE;
 
+	// Look up every uniform location once instead of by name each frame
+	UResolveUniforms(gProgramId, gUniforms, !USE_SCENE_BATCH, !USE_SCENE_BATCH, !USE_SCENE_BATCH);
+	UResolveUniforms(gInstanceProgramId, gInstanceUniforms, false, true, true);
+
+#if USE_FRAME_UBO
+	// Create the per-frame uniform buffer and attach it to the FrameBlock binding point
+	glGenBuffers(1, &gFrameUbo);
+	gGpuResources.Created(GpuResourceType::Buffer, gFrameUbo, "frame uniforms");
+	glBindBuffer(GL_UNIFORM_BUFFER, gFrameUbo);
+	glBufferData(GL_UNIFORM_BUFFER, sizeof(FrameBlock), NULL, GL_DYNAMIC_DRAW);
+	gGpuResources.SetBytes(GpuResourceType::Buffer, gFrameUbo, sizeof(FrameBlock));
+	glBindBufferBase(GL_UNIFORM_BUFFER, FRAME_BLOCK_BINDING, gFrameUbo);
+	glBindBuffer(GL_UNIFORM_BUFFER, 0);
+#endif
+
 	// tell opengl for each sampler to which texture unit it belongs to (only has to be done once)
-	glUseProgram(gProgramId);
+	gGLState.UseProgram(gInstanceProgramId);
+	gInstanceUniforms.textureArray.Set(0);
+	gInstanceUniforms.colorArray.Set(1);
+	gGLState.UseProgram(gProgramId);
+	gUniforms.textureArray.Set(0);
+	gUniforms.colorArray.Set(1);
 
 	// Sets the background color of the window to white (it will be implicitely used by glClear)
 	glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
 
-	// Load plane
-	const char* texFilename = "../7-1 Final Project_Winnie Kwong/Texture/foam_board.jpg";
-	if (!UCreateTexture(texFilename, texture0))
-	{
-		cout << "Failed to load texture " << texFilename << endl;
-	}
-	// Load ornament clasp & hook,triforce hook
-	texFilename = "../7-1 Final Project_Winnie Kwong/Texture/metal.jpg";
-	if (!UCreateTexture(texFilename, texture1))
-	{
-		cout << "Failed to load texture " << texFilename << endl;
-	}
-	// Load ornament body
-	texFilename = "../7-1 Final Project_Winnie Kwong/Texture/ornament_body.jpg";
-	if (!UCreateTexture(texFilename, texture2))
-	{
-		cout << "Failed to load texture " << texFilename << endl;
-	}
-	// Load Triforce
-	texFilename = "../7-1 Final Project_Winnie Kwong/Texture/metal_triforce.jpg";
-	if (!UCreateTexture(texFilename, texture3))
-	{
-		cout << "Failed to load texture " << texFilename << endl;
-	}
-	// Load donut bottom body
-	texFilename = "../7-1 Final Project_Winnie Kwong/Texture/bottom donut.jpg";
-	if (!UCreateTexture(texFilename, texture4))
-	{
-		cout << "Failed to load texture " << texFilename << endl;
-	}
-	// Load donut top body
-	texFilename = "../7-1 Final Project_Winnie Kwong/Texture/top donut.jpg";
-	if (!UCreateTexture(texFilename, texture5))
-	{
-		cout << "Failed to load texture " << texFilename << endl;
-	}
-	// Load Rubiks Cube
-	texFilename = "../7-1 Final Project_Winnie Kwong/Texture/orange.jpg";
-	if (!UCreateTexture(texFilename, gOrangeFaceTextureId))
-	{
-		cout << "Failed to load texture " << texFilename << endl;
-	}
-	// Load Rubiks Cube
-	texFilename = "../7-1 Final Project_Winnie Kwong/Texture/red.jpg";
-	if (!UCreateTexture(texFilename, gRedFaceTextureId))
-	{
-		cout << "Failed to load texture " << texFilename << endl;
-	}
-	// Load Rubiks Cube
-	texFilename = "../7-1 Final Project_Winnie Kwong/Texture/green.jpg";
-	if (!UCreateTexture(texFilename, gGreenFaceTextureId))
-	{
-		cout << "Failed to load texture " << texFilename << endl;
-	}
-	// Load Rubiks Cube
-	texFilename = "../7-1 Final Project_Winnie Kwong/Texture/blue.jpg";
-	if (!UCreateTexture(texFilename, gBlueFaceTextureId))
-	{
-		cout << "Failed to load texture " << texFilename << endl;
-	}
-	// Load Rubiks Cube
-	texFilename = "../7-1 Final Project_Winnie Kwong/Texture/yellow.jpg";
-	if (!UCreateTexture(texFilename, gYellowFaceTextureId))
-	{
-		cout << "Failed to load texture " << texFilename << endl;
-	}
-	// Load Rubiks Cube
-	texFilename = "../7-1 Final Project_Winnie Kwong/Texture/white.jpg";
-	if (!UCreateTexture(texFilename, gWhiteFaceTextureId))
-	{
-		cout << "Failed to load texture " << texFilename << endl;
-	}
-	// Load donut sprinkle yellow
-	texFilename = "../7-1 Final Project_Winnie Kwong/Texture/yellow sprinkle.jpg";
-	if (!UCreateTexture(texFilename, texture12))
-	{
-		cout << "Failed to load texture " << texFilename << endl;
-	}
-	// Load donut sprinkle red
-	texFilename = "../7-1 Final Project_Winnie Kwong/Texture/red sprinkle.jpg";
-	if (!UCreateTexture(texFilename, texture13))
-	{
-		cout << "Failed to load texture " << texFilename << endl;
-	}
-	// Load donut sprinkle pink
-	texFilename = "../7-1 Final Project_Winnie Kwong/Texture/pink sprinkle.jpg";
-	if (!UCreateTexture(texFilename, texture14))
-	{
-		cout << "Failed to load texture " << texFilename << endl;
-	}
-	// Load donut sprinkle green
-	texFilename = "../7-1 Final Project_Winnie Kwong/Texture/green sprinkle.jpg";
-	if (!UCreateTexture(texFilename, texture15))
+	// Create the scene texture array with placeholder layers; the images are
+	// decoded in the background and swapped in from the render loop
+	gTextureLoader.SetAssetPack(gAssetPack.IsOpen() ? &gAssetPack : nullptr);
+	if (!gTextureLoader.Start(TEXTURE_FILES, sizeof(TEXTURE_FILES) / sizeof(TEXTURE_FILES[0]), gTextureArrayId, gColorArrayId))
 	{
-		cout << "Failed to load texture " << texFilename << endl;
-	}
-	// Load donut sprinkle blue
-	texFilename = "../7-1 Final Project_Winnie Kwong/Texture/blue sprinkle.jpg";
-	if (!UCreateTexture(texFilename, texture16))
-	{
-		cout << "Failed to load texture " << texFilename << endl;
+		cout << "Failed to create the scene texture array" << endl;
 	}
 
-	// bind texture on corresponding texture unit
-	glActiveTexture(GL_TEXTURE0);
-	glBindTexture(GL_TEXTURE_2D, texture0);
-	glActiveTexture(GL_TEXTURE1);
-	glBindTexture(GL_TEXTURE_2D, texture1);
-	glActiveTexture(GL_TEXTURE2);
-	glBindTexture(GL_TEXTURE_2D, texture2);
-	glActiveTexture(GL_TEXTURE3);
-	glBindTexture(GL_TEXTURE_2D, texture3);
-	glActiveTexture(GL_TEXTURE4);
-	glBindTexture(GL_TEXTURE_2D, texture4);
-	glActiveTexture(GL_TEXTURE5);
-	glBindTexture(GL_TEXTURE_2D, texture5);
-	glActiveTexture(GL_TEXTURE6);
-	glBindTexture(GL_TEXTURE_2D, gOrangeFaceTextureId);
-	glActiveTexture(GL_TEXTURE7);
-	glBindTexture(GL_TEXTURE_2D, gRedFaceTextureId);
-	glActiveTexture(GL_TEXTURE8);
-	glBindTexture(GL_TEXTURE_2D, gGreenFaceTextureId);
-	glActiveTexture(GL_TEXTURE9);
-	glBindTexture(GL_TEXTURE_2D, gBlueFaceTextureId);
-	glActiveTexture(GL_TEXTURE10);
-	glBindTexture(GL_TEXTURE_2D, gYellowFaceTextureId);
-	glActiveTexture(GL_TEXTURE11);
-	glBindTexture(GL_TEXTURE_2D, gWhiteFaceTextureId);
-	glActiveTexture(GL_TEXTURE12);
-	glBindTexture(GL_TEXTURE_2D, texture12);
-	glActiveTexture(GL_TEXTURE13);
-	glBindTexture(GL_TEXTURE_2D, texture13);
-	glActiveTexture(GL_TEXTURE14);
-	glBindTexture(GL_TEXTURE_2D, texture14);
-	glActiveTexture(GL_TEXTURE15);
-	glBindTexture(GL_TEXTURE_2D, texture15);
-	glActiveTexture(GL_TEXTURE16);
-	glBindTexture(GL_TEXTURE_2D, texture16);
+	// the scene file numbers textures by file; point every record at the
+	// layer its file ended up in, which identical files share
+	for (RenderRecord& record : gScene.objects)
+		record.textureLayer = gTextureLoader.LayerOf(record.textureLayer);
+	for (RenderRecord& record : gScene.instances)
+		record.textureLayer = gTextureLoader.LayerOf(record.textureLayer);
+
+	// bind the texture array on the unit the loader uploads through and the
+	// single colors on texture unit 1
+	gGLState.BindTexture(TextureArrayLoader::TEXTURE_UNIT, GL_TEXTURE_2D_ARRAY, gTextureArrayId);
+	gGLState.BindTexture(1, GL_TEXTURE_2D_ARRAY, gColorArrayId);
+
+#if USE_SCENE_BATCH
+	// Merge the scene into the buffers used by the multi-draw path
+	if (!UBuildSceneBatch())
+		return EXIT_FAILURE;
+#endif
+
+	// Upload the instanced objects
+	UCreateInstanceSets(extraSprinkles);
+
+	cout << "INFO: GPU resources: " << gGpuResources.Summary() << endl;
 
 	gCamera.Position = glm::vec3(0.0f, 1.0f, 16.0f);
 	gCamera.Front = glm::vec3(0.0, 0.0, -1.0f);
@@ -434,38 +812,68 @@ int main(int argc, char* argv[])
 		// -----
 		UProcessInput(gWindow);
 
+		// Swap in the textures that finished loading
+		gTextureLoader.Poll();
+
 		// Render this frame
 		URender();
 
+		if (gPrintStats && currentFrame - gLastStatsTime >= 1.0)
+		{
+			gLastStatsTime = currentFrame;
+			cout << "STATS: " << gFrameStats.matricesRecomputed << " model matrices recomputed, "
+				<< gFrameStats.objectsDrawn << " objects drawn, " << gFrameStats.objectsCulled << " culled, "
+				<< gFrameStats.objectsReduced << " at reduced detail, "
+				<< gFrameStats.glCallsSkipped << " GL calls skipped, "
+				<< (gGpuResources.LiveBytes(GpuResourceType::Texture) + gGpuResources.LiveBytes(GpuResourceType::Buffer)) / (1024 * 1024)
+				<< " MB of GPU memory, " << gTextureLoader.ResidentBytes() / (1024 * 1024) << " MB of texture levels resident ("
+				<< gTextureLoader.Evictions() << " evictions)";
+#if !USE_SCENE_BATCH
+			cout << ", " << gFrameStats.stateChangesUnsorted << " state changes unsorted, "
+				<< gFrameStats.stateChangesSorted << " sorted";
+#endif
+			cout << endl;
+		}
+
+		// --bench-frames: report the average CPU time of the draw loop, then quit
+		if (gBenchFrames > 0 && ++gFramesDrawn == gBenchFrames)
+		{
+			cout << "INFO: Draw loop: " << 1000.0 * gDrawLoopSeconds / gFramesDrawn << " ms per frame over "
+				<< gFramesDrawn << " frames (" << gScene.objects.size() << " objects, "
+				<< gScene.instances.size() << " instances, " << gFrameStats.objectsDrawn << " objects drawn in the last frame)" << endl;
+			glfwSetWindowShouldClose(gWindow, true);
+		}
+
 		glfwPollEvents();
 	}
 
 	// Release mesh data
 	//UDestroyMesh(gMesh);
+#if USE_SCENE_BATCH
+	gSceneBatch.Destroy();
+#endif
+	for (InstanceSet& set : gInstanceSets)
+		meshes.DestroyInstances(set.instances);
 	meshes.DestroyMeshes();
 
 	// release textures
-	UDestroyTexture(texture0);
-	UDestroyTexture(texture1);
-	UDestroyTexture(texture2);
-	UDestroyTexture(texture3);
-	UDestroyTexture(texture4);
-	UDestroyTexture(texture5);
-	UDestroyTexture(gRedFaceTextureId);
-	UDestroyTexture(gYellowFaceTextureId);
-	UDestroyTexture(gWhiteFaceTextureId);
-	UDestroyTexture(gGreenFaceTextureId);
-	UDestroyTexture(gBlueFaceTextureId);
-	UDestroyTexture(gOrangeFaceTextureId);
-	UDestroyTexture(texture12);
-	UDestroyTexture(texture13);
-	UDestroyTexture(texture14);
-	UDestroyTexture(texture15);
-	UDestroyTexture(texture16);
+	gTextureLoader.Stop();
+	UDestroyTexture(gTextureArrayId);
+	UDestroyTexture(gColorArrayId);
+	gAssetPack.Close();
+
 
+#if USE_FRAME_UBO
+	gGpuResources.Deleted(GpuResourceType::Buffer, gFrameUbo);
+	glDeleteBuffers(1, &gFrameUbo);
+#endif
 
 	// Release shader program
 	UDestroyShaderProgram(gProgramId);
+	UDestroyShaderProgram(gInstanceProgramId);
+
+	// everything created above should be gone by now
+	gGpuResources.ReportLeaks();
 
 	exit(EXIT_SUCCESS); // Terminates the program successfully
 }
@@ -548,6 +956,12 @@ void UProcessInput(GLFWwindow* window)
 	if (glfwGetKey(window, GLFW_KEY_O) == GLFW_PRESS)
 		perspective = true;
 
+	if (glfwGetKey(window, GLFW_KEY_R) == GLFW_PRESS && gOrnamentNode >= 0)
+	{
+		gOrnamentAngle += gDeltaTime;
+		gScene.transforms.SetRotation(gOrnamentNode, gOrnamentAngle, glm::vec3(0.0f, 1.0f, 0.0f));
+	}
+
 
 }
 
@@ -629,31 +1043,11 @@ void UMouseButtonCallback(GLFWwindow* window, int button, int action, int mods)
 // Functioned called to render a frame
 void URender()
 {
-	glm::mat4 scale;
-	glm::mat4 rotation;
-	glm::mat4 rotation1;
-	glm::mat4 rotation2;
-	glm::mat4 translation;
-	glm::mat4 model;
 	glm::mat4 view;
 	glm::mat4 projection;
 	bool ubHasTextureVal;
-	GLint modelLoc;
-	GLint viewLoc;
-	GLint projLoc;
-	GLint viewPosLoc;
-	GLint ambStrLoc;
-	GLint ambColLoc;
-	GLint light1ColLoc;
-	GLint light1PosLoc;
-	GLint light2ColLoc;
-	GLint light2PosLoc;
-	GLint objColLoc;
-	GLint specInt1Loc;
-	GLint highlghtSz1Loc;
-	GLint specInt2Loc;
-	GLint highlghtSz2Loc;
-	GLint uHasTextureLoc;
+
+	gGLState.ResetCounters();
 
 	// Enable z-depth
 	glEnable(GL_DEPTH_TEST);
@@ -672,1355 +1066,340 @@ void URender()
 		projection = glm::ortho(-5.0f, 5.0f, -5.0f, 5.0f, 0.1f, 100.0f);
 
 	// Set the shader to be used
-	glUseProgram(gProgramId);
-
-	// Retrieves and passes transform matrices to the Shader program
-	modelLoc = glGetUniformLocation(gProgramId, "model");
-	viewLoc = glGetUniformLocation(gProgramId, "view");
-	projLoc = glGetUniformLocation(gProgramId, "projection");
-	viewPosLoc = glGetUniformLocation(gProgramId, "viewPosition");
-	ambStrLoc = glGetUniformLocation(gProgramId, "ambientStrength");
-	ambColLoc = glGetUniformLocation(gProgramId, "ambientColor");
-	light1ColLoc = glGetUniformLocation(gProgramId, "light1Color");
-	light1PosLoc = glGetUniformLocation(gProgramId, "light1Position");
-	light2ColLoc = glGetUniformLocation(gProgramId, "light2Color");
-	light2PosLoc = glGetUniformLocation(gProgramId, "light2Position");
-	objColLoc = glGetUniformLocation(gProgramId, "objectColor");
-	specInt1Loc = glGetUniformLocation(gProgramId, "specularIntensity1");
-	highlghtSz1Loc = glGetUniformLocation(gProgramId, "highlightSize1");
-	specInt2Loc = glGetUniformLocation(gProgramId, "specularIntensity2");
-	highlghtSz2Loc = glGetUniformLocation(gProgramId, "highlightSize2");
-	uHasTextureLoc = glGetUniformLocation(gProgramId, "ubHasTexture");
-
-	glUniformMatrix4fv(viewLoc, 1, GL_FALSE, glm::value_ptr(view));
-	glUniformMatrix4fv(projLoc, 1, GL_FALSE, glm::value_ptr(projection));
+	gGLState.UseProgram(gProgramId);
 
-	//set the camera view location
-	glUniform3f(viewPosLoc, gCamera.Position.x, gCamera.Position.y, gCamera.Position.z);
+#if USE_FRAME_UBO
+	// Fill the whole frame block and upload it with one buffer update
+	gFrameBlock.view = view;
+	gFrameBlock.projection = projection;
+	gFrameBlock.viewPosition = gCamera.Position;
 
 	// pre-set flashlight settings
-	glUniform3f(glGetUniformLocation(gProgramId, "flashLight.position"), gCamera.Position.x, gCamera.Position.y, gCamera.Position.z);
-	glUniform3f(glGetUniformLocation(gProgramId, "flashLight.direction"), gCamera.Front.x, gCamera.Front.y, gCamera.Front.z);
-	glUniform1f(glGetUniformLocation(gProgramId, "flashLight.cutOff"), glm::cos(glm::radians(12.5f)));
-	glUniform1f(glGetUniformLocation(gProgramId, "flashLight.outerCutOff"), glm::cos(glm::radians(17.5f)));
-	glUniform1f(glGetUniformLocation(gProgramId, "flashLight.constant"), 1.0f);
-	glUniform1f(glGetUniformLocation(gProgramId, "flashLight.linear"), 0.09f);
-	glUniform1f(glGetUniformLocation(gProgramId, "flashLight.quadratic"), 0.032f);
-	glUniform3f(glGetUniformLocation(gProgramId, "flashLight.ambientColor"), 1.0f, 1.0f, 1.0f);
-	glUniform3f(glGetUniformLocation(gProgramId, "flashLight.diffuseColor"), 0.6f, 0.6f, 0.6f);
-	glUniform3f(glGetUniformLocation(gProgramId, "flashLight.specularColor"), 0.8f, 0.8f, 0.8f);
+	gFrameBlock.flashLight.position = gCamera.Position;
+	gFrameBlock.flashLight.direction = gCamera.Front;
+	gFrameBlock.flashLight.cutOff = glm::cos(glm::radians(12.5f));
+	gFrameBlock.flashLight.outerCutOff = glm::cos(glm::radians(17.5f));
+	gFrameBlock.flashLight.constant = 1.0f;
+	gFrameBlock.flashLight.linear = 0.09f;
+	gFrameBlock.flashLight.quadratic = 0.032f;
+	gFrameBlock.flashLight.ambientColor = glm::vec3(1.0f, 1.0f, 1.0f);
+	gFrameBlock.flashLight.diffuseColor = glm::vec3(0.6f, 0.6f, 0.6f);
+	gFrameBlock.flashLight.specularColor = glm::vec3(0.8f, 0.8f, 0.8f);
+
+	//set ambient lighting strength and color
+	gFrameBlock.ambientStrength = 0.4f;
+	gFrameBlock.ambientColor = glm::vec3(0.5f, 0.5f, 0.5f);
+	gFrameBlock.light1Color = glm::vec3(0.26f, 0.05f, 0.38f);
+	gFrameBlock.light1Position = glm::vec3(-2.0f, 3.0f, 2.0f);
+	gFrameBlock.light2Color = glm::vec3(0.0f, 0.20f, 0.44f);
+	gFrameBlock.light2Position = glm::vec3(5.0f, 3.0f, 2.0f);
+
+	//set specular intensity and highlight size
+	gFrameBlock.specularIntensity1 = 1.0f;
+	gFrameBlock.specularIntensity2 = 1.0f;
+	gFrameBlock.highlightSize1 = 12.0f;
+	gFrameBlock.highlightSize2 = 12.0f;
+
+	glBindBuffer(GL_UNIFORM_BUFFER, gFrameUbo);
+	glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(FrameBlock), &gFrameBlock);
+	glBindBuffer(GL_UNIFORM_BUFFER, 0);
+#else
+	USetFrameUniforms(gUniforms, view, projection);
+#endif
 
-	//set ambient lighting strength
-	glUniform1f(ambStrLoc, 0.4f);
-	//set ambient color
-	glUniform3f(ambColLoc, 0.5f, 0.5f, 0.5f);
-	glUniform3f(light1ColLoc, 0.26f, 0.05f, 0.38f);
-	glUniform3f(light1PosLoc, -2.0f, 3.0f, 2.0f);
-	glUniform3f(light2ColLoc, 0.0f, 0.20f, 0.44f);
-	glUniform3f(light2PosLoc, 5.0f, 3.0f, 2.0f);
+	ubHasTextureVal = true;
+	gUniforms.hasTexture.Set(ubHasTextureVal);
 
-	//set specular intensity
-	glUniform1f(specInt1Loc, 1.0f);
-	glUniform1f(specInt2Loc, 1.0f);
+	double drawLoopStart = glfwGetTime();
 
-	//set specular highlight size
-	glUniform1f(highlghtSz1Loc, 12.0f);
-	glUniform1f(highlghtSz2Loc, 12.0f);
+	// Only objects that moved, and their children, get new model matrices
+	gFrameStats.matricesRecomputed = gScene.transforms.Update();
+#if USE_SCENE_BATCH
+	for (size_t i = 0; gFrameStats.matricesRecomputed > 0 && i < gScene.objects.size(); ++i)
+	{
+		int node = gScene.objects[i].transform;
+		if (gScene.transforms.Changed(node))
+			gSceneBatch.UpdateModel((GLsizei)i, gScene.transforms.Model(node));
+	}
+#endif
+	UUpdateObjectBounds(false);
 
-	ubHasTextureVal = true;
-	glUniform1i(uHasTextureLoc, ubHasTextureVal);
-
-	// White Styrfoam Information (Plane)
-	// Activate the VBOs contained within the mesh's VAO
-	glBindVertexArray(meshes.gPlaneMesh.vao);
-	// 1. Scales the object
-	scale = glm::scale(glm::vec3(13.0f, 13.0f, 13.0f));
-	// 2. Rotate the object
-	rotation = glm::rotate(0.0f, glm::vec3(1.0, 1.0f, 1.0f));
-	// 3. Position the object
-	translation = glm::translate(glm::vec3(0.0f, 0.0f, 0.0f));
-	// Model matrix: transformations are applied right-to-left order
-	model = translation * rotation * scale;
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-	// Draws texture
-	glUniform1i(glGetUniformLocation(gProgramId, "uTexture"), 0);
-	glUniform3f(glGetUniformLocation(gProgramId, "currentMaterial.diffuseColor"), 0.3f, 0.3f, 0.3f);
-	glUniform3f(glGetUniformLocation(gProgramId, "currentMaterial.specularColor"), 0.5f, 0.5f, 0.5f);
-	glUniform1f(glGetUniformLocation(gProgramId, "currentMaterial.shininess"), 32.f);
-	// Draws the triangles
-	glDrawElements(GL_TRIANGLES, meshes.gPlaneMesh.nIndices, GL_UNSIGNED_INT, (void*)0);
-	// Deactivate the Vertex Array Object
-	glBindVertexArray(0);
-
-	// Christmas Ornament Clasp (Cylinder)
-	// Activate the VBOs contained within the mesh's VAO
-	glBindVertexArray(meshes.gCylinderMesh.vao);
-	// 1. Scales the object
-	scale = glm::scale(glm::vec3(0.35f, 0.45f, 0.3f));
-	// 2. Rotate the object
-	rotation = glm::rotate(100.0f, glm::vec3(1.0, 1.0f, 270.0f));
-	// 3. Position the object
-	translation = glm::translate(glm::vec3(3.35f, 0.35f, 8.0f));
-	// Model matrix: transformations are applied right-to-left order
-	model = translation * rotation * scale;
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-	// Draws texture
-	glUniform1i(glGetUniformLocation(gProgramId, "uTexture"), 1);
-	glUniform3f(glGetUniformLocation(gProgramId, "currentMaterial.diffuseColor"), 0.6f, 0.6f, 0.6f);
-	glUniform3f(glGetUniformLocation(gProgramId, "currentMaterial.specularColor"), 0.5f, 0.5f, 0.5f);
-	glUniform1f(glGetUniformLocation(gProgramId, "currentMaterial.shininess"), 32.f);
-	// Draws the triangles
-	glDrawArrays(GL_TRIANGLE_FAN, 0, 36);		//bottom
-	glDrawArrays(GL_TRIANGLE_FAN, 36, 36);		//top
-	glDrawArrays(GL_TRIANGLE_STRIP, 72, 146);	//sides
-	// Deactivate the Vertex Array Object
-	glBindVertexArray(0);
-
-	// Christmas Ornament Hook (Torus)
-	// Activate the VBOs contained within the mesh's VAO
-	glBindVertexArray(meshes.gTorusMesh.vao);
-	// 1. Scales the object
-	scale = glm::scale(glm::vec3(0.3f, 0.3f, 0.3f));
-	// 2. Rotate the object
-	rotation = glm::rotate(0.0f, glm::vec3(1.0, 1.0f, 1.0f));
-	// 3. Position the object
-	translation = glm::translate(glm::vec3(3.35f, 0.33f, 8.0f));
-	// Model matrix: transformations are applied right-to-left order
-	model = translation * rotation * scale;
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-	// Draws the triangles
-	glDrawArrays(GL_TRIANGLES, 0, meshes.gTorusMesh.nVertices);
-	// Deactivate the Vertex Array Object
-	glBindVertexArray(0);
-
-	// Christmas Ornament Body (Sphere)
-	// Activate the VBOs contained within the mesh's VAO
-	glBindVertexArray(meshes.gSphereMesh.vao);
-	// 1. Scales the object
-	scale = glm::scale(glm::vec3(2.2f, 2.2f, 2.2f));
-	// 2. Rotate the object
-	rotation = glm::rotate(0.0f, glm::vec3(1.0, 1.0f, 1.0f));
-	// 3. Position the object
-	translation = glm::translate(glm::vec3(5.0f, 2.2f, 8.0f));
-	// Model matrix: transformations are applied right-to-left order
-	model = translation * rotation * scale;
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-	// Draws texture
-	glUniform1i(glGetUniformLocation(gProgramId, "uTexture"), 2);
-	glUniform3f(glGetUniformLocation(gProgramId, "currentMaterial.diffuseColor"), 0.3f, 0.3f, 0.5f);
-	glUniform3f(glGetUniformLocation(gProgramId, "currentMaterial.specularColor"), 1.0f, 1.0f, 1.0f);
-	glUniform1f(glGetUniformLocation(gProgramId, "currentMaterial.shininess"), 32.f);
-	// Draws the triangles
-	glDrawElements(GL_TRIANGLES, meshes.gSphereMesh.nIndices, GL_UNSIGNED_INT, (void*)0);
-	// Deactivate the Vertex Array Object
-	glBindVertexArray(0);
-
-	// Triforce Left (Prism)
-	// Activate the VBOs contained within the mesh's VAO
-	glBindVertexArray(meshes.gPrismMesh.vao);
-	// 1. Scales the object
-	scale = glm::scale(glm::vec3(0.5f, 0.1f, 0.5f));
-	// 2. Rotate the object
-	rotation = glm::rotate(0.0f, glm::vec3(1.0f, 1.0f, 1.0f));
-	// 3. Position the object
-	translation = glm::translate(glm::vec3(4.0f, 0.06f, -3.0f));
-	// Model matrix: transformations are applied right-to-left order
-	model = translation * rotation * scale;
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-	// Draws texture
-	glUniform1i(glGetUniformLocation(gProgramId, "uTexture"), 3);
-	glUniform3f(glGetUniformLocation(gProgramId, "currentMaterial.diffuseColor"), 0.3f, 0.3f, 0.3f);
-	glUniform3f(glGetUniformLocation(gProgramId, "currentMaterial.specularColor"), 0.5f, 0.5f, 0.5f);
-	glUniform1f(glGetUniformLocation(gProgramId, "currentMaterial.shininess"), 32.f);
-	// Draws the triangles
-	glDrawArrays(GL_TRIANGLE_STRIP, 0, meshes.gPrismMesh.nVertices);
-	// Deactivate the Vertex Array Object
-	glBindVertexArray(0);
-
-	// Triforce Center (Prism)
-	// Activate the VBOs contained within the mesh's VAO
-	glBindVertexArray(meshes.gPrismMesh.vao);
-	// 1. Scales the object
-	scale = glm::scale(glm::vec3(0.5f, 0.1f, 0.5f));
-	// 2. Rotate the object
-	rotation = glm::rotate(0.0f, glm::vec3(1.0f, 1.0f, 1.0f));
-	// 3. Position the object
-	translation = glm::translate(glm::vec3(4.5f, 0.06f, -3.0f));
-	// Model matrix: transformations are applied right-to-left order
-	model = translation * rotation * scale;
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-	// Draws the triangles
-	glDrawArrays(GL_TRIANGLE_STRIP, 0, meshes.gPrismMesh.nVertices);
-	// Deactivate the Vertex Array Object
-	glBindVertexArray(0);
-
-	// Triforce Right (Prism)
-	// Activate the VBOs contained within the mesh's VAO
-	glBindVertexArray(meshes.gPrismMesh.vao);
-	// 1. Scales the object
-	scale = glm::scale(glm::vec3(0.5f, 0.1f, 0.5f));
-	// 2. Rotate the object
-	rotation = glm::rotate(0.0f, glm::vec3(1.0f, 1.0f, 1.0f));
-	// 3. Position the object
-	translation = glm::translate(glm::vec3(4.25f, 0.06f, -2.5f));
-	// Model matrix: transformations are applied right-to-left order
-	model = translation * rotation * scale;
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-	// Draws the triangles
-	glDrawArrays(GL_TRIANGLE_STRIP, 0, meshes.gPrismMesh.nVertices);
-	// Deactivate the Vertex Array Object
-	glBindVertexArray(0);
-
-	// Triforce Hook 1 (Torus)
-	// Activate the VBOs contained within the mesh's VAO
-	glBindVertexArray(meshes.gTorusMesh.vao);
-	// 1. Scales the object
-	scale = glm::scale(glm::vec3(0.05f, 0.05f, 0.05f));
-	// 2. Rotate the object
-	rotation = glm::rotate(4.19f, glm::vec3(1.0f, 1.0f, 1.f));
-	// 3. Position the object
-	translation = glm::translate(glm::vec3(4.78f, 0.05f, -3.26f));
-	// Model matrix: transformations are applied right-to-left order
-	model = translation * rotation * scale;
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-	// Draws texture
-	glUniform1i(glGetUniformLocation(gProgramId, "uTexture"), 1);
-	glUniform3f(glGetUniformLocation(gProgramId, "currentMaterial.diffuseColor"), 0.4f, 0.4f, 0.4f);
-	glUniform3f(glGetUniformLocation(gProgramId, "currentMaterial.specularColor"), 0.3f, 0.3f, 0.3f);
-	glUniform1f(glGetUniformLocation(gProgramId, "currentMaterial.shininess"), 32.f);
-	// Draws the triangles
-	glDrawArrays(GL_TRIANGLES, 0, meshes.gTorusMesh.nVertices);
-	// Deactivate the Vertex Array Object
-	glBindVertexArray(0);
-
-	// Triforce Hook 2 (Torus)
-	// Activate the VBOs contained within the mesh's VAO
-	glBindVertexArray(meshes.gTorusMesh.vao);
-	// 1. Scales the object
-	scale = glm::scale(glm::vec3(0.1f, 0.1f, 0.1f));
-	// 2. Rotate the object
-	rotation = glm::rotate(3.0f, glm::vec3(1.0f, 270.0f, 180.0f));
-	// 3. Position the object
-	translation = glm::translate(glm::vec3(4.90f, 0.06f, -3.2f));
-	// Model matrix: transformations are applied right-to-left order
-	model = translation * rotation * scale;
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-	// Draws the triangles
-	glDrawArrays(GL_TRIANGLES, 0, meshes.gTorusMesh.nVertices);
-	// Deactivate the Vertex Array Object
-	glBindVertexArray(0);
-
-	// Donut (Bottom Main Left Box)
-	// Activate the VBOs contained within the mesh's VAO
-	glBindVertexArray(meshes.gBoxMesh.vao);
-	// 1. Scales the object
-	scale = glm::scale(glm::vec3(0.9f, 0.9f, 1.2f));
-	// 2. Rotate the object
-	rotation = glm::rotate(0.0f, glm::vec3(1.0f, 1.0f, 1.0f));
-	// 3. Position the object
-	translation = glm::translate(glm::vec3(-5.26f, 0.5f, 8.0f));
-	// Model matrix: transformations are applied right-to-left order
-	model = translation * rotation * scale;
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-	// Get texture
-	glUniform1i(glGetUniformLocation(gProgramId, "uTexture"), 4);
-	glUniform3f(glGetUniformLocation(gProgramId, "currentMaterial.diffuseColor"), 0.6f, 0.6f, 0.6f);
-	glUniform3f(glGetUniformLocation(gProgramId, "currentMaterial.specularColor"), 0.2f, 0.2f, 0.2f);
-	glUniform1f(glGetUniformLocation(gProgramId, "currentMaterial.shininess"), 32.f);
-	// Draws the triangles
-	glDrawArrays(GL_TRIANGLES, 0, meshes.gBoxMesh.nVertices);
-	// Deactivate the Vertex Array Object
-	glBindVertexArray(0);
-
-	// Donut (Bottom Middle LH Down-Left Box)
-	// Activate the VBOs contained within the mesh's VAO
-	glBindVertexArray(meshes.gBoxMesh.vao);
-	// 1. Scales the object
-	scale = glm::scale(glm::vec3(0.9f, 0.6f, 0.9f));
-	// 2. Rotate the object
-	rotation = glm::rotate(0.0f, glm::vec3(1.0f, 1.0f, 1.0f));
-	// 3. Position the object
-	translation = glm::translate(glm::vec3(-5.26f, 0.65f, 8.45f));
-	// Model matrix: transformations are applied right-to-left order
-	model = translation * rotation * scale;
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-	// Draws the triangles
-	glDrawArrays(GL_TRIANGLES, 0, meshes.gBoxMesh.nVertices);
-	// Deactivate the Vertex Array Object
-	glBindVertexArray(0);
-
-	// Donut (Bottom Corner Down-Left Box)
-	// Activate the VBOs contained within the mesh's VAO
-	glBindVertexArray(meshes.gBoxMesh.vao);
-	// 1. Scales the object
-	scale = glm::scale(glm::vec3(0.9f, 0.9f, 0.9f));
-	// 2. Rotate the object
-	rotation = glm::rotate(0.0f, glm::vec3(1.0f, 1.0f, 1.0f));
-	// 3. Position the object
-	translation = glm::translate(glm::vec3(-4.96f, 0.5f, 8.75f));
-	// Model matrix: transformations are applied right-to-left order
-	model = translation * rotation * scale;
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-	// Draws the triangles
-	glDrawArrays(GL_TRIANGLES, 0, meshes.gBoxMesh.nVertices);
-	// Deactivate the Vertex Array Object
-	glBindVertexArray(0);
-
-	// Donut (Bottom Middle LH Down-Right Box)
-	// Activate the VBOs contained within the mesh's VAO
-	glBindVertexArray(meshes.gBoxMesh.vao);
-	// 1. Scales the object
-	scale = glm::scale(glm::vec3(0.9f, 0.6f, 0.9f));
-	// 2. Rotate the object
-	rotation = glm::rotate(0.0f, glm::vec3(1.0f, 1.0f, 1.0f));
-	// 3. Position the object
-	translation = glm::translate(glm::vec3(-4.66f, 0.65f, 9.05f));
-	// Model matrix: transformations are applied right-to-left order
-	model = translation * rotation * scale;
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-	// Draws the triangles
-	glDrawArrays(GL_TRIANGLES, 0, meshes.gBoxMesh.nVertices);
-	// Deactivate the Vertex Array Object
-	glBindVertexArray(0);
-
-	// Donut (Bottom Main Down Box)
-	// Activate the VBOs contained within the mesh's VAO
-	glBindVertexArray(meshes.gBoxMesh.vao);
-	// 1. Scales the object
-	scale = glm::scale(glm::vec3(1.2f, 0.9f, 0.9f));
-	// 2. Rotate the object
-	rotation = glm::rotate(0.0f, glm::vec3(1.0f, 1.0f, 1.0f));
-	// 3. Position the object
-	translation = glm::translate(glm::vec3(-4.26f, 0.5f, 9.05f));
-	// Model matrix: transformations are applied right-to-left order
-	model = translation * rotation * scale;
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-	// Draws the triangles
-	glDrawArrays(GL_TRIANGLES, 0, meshes.gBoxMesh.nVertices);
-	// Deactivate the Vertex Array Object
-	glBindVertexArray(0);
-
-	// Donut (Bottom Middle RH Down-Left Box)
-	// Activate the VBOs contained within the mesh's VAO
-	glBindVertexArray(meshes.gBoxMesh.vao);
-	// 1. Scales the object
-	scale = glm::scale(glm::vec3(0.9f, 0.6f, 0.9f));
-	// 2. Rotate the object
-	rotation = glm::rotate(0.0f, glm::vec3(1.0f, 1.0f, 1.0f));
-	// 3. Position the object
-	translation = glm::translate(glm::vec3(-3.76f, 0.65f, 9.05f));
-	// Model matrix: transformations are applied right-to-left order
-	model = translation * rotation * scale;
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-	// Draws the triangles
-	glDrawArrays(GL_TRIANGLES, 0, meshes.gBoxMesh.nVertices);
-	// Deactivate the Vertex Array Object
-	glBindVertexArray(0);
-
-	// Donut (Bottom Corner Down-Right Box)
-	// Activate the VBOs contained within the mesh's VAO
-	glBindVertexArray(meshes.gBoxMesh.vao);
-	// 1. Scales the object
-	scale = glm::scale(glm::vec3(0.9f, 0.9f, 0.9f));
-	// 2. Rotate the object
-	rotation = glm::rotate(0.0f, glm::vec3(1.0f, 1.0f, 1.0f));
-	// 3. Position the object
-	translation = glm::translate(glm::vec3(-3.46f, 0.5f, 8.75f));
-	// Model matrix: transformations are applied right-to-left order
-	model = translation * rotation * scale;
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-	// Draws the triangles
-	glDrawArrays(GL_TRIANGLES, 0, meshes.gBoxMesh.nVertices);
-	// Deactivate the Vertex Array Object
-	glBindVertexArray(0);
-
-	// Donut (Bottom Middle RH Down-Right Box)
-	// Activate the VBOs contained within the mesh's VAO
-	glBindVertexArray(meshes.gBoxMesh.vao);
-	// 1. Scales the object
-	scale = glm::scale(glm::vec3(0.9f, 0.6f, 0.9f));
-	// 2. Rotate the object
-	rotation = glm::rotate(0.0f, glm::vec3(1.0f, 1.0f, 1.0f));
-	// 3. Position the object
-	translation = glm::translate(glm::vec3(-3.16f, 0.65f, 8.450f));
-	// Model matrix: transformations are applied right-to-left order
-	model = translation * rotation * scale;
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-	// Draws the triangles
-	glDrawArrays(GL_TRIANGLES, 0, meshes.gBoxMesh.nVertices);
-	// Deactivate the Vertex Array Object
-	glBindVertexArray(0);
-
-	// Donut (Bottom Main Right Box)
-	// Activate the VBOs contained within the mesh's VAO
-	glBindVertexArray(meshes.gBoxMesh.vao);
-	// 1. Scales the object
-	scale = glm::scale(glm::vec3(0.9f, 0.9f, 1.2f));
-	// 2. Rotate the object
-	rotation = glm::rotate(0.0f, glm::vec3(1.0f, 1.0f, 1.0f));
-	// 3. Position the object
-	translation = glm::translate(glm::vec3(-3.16f, 0.5f, 8.0f));
-	// Model matrix: transformations are applied right-to-left order
-	model = translation * rotation * scale;
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-	// Draws the triangles
-	glDrawArrays(GL_TRIANGLES, 0, meshes.gBoxMesh.nVertices);
-	// Deactivate the Vertex Array Object
-	glBindVertexArray(0);
-
-	// Donut (Bottom Middle RH Up-Right Box)
-	// Activate the VBOs contained within the mesh's VAO
-	glBindVertexArray(meshes.gBoxMesh.vao);
-	// 1. Scales the object
-	scale = glm::scale(glm::vec3(0.9f, 0.6f, 0.9f));
-	// 2. Rotate the object
-	rotation = glm::rotate(0.0f, glm::vec3(1.0f, 1.0f, 1.0f));
-	// 3. Position the object
-	translation = glm::translate(glm::vec3(-3.16f, 0.65f, 7.55f));
-	// Model matrix: transformations are applied right-to-left order
-	model = translation * rotation * scale;
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-	// Draws the triangles
-	glDrawArrays(GL_TRIANGLES, 0, meshes.gBoxMesh.nVertices);
-	// Deactivate the Vertex Array Object
-	glBindVertexArray(0);
-
-	// Donut (Bottom Corner Up-Right Box)
-	// Activate the VBOs contained within the mesh's VAO
-	glBindVertexArray(meshes.gBoxMesh.vao);
-	// 1. Scales the object
-	scale = glm::scale(glm::vec3(0.9f, 0.9f, 0.9f));
-	// 2. Rotate the object
-	rotation = glm::rotate(0.0f, glm::vec3(1.0f, 1.0f, 1.0f));
-	// 3. Position the object
-	translation = glm::translate(glm::vec3(-3.46f, 0.5f, 7.25f));
-	// Model matrix: transformations are applied right-to-left order
-	model = translation * rotation * scale;
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-	// Draws the triangles
-	glDrawArrays(GL_TRIANGLES, 0, meshes.gBoxMesh.nVertices);
-	// Deactivate the Vertex Array Object
-	glBindVertexArray(0);
-
-	// Donut (Bottom Middle RH Up-Left Box)
-	// Activate the VBOs contained within the mesh's VAO
-	glBindVertexArray(meshes.gBoxMesh.vao);
-	// 1. Scales the object
-	scale = glm::scale(glm::vec3(0.9f, 0.6f, 0.9f));
-	// 2. Rotate the object
-	rotation = glm::rotate(0.0f, glm::vec3(1.0f, 1.0f, 1.0f));
-	// 3. Position the object
-	translation = glm::translate(glm::vec3(-3.76f, 0.65f, 6.95f));
-	// Model matrix: transformations are applied right-to-left order
-	model = translation * rotation * scale;
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-	// Draws the triangles
-	glDrawArrays(GL_TRIANGLES, 0, meshes.gBoxMesh.nVertices);
-	// Deactivate the Vertex Array Object
-	glBindVertexArray(0);
-
-	// Donut (Bottom Main Up Box)
-	// Activate the VBOs contained within the mesh's VAO
-	glBindVertexArray(meshes.gBoxMesh.vao);
-	// 1. Scales the object
-	scale = glm::scale(glm::vec3(1.2f, 0.9f, 0.9f));
-	// 2. Rotate the object
-	rotation = glm::rotate(0.0f, glm::vec3(1.0f, 1.0f, 1.0f));
-	// 3. Position the object
-	translation = glm::translate(glm::vec3(-4.21f, 0.5f, 6.95f));
-	// Model matrix: transformations are applied right-to-left order
-	model = translation * rotation * scale;
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-	// Draws the triangles
-	glDrawArrays(GL_TRIANGLES, 0, meshes.gBoxMesh.nVertices);
-	// Deactivate the Vertex Array Object
-	glBindVertexArray(0);
-
-	// Donut (Bottom Middle LH Up-Right Box)
-	// Activate the VBOs contained within the mesh's VAO
-	glBindVertexArray(meshes.gBoxMesh.vao);
-	// 1. Scales the object
-	scale = glm::scale(glm::vec3(0.9f, 0.6f, 0.9f));
-	// 2. Rotate the object
-	rotation = glm::rotate(0.0f, glm::vec3(1.0f, 1.0f, 1.0f));
-	// 3. Position the object
-	translation = glm::translate(glm::vec3(-4.66f, 0.65f, 6.95f));
-	// Model matrix: transformations are applied right-to-left order
-	model = translation * rotation * scale;
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-	// Draws the triangles
-	glDrawArrays(GL_TRIANGLES, 0, meshes.gBoxMesh.nVertices);
-	// Deactivate the Vertex Array Object
-	glBindVertexArray(0);
-
-	// Donut (Bottom Corner Up-Left Box)
-	// Activate the VBOs contained within the mesh's VAO
-	glBindVertexArray(meshes.gBoxMesh.vao);
-	// 1. Scales the object
-	scale = glm::scale(glm::vec3(0.9f, 0.9f, 0.9f));
-	// 2. Rotate the object
-	rotation = glm::rotate(0.0f, glm::vec3(1.0f, 1.0f, 1.0f));
-	// 3. Position the object
-	translation = glm::translate(glm::vec3(-4.96f, 0.5f, 7.25f));
-	// Model matrix: transformations are applied right-to-left order
-	model = translation * rotation * scale;
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-	// Draws the triangles
-	glDrawArrays(GL_TRIANGLES, 0, meshes.gBoxMesh.nVertices);
-	// Deactivate the Vertex Array Object
-	glBindVertexArray(0);
-
-	// Donut (Bottom Middle LH Up-Left Box)
-	// Activate the VBOs contained within the mesh's VAO
-	glBindVertexArray(meshes.gBoxMesh.vao);
-	// 1. Scales the object
-	scale = glm::scale(glm::vec3(0.9f, 0.6f, 0.9f));
-	// 2. Rotate the object
-	rotation = glm::rotate(0.0f, glm::vec3(1.0f, 1.0f, 1.0f));
-	// 3. Position the object
-	translation = glm::translate(glm::vec3(-5.26f, 0.65f, 7.55f));
-	// Model matrix: transformations are applied right-to-left order
-	model = translation * rotation * scale;
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-	// Draws the triangles
-	glDrawArrays(GL_TRIANGLES, 0, meshes.gBoxMesh.nVertices);
-	// Deactivate the Vertex Array Object
-	glBindVertexArray(0);
-
-	// Donut (Top Main Left Box)
-	// Activate the VBOs contained within the mesh's VAO
-	glBindVertexArray(meshes.gBoxMesh.vao);
-	// 1. Scales the object
-	scale = glm::scale(glm::vec3(0.9f, 0.3f, 1.2f));
-	// 2. Rotate the object
-	rotation = glm::rotate(0.0f, glm::vec3(1.0f, 1.0f, 1.0f));
-	// 3. Position the object
-	translation = glm::translate(glm::vec3(-5.21f, 1.1f, 8.0f));
-	// Model matrix: transformations are applied right-to-left order
-	model = translation * rotation * scale;
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-	// Get texture
-	glUniform1i(glGetUniformLocation(gProgramId, "uTexture"), 5);
-	glUniform3f(glGetUniformLocation(gProgramId, "currentMaterial.diffuseColor"), 0.6f, 0.6f, 0.6f);
-	glUniform3f(glGetUniformLocation(gProgramId, "currentMaterial.specularColor"), 0.2f, 0.2f, 0.2f);
-	glUniform1f(glGetUniformLocation(gProgramId, "currentMaterial.shininess"), 32.f);
-	// Draws the triangles
-	glDrawArrays(GL_TRIANGLES, 0, meshes.gBoxMesh.nVertices);
-	// Deactivate the Vertex Array Object
-	glBindVertexArray(0);
-
-	// Donut (Top LH Down-Left Box)
-	// Activate the VBOs contained within the mesh's VAO
-	glBindVertexArray(meshes.gBoxMesh.vao);
-	// 1. Scales the object
-	scale = glm::scale(glm::vec3(0.3f, 0.3f, 0.3f));
-	// 2. Rotate the object
-	rotation = glm::rotate(0.0f, glm::vec3(1.0f, 1.0f, 1.0f));
-	// 3. Position the object
-	translation = glm::translate(glm::vec3(-5.26f, 1.1f, 8.75f));
-	// Model matrix: transformations are applied right-to-left order
-	model = translation * rotation * scale;
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-	// Draws the triangles
-	glDrawArrays(GL_TRIANGLES, 0, meshes.gBoxMesh.nVertices);
-	// Deactivate the Vertex Array Object
-	glBindVertexArray(0);
-
-	// Donut (Top Corner Down-Left Box)
-	// Activate the VBOs contained within the mesh's VAO
-	glBindVertexArray(meshes.gBoxMesh.vao);
-	// 1. Scales the object
-	scale = glm::scale(glm::vec3(0.3f, 0.3f, 0.3f));
-	// 2. Rotate the object
-	rotation = glm::rotate(0.0f, glm::vec3(1.0f, 1.0f, 1.0f));
-	// 3. Position the object
-	translation = glm::translate(glm::vec3(-4.96f, 1.1f, 8.75f));
-	// Model matrix: transformations are applied right-to-left order
-	model = translation * rotation * scale;
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-	// Draws the triangles
-	glDrawArrays(GL_TRIANGLES, 0, meshes.gBoxMesh.nVertices);
-	// Deactivate the Vertex Array Object
-	glBindVertexArray(0);
-
-	// Donut (Top Inner Corner Down-Left Box)
-	// Activate the VBOs contained within the mesh's VAO
-	glBindVertexArray(meshes.gBoxMesh.vao);
-	// 1. Scales the object
-	scale = glm::scale(glm::vec3(0.3f, 0.3f, 0.3f));
-	// 2. Rotate the object
-	rotation = glm::rotate(0.0f, glm::vec3(1.0f, 1.0f, 1.0f));
-	// 3. Position the object
-	translation = glm::translate(glm::vec3(-4.66f, 1.1f, 8.45f));
-	// Model matrix: transformations are applied right-to-left order
-	model = translation * rotation * scale;
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-	// Draws the triangles
-	glDrawArrays(GL_TRIANGLES, 0, meshes.gBoxMesh.nVertices);
-	// Deactivate the Vertex Array Object
-	glBindVertexArray(0);
-
-	// Donut (Top LH Down-Right Box)
-	// Activate the VBOs contained within the mesh's VAO
-	glBindVertexArray(meshes.gBoxMesh.vao);
-	// 1. Scales the object
-	scale = glm::scale(glm::vec3(0.3f, 0.3f, 0.3f));
-	// 2. Rotate the object
-	rotation = glm::rotate(0.0f, glm::vec3(1.0f, 1.0f, 1.0f));
-	// 3. Position the object
-	translation = glm::translate(glm::vec3(-4.96f, 1.1f, 9.05f));
-	// Model matrix: transformations are applied right-to-left order
-	model = translation * rotation * scale;
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-	// Draws the triangles
-	glDrawArrays(GL_TRIANGLES, 0, meshes.gBoxMesh.nVertices);
-	// Deactivate the Vertex Array Object
-	glBindVertexArray(0);
-
-	// Donut (Top Main Down Box)
-	// Activate the VBOs contained within the mesh's VAO
-	glBindVertexArray(meshes.gBoxMesh.vao);
-	// 1. Scales the object
-	scale = glm::scale(glm::vec3(1.2f, 0.3f, 0.9f));
-	// 2. Rotate the object
-	rotation = glm::rotate(0.0f, glm::vec3(1.0f, 1.0f, 1.0f));
-	// 3. Position the object
-	translation = glm::translate(glm::vec3(-4.21f, 1.1f, 9.05f));
-	// Model matrix: transformations are applied right-to-left order
-	model = translation * rotation * scale;
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-	// Draws the triangles
-	glDrawArrays(GL_TRIANGLES, 0, meshes.gBoxMesh.nVertices);
-	// Deactivate the Vertex Array Object
-	glBindVertexArray(0);
-
-	// Donut (Top RH Down-Left Box)
-	// Activate the VBOs contained within the mesh's VAO
-	glBindVertexArray(meshes.gBoxMesh.vao);
-	// 1. Scales the object
-	scale = glm::scale(glm::vec3(0.3f, 0.3f, 0.3f));
-	// 2. Rotate the object
-	rotation = glm::rotate(0.0f, glm::vec3(1.0f, 1.0f, 1.0f));
-	// 3. Position the object
-	translation = glm::translate(glm::vec3(-3.46f, 1.1f, 9.05f));
-	// Model matrix: transformations are applied right-to-left order
-	model = translation * rotation * scale;
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-	// Draws the triangles
-	glDrawArrays(GL_TRIANGLES, 0, meshes.gBoxMesh.nVertices);
-	// Deactivate the Vertex Array Object
-	glBindVertexArray(0);
-
-	// Donut (Top Corner Down-Right Box)
-	// Activate the VBOs contained within the mesh's VAO
-	glBindVertexArray(meshes.gBoxMesh.vao);
-	// 1. Scales the object
-	scale = glm::scale(glm::vec3(0.3f, 0.3f, 0.3f));
-	// 2. Rotate the object
-	rotation = glm::rotate(0.0f, glm::vec3(1.0f, 1.0f, 1.0f));
-	// 3. Position the object
-	translation = glm::translate(glm::vec3(-3.46f, 1.1f, 8.75f));
-	// Model matrix: transformations are applied right-to-left order
-	model = translation * rotation * scale;
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-	// Draws the triangles
-	glDrawArrays(GL_TRIANGLES, 0, meshes.gBoxMesh.nVertices);
-	// Deactivate the Vertex Array Object
-	glBindVertexArray(0);
-
-	// Donut (Top Inner Corner Down-Right Box)
-	// Activate the VBOs contained within the mesh's VAO
-	glBindVertexArray(meshes.gBoxMesh.vao);
-	// 1. Scales the object
-	scale = glm::scale(glm::vec3(0.3f, 0.3f, 0.3f));
-	// 2. Rotate the object
-	rotation = glm::rotate(0.0f, glm::vec3(1.0f, 1.0f, 1.0f));
-	// 3. Position the object
-	translation = glm::translate(glm::vec3(-3.76f, 1.1f, 8.45f));
-	// Model matrix: transformations are applied right-to-left order
-	model = translation * rotation * scale;
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-	// Draws the triangles
-	glDrawArrays(GL_TRIANGLES, 0, meshes.gBoxMesh.nVertices);
-	// Deactivate the Vertex Array Object
-	glBindVertexArray(0);
-
-	// Donut (Top RH Down-Right Box)
-	// Activate the VBOs contained within the mesh's VAO
-	glBindVertexArray(meshes.gBoxMesh.vao);
-	// 1. Scales the object
-	scale = glm::scale(glm::vec3(0.3f, 0.3f, 0.3f));
-	// 2. Rotate the object
-	rotation = glm::rotate(0.0f, glm::vec3(1.0f, 1.0f, 1.0f));
-	// 3. Position the object
-	translation = glm::translate(glm::vec3(-3.16f, 1.1f, 8.75));
-	// Model matrix: transformations are applied right-to-left order
-	model = translation * rotation * scale;
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-	// Draws the triangles
-	glDrawArrays(GL_TRIANGLES, 0, meshes.gBoxMesh.nVertices);
-	// Deactivate the Vertex Array Object
-	glBindVertexArray(0);
-
-	// Donut (Top Main Right Box)
-	// Activate the VBOs contained within the mesh's VAO
-	glBindVertexArray(meshes.gBoxMesh.vao);
-	// 1. Scales the object
-	scale = glm::scale(glm::vec3(0.9f, 0.3f, 1.2f));
-	// 2. Rotate the object
-	rotation = glm::rotate(0.0f, glm::vec3(1.0f, 1.0f, 1.0f));
-	// 3. Position the object
-	translation = glm::translate(glm::vec3(-3.16f, 1.1f, 8.0f));
-	// Model matrix: transformations are applied right-to-left order
-	model = translation * rotation * scale;
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-	// Draws the triangles
-	glDrawArrays(GL_TRIANGLES, 0, meshes.gBoxMesh.nVertices);
-	// Deactivate the Vertex Array Object
-	glBindVertexArray(0);
-
-	// Donut (Top RH Up-Left Box)
-	// Activate the VBOs contained within the mesh's VAO
-	glBindVertexArray(meshes.gBoxMesh.vao);
-	// 1. Scales the object
-	scale = glm::scale(glm::vec3(0.3f, 0.3f, 0.3f));
-	// 2. Rotate the object
-	rotation = glm::rotate(0.0f, glm::vec3(1.0f, 1.0f, 1.0f));
-	// 3. Position the object
-	translation = glm::translate(glm::vec3(-3.46f, 1.1f, 6.95f));
-	// Model matrix: transformations are applied right-to-left order
-	model = translation * rotation * scale;
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-	// Draws the triangles
-	glDrawArrays(GL_TRIANGLES, 0, meshes.gBoxMesh.nVertices);
-	// Deactivate the Vertex Array Object
-	glBindVertexArray(0);
-
-	// Donut (Top Corner Up-Right Box)
-	// Activate the VBOs contained within the mesh's VAO
-	glBindVertexArray(meshes.gBoxMesh.vao);
-	// 1. Scales the object
-	scale = glm::scale(glm::vec3(0.3f, 0.3f, 0.3f));
-	// 2. Rotate the object
-	rotation = glm::rotate(0.0f, glm::vec3(1.0f, 1.0f, 1.0f));
-	// 3. Position the object
-	translation = glm::translate(glm::vec3(-3.46f, 1.1f, 7.25f));
-	// Model matrix: transformations are applied right-to-left order
-	model = translation * rotation * scale;
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-	// Draws the triangles
-	glDrawArrays(GL_TRIANGLES, 0, meshes.gBoxMesh.nVertices);
-	// Deactivate the Vertex Array Object
-	glBindVertexArray(0);
-
-	// Donut (Top Inner Corner Up-Right Box)
-	// Activate the VBOs contained within the mesh's VAO
-	glBindVertexArray(meshes.gBoxMesh.vao);
-	// 1. Scales the object
-	scale = glm::scale(glm::vec3(0.3f, 0.3f, 0.3f));
-	// 2. Rotate the object
-	rotation = glm::rotate(0.0f, glm::vec3(1.0f, 1.0f, 1.0f));
-	// 3. Position the object
-	translation = glm::translate(glm::vec3(-3.76f, 1.1f, 7.55f));
-	// Model matrix: transformations are applied right-to-left order
-	model = translation * rotation * scale;
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-	// Draws the triangles
-	glDrawArrays(GL_TRIANGLES, 0, meshes.gBoxMesh.nVertices);
-	// Deactivate the Vertex Array Object
-	glBindVertexArray(0);
-
-	// Donut (Top RH Up-Right Box)
-	// Activate the VBOs contained within the mesh's VAO
-	glBindVertexArray(meshes.gBoxMesh.vao);
-	// 1. Scales the object
-	scale = glm::scale(glm::vec3(0.3f, 0.3f, 0.3f));
-	// 2. Rotate the object
-	rotation = glm::rotate(0.0f, glm::vec3(1.0f, 1.0f, 1.0f));
-	// 3. Position the object
-	translation = glm::translate(glm::vec3(-3.16f, 1.1f, 7.25));
-	// Model matrix: transformations are applied right-to-left order
-	model = translation * rotation * scale;
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-	// Draws the triangles
-	glDrawArrays(GL_TRIANGLES, 0, meshes.gBoxMesh.nVertices);
-	// Deactivate the Vertex Array Object
-	glBindVertexArray(0);
-
-	// Donut (Top LH Up-Left Box)
-// Activate the VBOs contained within the mesh's VAO
-	glBindVertexArray(meshes.gBoxMesh.vao);
-	// 1. Scales the object
-	scale = glm::scale(glm::vec3(0.3f, 0.3f, 0.3f));
-	// 2. Rotate the object
-	rotation = glm::rotate(0.0f, glm::vec3(1.0f, 1.0f, 1.0f));
-	// 3. Position the object
-	translation = glm::translate(glm::vec3(-5.26f, 1.1f, 7.25f));
-	// Model matrix: transformations are applied right-to-left order
-	model = translation * rotation * scale;
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-	// Draws the triangles
-	glDrawArrays(GL_TRIANGLES, 0, meshes.gBoxMesh.nVertices);
-	// Deactivate the Vertex Array Object
-	glBindVertexArray(0);
-
-	// Donut (Top Corner Up-Left Box)
-	// Activate the VBOs contained within the mesh's VAO
-	glBindVertexArray(meshes.gBoxMesh.vao);
-	// 1. Scales the object
-	scale = glm::scale(glm::vec3(0.3f, 0.3f, 0.3f));
-	// 2. Rotate the object
-	rotation = glm::rotate(0.0f, glm::vec3(1.0f, 1.0f, 1.0f));
-	// 3. Position the object
-	translation = glm::translate(glm::vec3(-4.96f, 1.1f, 7.25f));
-	// Model matrix: transformations are applied right-to-left order
-	model = translation * rotation * scale;
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-	// Draws the triangles
-	glDrawArrays(GL_TRIANGLES, 0, meshes.gBoxMesh.nVertices);
-	// Deactivate the Vertex Array Object
-	glBindVertexArray(0);
-
-	// Donut (Top Inner Corner Up-Left Box)
-	// Activate the VBOs contained within the mesh's VAO
-	glBindVertexArray(meshes.gBoxMesh.vao);
-	// 1. Scales the object
-	scale = glm::scale(glm::vec3(0.3f, 0.3f, 0.3f));
-	// 2. Rotate the object
-	rotation = glm::rotate(0.0f, glm::vec3(1.0f, 1.0f, 1.0f));
-	// 3. Position the object
-	translation = glm::translate(glm::vec3(-4.66f, 1.1f, 7.55f));
-	// Model matrix: transformations are applied right-to-left order
-	model = translation * rotation * scale;
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-	// Draws the triangles
-	glDrawArrays(GL_TRIANGLES, 0, meshes.gBoxMesh.nVertices);
-	// Deactivate the Vertex Array Object
-	glBindVertexArray(0);
-
-	// Donut (Top LH Up-Right Box)
-	// Activate the VBOs contained within the mesh's VAO
-	glBindVertexArray(meshes.gBoxMesh.vao);
-	// 1. Scales the object
-	scale = glm::scale(glm::vec3(0.3f, 0.3f, 0.3f));
-	// 2. Rotate the object
-	rotation = glm::rotate(0.0f, glm::vec3(1.0f, 1.0f, 1.0f));
-	// 3. Position the object
-	translation = glm::translate(glm::vec3(-4.96f, 1.1f, 6.95f));
-	// Model matrix: transformations are applied right-to-left order
-	model = translation * rotation * scale;
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-	// Draws the triangles
-	glDrawArrays(GL_TRIANGLES, 0, meshes.gBoxMesh.nVertices);
-	// Deactivate the Vertex Array Object
-	glBindVertexArray(0);
-
-	// Donut (Top Main Up Box)
-	// Activate the VBOs contained within the mesh's VAO
-	glBindVertexArray(meshes.gBoxMesh.vao);
-	// 1. Scales the object
-	scale = glm::scale(glm::vec3(1.2f, 0.3f, 0.9f));
-	// 2. Rotate the object
-	rotation = glm::rotate(0.0f, glm::vec3(1.0f, 1.0f, 1.0f));
-	// 3. Position the object
-	translation = glm::translate(glm::vec3(-4.21f, 1.1f, 6.95f));
-	// Model matrix: transformations are applied right-to-left order
-	model = translation * rotation * scale;
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-	// Draws the triangles
-	glDrawArrays(GL_TRIANGLES, 0, meshes.gBoxMesh.nVertices);
-	// Deactivate the Vertex Array Object
-	glBindVertexArray(0);
-
-	// Sprinkles start from top-down, left-right
-	//  
-	// Donut sprinkle yellow 1/4 (Cylinder)
-	// Activate the VBOs contained within the mesh's VAO
-	glBindVertexArray(meshes.gCylinderMesh.vao);
-	// 1. Scales the object
-	scale = glm::scale(glm::vec3(0.15f, 0.3f, 0.15f));
-	// 2. Rotate the object
-	rotation = glm::rotate(0.0f, glm::vec3(1.0, 1.0f, 1.0f));
-	// 3. Position the object
-	translation = glm::translate(glm::vec3(-4.05f, 1.2f, 6.95f));
-	// Model matrix: transformations are applied right-to-left order
-	model = translation * rotation * scale;
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-	// Draws texture
-	glUniform1i(glGetUniformLocation(gProgramId, "uTexture"), 12);
-	glUniform3f(glGetUniformLocation(gProgramId, "currentMaterial.diffuseColor"), 0.6f, 0.6f, 0.6f);
-	glUniform3f(glGetUniformLocation(gProgramId, "currentMaterial.specularColor"), 0.5f, 0.5f, 0.5f);
-	glUniform1f(glGetUniformLocation(gProgramId, "currentMaterial.shininess"), 16.0f);
-	// Draws the triangles
-	glDrawArrays(GL_TRIANGLE_FAN, 0, 36);		//bottom
-	glDrawArrays(GL_TRIANGLE_FAN, 36, 36);		//top
-	glDrawArrays(GL_TRIANGLE_STRIP, 72, 146);	//sides
-	// Deactivate the Vertex Array Object
-	glBindVertexArray(0);
-
-	// Donut sprinkle yellow 2/4 (Cylinder)
-	// Activate the VBOs contained within the mesh's VAO
-	glBindVertexArray(meshes.gCylinderMesh.vao);
-	// 1. Scales the object
-	scale = glm::scale(glm::vec3(0.15f, 0.3f, 0.15f));
-	// 2. Rotate the object
-	rotation = glm::rotate(0.0f, glm::vec3(1.0, 1.0f, 1.0f));
-	// 3. Position the object
-	translation = glm::translate(glm::vec3(-5.25f, 1.2f, 7.55f));
-	// Model matrix: transformations are applied right-to-left order
-	model = translation * rotation * scale;
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-	// Draws the triangles
-	glDrawArrays(GL_TRIANGLE_FAN, 0, 36);		//bottom
-	glDrawArrays(GL_TRIANGLE_FAN, 36, 36);		//top
-	glDrawArrays(GL_TRIANGLE_STRIP, 72, 146);	//sides
-	// Deactivate the Vertex Array Object
-	glBindVertexArray(0);
-
-	// Donut sprinkle yellow 3/4 (Cylinder)
-	// Activate the VBOs contained within the mesh's VAO
-	glBindVertexArray(meshes.gCylinderMesh.vao);
-	// 1. Scales the object
-	scale = glm::scale(glm::vec3(0.15f, 0.3f, 0.15f));
-	// 2. Rotate the object
-	rotation = glm::rotate(0.0f, glm::vec3(1.0, 1.0f, 1.0f));
-	// 3. Position the object
-	translation = glm::translate(glm::vec3(-3.73f, 1.2f, 8.45f));
-	// Model matrix: transformations are applied right-to-left order
-	model = translation * rotation * scale;
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-	// Draws the triangles
-	glDrawArrays(GL_TRIANGLE_FAN, 0, 36);		//bottom
-	glDrawArrays(GL_TRIANGLE_FAN, 36, 36);		//top
-	glDrawArrays(GL_TRIANGLE_STRIP, 72, 146);	//sides
-	// Deactivate the Vertex Array Object
-	glBindVertexArray(0);
-
-	// Donut sprinkle yellow 4/4 (Cylinder)
-	// Activate the VBOs contained within the mesh's VAO
-	glBindVertexArray(meshes.gCylinderMesh.vao);
-	// 1. Scales the object
-	scale = glm::scale(glm::vec3(0.15f, 0.3f, 0.15f));
-	// 2. Rotate the object
-	rotation = glm::rotate(0.0f, glm::vec3(1.0, 1.0f, 1.0f));
-	// 3. Position the object
-	translation = glm::translate(glm::vec3(-4.35f, 1.2f, 9.05f));
-	// Model matrix: transformations are applied right-to-left order
-	model = translation * rotation * scale;
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-	// Draws the triangles
-	glDrawArrays(GL_TRIANGLE_FAN, 0, 36);		//bottom
-	glDrawArrays(GL_TRIANGLE_FAN, 36, 36);		//top
-	glDrawArrays(GL_TRIANGLE_STRIP, 72, 146);	//sides
-	// Deactivate the Vertex Array Object
-	glBindVertexArray(0);
-
-	// Donut sprinkle red 1/5 (Cylinder)
-	// Activate the VBOs contained within the mesh's VAO
-	glBindVertexArray(meshes.gCylinderMesh.vao);
-	// 1. Scales the object
-	scale = glm::scale(glm::vec3(0.15f, 0.3f, 0.15f));
-	// 2. Rotate the object
-	rotation = glm::rotate(0.0f, glm::vec3(1.0, 1.0f, 1.0f));
-	// 3. Position the object
-	translation = glm::translate(glm::vec3(-4.95f, 1.2f, 7.25f));
-	// Model matrix: transformations are applied right-to-left order
-	model = translation * rotation * scale;
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-	// Draws texture
-	glUniform1i(glGetUniformLocation(gProgramId, "uTexture"), 13);
-	glUniform3f(glGetUniformLocation(gProgramId, "currentMaterial.diffuseColor"), 0.6f, 0.6f, 0.6f);
-	glUniform3f(glGetUniformLocation(gProgramId, "currentMaterial.specularColor"), 0.5f, 0.5f, 0.5f);
-	glUniform1f(glGetUniformLocation(gProgramId, "currentMaterial.shininess"), 16.0f);
-	// Draws the triangles
-	glDrawArrays(GL_TRIANGLE_FAN, 0, 36);		//bottom
-	glDrawArrays(GL_TRIANGLE_FAN, 36, 36);		//top
-	glDrawArrays(GL_TRIANGLE_STRIP, 72, 146);	//sides
-	// Deactivate the Vertex Array Object
-	glBindVertexArray(0);
-
-	// Donut sprinkle red 2/5 (Cylinder)
-	// Activate the VBOs contained within the mesh's VAO
-	glBindVertexArray(meshes.gCylinderMesh.vao);
-	// 1. Scales the object
-	scale = glm::scale(glm::vec3(0.15f, 0.3f, 0.15f));
-	// 2. Rotate the object
-	rotation = glm::rotate(0.0f, glm::vec3(1.0, 1.0f, 1.0f));
-	// 3. Position the object
-	translation = glm::translate(glm::vec3(-3.43f, 1.2f, 7.55f));
-	// Model matrix: transformations are applied right-to-left order
-	model = translation * rotation * scale;
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-	// Draws the triangles
-	glDrawArrays(GL_TRIANGLE_FAN, 0, 36);		//bottom
-	glDrawArrays(GL_TRIANGLE_FAN, 36, 36);		//top
-	glDrawArrays(GL_TRIANGLE_STRIP, 72, 146);	//sides
-	// Deactivate the Vertex Array Object
-	glBindVertexArray(0);
-
-	// Donut sprinkle red 3/5 (Cylinder)
-	// Activate the VBOs contained within the mesh's VAO
-	glBindVertexArray(meshes.gCylinderMesh.vao);
-	// 1. Scales the object
-	scale = glm::scale(glm::vec3(0.15f, 0.3f, 0.15f));
-	// 2. Rotate the object
-	rotation = glm::rotate(0.0f, glm::vec3(1.0, 1.0f, 1.0f));
-	// 3. Position the object
-	translation = glm::translate(glm::vec3(-5.25f, 1.2f, 7.85f));
-	// Model matrix: transformations are applied right-to-left order
-	model = translation * rotation * scale;
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-	// Draws the triangles
-	glDrawArrays(GL_TRIANGLE_FAN, 0, 36);		//bottom
-	glDrawArrays(GL_TRIANGLE_FAN, 36, 36);		//top
-	glDrawArrays(GL_TRIANGLE_STRIP, 72, 146);	//sides
-	// Deactivate the Vertex Array Object
-	glBindVertexArray(0);
-
-	// Donut sprinkle red 4/5 (Cylinder)
-	// Activate the VBOs contained within the mesh's VAO
-	glBindVertexArray(meshes.gCylinderMesh.vao);
-	// 1. Scales the object
-	scale = glm::scale(glm::vec3(0.15f, 0.3f, 0.15f));
-	// 2. Rotate the object
-	rotation = glm::rotate(0.0f, glm::vec3(1.0, 1.0f, 1.0f));
-	// 3. Position the object
-	translation = glm::translate(glm::vec3(-4.95f, 1.2f, 8.75f));
-	// Model matrix: transformations are applied right-to-left order
-	model = translation * rotation * scale;
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-	// Draws the triangles
-	glDrawArrays(GL_TRIANGLE_FAN, 0, 36);		//bottom
-	glDrawArrays(GL_TRIANGLE_FAN, 36, 36);		//top
-	glDrawArrays(GL_TRIANGLE_STRIP, 72, 146);	//sides
-	// Deactivate the Vertex Array Object
-	glBindVertexArray(0);
-
-	// Donut sprinkle red 5/5 (Cylinder)
-	// Activate the VBOs contained within the mesh's VAO
-	glBindVertexArray(meshes.gCylinderMesh.vao);
-	// 1. Scales the object
-	scale = glm::scale(glm::vec3(0.15f, 0.3f, 0.15f));
-	// 2. Rotate the object
-	rotation = glm::rotate(0.0f, glm::vec3(1.0, 1.0f, 1.0f));
-	// 3. Position the object
-	translation = glm::translate(glm::vec3(-3.45f, 1.2f, 8.75f));
-	// Model matrix: transformations are applied right-to-left order
-	model = translation * rotation * scale;
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-	// Draws the triangles
-	glDrawArrays(GL_TRIANGLE_FAN, 0, 36);		//bottom
-	glDrawArrays(GL_TRIANGLE_FAN, 36, 36);		//top
-	glDrawArrays(GL_TRIANGLE_STRIP, 72, 146);	//sides
-	// Deactivate the Vertex Array Object
-	glBindVertexArray(0);
-
-	// Donut sprinkle pink 1/5 (Cylinder)
-	// Activate the VBOs contained within the mesh's VAO
-	glBindVertexArray(meshes.gCylinderMesh.vao);
-	// 1. Scales the object
-	scale = glm::scale(glm::vec3(0.15f, 0.3f, 0.15f));
-	// 2. Rotate the object
-	rotation = glm::rotate(0.0f, glm::vec3(1.0, 1.0f, 1.0f));
-	// 3. Position the object
-	translation = glm::translate(glm::vec3(-3.73f, 1.2f, 7.25f));
-	// Model matrix: transformations are applied right-to-left order
-	model = translation * rotation * scale;
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-	// Draws texture
-	glUniform1i(glGetUniformLocation(gProgramId, "uTexture"), 14);
-	glUniform3f(glGetUniformLocation(gProgramId, "currentMaterial.diffuseColor"), 0.6f, 0.6f, 0.6f);
-	glUniform3f(glGetUniformLocation(gProgramId, "currentMaterial.specularColor"), 0.5f, 0.5f, 0.5f);
-	glUniform1f(glGetUniformLocation(gProgramId, "currentMaterial.shininess"), 16.0f);
-	// Draws the triangles
-	glDrawArrays(GL_TRIANGLE_FAN, 0, 36);		//bottom
-	glDrawArrays(GL_TRIANGLE_FAN, 36, 36);		//top
-	glDrawArrays(GL_TRIANGLE_STRIP, 72, 146);	//sides
-	// Deactivate the Vertex Array Object
-	glBindVertexArray(0);
-
-	// Donut sprinkle pink 2/5 (Cylinder)
-	// Activate the VBOs contained within the mesh's VAO
-	glBindVertexArray(meshes.gCylinderMesh.vao);
-	// 1. Scales the object
-	scale = glm::scale(glm::vec3(0.15f, 0.3f, 0.15f));
-	// 2. Rotate the object
-	rotation = glm::rotate(0.0f, glm::vec3(1.0, 1.0f, 1.0f));
-	// 3. Position the object
-	translation = glm::translate(glm::vec3(-4.68f, 1.2f, 7.55f));
-	// Model matrix: transformations are applied right-to-left order
-	model = translation * rotation * scale;
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-	// Draws the triangles
-	glDrawArrays(GL_TRIANGLE_FAN, 0, 36);		//bottom
-	glDrawArrays(GL_TRIANGLE_FAN, 36, 36);		//top
-	glDrawArrays(GL_TRIANGLE_STRIP, 72, 146);	//sides
-	// Deactivate the Vertex Array Object
-	glBindVertexArray(0);
-
-	// Donut sprinkle pink 3/5 (Cylinder)
-	// Activate the VBOs contained within the mesh's VAO
-	glBindVertexArray(meshes.gCylinderMesh.vao);
-	// 1. Scales the object
-	scale = glm::scale(glm::vec3(0.15f, 0.3f, 0.15f));
-	// 2. Rotate the object
-	rotation = glm::rotate(0.0f, glm::vec3(1.0, 1.0f, 1.0f));
-	// 3. Position the object
-	translation = glm::translate(glm::vec3(-3.13f, 1.2f, 7.85f));
-	// Model matrix: transformations are applied right-to-left order
-	model = translation * rotation * scale;
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-	// Draws the triangles
-	glDrawArrays(GL_TRIANGLE_FAN, 0, 36);		//bottom
-	glDrawArrays(GL_TRIANGLE_FAN, 36, 36);		//top
-	glDrawArrays(GL_TRIANGLE_STRIP, 72, 146);	//sides
-	// Deactivate the Vertex Array Object
-	glBindVertexArray(0);
-
-	// Donut sprinkle pink 4/5 (Cylinder)
-	// Activate the VBOs contained within the mesh's VAO
-	glBindVertexArray(meshes.gCylinderMesh.vao);
-	// 1. Scales the object
-	scale = glm::scale(glm::vec3(0.15f, 0.3f, 0.15f));
-	// 2. Rotate the object
-	rotation = glm::rotate(0.0f, glm::vec3(1.0, 1.0f, 1.0f));
-	// 3. Position the object
-	translation = glm::translate(glm::vec3(-5.25f, 1.2f, 8.45f));
-	// Model matrix: transformations are applied right-to-left order
-	model = translation * rotation * scale;
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-	// Draws the triangles
-	glDrawArrays(GL_TRIANGLE_FAN, 0, 36);		//bottom
-	glDrawArrays(GL_TRIANGLE_FAN, 36, 36);		//top
-	glDrawArrays(GL_TRIANGLE_STRIP, 72, 146);	//sides
-	// Deactivate the Vertex Array Object
-	glBindVertexArray(0);
-
-	// Donut sprinkle pink 5/5 (Cylinder)
-	// Activate the VBOs contained within the mesh's VAO
-	glBindVertexArray(meshes.gCylinderMesh.vao);
-	// 1. Scales the object
-	scale = glm::scale(glm::vec3(0.15f, 0.3f, 0.15f));
-	// 2. Rotate the object
-	rotation = glm::rotate(0.0f, glm::vec3(1.0, 1.0f, 1.0f));
-	// 3. Position the object
-	translation = glm::translate(glm::vec3(-4.05f, 1.2f, 8.75f));
-	// Model matrix: transformations are applied right-to-left order
-	model = translation * rotation * scale;
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-	// Draws the triangles
-	glDrawArrays(GL_TRIANGLE_FAN, 0, 36);		//bottom
-	glDrawArrays(GL_TRIANGLE_FAN, 36, 36);		//top
-	glDrawArrays(GL_TRIANGLE_STRIP, 72, 146);	//sides
-	// Deactivate the Vertex Array Object
-	glBindVertexArray(0);
-
-	// Donut sprinkle green 1/5 (Cylinder)
-	// Activate the VBOs contained within the mesh's VAO
-	glBindVertexArray(meshes.gCylinderMesh.vao);
-	// 1. Scales the object
-	scale = glm::scale(glm::vec3(0.15f, 0.3f, 0.15f));
-	// 2. Rotate the object
-	rotation = glm::rotate(0.0f, glm::vec3(1.0, 1.0f, 1.0f));
-	// 3. Position the object
-	translation = glm::translate(glm::vec3(-4.65f, 1.2f, 6.95f));
-	// Model matrix: transformations are applied right-to-left order
-	model = translation * rotation * scale;
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-	// Draws texture
-	glUniform1i(glGetUniformLocation(gProgramId, "uTexture"), 15);
-	glUniform3f(glGetUniformLocation(gProgramId, "currentMaterial.diffuseColor"), 0.6f, 0.6f, 0.6f);
-	glUniform3f(glGetUniformLocation(gProgramId, "currentMaterial.specularColor"), 0.5f, 0.5f, 0.5f);
-	glUniform1f(glGetUniformLocation(gProgramId, "currentMaterial.shininess"), 16.0f);
-	// Draws the triangles
-	glDrawArrays(GL_TRIANGLE_FAN, 0, 36);		//bottom
-	glDrawArrays(GL_TRIANGLE_FAN, 36, 36);		//top
-	glDrawArrays(GL_TRIANGLE_STRIP, 72, 146);	//sides
-	// Deactivate the Vertex Array Object
-	glBindVertexArray(0);
-
-	// Donut sprinkle green 2/5 (Cylinder)
-	// Activate the VBOs contained within the mesh's VAO
-	glBindVertexArray(meshes.gCylinderMesh.vao);
-	// 1. Scales the object
-	scale = glm::scale(glm::vec3(0.15f, 0.3f, 0.15f));
-	// 2. Rotate the object
-	rotation = glm::rotate(0.0f, glm::vec3(1.0, 1.0f, 1.0f));
-	// 3. Position the object
-	translation = glm::translate(glm::vec3(-3.43f, 1.2f, 7.25f));
-	// Model matrix: transformations are applied right-to-left order
-	model = translation * rotation * scale;
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-	// Draws the triangles
-	glDrawArrays(GL_TRIANGLE_FAN, 0, 36);		//bottom
-	glDrawArrays(GL_TRIANGLE_FAN, 36, 36);		//top
-	glDrawArrays(GL_TRIANGLE_STRIP, 72, 146);	//sides
-	// Deactivate the Vertex Array Object
-	glBindVertexArray(0);
-
-	// Donut sprinkle green 3/5 (Cylinder)
-	// Activate the VBOs contained within the mesh's VAO
-	glBindVertexArray(meshes.gCylinderMesh.vao);
-	// 1. Scales the object
-	scale = glm::scale(glm::vec3(0.15f, 0.3f, 0.15f));
-	// 2. Rotate the object
-	rotation = glm::rotate(0.0f, glm::vec3(1.0, 1.0f, 1.0f));
-	// 3. Position the object
-	translation = glm::translate(glm::vec3(-4.95f, 1.2f, 8.15f));
-	// Model matrix: transformations are applied right-to-left order
-	model = translation * rotation * scale;
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-	// Draws the triangles
-	glDrawArrays(GL_TRIANGLE_FAN, 0, 36);		//bottom
-	glDrawArrays(GL_TRIANGLE_FAN, 36, 36);		//top
-	glDrawArrays(GL_TRIANGLE_STRIP, 72, 146);	//sides
-	// Deactivate the Vertex Array Object
-	glBindVertexArray(0);
-
-	// Donut sprinkle green 4/5 (Cylinder)
-	// Activate the VBOs contained within the mesh's VAO
-	glBindVertexArray(meshes.gCylinderMesh.vao);
-	// 1. Scales the object
-	scale = glm::scale(glm::vec3(0.15f, 0.3f, 0.15f));
-	// 2. Rotate the object
-	rotation = glm::rotate(0.0f, glm::vec3(1.0, 1.0f, 1.0f));
-	// 3. Position the object
-	translation = glm::translate(glm::vec3(-3.13f, 1.2f, 8.45f));
-	// Model matrix: transformations are applied right-to-left order
-	model = translation * rotation * scale;
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-	// Draws the triangles
-	glDrawArrays(GL_TRIANGLE_FAN, 0, 36);		//bottom
-	glDrawArrays(GL_TRIANGLE_FAN, 36, 36);		//top
-	glDrawArrays(GL_TRIANGLE_STRIP, 72, 146);	//sides
-	// Deactivate the Vertex Array Object
-	glBindVertexArray(0);
-
-	// Donut sprinkle green 5/5 (Cylinder)
-	// Activate the VBOs contained within the mesh's VAO
-	glBindVertexArray(meshes.gCylinderMesh.vao);
-	// 1. Scales the object
-	scale = glm::scale(glm::vec3(0.15f, 0.3f, 0.15f));
-	// 2. Rotate the object
-	rotation = glm::rotate(0.0f, glm::vec3(1.0, 1.0f, 1.0f));
-	// 3. Position the object
-	translation = glm::translate(glm::vec3(-3.75f, 1.2f, 9.05f));
-	// Model matrix: transformations are applied right-to-left order
-	model = translation * rotation * scale;
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-	// Draws the triangles
-	glDrawArrays(GL_TRIANGLE_FAN, 0, 36);		//bottom
-	glDrawArrays(GL_TRIANGLE_FAN, 36, 36);		//top
-	glDrawArrays(GL_TRIANGLE_STRIP, 72, 146);	//sides
-	// Deactivate the Vertex Array Object
-	glBindVertexArray(0);
-
-	// Donut sprinkle blue 1/3 (Cylinder)
-	// Activate the VBOs contained within the mesh's VAO
-	glBindVertexArray(meshes.gCylinderMesh.vao);
-	// 1. Scales the object
-	scale = glm::scale(glm::vec3(0.15f, 0.3f, 0.15f));
-	// 2. Rotate the object
-	rotation = glm::rotate(0.0f, glm::vec3(1.0, 1.0f, 1.0f));
-	// 3. Position the object
-	translation = glm::translate(glm::vec3(-4.35f, 1.2f, 7.25f));
-	// Model matrix: transformations are applied right-to-left order
-	model = translation * rotation * scale;
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-	// Draws texture
-	glUniform1i(glGetUniformLocation(gProgramId, "uTexture"), 16);
-	glUniform3f(glGetUniformLocation(gProgramId, "currentMaterial.diffuseColor"), 0.6f, 0.6f, 0.6f);
-	glUniform3f(glGetUniformLocation(gProgramId, "currentMaterial.specularColor"), 0.5f, 0.5f, 0.5f);
-	glUniform1f(glGetUniformLocation(gProgramId, "currentMaterial.shininess"), 16.0f);
-	// Draws the triangles
-	glDrawArrays(GL_TRIANGLE_FAN, 0, 36);		//bottom
-	glDrawArrays(GL_TRIANGLE_FAN, 36, 36);		//top
-	glDrawArrays(GL_TRIANGLE_STRIP, 72, 146);	//sides
-	// Deactivate the Vertex Array Object
-	glBindVertexArray(0);
-
-	// Donut sprinkle blue 2/3 (Cylinder)
-	// Activate the VBOs contained within the mesh's VAO
-	glBindVertexArray(meshes.gCylinderMesh.vao);
-	// 1. Scales the object
-	scale = glm::scale(glm::vec3(0.15f, 0.3f, 0.15f));
-	// 2. Rotate the object
-	rotation = glm::rotate(0.0f, glm::vec3(1.0, 1.0f, 1.0f));
-	// 3. Position the object
-	translation = glm::translate(glm::vec3(-3.43f, 1.2f, 8.15f));
-	// Model matrix: transformations are applied right-to-left order
-	model = translation * rotation * scale;
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-	// Draws the triangles
-	glDrawArrays(GL_TRIANGLE_FAN, 0, 36);		//bottom
-	glDrawArrays(GL_TRIANGLE_FAN, 36, 36);		//top
-	glDrawArrays(GL_TRIANGLE_STRIP, 72, 146);	//sides
-	// Deactivate the Vertex Array Object
-	glBindVertexArray(0);
-
-	// Donut sprinkle blue 3/3 (Cylinder)
-	// Activate the VBOs contained within the mesh's VAO
-	glBindVertexArray(meshes.gCylinderMesh.vao);
-	// 1. Scales the object
-	scale = glm::scale(glm::vec3(0.15f, 0.3f, 0.15f));
-	// 2. Rotate the object
-	rotation = glm::rotate(0.0f, glm::vec3(1.0, 1.0f, 1.0f));
-	// 3. Position the object
-	translation = glm::translate(glm::vec3(-4.65f, 1.2f, 8.75f));
-	// Model matrix: transformations are applied right-to-left order
-	model = translation * rotation * scale;
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-	// Draws the triangles
-	glDrawArrays(GL_TRIANGLE_FAN, 0, 36);		//bottom
-	glDrawArrays(GL_TRIANGLE_FAN, 36, 36);		//top
-	glDrawArrays(GL_TRIANGLE_STRIP, 72, 146);	//sides
-	// Deactivate the Vertex Array Object
-	glBindVertexArray(0);
-
-	// Rubiks Cube (Box)
-	// Activate the VBOs contained within the mesh's VAO
-	glBindVertexArray(meshes.gBoxMesh.vao);
-	// 1. Scales the object
-	scale = glm::scale(glm::vec3(5.0f, 5.0f, 5.0f));
-	// 2. Rotate the object
-	rotation = glm::rotate(1.0f, glm::vec3(0.1f, 25.0f, 0.1f));
-	// 3. Position the object
-	translation = glm::translate(glm::vec3(-3.90f, 2.52f, -3.0f));
-	// Model matrix: transformations are applied right-to-left order
-	model = translation * rotation * scale;
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-	glUniform3f(glGetUniformLocation(gProgramId, "currentMaterial.diffuseColor"), 0.4f, 0.4f, 0.4f);
-	glUniform3f(glGetUniformLocation(gProgramId, "currentMaterial.specularColor"), 0.5f, 0.5f, 0.5f);
-	glUniform1f(glGetUniformLocation(gProgramId, "currentMaterial.shininess"), 32.f);
-	// Draws texture
-	// back
-	glUniform1i(glGetUniformLocation(gProgramId, "uTexture"), 11);
-	glDrawArrays(GL_TRIANGLE_FAN, 0, 6);
-	// front
-	glUniform1i(glGetUniformLocation(gProgramId, "uTexture"), 10);
-	glDrawArrays(GL_TRIANGLE_FAN, 6, 6);
-	// left
-	glUniform1i(glGetUniformLocation(gProgramId, "uTexture"), 9);
-	glDrawArrays(GL_TRIANGLE_FAN, 12, 6);
-	// right
-	glUniform1i(glGetUniformLocation(gProgramId, "uTexture"), 8);
-	glDrawArrays(GL_TRIANGLE_FAN, 18, 6);
-	// bottom
-	glUniform1i(glGetUniformLocation(gProgramId, "uTexture"), 7);
-	glDrawArrays(GL_TRIANGLE_FAN, 24, 6);
-	// top
-	glUniform1i(glGetUniformLocation(gProgramId, "uTexture"), 6);
-	glDrawArrays(GL_TRIANGLE_FAN, 30, 6);
-	// Draws the triangles
-	glDrawArrays(GL_TRIANGLES, 0, meshes.gBoxMesh.nVertices);
-	// Deactivate the Vertex Array Object
-	glBindVertexArray(0);
+	// Skip objects whose bounding sphere is outside the view frustum
+	if (gCulling)
+		gFrameStats.objectsDrawn = CullSpheres(ExtractFrustum(projection * view), gObjectSpheres, gObjectVisible.data());
+	else
+	{
+		std::fill(gObjectVisible.begin(), gObjectVisible.end(), 1);
+		gFrameStats.objectsDrawn = (GLuint)gObjectVisible.size();
+	}
+	gFrameStats.objectsCulled = (GLuint)gObjectVisible.size() - gFrameStats.objectsDrawn;
+
+	// Texture levels follow what is on screen; Poll uploads them next frame
+	URequestTextureDetail();
+	gTextureLoader.UpdateResidency();
+
+	// Coarser meshes for what is small on screen
+	USelectLods();
+
+#if USE_SCENE_BATCH
+	// Every object in a few multi-draw calls; transforms and materials come from the draw records
+	gSceneBatch.SetVisible(gObjectVisible.data(), gObjectLods.data());
+	gSceneBatch.Draw();
+#else
+	// Queue the visible objects by program, VAO, texture layer and distance along the view direction
+	gRenderQueue.Clear();
+	for (size_t i = 0; i < gScene.objects.size(); ++i)
+	{
+		if (!gObjectVisible[i])
+			continue;
+
+		const RenderRecord& record = gScene.objects[i];
+		glm::vec3 center(gObjectSpheres.x[i], gObjectSpheres.y[i], gObjectSpheres.z[i]);
+		float depth = glm::dot(center - gCamera.Position, gCamera.Front);
+		gRenderQueue.Push(RenderQueue::MakeKey(gProgramId, record.mesh->vao, record.textureLayer, depth), (GLuint)i);
+	}
+	gFrameStats.stateChangesUnsorted = gRenderQueue.CountStateChanges();
+	gRenderQueue.Sort();
+	gFrameStats.stateChangesSorted = gRenderQueue.CountStateChanges();
+
+	// gGLState drops the VAO binds and uniform uploads that repeat the previous draw's
+	for (const RenderQueue::Item& item : gRenderQueue.Items())
+	{
+		const RenderRecord& record = gScene.objects[item.index];
+		// Activate the VBOs contained within the mesh's VAO
+		gGLState.BindVertexArray(record.mesh->vao);
+		gUniforms.model.Set(gScene.transforms.Model(record.transform));
+		gUniforms.positionOffset.Set(record.mesh->positionOffset);
+		gUniforms.positionScale.Set(record.mesh->positionScale);
+		// Draws texture
+		gUniforms.textureLayer.Set(record.textureLayer);
+		gUniforms.material.diffuseColor.Set(record.diffuseColor);
+		gUniforms.material.specularColor.Set(record.specularColor);
+		gUniforms.material.shininess.Set(record.shininess);
+		// Draws the triangles
+		if (record.part < 0)
+			meshes.DrawMesh(*record.mesh, gObjectLods[item.index]);
+		else
+			meshes.DrawMeshPart(*record.mesh, record.part, gObjectLods[item.index]);
+	}
+#endif
+
+	// Instanced objects: one instanced draw per mesh part
+	gGLState.UseProgram(gInstanceProgramId);
+#if !USE_FRAME_UBO
+	USetFrameUniforms(gInstanceUniforms, view, projection);
+#endif
+	gInstanceUniforms.hasTexture.Set(ubHasTextureVal);
+	for (const InstanceSet& set : gInstanceSets)
+	{
+		gInstanceUniforms.material.diffuseColor.Set(set.diffuseColor);
+		gInstanceUniforms.material.specularColor.Set(set.specularColor);
+		gInstanceUniforms.material.shininess.Set(set.shininess);
+		gInstanceUniforms.positionOffset.Set(set.instances.mesh->positionOffset);
+		gInstanceUniforms.positionScale.Set(set.instances.mesh->positionScale);
+		gGLState.BindVertexArray(set.instances.vao);
+		meshes.DrawInstances(set.instances, set.lod);
+	}
+
+	gDrawLoopSeconds += glfwGetTime() - drawLoopStart;
+	gFrameStats.glCallsSkipped = gGLState.SkippedCalls();
 
 	// glfw: swap buffers and poll IO events (keys pressed/released, mouse moved etc.)
 	glfwSwapBuffers(gWindow);    // Flips the the back buffer with the front buffer every frame.
 
 }
 
+// Queues every scene object into gSceneBatch and uploads the merged buffers
+bool UBuildSceneBatch()
+{
+#if USE_SCENE_BATCH
+	for (const RenderRecord& record : gScene.objects)
+	{
+		gSceneBatch.Add(*record.mesh, record.part, gScene.transforms.Model(record.transform), record.textureLayer,
+			record.diffuseColor, record.specularColor, record.shininess);
+	}
+	return gSceneBatch.Build();
+#else
+	return true;
+#endif
+}
+
+
+// Moves the world-space bounding spheres of the scene objects whose model matrix
+// was recomputed by the last transform update, or of every object
+void UUpdateObjectBounds(bool all)
+{
+	gObjectSpheres.Resize(gScene.objects.size());
+	gObjectVisible.resize(gScene.objects.size(), 1);
+	gObjectLods.resize(gScene.objects.size(), 0);
+
+	for (size_t i = 0; i < gScene.objects.size(); ++i)
+	{
+		const RenderRecord& record = gScene.objects[i];
+		if (!all && !gScene.transforms.Changed(record.transform))
+			continue;
+
+		// the largest axis scale keeps the sphere conservative under non-uniform scaling
+		const glm::mat4& model = gScene.transforms.Model(record.transform);
+		float scale = glm::max(glm::length(glm::vec3(model[0])), glm::max(glm::length(glm::vec3(model[1])), glm::length(glm::vec3(model[2]))));
+		gObjectSpheres.Set(i, glm::vec3(model * glm::vec4(record.mesh->boundsCenter, 1.0f)), record.mesh->boundsRadius * scale);
+	}
+}
+
+
+// Groups the scene's instance records into one instance set per mesh. For stress
+// testing, extraSprinkles copies of random instances are scattered over the donut top.
+void UCreateInstanceSets(GLuint extraSprinkles)
+{
+	// instances are placed once, so their model matrices can be copied out of the hierarchy
+	std::vector<RenderRecord> records = gScene.instances;
+	std::vector<glm::mat4> recordModels;
+	for (const RenderRecord& record : records)
+		recordModels.push_back(gScene.transforms.Model(record.transform));
+
+	if (!records.empty())
+	{
+		// fixed seed so stress-test runs are repeatable; the donut hole is left empty
+		std::mt19937 random(330);
+		std::uniform_real_distribution<float> x(-5.25f, -3.13f);
+		std::uniform_real_distribution<float> z(6.95f, 9.05f);
+		std::uniform_int_distribution<size_t> pick(0, gScene.instances.size() - 1);
+		while (records.size() < gScene.instances.size() + extraSprinkles)
+		{
+			size_t source = pick(random);
+			glm::mat4 model = recordModels[source];
+			model[3].x = x(random);
+			model[3].z = z(random);
+			if (glm::abs(model[3].x + 4.21f) < 0.55f && glm::abs(model[3].z - 8.0f) < 0.6f)
+				continue;
+			records.push_back(gScene.instances[source]);
+			recordModels.push_back(model);
+		}
+	}
+
+	std::vector<glm::mat4> models;
+	std::vector<GLint> layers;
+	for (size_t first = 0; first < records.size(); ++first)
+	{
+		const Meshes::GLMesh* mesh = records[first].mesh;
+		bool created = false;
+		for (const InstanceSet& set : gInstanceSets)
+			created = created || set.instances.mesh == mesh;
+		if (created)
+			continue;
+
+		models.clear();
+		layers.clear();
+		for (size_t i = first; i < records.size(); ++i)
+		{
+			if (records[i].mesh == mesh)
+			{
+				models.push_back(recordModels[i]);
+				layers.push_back(records[i].textureLayer);
+			}
+		}
+
+		InstanceSet set;
+		set.diffuseColor = records[first].diffuseColor;
+		set.specularColor = records[first].specularColor;
+		set.shininess = records[first].shininess;
+		set.lod = 0;
+		meshes.CreateInstances(set.instances, *mesh, models.data(), layers.data(), (GLuint)models.size());
+		gInstanceSets.push_back(set);
+	}
+
+	// instances never move, so their bounds for texture streaming are computed once
+	gInstanceSpheres.Resize(records.size());
+	gInstanceLayers.resize(records.size());
+	gInstanceSetIndices.resize(records.size());
+	for (size_t i = 0; i < records.size(); ++i)
+	{
+		for (size_t set = 0; set < gInstanceSets.size(); ++set)
+		{
+			if (gInstanceSets[set].instances.mesh == records[i].mesh)
+				gInstanceSetIndices[i] = set;
+		}
+
+		const glm::mat4& model = recordModels[i];
+		float scale = glm::max(glm::length(glm::vec3(model[0])), glm::max(glm::length(glm::vec3(model[1])), glm::length(glm::vec3(model[2]))));
+		gInstanceSpheres.Set(i, glm::vec3(model * glm::vec4(records[i].mesh->boundsCenter, 1.0f)), records[i].mesh->boundsRadius * scale);
+		gInstanceLayers[i] = records[i].textureLayer;
+	}
+
+	cout << "INFO: " << records.size() << " instances in " << gInstanceSets.size() << " instance sets" << endl;
+}
+
+
+// Tells the texture loader how large each textured object appears: the projected
+// diameter of its bounding sphere in pixels, nearest edge first
+void URequestTextureDetail()
+{
+	auto request = [](GLint layer, const BoundingSpheres& spheres, size_t i)
+	{
+		gTextureLoader.RequestSize(layer, 2.0f * spheres.radius[i] * UPixelsPerUnit(spheres, i));
+	};
+
+	for (size_t i = 0; i < gScene.objects.size(); ++i)
+	{
+		if (gObjectVisible[i] && gScene.objects[i].textureLayer >= 0)
+			request(gScene.objects[i].textureLayer, gObjectSpheres, i);
+	}
+	for (size_t i = 0; i < gInstanceLayers.size(); ++i)
+	{
+		if (gInstanceLayers[i] >= 0)
+			request(gInstanceLayers[i], gInstanceSpheres, i);
+	}
+}
+
+
+// Pixels one world unit covers at the near edge of bounding sphere i
+float UPixelsPerUnit(const BoundingSpheres& spheres, size_t i)
+{
+	// everywhere the same in the 10-unit ortho view
+	if (perspective)
+		return WINDOW_HEIGHT / 10.0f;
+
+	glm::vec3 center(spheres.x[i], spheres.y[i], spheres.z[i]);
+	float distance = glm::max(glm::length(center - gCamera.Position) - spheres.radius[i], 0.1f);
+	return WINDOW_HEIGHT / (2.0f * std::tan(glm::radians(gCamera.Zoom) * 0.5f) * distance);
+}
+
+
+// Picks the level of detail of each visible object and of each instance set: the
+// coarsest whose error, scaled like the object and seen at its near edge, is under
+// LOD_PIXEL_ERROR pixels
+void USelectLods()
+{
+	auto select = [](const Meshes::GLMesh& mesh, const BoundingSpheres& spheres, size_t i) -> GLuint
+	{
+		if (!gLods || mesh.nLods == 0 || mesh.boundsRadius <= 0.0f)
+			return 0;
+		// the world sphere is the model sphere scaled by the object's largest axis scale
+		float pixelsPerModelUnit = UPixelsPerUnit(spheres, i) * spheres.radius[i] / mesh.boundsRadius;
+		return Meshes::SelectLod(mesh, LOD_PIXEL_ERROR / pixelsPerModelUnit);
+	};
+
+	gFrameStats.objectsReduced = 0;
+	for (size_t i = 0; i < gScene.objects.size(); ++i)
+	{
+		if (!gObjectVisible[i])
+			continue;
+		gObjectLods[i] = (unsigned char)select(*gScene.objects[i].mesh, gObjectSpheres, i);
+		if (gObjectLods[i] > 0)
+			++gFrameStats.objectsReduced;
+	}
+
+	// instances are not culled, and a set draws all of its instances at one level
+	for (InstanceSet& set : gInstanceSets)
+		set.lod = Meshes::MAX_MESH_LODS;
+	for (size_t i = 0; i < gInstanceSetIndices.size(); ++i)
+	{
+		InstanceSet& set = gInstanceSets[gInstanceSetIndices[i]];
+		set.lod = std::min(set.lod, select(*set.instances.mesh, gInstanceSpheres, i));
+	}
+}
+
+
 // Implements the UCreateShaders function
 bool UCreateShaderProgram(const char* vtxShaderSource, const char* fragShaderSource, GLuint& programId)
 {
@@ -2030,6 +1409,7 @@ bool UCreateShaderProgram(const char* vtxShaderSource, const char* fragShaderSou
 
 	// Create a Shader program object.
 	programId = glCreateProgram();
+	gGpuResources.Created(GpuResourceType::Program, programId, "shader program");
 
 	// Create the vertex and fragment shader objects
 	GLuint vertexShaderId = glCreateShader(GL_VERTEX_SHADER);
@@ -2077,17 +1457,129 @@ bool UCreateShaderProgram(const char* vtxShaderSource, const char* fragShaderSou
 		return false;
 	}
 
-	glUseProgram(programId);    // Uses the shader program
+	gGLState.UseProgram(programId);    // Uses the shader program
 
 	return true;
 }
 
 
+// Resolves the uniforms used by URender against a linked program. modelUniform,
+// materialUniforms and meshUniforms (position decoding) say whether the program
+// sets those per draw with glUniform.
+void UResolveUniforms(GLuint programId, SceneUniforms& uniforms, bool modelUniform, bool materialUniforms, bool meshUniforms)
+{
+	UniformRegistry registry;
+
+	registry.Add("objectColor", uniforms.objectColor);
+	registry.Add("ubHasTexture", uniforms.hasTexture);
+	registry.Add("uTextureArray", uniforms.textureArray);
+	registry.Add("uColorArray", uniforms.colorArray);
+
+	// Per-object uniforms; batched and instanced draws read these from buffers instead
+	if (modelUniform)
+	{
+		registry.Add("model", uniforms.model);
+		registry.Add("textureLayer", uniforms.textureLayer);
+	}
+	if (meshUniforms)
+	{
+		registry.Add("positionOffset", uniforms.positionOffset);
+		registry.Add("positionScale", uniforms.positionScale);
+	}
+	if (materialUniforms)
+	{
+		registry.Add("currentMaterial.diffuseColor", uniforms.material.diffuseColor);
+		registry.Add("currentMaterial.specularColor", uniforms.material.specularColor);
+		registry.Add("currentMaterial.shininess", uniforms.material.shininess);
+	}
+
+#if !USE_FRAME_UBO
+	// Frame-level uniforms only exist as plain uniforms when FrameBlock is disabled
+	registry.Add("view", uniforms.view);
+	registry.Add("projection", uniforms.projection);
+	registry.Add("viewPosition", uniforms.viewPosition);
+	registry.Add("ambientStrength", uniforms.ambientStrength);
+	registry.Add("ambientColor", uniforms.ambientColor);
+	registry.Add("light1Color", uniforms.light1Color);
+	registry.Add("light1Position", uniforms.light1Position);
+	registry.Add("light2Color", uniforms.light2Color);
+	registry.Add("light2Position", uniforms.light2Position);
+	registry.Add("specularIntensity1", uniforms.specularIntensity1);
+	registry.Add("highlightSize1", uniforms.highlightSize1);
+	registry.Add("specularIntensity2", uniforms.specularIntensity2);
+	registry.Add("highlightSize2", uniforms.highlightSize2);
+
+	registry.Add("flashLight.position", uniforms.flashLight.position);
+	registry.Add("flashLight.direction", uniforms.flashLight.direction);
+	registry.Add("flashLight.cutOff", uniforms.flashLight.cutOff);
+	registry.Add("flashLight.outerCutOff", uniforms.flashLight.outerCutOff);
+	registry.Add("flashLight.constant", uniforms.flashLight.constant);
+	registry.Add("flashLight.linear", uniforms.flashLight.linear);
+	registry.Add("flashLight.quadratic", uniforms.flashLight.quadratic);
+	registry.Add("flashLight.ambientColor", uniforms.flashLight.ambientColor);
+	registry.Add("flashLight.diffuseColor", uniforms.flashLight.diffuseColor);
+	registry.Add("flashLight.specularColor", uniforms.flashLight.specularColor);
+#endif
+
+	if (!registry.Resolve(programId))
+	{
+		for (const string& name : registry.Missing())
+			cout << "WARNING: uniform " << name << " not found in shader program" << endl;
+	}
+}
+
+
+#if !USE_FRAME_UBO
+// Sets the camera and lighting uniforms of the program in use
+void USetFrameUniforms(const SceneUniforms& uniforms, const glm::mat4& view, const glm::mat4& projection)
+{
+	// Passes transform matrices to the Shader program
+	uniforms.view.Set(view);
+	uniforms.projection.Set(projection);
+
+	//set the camera view location
+	uniforms.viewPosition.Set(gCamera.Position);
+
+	// pre-set flashlight settings
+	uniforms.flashLight.position.Set(gCamera.Position);
+	uniforms.flashLight.direction.Set(gCamera.Front);
+	uniforms.flashLight.cutOff.Set(glm::cos(glm::radians(12.5f)));
+	uniforms.flashLight.outerCutOff.Set(glm::cos(glm::radians(17.5f)));
+	uniforms.flashLight.constant.Set(1.0f);
+	uniforms.flashLight.linear.Set(0.09f);
+	uniforms.flashLight.quadratic.Set(0.032f);
+	uniforms.flashLight.ambientColor.Set(1.0f, 1.0f, 1.0f);
+	uniforms.flashLight.diffuseColor.Set(0.6f, 0.6f, 0.6f);
+	uniforms.flashLight.specularColor.Set(0.8f, 0.8f, 0.8f);
+
+	//set ambient lighting strength
+	uniforms.ambientStrength.Set(0.4f);
+	//set ambient color
+	uniforms.ambientColor.Set(0.5f, 0.5f, 0.5f);
+	uniforms.light1Color.Set(0.26f, 0.05f, 0.38f);
+	uniforms.light1Position.Set(-2.0f, 3.0f, 2.0f);
+	uniforms.light2Color.Set(0.0f, 0.20f, 0.44f);
+	uniforms.light2Position.Set(5.0f, 3.0f, 2.0f);
+
+	//set specular intensity
+	uniforms.specularIntensity1.Set(1.0f);
+	uniforms.specularIntensity2.Set(1.0f);
+
+	//set specular highlight size
+	uniforms.highlightSize1.Set(12.0f);
+	uniforms.highlightSize2.Set(12.0f);
+}
+#endif
+
+
 void UDestroyShaderProgram(GLuint programId)
 {
-	glDeleteProgram(programId);
+	gGpuResources.Deleted(GpuResourceType::Program, programId);
+	gGLState.DeleteProgram(programId);
 }
 
+// Original byte-at-a-time flip, kept as the baseline of --bench-image-ops;
+// textures are flipped with FlipImageVertically from ImageOps.h
 void flipImageVertically(unsigned char* image, int width, int height, int channels)
 {
 	for (int j = 0; j < height / 2; ++j)
@@ -2106,53 +1598,246 @@ void flipImageVertically(unsigned char* image, int width, int height, int channe
 	}
 }
 
-bool UCreateTexture(const char* filename, GLuint& textureId)
+// --cook-textures: compress every scene texture into a container next to it
+bool UCookTextures()
 {
-	int width, height, channels;
-	unsigned char* image = stbi_load(filename, &width, &height, &channels, 0);
+	bool cooked = true;
+	for (const char* filename : TEXTURE_FILES)
+		cooked = CookTexture(filename, (string(filename) + TEXTURE_CONTAINER_EXTENSION).c_str()) && cooked;
+	return cooked;
+}
+
+// --build-pack: write the mip chain of every scene texture and the data of
+// every mesh to ASSET_PACK_FILE. The cooked containers are packed as they are
+// when all of them fit one texture array; otherwise the images are decoded and
+// resampled to the size of the first, as the texture array loader does.
+// Single-color images are packed as 1x1 textures, and identical data is
+// stored once.
+bool UBuildAssetPack()
+{
+	const size_t count = sizeof(TEXTURE_FILES) / sizeof(TEXTURE_FILES[0]);
+	AssetPackWriter writer;
 
-	if (image)
+	std::unique_ptr<MappedTexture[]> containers(new MappedTexture[count]);
+	bool cooked = GLEW_EXT_texture_compression_s3tc;
+	for (size_t i = 0; cooked && i < count; ++i)
 	{
-		flipImageVertically(image, width, height, channels);
-
-		// generates texture names
-		glGenTextures(1, &textureId);
-		// binding texure to 2D texture
-		glBindTexture(GL_TEXTURE_2D, textureId);
-
-		// set texture wrapping params
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-		// set texture filtering params
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-		// Assigning texture to pointer, and defining how it will be stored in memory
-		if (channels == 3)
-			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB8, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, image);
-		else if (channels == 4)
-			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, image);
+		cooked = containers[i].Open((string(TEXTURE_FILES[i]) + TEXTURE_CONTAINER_EXTENSION).c_str()) &&
+			containers[i].Header().glFormat == containers[0].Header().glFormat &&
+			containers[i].Header().width == containers[0].Header().width && containers[i].Header().height == containers[0].Header().height;
+	}
+
+	int width = 0, height = 0;
+	for (size_t i = 0; i < count; ++i)
+	{
+		std::vector<unsigned char> chain;
+		std::vector<unsigned char> pixels;
+		GLenum format = GL_RGBA8;
+		int imageWidth, imageHeight;
+		if (cooked)
+		{
+			const TextureContainerHeader& header = containers[i].Header();
+			for (uint32_t level = 0; level < header.levels; ++level)
+				chain.insert(chain.end(), containers[i].LevelData(level), containers[i].LevelData(level) + containers[i].LevelBytes(level));
+			format = header.glFormat;
+			width = imageWidth = header.width;
+			height = imageHeight = header.height;
+
+			// decoded again only to tell whether the image is one color
+			pixels.resize((size_t)width * height * 4);
+			if (format == GL_COMPRESSED_RGB_S3TC_DXT1_EXT)
+				DecompressBC1(chain.data(), width, height, pixels.data());
+			else
+				DecompressBC3(chain.data(), width, height, pixels.data());
+		}
 		else
 		{
-			cout << "Not implemented to handle image with " << channels << "channels" << endl;
-			return false;
+			int channels;
+			unsigned char* image = stbi_load(TEXTURE_FILES[i], &imageWidth, &imageHeight, &channels, 4);
+			if (!image)
+			{
+				cout << "Failed to load texture " << TEXTURE_FILES[i] << endl;
+				return false;
+			}
+			FlipImageVertically(image, imageWidth, imageHeight, 4);
+			pixels.assign(image, image + (size_t)imageWidth * imageHeight * 4);
+			stbi_image_free(image);
+		}
+
+		// a single color is packed as one RGBA8 texel
+		uint32_t color;
+		if (IsSolidColor(pixels.data(), (size_t)imageWidth * imageHeight, SOLID_COLOR_TOLERANCE, color))
+		{
+			AssetPackEntry& entry = writer.Add(AssetType::Texture, AssetPackName(TEXTURE_FILES[i]), &color, sizeof(color));
+			entry.glFormat = GL_RGBA8;
+			entry.width = entry.height = 1;
+			entry.levels = 1;
+			entry.solid = 1;
+			entry.color = color;
+			continue;
+		}
+
+		if (!cooked)
+		{
+			if (width == 0)
+			{
+				width = imageWidth;
+				height = imageHeight;
+			}
+			if (imageWidth != width || imageHeight != height)
+			{
+				std::vector<unsigned char> resampled((size_t)width * height * 4);
+				ResampleImage(pixels.data(), imageWidth, imageHeight, resampled.data(), width, height, 4);
+				pixels.swap(resampled);
+			}
+			chain.resize(MipChainBytes(width, height));
+			BuildMipChain(pixels.data(), width, height, chain.data());
 		}
 
-		// generating mipmap for GL_TEXTURE_2D
-		glGenerateMipmap(GL_TEXTURE_2D);
+		AssetPackEntry& entry = writer.Add(AssetType::Texture, AssetPackName(TEXTURE_FILES[i]), chain.data(), chain.size());
+		entry.glFormat = format;
+		entry.width = width;
+		entry.height = height;
+		entry.levels = MipLevelCount(width, height);
+	}
 
-		// free loaded image
-		stbi_image_free(image);
-		// rebinding GL_TEXTURE_2D to nothing
-		glBindTexture(GL_TEXTURE_2D, 0);
+	meshes.PackMeshes(writer);
+	return writer.Write(ASSET_PACK_FILE);
+}
 
-		return true;
+// --bench-image-ops: average time of each pixel kernel on one decoded image,
+// with the original flip loop for comparison
+bool UBenchmarkImageOps(const char* filename)
+{
+	int width, height, channels;
+	unsigned char* image = stbi_load(filename, &width, &height, &channels, 3);
+	if (!image)
+	{
+		cout << "Failed to load image " << filename << endl;
+		return false;
 	}
 
-	return false;
+	const size_t pixelCount = (size_t)width * height;
+	std::vector<unsigned char> rgb(image, image + pixelCount * 3);
+	std::vector<unsigned char> rgba(pixelCount * 4);
+	stbi_image_free(image);
+
+	const int repeats = 20;
+	auto averageMs = [repeats](auto&& op)
+	{
+		auto start = std::chrono::steady_clock::now();
+		for (int r = 0; r < repeats; ++r)
+			op();
+		return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / repeats;
+	};
+
+	cout << "INFO: Image kernels (" << ImageOpsInstructionSet() << ") on " << width << "x" << height
+		<< ", average of " << repeats << " runs:" << endl;
+
+	double byteFlip = averageMs([&] { flipImageVertically(rgb.data(), width, height, 3); });
+	double rowFlip = averageMs([&] { FlipImageVertically(rgb.data(), width, height, 3); });
+	cout << "  flip RGB    byte loop " << byteFlip << " ms, row kernel " << rowFlip << " ms ("
+		<< byteFlip / rowFlip << "x)" << endl;
+
+	ExpandRgbToRgba(rgb.data(), rgba.data(), pixelCount);
+	byteFlip = averageMs([&] { flipImageVertically(rgba.data(), width, height, 4); });
+	rowFlip = averageMs([&] { FlipImageVertically(rgba.data(), width, height, 4); });
+	cout << "  flip RGBA   byte loop " << byteFlip << " ms, row kernel " << rowFlip << " ms ("
+		<< byteFlip / rowFlip << "x)" << endl;
+
+	const int bgra[4] = { 2, 1, 0, 3 };
+	cout << "  RGB->RGBA   " << averageMs([&] { ExpandRgbToRgba(rgb.data(), rgba.data(), pixelCount); }) << " ms" << endl;
+	cout << "  swizzle     " << averageMs([&] { SwizzleChannels(rgba.data(), pixelCount, bgra); }) << " ms" << endl;
+	cout << "  premultiply " << averageMs([&] { PremultiplyAlpha(rgba.data(), pixelCount); }) << " ms" << endl;
+
+	// both flips must agree
+	std::vector<unsigned char> expected(rgb);
+	flipImageVertically(expected.data(), width, height, 3);
+	FlipImageVertically(rgb.data(), width, height, 3);
+	if (memcmp(expected.data(), rgb.data(), rgb.size()) != 0)
+	{
+		cout << "ERROR: FlipImageVertically does not match the byte loop" << endl;
+		return false;
+	}
+	return true;
+}
+
+// --bench-meshes: average time of generating every mesh with the round ones at
+// segments x segments, on one thread and then on more, up to one per core. The
+// meshes are the unit of work, so the slowest of the six round ones bounds the
+// speedup however many cores there are
+bool UBenchmarkMeshGeneration(GLuint segments)
+{
+	if (segments < 3)
+	{
+		cout << "Mesh benchmark needs at least 3 segments" << endl;
+		return false;
+	}
+	const Meshes::Tessellation tessellation = { segments, segments };
+	meshes.gConeTessellation = meshes.gCylinderTessellation = meshes.gTaperedCylinderTessellation = tessellation;
+	meshes.gSphereTessellation = meshes.gTorusTessellation = meshes.gDonutTessellation = tessellation;
+
+	const unsigned cores = std::max(std::thread::hardware_concurrency(), 1u);
+	std::vector<unsigned> threadCounts;
+	for (unsigned threads = 1; threads < cores; threads *= 2)
+		threadCounts.push_back(threads);
+	threadCounts.push_back(cores);
+
+	// the generators report every mesh they build, which would bury the timings
+	const int repeats = 3;
+	std::vector<double> averageMs;
+	std::vector<Meshes::MeshData> data;
+	std::streambuf* output = cout.rdbuf(nullptr);
+	for (unsigned threads : threadCounts)
+	{
+		auto start = std::chrono::steady_clock::now();
+		for (int r = 0; r < repeats; ++r)
+			meshes.GenerateMeshes(data, std::vector<bool>(), threads);
+		averageMs.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / repeats);
+	}
+	cout.rdbuf(output);
+	cout.clear();
+
+	size_t vertices = 0, indices = 0;
+	for (const Meshes::MeshData& mesh : data)
+	{
+		vertices += mesh.vertices.size() / 8;
+		indices += mesh.indices.size();
+	}
+	cout << "INFO: Mesh generation at " << segments << "x" << segments << " (" << vertices << " vertices, "
+		<< indices << " indices with every level of detail), average of " << repeats << " runs:" << endl;
+	for (size_t i = 0; i < threadCounts.size(); ++i)
+		cout << "  " << threadCounts[i] << (threadCounts[i] == 1 ? " thread   " : " threads  ") << averageMs[i] << " ms ("
+			<< averageMs[0] / averageMs[i] << "x)" << endl;
+	return true;
+}
+
+// Read the value of the numeric option argv[i] into value and step i past it.
+// The value must be a whole decimal number from 0 to max; a sign, trailing
+// characters or a missing value are reported and rejected.
+bool UOptionCount(int argc, char* argv[], int& i, unsigned long max, unsigned long& value)
+{
+	if (i + 1 == argc)
+	{
+		cout << "ERROR: " << argv[i] << " needs a count" << endl;
+		return false;
+	}
+	const char* text = argv[++i];
+
+	// strtoul would accept a sign and wrap a negative count round to a huge one
+	char* end = nullptr;
+	errno = 0;
+	value = text[0] >= '0' && text[0] <= '9' ? strtoul(text, &end, 10) : 0;
+	if (end == nullptr || *end != '\0' || errno == ERANGE || value > max)
+	{
+		cout << "ERROR: " << argv[i - 1] << " takes a count from 0 to " << max << ", not \"" << text << "\"" << endl;
+		return false;
+	}
+	return true;
 }
 
 void UDestroyTexture(GLuint textureId)
 {
-	glGenTextures(1, &textureId);
-}
\ No newline at end of file
+	gGpuResources.Deleted(GpuResourceType::Texture, textureId);
+	gGLState.DeleteTexture(textureId);
+}
\ No newline at end of file
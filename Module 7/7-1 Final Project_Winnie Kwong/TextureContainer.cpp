@@ -0,0 +1,166 @@
+///////////////////////////////////////////////////////////////////////////////
+// texturecontainer.cpp
+// ========
+// texture cooking and memory-mapped container access
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TextureContainer.h"
+#include "BlockCompress.h"
+#include "ImageOps.h"
+#include "MipChain.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <vector>
+
+#include "stb_image.h"
+
+namespace
+{
+	const uint32_t TEXTURE_CONTAINER_MAGIC = 0x58544342;	// "BCTX"
+	const uint32_t TEXTURE_CONTAINER_VERSION = 1;
+}
+
+size_t TextureLevelBytes(GLenum glFormat, int width, int height, int level)
+{
+	int levelWidth = MipLevelSize(width, level);
+	int levelHeight = MipLevelSize(height, level);
+	if (glFormat == GL_COMPRESSED_RGB_S3TC_DXT1_EXT)
+		return BlockCompressedBytes(levelWidth, levelHeight, BC1_BLOCK_BYTES);
+	if (glFormat == GL_COMPRESSED_RGBA_S3TC_DXT5_EXT)
+		return BlockCompressedBytes(levelWidth, levelHeight, BC3_BLOCK_BYTES);
+	return (size_t)levelWidth * levelHeight * 4;
+}
+
+bool MappedTexture::Open(const char* path)
+{
+	if (!file.Open(path))
+		return false;
+
+	const size_t size = file.Size();
+	bool valid = size >= sizeof(TextureContainerHeader);
+	valid = valid && Header().magic == TEXTURE_CONTAINER_MAGIC && Header().version == TEXTURE_CONTAINER_VERSION;
+	valid = valid && Header().levels > 0 && Header().levels == (uint32_t)MipLevelCount(Header().width, Header().height);
+	valid = valid && sizeof(TextureContainerHeader) + Header().levels * sizeof(TextureContainerLevel) <= size;
+	for (uint32_t level = 0; valid && level < Header().levels; ++level)
+		valid = Levels()[level].offset + Levels()[level].bytes <= size;
+
+	if (!valid)
+		Close();
+	return valid;
+}
+
+const unsigned char* MappedTexture::LevelData(int level) const
+{
+	return file.Data() + Levels()[level].offset;
+}
+
+size_t MappedTexture::LevelBytes(int level) const
+{
+	return (size_t)Levels()[level].bytes;
+}
+
+size_t MappedTexture::ChainBytes() const
+{
+	const TextureContainerLevel& last = Levels()[Header().levels - 1];
+	return (size_t)(last.offset + last.bytes - Levels()[0].offset);
+}
+
+///////////////////////////////////////////////////
+//	CookTexture(const char*, const char*)
+//
+//	The image is flipped like every texture of the
+//	scene and filtered with BuildMipChain, so a cooked
+//	texture matches the one the loader would build
+///////////////////////////////////////////////////
+bool CookTexture(const char* imagePath, const char* containerPath)
+{
+	std::ifstream in(imagePath, std::ios::binary);
+	std::vector<unsigned char> source((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+	int width, height, channels;
+	unsigned char* image = source.empty() ? nullptr :
+		stbi_load_from_memory(source.data(), (int)source.size(), &width, &height, &channels, 4);
+	if (!image)
+	{
+		std::cout << "Failed to load texture " << imagePath << std::endl;
+		return false;
+	}
+
+	FlipImageVertically(image, width, height, 4);
+	std::vector<unsigned char> chain(MipChainBytes(width, height));
+	BuildMipChain(image, width, height, chain.data());
+	stbi_image_free(image);
+
+	bool opaque = true;
+	for (size_t i = 3; i < (size_t)width * height * 4; i += 4)
+		opaque = opaque && chain[i] == 255;
+
+	const int levels = MipLevelCount(width, height);
+	const int blockBytes = opaque ? BC1_BLOCK_BYTES : BC3_BLOCK_BYTES;
+
+	TextureContainerHeader header = {};
+	header.magic = TEXTURE_CONTAINER_MAGIC;
+	header.version = TEXTURE_CONTAINER_VERSION;
+	header.glFormat = opaque ? GL_COMPRESSED_RGB_S3TC_DXT1_EXT : GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+	header.width = width;
+	header.height = height;
+	header.levels = levels;
+	header.sourceHash = HashBytes(source.data(), source.size());
+
+	std::vector<TextureContainerLevel> table(levels);
+	std::vector<unsigned char> blocks;
+	uint64_t offset = sizeof(TextureContainerHeader) + sizeof(TextureContainerLevel) * levels;
+
+	auto start = std::chrono::steady_clock::now();
+	for (int level = 0; level < levels; ++level)
+	{
+		int levelWidth = MipLevelSize(width, level);
+		int levelHeight = MipLevelSize(height, level);
+		table[level].offset = offset + blocks.size();
+		table[level].bytes = BlockCompressedBytes(levelWidth, levelHeight, blockBytes);
+
+		blocks.resize(blocks.size() + (size_t)table[level].bytes);
+		unsigned char* out = blocks.data() + (table[level].offset - offset);
+		const unsigned char* pixels = chain.data() + MipLevelOffset(width, height, level);
+		if (opaque)
+			CompressBC1(pixels, levelWidth, levelHeight, out);
+		else
+			CompressBC3(pixels, levelWidth, levelHeight, out);
+	}
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	// color error of the largest level after a round trip
+	std::vector<unsigned char> decoded((size_t)width * height * 4);
+	if (opaque)
+		DecompressBC1(blocks.data(), width, height, decoded.data());
+	else
+		DecompressBC3(blocks.data(), width, height, decoded.data());
+	double squaredError = 0.0;
+	for (size_t i = 0; i < decoded.size(); ++i)
+	{
+		double difference = (double)decoded[i] - chain[i];
+		squaredError += i % 4 != 3 ? difference * difference : 0.0;
+	}
+	double rmse = std::sqrt(squaredError / (decoded.size() / 4 * 3));
+
+	std::ofstream out(containerPath, std::ios::binary | std::ios::trunc);
+	out.write((const char*)&header, sizeof(header));
+	out.write((const char*)table.data(), sizeof(TextureContainerLevel) * table.size());
+	out.write((const char*)blocks.data(), blocks.size());
+	if (!out)
+	{
+		std::cout << "Failed to write " << containerPath << std::endl;
+		return false;
+	}
+
+	std::cout << "INFO: Cooked " << imagePath << ": " << width << "x" << height << (opaque ? " BC1, " : " BC3, ")
+		<< levels << " levels, " << blocks.size() / 1024 << " KB (" << (double)chain.size() / blocks.size() << "x smaller), RMSE "
+		<< rmse << ", PSNR " << 20.0 * std::log10(255.0 / std::max(rmse, 1e-6)) << " dB, "
+		<< chain.size() / seconds / (1024.0 * 1024.0) << " MB/s" << std::endl;
+	return true;
+}
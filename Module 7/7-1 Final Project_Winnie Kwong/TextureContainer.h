@@ -0,0 +1,71 @@
+///////////////////////////////////////////////////////////////////////////////
+// texturecontainer.h
+// ========
+// cooked texture files: a KTX-style container holding every mip level of a
+// texture as BC1 or BC3 blocks, read through a memory mapping so that the
+// blocks go from the page cache to the GL without an extra copy
+//
+// Layout (little endian): TextureContainerHeader, one TextureContainerLevel
+// per mip level, then the block data of each level, largest first and back
+// to back
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+
+#include <cstddef>
+#include <cstdint>
+
+#include "MappedFile.h"
+
+struct TextureContainerHeader
+{
+	uint32_t magic;         // TEXTURE_CONTAINER_MAGIC
+	uint32_t version;
+	uint32_t glFormat;      // GL_COMPRESSED_RGB_S3TC_DXT1_EXT or GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+	int32_t width;
+	int32_t height;
+	uint32_t levels;
+	uint64_t sourceHash;    // HashBytes of the image file it was cooked from
+};
+
+struct TextureContainerLevel
+{
+	uint64_t offset;        // from the start of the file
+	uint64_t bytes;
+};
+
+// Extension cooked containers get, appended to the image file name
+const char* const TEXTURE_CONTAINER_EXTENSION = ".bctex";
+
+// Bytes of one mip level of a width x height texture stored as glFormat:
+// GL_RGBA8, or DXT1/DXT5 blocks
+size_t TextureLevelBytes(GLenum glFormat, int width, int height, int level);
+
+// Read-only memory mapping of a container file
+class MappedTexture
+{
+public:
+	// Map path and check that its header and level table fit the file
+	bool Open(const char* path);
+	void Close() { file.Close(); }
+
+	const TextureContainerHeader& Header() const { return *(const TextureContainerHeader*)file.Data(); }
+	const unsigned char* LevelData(int level) const;
+	size_t LevelBytes(int level) const;
+
+	// The levels are stored back to back, so the whole chain is one range
+	const unsigned char* ChainData() const { return LevelData(0); }
+	size_t ChainBytes() const;
+
+private:
+	const TextureContainerLevel* Levels() const { return (const TextureContainerLevel*)(file.Data() + sizeof(TextureContainerHeader)); }
+
+	MappedFile file;
+};
+
+// Decode imagePath, build its mip chain, compress every level (BC1 when the
+// image is opaque, BC3 otherwise) and write the container to containerPath.
+// Prints the round-trip error of the largest level and the encoding speed.
+bool CookTexture(const char* imagePath, const char* containerPath);
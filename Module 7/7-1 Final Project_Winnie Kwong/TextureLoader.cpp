@@ -0,0 +1,778 @@
+///////////////////////////////////////////////////////////////////////////////
+// textureloader.cpp
+// ========
+// background texture array loading with pixel buffer object uploads
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TextureLoader.h"
+#include "GLState.h"
+#include "GpuResources.h"
+#include "ImageOps.h"
+#include "ShaderBlocks.h"
+#include "MipChain.h"
+#include "BlockCompress.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <string>
+
+#include "stb_image.h"
+
+namespace
+{
+	// every layer is stored as RGBA whatever the file holds
+	const int CHANNELS = 4;
+
+	int BlockBytes(GLenum format)
+	{
+		return format == GL_COMPRESSED_RGB_S3TC_DXT1_EXT ? BC1_BLOCK_BYTES : BC3_BLOCK_BYTES;
+	}
+
+	// Fill bytes of format blocks with one opaque grey, 255 for white
+	void FillBlocks(unsigned char* blocks, size_t bytes, GLenum format, unsigned char grey)
+	{
+		// 565 color at both ends and every index 0
+		unsigned short color = (unsigned short)(((grey >> 3) << 11) | ((grey >> 2) << 5) | (grey >> 3));
+		const unsigned char block[BC3_BLOCK_BYTES] =
+		{
+			255, 255, 0, 0, 0, 0, 0, 0,         // BC3 alpha: opaque
+			(unsigned char)color, (unsigned char)(color >> 8), (unsigned char)color, (unsigned char)(color >> 8), 0, 0, 0, 0,
+		};
+		const unsigned char* first = BlockBytes(format) == BC1_BLOCK_BYTES ? block + 8 : block;
+		for (size_t b = 0; b < bytes; b += BlockBytes(format))
+			memcpy(blocks + b, first, BlockBytes(format));
+	}
+
+	///////////////////////////////////////////////////
+	//	DecodeImage(...)
+	//
+	//	Decode an image file held in memory into flipped
+	//	RGBA of width x height, resampling if its size
+	//	differs. JPEGs decode to RGB and are expanded with
+	//	ExpandRgbToRgba, which is faster than stb_image's
+	//	per-pixel conversion; grey images are still
+	//	converted by stb_image.
+	///////////////////////////////////////////////////
+	bool DecodeImage(const std::vector<unsigned char>& file, const char* filename, int width, int height,
+		std::vector<unsigned char>& pixels)
+	{
+		int imageWidth, imageHeight, fileChannels;
+		unsigned char* image = stbi_load_from_memory(file.data(), (int)file.size(), &imageWidth, &imageHeight, &fileChannels, 0);
+		if (image && fileChannels != 3 && fileChannels != CHANNELS)
+		{
+			stbi_image_free(image);
+			image = stbi_load_from_memory(file.data(), (int)file.size(), &imageWidth, &imageHeight, &fileChannels, CHANNELS);
+		}
+		if (!image)
+			return false;
+
+		std::vector<unsigned char> rgba((size_t)imageWidth * imageHeight * CHANNELS);
+		if (fileChannels == 3)
+			ExpandRgbToRgba(image, rgba.data(), (size_t)imageWidth * imageHeight);
+		else
+			memcpy(rgba.data(), image, rgba.size());
+		stbi_image_free(image);
+
+		// OpenGL expects the first row at the bottom
+		FlipImageVertically(rgba.data(), imageWidth, imageHeight, CHANNELS);
+
+		if (imageWidth == width && imageHeight == height)
+			pixels.swap(rgba);
+		else
+		{
+			std::cout << "Resampling texture " << filename << " from " << imageWidth << "x" << imageHeight
+				<< " to " << width << "x" << height << std::endl;
+			pixels.resize((size_t)width * height * CHANNELS);
+			ResampleImage(rgba.data(), imageWidth, imageHeight, pixels.data(), width, height, CHANNELS);
+		}
+		return true;
+	}
+}
+
+bool TextureArrayLoader::Start(const char* const* files, GLsizei count, GLuint& id, GLuint& colorId)
+{
+	Stop();
+	filenames.assign(files, files + count);
+	uploaded = 0;
+	cacheHits = 0;
+	startTime = std::chrono::steady_clock::now();
+
+	// files are matched up by content first; then the first readable header
+	// among the layers that are left sets the layer size
+	width = height = 0;
+	bool prebuilt = OpenPackedLayers() || OpenContainers();
+	AssignLayers();
+	for (size_t layer = 0; !prebuilt && layer < layerFiles.size() && width == 0; ++layer)
+	{
+		const std::vector<unsigned char>& file = fileData[layer];
+		int fileChannels;
+		if (file.empty() || !stbi_info_from_memory(file.data(), (int)file.size(), &width, &height, &fileChannels))
+			width = height = 0;
+	}
+	const GLsizei layerCount = std::max((GLsizei)layerFiles.size(), 1);
+
+	// nothing readable: keep going with plain white 1x1 layers
+	if (width == 0)
+		width = height = 1;
+
+	const GLenum format = compressedFormat ? compressedFormat : GL_RGBA8;
+	const GLsizei levels = MipLevelCount(width, height);
+	levelOffsets.assign(1, 0);
+	for (GLsizei level = 0; level < levels; ++level)
+	{
+		levelOffsets.push_back(levelOffsets.back() + TextureLevelBytes(format, width, height, level));
+	}
+
+	// generates texture names
+	glGenTextures(1, &textureId);
+	// binding texure to 2D texture array
+	gGLState.BindTexture(TEXTURE_UNIT, GL_TEXTURE_2D_ARRAY, textureId);
+	CreateStorage(format, layerCount);
+	gGpuResources.Created(GpuResourceType::Texture, textureId, "texture array");
+
+	// set texture wrapping params
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+	// set texture filtering params
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+	// the levels every layer starts with; sparse pages are committed first
+	residentLevels.assign(layerCount, levels);
+	targetLevels.assign(layerCount, loadLevel);
+	layerChains.assign(layerCount, nullptr);
+	ownedChains.assign(streamingBudget > 0 ? layerCount : 0, std::vector<unsigned char>());
+	residentBytes = 0;
+	evictions = 0;
+	for (GLsizei layer = 0; layer < layerCount; ++layer)
+	{
+		for (int level = loadLevel; level < levels; ++level)
+			Commit(layer, level, GL_TRUE);
+		SetResident(layer, loadLevel);
+	}
+	gGpuResources.SetBytes(GpuResourceType::Texture, textureId, sparse ? residentBytes :
+		(levelOffsets.back() - levelOffsets[firstLevel]) * layerCount);
+
+	// grey placeholders in every layer and mip level until the images arrive;
+	// compressed storage cannot be cleared, so it gets grey blocks instead
+	if (compressedFormat)
+	{
+		for (GLsizei level = loadLevel; level < levels; ++level)
+		{
+			std::vector<unsigned char> blocks(levelOffsets[level + 1] - levelOffsets[level]);
+			FillBlocks(blocks.data(), blocks.size(), compressedFormat, 128);
+			for (GLsizei layer = 0; layer < layerCount; ++layer)
+				glCompressedTexSubImage3D(GL_TEXTURE_2D_ARRAY, level - firstLevel, 0, 0, layer, MipLevelSize(width, level), MipLevelSize(height, level), 1,
+					compressedFormat, (GLsizei)blocks.size(), blocks.data());
+		}
+	}
+	else
+	{
+		const unsigned char placeholder[CHANNELS] = { 128, 128, 128, 255 };
+		for (GLsizei level = loadLevel; level < levels; ++level)
+			glClearTexImage(textureId, level - firstLevel, GL_RGBA, GL_UNSIGNED_BYTE, placeholder);
+	}
+
+	// rebinding GL_TEXTURE_2D_ARRAY to nothing
+	gGLState.BindTexture(TEXTURE_UNIT, GL_TEXTURE_2D_ARRAY, 0);
+
+	GLsizeiptr chainBytes = (GLsizeiptr)levelOffsets.back();
+	glGenBuffers(2, pixelBuffers);
+	gGpuResources.Created(GpuResourceType::Buffer, 2, pixelBuffers, "texture upload");
+	for (GLuint buffer : pixelBuffers)
+	{
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer);
+		glBufferData(GL_PIXEL_UNPACK_BUFFER, chainBytes, nullptr, GL_STREAM_DRAW);
+		gGpuResources.SetBytes(GpuResourceType::Buffer, buffer, chainBytes);
+	}
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+	// single-color files share a 1x1 layer per color, filled at once
+	glGenTextures(1, &colorArrayId);
+	gGLState.BindTexture(TEXTURE_UNIT, GL_TEXTURE_2D_ARRAY, colorArrayId);
+	glTexStorage3D(GL_TEXTURE_2D_ARRAY, 1, GL_RGBA8, 1, 1, std::max((GLsizei)colors.size(), 1));
+	gGpuResources.Created(GpuResourceType::Texture, colorArrayId, "color array");
+	gGpuResources.SetBytes(GpuResourceType::Texture, colorArrayId, GpuTextureBytes(GL_RGBA8, 1, 1, std::max((GLsizei)colors.size(), 1), 1));
+	if (!colors.empty())
+		glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, 0, 1, 1, (GLsizei)colors.size(), GL_RGBA, GL_UNSIGNED_BYTE, colors.data());
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	gGLState.BindTexture(TEXTURE_UNIT, GL_TEXTURE_2D_ARRAY, 0);
+
+	// the finest level each layer can be sampled at, filled in by SetResident
+	std::vector<GLfloat> minLods(layerCount);
+	for (GLsizei layer = 0; layer < layerCount; ++layer)
+		minLods[layer] = (GLfloat)(residentLevels[layer] - firstLevel);
+	glGenBuffers(1, &lodBuffer);
+	gGpuResources.Created(GpuResourceType::Buffer, lodBuffer, "texture layer levels");
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, lodBuffer);
+	glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(GLfloat) * layerCount, minLods.data(), GL_DYNAMIC_DRAW);
+	gGpuResources.SetBytes(GpuResourceType::Buffer, lodBuffer, sizeof(GLfloat) * layerCount);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, LAYER_LOD_BINDING, lodBuffer);
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+	// decoding and filtering are the slow part, so spread the layers over the cores
+	GLsizei threads = std::min((GLsizei)std::max(std::thread::hardware_concurrency(), 1u), layerCount);
+	nextLayer = 0;
+	cancelled = false;
+	for (GLsizei i = 0; i < threads; ++i)
+		workers.emplace_back(&TextureArrayLoader::Decode, this);
+
+	std::cout << "INFO: Texture array: " << count << " files in " << layerFiles.size() << " layers of " << width << "x" << height
+		<< (compressedFormat == GL_COMPRESSED_RGB_S3TC_DXT1_EXT ? " BC1" : compressedFormat ? " BC3" : " RGBA8")
+		<< (!packedLayers.empty() ? " from the asset pack" : containers ? " from cooked containers" : "")
+		<< " and " << colors.size() << " single colors, loading on " << threads << " threads" << std::endl;
+	if (streamingBudget > 0)
+	{
+		std::cout << "INFO: Texture streaming: " << streamingBudget / (1024 * 1024) << " MB budget, levels of "
+			<< MipLevelSize(width, loadLevel) << "x" << MipLevelSize(height, loadLevel) << " and smaller always resident, ";
+		if (sparse)
+			std::cout << "finer levels in sparse pages" << std::endl;
+		else
+			std::cout << "no sparse textures, so the array starts at " << MipLevelSize(width, firstLevel) << "x"
+				<< MipLevelSize(height, firstLevel) << std::endl;
+	}
+
+	id = textureId;
+	colorId = colorArrayId;
+	return true;
+}
+
+///////////////////////////////////////////////////
+//	CreateStorage(GLenum, GLsizei)
+//
+//	Allocate the array bound to GL_TEXTURE_2D_ARRAY
+//	and choose the levels a layer starts with. When
+//	streaming, levels finer than STREAM_BASE_SIZE come
+//	and go per layer: as sparse pages committed and
+//	released with them where the driver takes the
+//	format and size, otherwise inside an array that
+//	drops its finest levels until every layer fits
+//	the budget at once.
+///////////////////////////////////////////////////
+void TextureArrayLoader::CreateStorage(GLenum format, GLsizei layerCount)
+{
+	const int levels = (int)levelOffsets.size() - 1;
+	sparse = false;
+	sparseLevels = 0;
+	firstLevel = 0;
+	loadLevel = 0;
+
+	if (streamingBudget > 0)
+	{
+		while (loadLevel + 1 < levels && std::max(MipLevelSize(width, loadLevel), MipLevelSize(height, loadLevel)) > STREAM_BASE_SIZE)
+			++loadLevel;
+
+		GLint pageSizes = 0, pageWidth = 0, pageHeight = 0;
+		if (GLEW_ARB_sparse_texture)
+		{
+			glGetInternalformativ(GL_TEXTURE_2D_ARRAY, format, GL_NUM_VIRTUAL_PAGE_SIZES_ARB, 1, &pageSizes);
+			glGetInternalformativ(GL_TEXTURE_2D_ARRAY, format, GL_VIRTUAL_PAGE_SIZE_X_ARB, 1, &pageWidth);
+			glGetInternalformativ(GL_TEXTURE_2D_ARRAY, format, GL_VIRTUAL_PAGE_SIZE_Y_ARB, 1, &pageHeight);
+		}
+		sparse = pageSizes > 0 && pageWidth > 0 && pageHeight > 0 && width % pageWidth == 0 && height % pageHeight == 0;
+		if (sparse)
+		{
+			glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_SPARSE_ARB, GL_TRUE);
+			glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_VIRTUAL_PAGE_SIZE_INDEX_ARB, 0);
+			glTexStorage3D(GL_TEXTURE_2D_ARRAY, levels, format, width, height, layerCount);
+			glGetTexParameteriv(GL_TEXTURE_2D_ARRAY, GL_NUM_SPARSE_LEVELS_ARB, &sparseLevels);
+
+			// the mip tail is committed as a whole, so its levels cannot come and go
+			loadLevel = std::min(loadLevel, (int)sparseLevels);
+		}
+		else
+		{
+			while (firstLevel + 1 < levels && (levelOffsets.back() - levelOffsets[firstLevel]) * layerCount > streamingBudget)
+				++firstLevel;
+			loadLevel = std::max(loadLevel, firstLevel);
+		}
+	}
+	if (!sparse)
+		glTexStorage3D(GL_TEXTURE_2D_ARRAY, levels - firstLevel, format, MipLevelSize(width, firstLevel), MipLevelSize(height, firstLevel), layerCount);
+
+	std::vector<size_t> levelBytes(levels);
+	for (int level = 0; level < levels; ++level)
+		levelBytes[level] = levelOffsets[level + 1] - levelOffsets[level];
+	residency.Reset(layerCount, levelBytes, loadLevel, streamingBudget);
+}
+
+///////////////////////////////////////////////////
+//	AssignLayers()
+//
+//	Give every file a place by content: files with
+//	the same bytes (or the same packed chain) share a
+//	layer, and images the mip cache or the pack marks
+//	as one color get a 1x1 layer of the color array,
+//	shared by every file of that color, and are not
+//	decoded at all. Unpacked files are read here to
+//	hash them and handed to the workers as they are.
+///////////////////////////////////////////////////
+void TextureArrayLoader::AssignLayers()
+{
+	std::map<uint64_t, GLint> layerOfContent;   // same encoding as fileLayers
+	std::map<uint32_t, GLint> layerOfColor;
+	fileLayers.assign(filenames.size(), 0);
+	layerFiles.clear();
+	colors.clear();
+	fileData.clear();
+	duplicates = 0;
+
+	for (GLsizei i = 0; i < (GLsizei)filenames.size(); ++i)
+	{
+		std::vector<unsigned char> file;
+		uint64_t hash;
+		if (!packedLayers.empty())
+			hash = packedLayers[i]->hash;
+		else if (containers)
+			hash = containers[i].Header().sourceHash;
+		else
+		{
+			std::ifstream in(filenames[i], std::ios::binary);
+			file.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+			if (in.bad())
+				file.clear();
+			hash = HashBytes(file.data(), file.size());
+		}
+
+		// unreadable files never match, so each gets its own white layer
+		bool readable = !packedLayers.empty() || containers || !file.empty();
+		if (readable && layerOfContent.count(hash) != 0)
+		{
+			fileLayers[i] = layerOfContent[hash];
+			++duplicates;
+			continue;
+		}
+
+		uint32_t color = 0;
+		bool solid = false;
+		if (!packedLayers.empty())
+		{
+			solid = packedLayers[i]->solid != 0;
+			color = packedLayers[i]->color;
+		}
+		else if (readable && mipCache)
+			solid = ReadMipCacheColor((std::string(filenames[i]) + ".mips").c_str(), hash, color);
+
+		if (solid)
+		{
+			if (layerOfColor.count(color) == 0)
+			{
+				layerOfColor[color] = (GLint)colors.size();
+				colors.push_back(color);
+			}
+			fileLayers[i] = -1 - layerOfColor[color];
+		}
+		else
+		{
+			fileLayers[i] = (GLint)layerFiles.size();
+			layerFiles.push_back(i);
+			fileData.push_back(std::move(file));
+		}
+		if (readable)
+			layerOfContent[hash] = fileLayers[i];
+	}
+}
+
+///////////////////////////////////////////////////
+//	OpenContainers()
+//
+//	Map the cooked container of every file. They are
+//	only used if all of them exist and agree on size
+//	and block format, since every layer of an array
+//	shares both, and the GL can sample S3TC blocks.
+//	Sets compressedFormat and the layer size.
+///////////////////////////////////////////////////
+bool TextureArrayLoader::OpenContainers()
+{
+	const GLsizei count = (GLsizei)filenames.size();
+	compressedFormat = 0;
+	containers.reset(new MappedTexture[count]);
+
+	bool usable = count > 0 && GLEW_EXT_texture_compression_s3tc;
+	for (GLsizei i = 0; usable && i < count; ++i)
+	{
+		std::string path = std::string(filenames[i]) + TEXTURE_CONTAINER_EXTENSION;
+		usable = containers[i].Open(path.c_str());
+
+		// the loop stops at the first failure, so container 0 is open here
+		if (usable && i > 0)
+		{
+			const TextureContainerHeader& first = containers[0].Header();
+			usable = containers[i].Header().glFormat == first.glFormat &&
+				containers[i].Header().width == first.width && containers[i].Header().height == first.height;
+		}
+	}
+	for (GLsizei i = 0; usable && i < count; ++i)
+	{
+		// the blocks of every level must be where Upload expects them
+		const TextureContainerHeader& header = containers[i].Header();
+		size_t expected = 0;
+		for (uint32_t level = 0; usable && level < header.levels; ++level)
+		{
+			size_t bytes = TextureLevelBytes(header.glFormat, header.width, header.height, level);
+			usable = containers[i].LevelBytes(level) == bytes && containers[i].LevelData(level) == containers[i].ChainData() + expected;
+			expected += bytes;
+		}
+	}
+
+	if (!usable)
+	{
+		containers.reset();
+		return false;
+	}
+
+	compressedFormat = containers[0].Header().glFormat;
+	width = containers[0].Header().width;
+	height = containers[0].Header().height;
+	return true;
+}
+
+///////////////////////////////////////////////////
+//	OpenPackedLayers()
+//
+//	Find every file in the asset pack. As with the
+//	containers, the pack is only used if it holds all
+//	of them, and all but the single colors (packed as
+//	1x1 texels) at one size and format. Sets
+//	compressedFormat and the layer size.
+///////////////////////////////////////////////////
+bool TextureArrayLoader::OpenPackedLayers()
+{
+	const GLsizei count = (GLsizei)filenames.size();
+	const AssetPackEntry* first = nullptr;   // first entry that is not a single color
+	compressedFormat = 0;
+	packedLayers.clear();
+
+	bool usable = count > 0 && assetPack != nullptr && assetPack->IsOpen();
+	for (GLsizei i = 0; usable && i < count; ++i)
+	{
+		const AssetPackEntry* entry = assetPack->Find(AssetType::Texture, AssetPackName(filenames[i]));
+		usable = entry != nullptr;
+		if (usable && !entry->solid)
+		{
+			usable = entry->width > 0 && entry->height > 0 && entry->levels == (uint32_t)MipLevelCount(entry->width, entry->height);
+			if (usable && first != nullptr)
+				usable = entry->glFormat == first->glFormat && entry->width == first->width && entry->height == first->height;
+
+			// the chain must be exactly the levels Upload copies
+			size_t expected = 0;
+			for (uint32_t level = 0; usable && level < entry->levels; ++level)
+				expected += TextureLevelBytes(entry->glFormat, entry->width, entry->height, level);
+			usable = usable && entry->bytes == expected;
+			first = first != nullptr ? first : entry;
+		}
+		if (usable)
+			packedLayers.push_back(entry);
+	}
+
+	GLenum format = first != nullptr ? first->glFormat : GL_RGBA8;
+	usable = usable && (format == GL_RGBA8 || (GLEW_EXT_texture_compression_s3tc &&
+		(format == GL_COMPRESSED_RGB_S3TC_DXT1_EXT || format == GL_COMPRESSED_RGBA_S3TC_DXT5_EXT)));
+	if (!usable)
+	{
+		packedLayers.clear();
+		return false;
+	}
+
+	compressedFormat = format == GL_RGBA8 ? 0 : format;
+	width = first != nullptr ? first->width : 1;
+	height = first != nullptr ? first->height : 1;
+	return true;
+}
+
+///////////////////////////////////////////////////
+//	Decode()
+//
+//	Worker thread: take the next file and turn it
+//	into a mip chain, from the asset pack or its
+//	cooked container when the array uses them, from
+//	the cache when the file is unchanged since the
+//	chain was written, otherwise by decoding and
+//	filtering it (and caching the result), then hand
+//	it to the GL thread
+///////////////////////////////////////////////////
+void TextureArrayLoader::Decode()
+{
+	for (GLsizei layer = nextLayer++; layer < (GLsizei)layerFiles.size() && !cancelled; layer = nextLayer++)
+	{
+		const GLsizei i = layerFiles[layer];
+		DecodedLayer decoded;
+		decoded.layer = layer;
+		decoded.mapped = nullptr;
+
+		// packed or cooked: the chain is already in a mapped file and is
+		// uploaded from there. Reading it here (hashing the packed chain,
+		// touching every page of the cooked one) takes the page faults off
+		// the GL thread.
+		if (!packedLayers.empty())
+		{
+			if (assetPack->Verify(*packedLayers[i]))
+				decoded.mapped = assetPack->Data(*packedLayers[i]);
+			else
+				std::cout << "WARNING: texture " << filenames[i] << " in the asset pack is damaged" << std::endl;
+			std::lock_guard<std::mutex> lock(readyMutex);
+			ready.push_back(std::move(decoded));
+			continue;
+		}
+		if (containers)
+		{
+			const size_t pageBytes = 4096;
+			volatile unsigned char touched = 0;
+			for (size_t offset = 0; offset < containers[i].ChainBytes(); offset += pageBytes)
+				touched = touched + containers[i].ChainData()[offset];
+			decoded.mapped = containers[i].ChainData();
+			std::lock_guard<std::mutex> lock(readyMutex);
+			ready.push_back(std::move(decoded));
+			continue;
+		}
+
+		// read by AssignLayers; nothing else touches this layer's entry
+		std::vector<unsigned char> file(std::move(fileData[layer]));
+		uint64_t hash = HashBytes(file.data(), file.size());
+		std::string cachePath = std::string(filenames[i]) + ".mips";
+
+		std::vector<unsigned char> pixels;
+		if (!file.empty() && mipCache && ReadMipCache(cachePath.c_str(), hash, width, height, decoded.chain))
+			++cacheHits;
+		else if (!file.empty() && DecodeImage(file, filenames[i], width, height, pixels))
+		{
+			decoded.chain.resize(MipChainBytes(width, height));
+			BuildMipChain(pixels.data(), width, height, decoded.chain.data());
+			if (mipCache && !WriteMipCache(cachePath.c_str(), hash, width, height, decoded.chain))
+				std::cout << "WARNING: could not write mip cache " << cachePath << std::endl;
+
+			uint32_t color;
+			if (mipCache && IsSolidColor(pixels.data(), (size_t)width * height, SOLID_COLOR_TOLERANCE, color))
+				std::cout << "INFO: " << filenames[i] << " is a single color and will load as a 1x1 layer from now on" << std::endl;
+		}
+		else
+			std::cout << "Failed to load texture " << filenames[i] << std::endl;
+
+		std::lock_guard<std::mutex> lock(readyMutex);
+		ready.push_back(std::move(decoded));
+	}
+}
+
+GLuint TextureArrayLoader::Poll(GLuint maxLayers)
+{
+	if (Done())
+	{
+		Stream();
+		return 0;
+	}
+
+	std::vector<DecodedLayer> batch;
+	{
+		std::lock_guard<std::mutex> lock(readyMutex);
+		GLuint take = std::min(maxLayers, (GLuint)ready.size());
+		batch.assign(std::make_move_iterator(ready.begin()), std::make_move_iterator(ready.begin() + take));
+		ready.erase(ready.begin(), ready.begin() + take);
+	}
+	if (batch.empty())
+		return 0;
+
+	gGLState.BindTexture(TEXTURE_UNIT, GL_TEXTURE_2D_ARRAY, textureId);
+	for (DecodedLayer& decoded : batch)
+	{
+		// a streamed layer uploads its finer levels later, so the chain is kept
+		const unsigned char* chain = decoded.mapped != nullptr ? decoded.mapped : decoded.chain.empty() ? nullptr : decoded.chain.data();
+		if (streamingBudget > 0)
+		{
+			ownedChains[decoded.layer].swap(decoded.chain);
+			layerChains[decoded.layer] = chain;
+		}
+		Upload(decoded.layer, chain, loadLevel, (int)levelOffsets.size() - 1);
+	}
+
+	uploaded += (GLuint)batch.size();
+	if (Done())
+	{
+		double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+		std::cout << "INFO: Texture array: all " << uploaded << " layers loaded in " << ms << " ms ("
+			<< cacheHits << " from the mip cache, " << duplicates << " files sharing another's layer)" << std::endl;
+	}
+	return (GLuint)batch.size();
+}
+
+///////////////////////////////////////////////////
+//	Upload(GLsizei, const unsigned char*, int, int)
+//
+//	layer: array layer to fill
+//	chain: the layer's whole mip chain, or nullptr for
+//		a plain white layer
+//	finestLevel, endLevel: levels to upload, as
+//		[finestLevel, endLevel) of the chain
+//
+//	Copy the levels into the next pixel buffer and
+//	let the driver transfer them into the array from
+//	there. The buffer is orphaned first so mapping
+//	does not wait for an earlier transfer from it.
+///////////////////////////////////////////////////
+void TextureArrayLoader::Upload(GLsizei layer, const unsigned char* chain, int finestLevel, int endLevel)
+{
+	GLsizeiptr chainBytes = (GLsizeiptr)levelOffsets.back();
+	size_t start = levelOffsets[finestLevel];
+	size_t bytes = levelOffsets[endLevel] - start;
+
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pixelBuffers[nextPixelBuffer]);
+	nextPixelBuffer = (nextPixelBuffer + 1) % 2;
+
+	glBufferData(GL_PIXEL_UNPACK_BUFFER, chainBytes, nullptr, GL_STREAM_DRAW);
+	unsigned char* mapped = (unsigned char*)glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, bytes,
+		GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+	if (mapped != nullptr)
+	{
+		if (chain != nullptr)
+			memcpy(mapped, chain + start, bytes);
+		else if (compressedFormat)
+			FillBlocks(mapped, bytes, compressedFormat, 255); // damaged pack entry: plain white layer
+		else
+			memset(mapped, 255, bytes); // failed file: plain white layer
+		glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+
+		// with a pixel unpack buffer bound the data pointer is an offset into it
+		for (int level = finestLevel; level < endLevel; ++level)
+		{
+			const void* offset = (const void*)(levelOffsets[level] - start);
+			if (compressedFormat)
+				glCompressedTexSubImage3D(GL_TEXTURE_2D_ARRAY, level - firstLevel, 0, 0, layer, MipLevelSize(width, level), MipLevelSize(height, level), 1,
+					compressedFormat, (GLsizei)(levelOffsets[level + 1] - levelOffsets[level]), offset);
+			else
+				glTexSubImage3D(GL_TEXTURE_2D_ARRAY, level - firstLevel, 0, 0, layer, MipLevelSize(width, level), MipLevelSize(height, level), 1,
+					GL_RGBA, GL_UNSIGNED_BYTE, offset);
+		}
+	}
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+}
+
+void TextureArrayLoader::RequestSize(GLint layer, float pixels)
+{
+	if (streamingBudget == 0 || !Done() || layer < 0 || pixels <= 0.0f)
+		return;
+
+	// one texel per pixel: every halving of the size on screen is a level coarser
+	int level = (int)std::floor(std::log2(std::max(width, height) / pixels));
+	residency.Request(layer, std::max(level, firstLevel), pixels);
+}
+
+void TextureArrayLoader::UpdateResidency()
+{
+	if (streamingBudget == 0 || !Done())
+		return;
+
+	// release first, so the levels Poll adds fit the budget
+	residency.Plan(residentLevels, targetLevels);
+	for (GLsizei layer = 0; layer < (GLsizei)residentLevels.size(); ++layer)
+	{
+		int released = residentLevels[layer];
+		if (targetLevels[layer] <= released)
+			continue;
+		SetResident(layer, targetLevels[layer]);
+		for (int level = released; level < targetLevels[layer]; ++level)
+			Commit(layer, level, GL_FALSE);
+		++evictions;
+	}
+}
+
+///////////////////////////////////////////////////
+//	Stream()
+//
+//	Bring the layers up to their planned levels one
+//	level per layer per pass, coarse to fine, until
+//	STREAM_BYTES_PER_POLL have been uploaded. Each
+//	layer may be sampled at a level as soon as it
+//	lands, so textures sharpen a step at a time.
+///////////////////////////////////////////////////
+void TextureArrayLoader::Stream()
+{
+	size_t bytes = 0;
+	bool progress = true;
+	while (progress && bytes < STREAM_BYTES_PER_POLL)
+	{
+		progress = false;
+		for (GLsizei layer = 0; layer < (GLsizei)residentLevels.size() && bytes < STREAM_BYTES_PER_POLL; ++layer)
+		{
+			if (targetLevels[layer] >= residentLevels[layer])
+				continue;
+
+			int level = residentLevels[layer] - 1;
+			gGLState.BindTexture(TEXTURE_UNIT, GL_TEXTURE_2D_ARRAY, textureId);
+			Commit(layer, level, GL_TRUE);
+			Upload(layer, layerChains[layer], level, level + 1);
+			SetResident(layer, level);
+			bytes += levelOffsets[level + 1] - levelOffsets[level];
+			progress = true;
+		}
+	}
+}
+
+// Commit or release the pages of one level of a sparse layer; the levels
+// in the mip tail all go with the first of them
+void TextureArrayLoader::Commit(GLsizei layer, int level, GLboolean commit)
+{
+	int arrayLevel = level - firstLevel;
+	int arrayLevels = (int)levelOffsets.size() - 1 - firstLevel;
+	if (!sparse || arrayLevel > sparseLevels || arrayLevel >= arrayLevels)
+		return;
+
+	gGLState.BindTexture(TEXTURE_UNIT, GL_TEXTURE_2D_ARRAY, textureId);
+	glTexPageCommitmentARB(GL_TEXTURE_2D_ARRAY, arrayLevel, 0, 0, layer, MipLevelSize(width, level), MipLevelSize(height, level), 1, commit);
+}
+
+// Make level the finest one layer is sampled at and update the byte count
+void TextureArrayLoader::SetResident(GLsizei layer, int level)
+{
+	residentBytes += residency.LayerBytes(level);
+	residentBytes -= residency.LayerBytes(residentLevels[layer]);
+	residentLevels[layer] = level;
+
+	if (sparse)
+		gGpuResources.SetBytes(GpuResourceType::Texture, textureId, residentBytes);
+	if (lodBuffer != 0)
+	{
+		GLfloat minLod = (GLfloat)(level - firstLevel);
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, lodBuffer);
+		glBufferSubData(GL_SHADER_STORAGE_BUFFER, sizeof(GLfloat) * layer, sizeof(GLfloat), &minLod);
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+	}
+}
+
+void TextureArrayLoader::Stop()
+{
+	cancelled = true;
+	for (std::thread& worker : workers)
+		worker.join();
+	workers.clear();
+
+	ready.clear();
+	containers.reset();
+	packedLayers.clear();
+	fileData.clear();
+	layerChains.clear();
+	ownedChains.clear();
+
+	if (pixelBuffers[0] != 0)
+	{
+		gGpuResources.Deleted(GpuResourceType::Buffer, 2, pixelBuffers);
+		glDeleteBuffers(2, pixelBuffers);
+	}
+	pixelBuffers[0] = pixelBuffers[1] = 0;
+
+	if (lodBuffer != 0)
+	{
+		gGpuResources.Deleted(GpuResourceType::Buffer, lodBuffer);
+		glDeleteBuffers(1, &lodBuffer);
+	}
+	lodBuffer = 0;
+}
+
+GLint TextureArrayLoader::LayerOf(GLsizei file) const
+{
+	return file >= 0 && file < (GLsizei)fileLayers.size() ? fileLayers[file] : 0;
+}
@@ -0,0 +1,177 @@
+///////////////////////////////////////////////////////////////////////////////
+// textureloader.h
+// ========
+// fill a texture array in the background: worker threads decode the image
+// files and build their mip chains (or read them from the chain cache, a
+// cooked container or the asset pack) while the GL thread streams finished
+// layers through pixel buffer objects. The array exists at once with
+// placeholder layers, so the scene renders before the first image is decoded.
+//
+// Layers are assigned by content rather than by file: files with the same
+// bytes share one layer, and files known to be a single color get a 1x1
+// layer in a second, tiny array instead of a full-size one.
+//
+// With a streaming budget only the small levels of each layer are loaded up
+// front. The finer ones follow the size each layer has on screen and are
+// released again when the budget is needed elsewhere; the shaders read the
+// finest resident level of every layer from the LayerLodBlock buffer.
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "AssetPack.h"
+#include "MipResidency.h"
+#include "TextureContainer.h"
+
+class TextureArrayLoader
+{
+public:
+	// Layers uploaded per Poll call at most, so a frame never stalls on many uploads
+	static const GLuint DEFAULT_LAYERS_PER_POLL = 2;
+
+	// When streaming: levels this size and smaller are always resident, and
+	// at most this many bytes of finer levels are uploaded per Poll call
+	static const int STREAM_BASE_SIZE = 64;
+	static const size_t STREAM_BYTES_PER_POLL = 4 * 1024 * 1024;
+
+	// Texture unit the array is bound on for uploads, whichever unit is
+	// active; the scene's shaders sample it there as well
+	static const GLuint TEXTURE_UNIT = 0;
+
+	~TextureArrayLoader() { Stop(); }
+
+	// Create the array with one grey placeholder layer per file and start the
+	// workers. When the asset pack holds every file as chains of one size and
+	// format, the layers come from the pack. Otherwise, when every file has a cooked container (--cook-textures) of the
+	// same size and block format, the array is block compressed and filled
+	// from the containers. Otherwise the layer size is read from the first
+	// readable image header and images of another size are resampled to it.
+	// filenames must outlive the loader. colorArrayId receives the 1x1 array
+	// of single colors; the caller deletes both arrays.
+	bool Start(const char* const* filenames, GLsizei count, GLuint& textureId, GLuint& colorArrayId);
+
+	// Where file (an index into filenames) ended up: a layer of the texture
+	// array, or for a single-color file -1 - its layer of the color array
+	GLint LayerOf(GLsizei file) const;
+
+	// Upload the mip chains of up to maxLayers decoded images, and once every
+	// layer is in, the finer levels UpdateResidency planned; call once per
+	// frame on the GL thread. The array is left bound on TEXTURE_UNIT, which
+	// is left active. Returns the number of layers swapped in.
+	GLuint Poll(GLuint maxLayers = DEFAULT_LAYERS_PER_POLL);
+
+	// Stream the levels of the texture array within budgetBytes, counting
+	// the always-resident levels (0, the default, loads every level). Where
+	// ARB_sparse_texture takes the layer format and size, released levels
+	// free their memory; otherwise the array is allocated with as many
+	// levels as fit the budget for every layer. Set before Start.
+	void SetStreamingBudget(size_t budgetBytes) { streamingBudget = budgetBytes; }
+
+	// Ask for layer (a texture array layer, as returned by LayerOf) to be
+	// sharp at pixels texels across, e.g. its object's size on screen; call
+	// for every drawn object between UpdateResidency calls
+	void RequestSize(GLint layer, float pixels);
+
+	// Once per frame after the requests: plan the level of every layer,
+	// release the levels the plan drops and leave the new ones to Poll
+	void UpdateResidency();
+
+	// Bytes of texture array levels resident now, and how many times a
+	// layer has had levels released
+	size_t ResidentBytes() const { return residentBytes; }
+	GLuint Evictions() const { return evictions; }
+	bool Sparse() const { return sparse; }
+
+	// Keep finished chains in a "<image file>.mips" file next to each image and
+	// read them back on later runs (on by default). Set before Start.
+	void SetMipCache(bool enabled) { mipCache = enabled; }
+
+	// Read the layers from pack, which must stay open until the loader is
+	// done or stopped (nullptr by default). Set before Start.
+	void SetAssetPack(const AssetPack* pack) { assetPack = pack; }
+
+	// Every layer holds its final image (or white if its file failed)
+	bool Done() const { return uploaded == (GLuint)layerFiles.size(); }
+
+	// Cancel decoding, join the workers and release the upload and level buffers
+	void Stop();
+
+private:
+	// A finished mip chain waiting for the GL thread
+	struct DecodedLayer
+	{
+		GLsizei layer;
+		std::vector<unsigned char> chain;   // every level, largest first; empty if the file failed
+		const unsigned char* mapped;        // or the chain inside a mapped file, uploaded from there
+	};
+
+	void AssignLayers();
+	void CreateStorage(GLenum format, GLsizei layerCount);
+	void Decode();
+	void Upload(GLsizei layer, const unsigned char* chain, int finestLevel, int endLevel);
+	void Stream();
+	void Commit(GLsizei layer, int level, GLboolean commit);
+	void SetResident(GLsizei layer, int level);
+	bool OpenContainers();
+	bool OpenPackedLayers();
+
+	std::vector<const char*> filenames;
+	GLuint textureId = 0;
+	GLuint colorArrayId = 0;
+
+	std::vector<GLint> fileLayers;      // LayerOf of every file
+	std::vector<GLsizei> layerFiles;    // file that fills each layer of the texture array
+	std::vector<uint32_t> colors;       // RGBA of each layer of the color array
+	std::vector<std::vector<unsigned char>> fileData;  // contents of each layer's file, when decoding
+	GLuint duplicates = 0;
+	int width = 0;
+	int height = 0;
+	bool mipCache = true;
+
+	const AssetPack* assetPack = nullptr;
+	GLenum compressedFormat = 0;                    // block format of the layers, 0 if uncompressed
+	std::unique_ptr<MappedTexture[]> containers;    // one per file when read from cooked containers
+	std::vector<const AssetPackEntry*> packedLayers;    // one per file when read from the asset pack
+	std::vector<size_t> levelOffsets;               // each level's start within a chain, then the chain size
+
+	// Streaming. Levels are numbered as in the full chain; array level 0
+	// holds chain level firstLevel.
+	size_t streamingBudget = 0;
+	MipResidency residency;
+	bool sparse = false;
+	GLint sparseLevels = 0;         // array levels before the mip tail, when sparse
+	int firstLevel = 0;
+	int loadLevel = 0;              // finest level loaded with a layer's first upload
+	std::vector<int> residentLevels;    // finest level each layer holds
+	std::vector<int> targetLevels;      // finest level each layer should hold
+	std::vector<const unsigned char*> layerChains;      // each layer's chain, kept to upload finer levels later
+	std::vector<std::vector<unsigned char>> ownedChains;    // the decoded ones, which nothing else keeps
+	size_t residentBytes = 0;
+	GLuint evictions = 0;
+	GLuint lodBuffer = 0;           // LayerLodBlock: finest resident array level of each layer
+
+	std::vector<std::thread> workers;
+	std::atomic<GLsizei> nextLayer{ 0 };
+	std::atomic<bool> cancelled{ false };
+	std::atomic<GLuint> cacheHits{ 0 };
+
+	std::mutex readyMutex;
+	std::vector<DecodedLayer> ready;    // guarded by readyMutex
+
+	// Two upload buffers used in turn, so filling one does not wait for the
+	// GPU to finish reading the other
+	GLuint pixelBuffers[2] = { 0, 0 };
+	GLuint nextPixelBuffer = 0;
+
+	GLuint uploaded = 0;
+	std::chrono::steady_clock::time_point startTime;
+};
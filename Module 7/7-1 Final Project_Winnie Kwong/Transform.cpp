@@ -0,0 +1,84 @@
+///////////////////////////////////////////////////////////////////////////////
+// transform.cpp
+// ========
+// cached model matrices with dirty flags and a parent/child hierarchy
+///////////////////////////////////////////////////////////////////////////////
+
+#include "Transform.h"
+
+#include <glm/gtx/transform.hpp>
+
+int TransformHierarchy::Add(const glm::vec3& scale, float angle, const glm::vec3& axis, const glm::vec3& position, int parent)
+{
+	Local local;
+	local.scale = scale;
+	local.angle = angle;
+	local.axis = axis;
+	local.position = position;
+
+	locals.push_back(local);
+	parents.push_back(parent < (int)parents.size() ? parent : -1);
+	frames.push_back(glm::mat4(1.0f));
+	models.push_back(glm::mat4(1.0f));
+	dirty.push_back(1);
+	changed.push_back(0);
+	return (int)locals.size() - 1;
+}
+
+void TransformHierarchy::SetScale(int node, const glm::vec3& scale)
+{
+	locals[node].scale = scale;
+	dirty[node] = 1;
+}
+
+void TransformHierarchy::SetRotation(int node, float angle, const glm::vec3& axis)
+{
+	locals[node].angle = angle;
+	locals[node].axis = axis;
+	dirty[node] = 1;
+}
+
+void TransformHierarchy::SetPosition(int node, const glm::vec3& position)
+{
+	locals[node].position = position;
+	dirty[node] = 1;
+}
+
+///////////////////////////////////////////////////
+//	Update()
+//
+//	Walk the nodes front to back. A node is recomputed
+//	when its own transform changed or its parent was
+//	recomputed in this pass; parents always come before
+//	their children, so their frames are already current.
+///////////////////////////////////////////////////
+GLuint TransformHierarchy::Update()
+{
+	GLuint recomputed = 0;
+	for (size_t i = 0; i < locals.size(); ++i)
+	{
+		int parent = parents[i];
+		changed[i] = dirty[i] || (parent >= 0 && changed[parent]);
+		if (!changed[i])
+			continue;
+
+		const Local& local = locals[i];
+		glm::mat4 frame = glm::translate(local.position) * glm::rotate(local.angle, local.axis);
+		frames[i] = parent >= 0 ? frames[parent] * frame : frame;
+		// transformations are applied right-to-left: scale, rotate, then position
+		models[i] = frames[i] * glm::scale(local.scale);
+		dirty[i] = 0;
+		++recomputed;
+	}
+	return recomputed;
+}
+
+void TransformHierarchy::Clear()
+{
+	locals.clear();
+	parents.clear();
+	frames.clear();
+	models.clear();
+	dirty.clear();
+	changed.clear();
+}
@@ -0,0 +1,60 @@
+///////////////////////////////////////////////////////////////////////////////
+// transform.h
+// ========
+// cached model matrices for the scene: every node keeps its local transform,
+// an optional parent and a dirty flag, and only dirty nodes and the nodes
+// below them are recomputed
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+class TransformHierarchy
+{
+public:
+	// Add a node and return its index; parent is -1 for a root. A parent must
+	// be added before its children so one front-to-back pass visits parents
+	// first. The node's frame is parentFrame * translate(position) *
+	// rotate(angle, axis); scale only sizes the node's own mesh and is not
+	// inherited by its children.
+	int Add(const glm::vec3& scale, float angle, const glm::vec3& axis, const glm::vec3& position, int parent = -1);
+
+	// Change a node's local transform; it is recomputed by the next Update
+	void SetScale(int node, const glm::vec3& scale);
+	void SetRotation(int node, float angle, const glm::vec3& axis);
+	void SetPosition(int node, const glm::vec3& position);
+
+	// Recompute the model matrices of dirty nodes and of every node below
+	// them. Returns the number of matrices recomputed.
+	GLuint Update();
+
+	// True if the node's model matrix was recomputed by the last Update
+	bool Changed(int node) const { return changed[node] != 0; }
+
+	const glm::mat4& Model(int node) const { return models[node]; }
+	int Parent(int node) const { return parents[node]; }
+	GLsizei Count() const { return (GLsizei)locals.size(); }
+
+	void Clear();
+
+private:
+	struct Local
+	{
+		glm::vec3 scale;
+		float angle;        // rotation about axis, in radians
+		glm::vec3 axis;
+		glm::vec3 position;
+	};
+
+	std::vector<Local> locals;
+	std::vector<int> parents;
+	std::vector<glm::mat4> frames;          // translation and rotation, inherited by children
+	std::vector<glm::mat4> models;          // frame * scale, what the node's mesh is drawn with
+	std::vector<unsigned char> dirty;       // local transform changed since the last Update
+	std::vector<unsigned char> changed;     // model recomputed by the last Update
+};
@@ -0,0 +1,99 @@
+///////////////////////////////////////////////////////////////////////////////
+// uniforms.cpp
+// ========
+// resolve shader uniform locations once after a program links and hand out
+// typed handles so the render loop never looks a uniform up by name
+///////////////////////////////////////////////////////////////////////////////
+
+#include "Uniforms.h"
+
+#include <glm/gtc/type_ptr.hpp>
+
+#include "GLState.h"
+
+// Every Set goes through gGLState, which drops uploads of unchanged values
+
+void UniformInt::Set(GLint value) const
+{
+	if (gGLState.UniformChanged(location, &value, sizeof(value)))
+		glUniform1i(location, value);
+}
+
+void UniformFloat::Set(GLfloat value) const
+{
+	if (gGLState.UniformChanged(location, &value, sizeof(value)))
+		glUniform1f(location, value);
+}
+
+void UniformVec3::Set(GLfloat x, GLfloat y, GLfloat z) const
+{
+	Set(glm::vec3(x, y, z));
+}
+
+void UniformVec3::Set(const glm::vec3& value) const
+{
+	if (gGLState.UniformChanged(location, glm::value_ptr(value), sizeof(GLfloat) * 3))
+		glUniform3f(location, value.x, value.y, value.z);
+}
+
+void UniformVec4::Set(GLfloat x, GLfloat y, GLfloat z, GLfloat w) const
+{
+	const GLfloat value[4] = { x, y, z, w };
+	if (gGLState.UniformChanged(location, value, sizeof(value)))
+		glUniform4f(location, x, y, z, w);
+}
+
+void UniformMat4::Set(const glm::mat4& value) const
+{
+	if (gGLState.UniformChanged(location, glm::value_ptr(value), sizeof(GLfloat) * 16))
+		glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(value));
+}
+
+void UniformRegistry::Add(const char* name, UniformInt& handle)
+{
+	entries.push_back({ name, &handle.location });
+}
+
+void UniformRegistry::Add(const char* name, UniformFloat& handle)
+{
+	entries.push_back({ name, &handle.location });
+}
+
+void UniformRegistry::Add(const char* name, UniformVec3& handle)
+{
+	entries.push_back({ name, &handle.location });
+}
+
+void UniformRegistry::Add(const char* name, UniformVec4& handle)
+{
+	entries.push_back({ name, &handle.location });
+}
+
+void UniformRegistry::Add(const char* name, UniformMat4& handle)
+{
+	entries.push_back({ name, &handle.location });
+}
+
+///////////////////////////////////////////////////
+//	Resolve(GLuint)
+//
+//	programId: linked shader program
+//
+//	Look up the location of every registered uniform.
+//	Uniforms the GLSL compiler optimized away, or that
+//	were misspelled, come back as -1 and are recorded
+//	in the missing list.
+///////////////////////////////////////////////////
+bool UniformRegistry::Resolve(GLuint programId)
+{
+	missing.clear();
+
+	for (const Entry& entry : entries)
+	{
+		*entry.location = glGetUniformLocation(programId, entry.name);
+		if (*entry.location == -1)
+			missing.push_back(entry.name);
+	}
+
+	return missing.empty();
+}
@@ -0,0 +1,76 @@
+///////////////////////////////////////////////////////////////////////////////
+// uniforms.h
+// ========
+// resolve shader uniform locations once after a program links and hand out
+// typed handles so the render loop never looks a uniform up by name
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+
+#include <glm/glm.hpp>
+
+#include <string>
+#include <vector>
+
+// Typed handles for a resolved uniform location. A location of -1 is
+// silently ignored by glUniform*, so an unresolved handle is harmless to set.
+struct UniformInt
+{
+	GLint location = -1;
+	void Set(GLint value) const;
+};
+
+struct UniformFloat
+{
+	GLint location = -1;
+	void Set(GLfloat value) const;
+};
+
+struct UniformVec3
+{
+	GLint location = -1;
+	void Set(GLfloat x, GLfloat y, GLfloat z) const;
+	void Set(const glm::vec3& value) const;
+};
+
+struct UniformVec4
+{
+	GLint location = -1;
+	void Set(GLfloat x, GLfloat y, GLfloat z, GLfloat w) const;
+};
+
+struct UniformMat4
+{
+	GLint location = -1;
+	void Set(const glm::mat4& value) const;
+};
+
+class UniformRegistry
+{
+public:
+	// Register a handle to be filled in by Resolve()
+	void Add(const char* name, UniformInt& handle);
+	void Add(const char* name, UniformFloat& handle);
+	void Add(const char* name, UniformVec3& handle);
+	void Add(const char* name, UniformVec4& handle);
+	void Add(const char* name, UniformMat4& handle);
+
+	// Look up every registered name in the linked program.
+	// Returns false if any name did not resolve; see Missing().
+	bool Resolve(GLuint programId);
+
+	// Names that failed to resolve during the last Resolve()
+	const std::vector<std::string>& Missing() const { return missing; }
+
+private:
+	struct Entry
+	{
+		const char* name;
+		GLint* location;
+	};
+
+	std::vector<Entry> entries;
+	std::vector<std::string> missing;
+};